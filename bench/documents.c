@@ -0,0 +1,392 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            documents.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Synthetic documents for the benchmarks.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <serdec/yaml-error.h>
+
+#include "documents.h"
+
+// The trees of the "deep" shape are nested this deep.
+static const size_t DEEP_DEPTH = 32;
+
+// The strings of the "strings" shape are this long.
+#define STRING_LENGTH 1024
+
+///////////////////////////////////////////////////////////////////////////////
+// Writing
+////
+
+static int write_event(BenchWriter* writer, int result) {
+    writer->events += 1;
+    return result;
+}
+
+static int map_start(BenchWriter* writer) {
+    return write_event(writer, serdec_yaml_serialize_map_start(writer->ser));
+}
+
+static int map_end(BenchWriter* writer) {
+    return write_event(writer, serdec_yaml_serialize_map_end(writer->ser));
+}
+
+static int map_key(BenchWriter* writer, const char* key) {
+    return write_event(writer, serdec_yaml_serialize_map_key(writer->ser,
+            key));
+}
+
+static int list_start(BenchWriter* writer) {
+    return write_event(writer, serdec_yaml_serialize_list_start(writer->ser));
+}
+
+static int list_end(BenchWriter* writer) {
+    return write_event(writer, serdec_yaml_serialize_list_end(writer->ser));
+}
+
+static int int64_value(BenchWriter* writer, int64_t value) {
+    return write_event(writer, serdec_yaml_serialize_int64(writer->ser,
+            value));
+}
+
+static int string_value(BenchWriter* writer, const char* value,
+    size_t length)
+{
+    return write_event(writer, serdec_yaml_serialize_string_n(writer->ser,
+            value, length));
+}
+
+// The content of the <index>th string of the "strings" shape: printable
+// characters which need no escapes, so that every string has the same length.
+static void fill_string(char* string, size_t index) {
+    for (size_t i = 0; i < STRING_LENGTH; ++i) {
+        string[i] = (char)('a' + (i + index) % 26);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Deep Nesting
+////
+
+// A list of trees. Each level of a tree is {level: N, child: {...}}, and the
+// innermost level has no child.
+static int serialize_tree(BenchWriter* writer, size_t level) {
+    if (map_start(writer) || map_key(writer, "level") ||
+        int64_value(writer, (int64_t)level)) {
+        return 1;
+    } else if (level + 1 < DEEP_DEPTH && (map_key(writer, "child") ||
+            serialize_tree(writer, level + 1))) {
+        return 1;
+    }
+    return map_end(writer);
+}
+
+static int serialize_deep(BenchWriter* writer, size_t count) {
+    if (list_start(writer)) {
+        return 1;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (serialize_tree(writer, 0)) {
+            return 1;
+        }
+    }
+    return list_end(writer);
+}
+
+typedef struct TreeVisit {
+    size_t level;
+    size_t depth;
+} TreeVisit;
+
+static int visit_tree_entry(SerdecYamlDeserializer* deser, void* user_data,
+    const char* key)
+{
+    TreeVisit* visit = (TreeVisit*)user_data;
+    if (0 == strcmp("level", key)) {
+        int64_t level = 0;
+        if (serdec_yaml_deserialize_int64(deser, &level)) {
+            return 1;
+        }
+        return (int64_t)visit->level != level;
+    } else if (0 == strcmp("child", key)) {
+        TreeVisit child = {.level=visit->level + 1, .depth=visit->level + 1};
+        if (serdec_yaml_deserialize_map(deser, visit_tree_entry, &child)) {
+            return 1;
+        }
+        visit->depth = child.depth;
+        return 0;
+    }
+    return 1;
+}
+
+static int visit_tree(SerdecYamlDeserializer* deser, void* user_data,
+    size_t index)
+{
+    (void)index;
+    (void)user_data;
+    TreeVisit visit = {0};
+    if (serdec_yaml_deserialize_map(deser, visit_tree_entry, &visit)) {
+        return 1;
+    }
+    return DEEP_DEPTH != visit.depth + 1;
+}
+
+static int deserialize_deep(SerdecYamlDeserializer* deser, size_t count) {
+    (void)count;
+    return serdec_yaml_deserialize_list(deser, visit_tree, NULL);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Wide Maps
+////
+
+// A single map with <count> integer entries, "field_000000" onwards.
+static int serialize_wide(BenchWriter* writer, size_t count) {
+    if (map_start(writer)) {
+        return 1;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        char key[32];
+        snprintf(key, sizeof(key), "field_%06zu", i);
+        if (map_key(writer, key) || int64_value(writer, (int64_t)i)) {
+            return 1;
+        }
+    }
+    return map_end(writer);
+}
+
+static int visit_wide_entry(SerdecYamlDeserializer* deser, void* user_data,
+    const char* key)
+{
+    (void)key;
+    size_t* entries = (size_t*)user_data;
+    int64_t value = 0;
+    if (serdec_yaml_deserialize_int64(deser, &value)) {
+        return 1;
+    }
+    return (int64_t)(*entries)++ != value;
+}
+
+static int deserialize_wide(SerdecYamlDeserializer* deser, size_t count) {
+    size_t entries = 0;
+    if (serdec_yaml_deserialize_map(deser, visit_wide_entry, &entries)) {
+        return 1;
+    }
+    return count != entries;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Integer Lists
+////
+
+static int64_t list_value(size_t index) {
+    return (int64_t)(index * 2654435761u % 1000000007u) - 500000000;
+}
+
+static int serialize_ints(BenchWriter* writer, size_t count) {
+    if (list_start(writer)) {
+        return 1;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (int64_value(writer, list_value(i))) {
+            return 1;
+        }
+    }
+    return list_end(writer);
+}
+
+// The benchmark's allocators are backed by malloc(3), so the vector can be
+// released with free(3).
+static int deserialize_ints(SerdecYamlDeserializer* deser, size_t count) {
+    int64_t* values = NULL;
+    size_t length = 0;
+    if (serdec_yaml_deserialize_int64_vector(deser, &values, &length)) {
+        return 1;
+    }
+
+    int result = count != length;
+    for (size_t i = 0; 0 == result && i < length; ++i) {
+        result = list_value(i) != values[i];
+    }
+    free(values);
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Long Strings
+////
+
+static int serialize_strings(BenchWriter* writer, size_t count) {
+    if (list_start(writer)) {
+        return 1;
+    }
+
+    char string[STRING_LENGTH];
+    for (size_t i = 0; i < count; ++i) {
+        fill_string(string, i);
+        if (string_value(writer, string, sizeof(string))) {
+            return 1;
+        }
+    }
+    return list_end(writer);
+}
+
+static int visit_string(SerdecYamlDeserializer* deser, void* user_data,
+    size_t index)
+{
+    (void)user_data;
+    const char* value = NULL;
+    size_t length = 0;
+    if (serdec_yaml_deserialize_string_n(deser, &value, &length)) {
+        return 1;
+    }
+
+    char expected[STRING_LENGTH];
+    fill_string(expected, index);
+    return STRING_LENGTH != length || 0 != memcmp(expected, value, length);
+}
+
+static int deserialize_strings(SerdecYamlDeserializer* deser, size_t count) {
+    (void)count;
+    return serdec_yaml_deserialize_list(deser, visit_string, NULL);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Document Streams
+////
+
+// <count> small documents, each a record like {id: 3, name: 'record 3',
+// values: [3, 4, 5, 6]}.
+static int serialize_record(BenchWriter* writer, size_t id) {
+    char name[32];
+    int length = snprintf(name, sizeof(name), "record %zu", id);
+    if (map_start(writer) || map_key(writer, "id") ||
+        int64_value(writer, (int64_t)id) || map_key(writer, "name") ||
+        string_value(writer, name, (size_t)length) ||
+        map_key(writer, "values") || list_start(writer)) {
+        return 1;
+    }
+
+    for (size_t i = 0; i < 4; ++i) {
+        if (int64_value(writer, (int64_t)(id + i))) {
+            return 1;
+        }
+    }
+    return list_end(writer) || map_end(writer);
+}
+
+static int serialize_stream(BenchWriter* writer, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        if (0 < i && (write_event(writer,
+                    serdec_yaml_serialize_document_end(writer->ser)) ||
+                write_event(writer,
+                    serdec_yaml_serialize_document_start(writer->ser)))) {
+            return 1;
+        } else if (serialize_record(writer, i)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+typedef struct RecordVisit {
+    int64_t id;
+    int64_t sum;
+} RecordVisit;
+
+static int visit_record_value(SerdecYamlDeserializer* deser,
+    void* user_data, size_t index)
+{
+    (void)index;
+    RecordVisit* visit = (RecordVisit*)user_data;
+    int64_t value = 0;
+    if (serdec_yaml_deserialize_int64(deser, &value)) {
+        return 1;
+    }
+
+    visit->sum += value;
+    return 0;
+}
+
+static int visit_record_entry(SerdecYamlDeserializer* deser,
+    void* user_data, const char* key)
+{
+    RecordVisit* visit = (RecordVisit*)user_data;
+    const char* name = NULL;
+    switch (*key) {
+    case 'i': return serdec_yaml_deserialize_int64(deser, &visit->id);
+    case 'n': return serdec_yaml_deserialize_string(deser, &name);
+    case 'v':
+        return serdec_yaml_deserialize_list(deser, visit_record_value,
+            visit);
+    default:
+        return 1;
+    }
+}
+
+static int deserialize_stream(SerdecYamlDeserializer* deser, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        RecordVisit visit = {0};
+        if (0 < i && serdec_yaml_deserializer_next_document(deser)) {
+            return 1;
+        } else if (serdec_yaml_deserialize_map(deser, visit_record_entry,
+                &visit) || (int64_t)i != visit.id ||
+            (int64_t)(4 * i + 6) != visit.sum) {
+            return 1;
+        }
+    }
+    return SERDEC_YAML_END_OF_STREAM !=
+        serdec_yaml_deserializer_next_document(deser);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Shapes
+////
+
+// The counts give documents of roughly 64 KiB and 4 MiB.
+const BenchShape BENCH_SHAPES[] = {
+    {"deep", serialize_deep, deserialize_deep, {14, 900}},
+    {"wide", serialize_wide, deserialize_wide, {3600, 230000}},
+    {"ints", serialize_ints, deserialize_ints, {5400, 340000}},
+    {"strings", serialize_strings, deserialize_strings, {64, 4000}},
+    {"stream", serialize_stream, deserialize_stream, {870, 48000}},
+};
+
+const size_t BENCH_SHAPE_COUNT =
+    sizeof(BENCH_SHAPES) / sizeof(BENCH_SHAPES[0]);
+
+///////////////////////////////////////////////////////////////////////////////
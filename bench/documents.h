@@ -0,0 +1,69 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            documents.h
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Synthetic documents for the benchmarks.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#ifndef SERDEC_BENCH_DOCUMENTS_H
+#define SERDEC_BENCH_DOCUMENTS_H
+
+#include <stddef.h>
+
+#include <serdec/yaml.h>
+
+// A serializer, and the number of events (map and list starts and ends, keys,
+// scalars and document boundaries) which have been written to it.
+typedef struct BenchWriter {
+    SerdecYamlSerializer* ser;
+    size_t events;
+} BenchWriter;
+
+typedef enum BenchSize {
+    BENCH_SIZE_SMALL,
+    BENCH_SIZE_LARGE,
+    BENCH_SIZE_COUNT,
+} BenchSize;
+
+// A shape of document. _serialize() writes the document with <count>
+// elements (trees, entries, documents, etc.) between _start() and _end(), and
+// _deserialize() reads it back, checking its contents. Both return non-zero
+// on failure. <counts> selects the number of elements for each size.
+typedef struct BenchShape {
+    const char* name;
+    int (*serialize)(BenchWriter* writer, size_t count);
+    int (*deserialize)(SerdecYamlDeserializer* deser, size_t count);
+    size_t counts[BENCH_SIZE_COUNT];
+} BenchShape;
+
+extern const BenchShape BENCH_SHAPES[];
+extern const size_t BENCH_SHAPE_COUNT;
+
+#endif // SERDEC_BENCH_DOCUMENTS_H
+
+///////////////////////////////////////////////////////////////////////////////
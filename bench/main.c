@@ -0,0 +1,369 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            main.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Entrypoint for the benchmarks.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <serdec/allocator.h>
+#include <serdec/yaml.h>
+
+#include "documents.h"
+
+// Each measurement processes at least this many bytes, and repeats at least
+// this many times, so that small documents aren't dominated by timer noise.
+static const size_t TARGET_BYTES = 16 * 1024 * 1024;
+static const size_t MIN_REPETITIONS = 3;
+
+// A document of one shape and size, and the files it's read from and written
+// to.
+typedef struct BenchCase {
+    const BenchShape* shape;
+    size_t count;
+    char* document;
+    size_t length;
+    size_t events;
+    char* buffer;
+    FILE* output;
+    char path[64];
+} BenchCase;
+
+typedef int bench_target(BenchCase* bench, const SerdecAllocator* allocator);
+
+///////////////////////////////////////////////////////////////////////////////
+// Allocations and Memory
+////
+
+// Every allocation from serdec goes through this. libyaml allocates its own
+// state with malloc(3), so it's not counted.
+static void* counting_alloc(void* ctx, size_t size) {
+    *(size_t*)ctx += 1;
+    return malloc(size);
+}
+
+static void* counting_realloc(void* ctx, void* pointer, size_t size) {
+    *(size_t*)ctx += 1;
+    return realloc(pointer, size);
+}
+
+static void counting_free(void* ctx, void* pointer) {
+    (void)ctx;
+    free(pointer);
+}
+
+// Reset the high-water mark of the resident set, so that each measurement
+// reports its own peak. This is only possible on Linux: elsewhere, the peak
+// is that of the whole run so far.
+static void reset_peak_rss(void) {
+    FILE* clear_refs = fopen("/proc/self/clear_refs", "w");
+    if (NULL != clear_refs) {
+        fputs("5", clear_refs);
+        fclose(clear_refs);
+    }
+}
+
+// Return the peak resident set size, in KiB.
+static long peak_rss(void) {
+    FILE* status = fopen("/proc/self/status", "r");
+    if (NULL != status) {
+        char line[128];
+        long peak = -1;
+        while (0 > peak && NULL != fgets(line, sizeof(line), status)) {
+            if (1 != sscanf(line, "VmHWM: %ld kB", &peak)) {
+                peak = -1;
+            }
+        }
+        fclose(status);
+        if (0 <= peak) {
+            return peak;
+        }
+    }
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+static double now(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec + (double)time.tv_nsec / 1e9;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Serializers
+////
+
+static int serialize(const BenchCase* bench, SerdecYamlSerializer* ser) {
+    BenchWriter writer = {.ser=ser};
+    return NULL == ser || serdec_yaml_serialize_start(ser) ||
+        bench->shape->serialize(&writer, bench->count) ||
+        serdec_yaml_serialize_end(ser);
+}
+
+static int serialize_string(BenchCase* bench,
+    const SerdecAllocator* allocator)
+{
+    SerdecYamlSerializer* ser =
+        serdec_yaml_serializer_new_string_with_allocator(allocator);
+    int result = serialize(bench, ser);
+    if (NULL != ser) {
+        serdec_yaml_serializer_free(ser);
+    }
+    return result;
+}
+
+static int serialize_buffer(BenchCase* bench,
+    const SerdecAllocator* allocator)
+{
+    SerdecYamlSerializer* ser =
+        serdec_yaml_serializer_new_buffer_with_allocator(bench->buffer,
+            bench->length + 1, allocator);
+    int result = serialize(bench, ser);
+    if (NULL != ser) {
+        serdec_yaml_serializer_free(ser);
+    }
+    return result;
+}
+
+static int serialize_file(BenchCase* bench, const SerdecAllocator* allocator)
+{
+    rewind(bench->output);
+    SerdecYamlSerializer* ser = serdec_yaml_serializer_new_file_with_allocator(
+        bench->output, allocator);
+    int result = serialize(bench, ser);
+    if (NULL != ser) {
+        serdec_yaml_serializer_free(ser);
+    }
+    return result || 0 != fflush(bench->output);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// De-serializers
+////
+
+static int deserialize(const BenchCase* bench, SerdecYamlDeserializer* deser)
+{
+    if (NULL == deser) {
+        return 1;
+    }
+
+    int result = bench->shape->deserialize(deser, bench->count);
+    serdec_yaml_deserializer_free(deser);
+    return result;
+}
+
+static int deserialize_string(BenchCase* bench,
+    const SerdecAllocator* allocator)
+{
+    return deserialize(bench,
+        serdec_yaml_deserializer_new_string_with_allocator(bench->document,
+            bench->length, allocator));
+}
+
+static int deserialize_file(BenchCase* bench,
+    const SerdecAllocator* allocator)
+{
+    FILE* input = fopen(bench->path, "r");
+    if (NULL == input) {
+        return 1;
+    }
+
+    int result = deserialize(bench,
+        serdec_yaml_deserializer_new_file_with_allocator(input, allocator));
+    fclose(input);
+    return result;
+}
+
+// Regular files are mapped into memory by the path de-serializer.
+static int deserialize_mmap(BenchCase* bench,
+    const SerdecAllocator* allocator)
+{
+    return deserialize(bench,
+        serdec_yaml_deserializer_new_path_with_allocator(bench->path,
+            allocator));
+}
+
+typedef struct BenchTarget {
+    const char* name;
+    bench_target* run;
+} BenchTarget;
+
+static const BenchTarget TARGETS[] = {
+    {"ser-string", serialize_string},
+    {"ser-buffer", serialize_buffer},
+    {"ser-file", serialize_file},
+    {"deser-string", deserialize_string},
+    {"deser-file", deserialize_file},
+    {"deser-mmap", deserialize_mmap},
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Cases
+////
+
+// Generate the document for <bench>, and stage it in a temporary file for the
+// de-serializers which read files.
+static int prepare_case(BenchCase* bench) {
+    SerdecYamlSerializer* ser = serdec_yaml_serializer_new_string();
+    BenchWriter writer = {.ser=ser};
+    if (NULL == ser || serdec_yaml_serialize_start(ser) ||
+        bench->shape->serialize(&writer, bench->count) ||
+        serdec_yaml_serialize_end(ser)) {
+        fprintf(stderr, "%s: %s\n", bench->shape->name,
+            NULL != ser ? serdec_yaml_serializer_strerror(ser) : "no memory");
+        return 1;
+    }
+
+    bench->events = writer.events;
+    bench->document = serdec_yaml_serializer_take_string(ser, &bench->length);
+    serdec_yaml_serializer_free(ser);
+    bench->buffer = malloc(bench->length + 1);
+    bench->output = tmpfile();
+    if (NULL == bench->document || NULL == bench->buffer ||
+        NULL == bench->output) {
+        perror(bench->shape->name);
+        return 1;
+    }
+
+    const char* directory = getenv("TMPDIR");
+    snprintf(bench->path, sizeof(bench->path), "%s/benchserdec-XXXXXX",
+        NULL != directory && strlen(directory) < 32 ? directory : "/tmp");
+    int fd = mkstemp(bench->path);
+    if (0 > fd) {
+        perror(bench->path);
+        bench->path[0] = '\0';
+        return 1;
+    }
+
+    ssize_t written = write(fd, bench->document, bench->length);
+    close(fd);
+    if ((ssize_t)bench->length != written) {
+        perror(bench->path);
+        return 1;
+    }
+    return 0;
+}
+
+static void release_case(BenchCase* bench) {
+    if ('\0' != bench->path[0]) {
+        unlink(bench->path);
+    }
+    if (NULL != bench->output) {
+        fclose(bench->output);
+    }
+    free(bench->buffer);
+    free(bench->document);
+}
+
+static int run_target(BenchCase* bench, const BenchTarget* target) {
+    size_t allocations = 0;
+    SerdecAllocator allocator = {
+        .alloc=counting_alloc,
+        .realloc=counting_realloc,
+        .free=counting_free,
+        .ctx=&allocations,
+    };
+
+    size_t repetitions = TARGET_BYTES / bench->length;
+    if (MIN_REPETITIONS > repetitions) {
+        repetitions = MIN_REPETITIONS;
+    }
+
+    reset_peak_rss();
+    double start = now();
+    for (size_t i = 0; i < repetitions; ++i) {
+        if (target->run(bench, &allocator)) {
+            fprintf(stderr, "%s: %s failed\n", bench->shape->name,
+                target->name);
+            return 1;
+        }
+    }
+    double seconds = now() - start;
+
+    double documents = (double)repetitions;
+    printf("%-8s %9zu  %-12s %9.1f %11.2f %11.1f %10ld\n", bench->shape->name,
+        bench->length / 1024, target->name,
+        documents * (double)bench->length / seconds / 1e6,
+        documents * (double)bench->events / seconds / 1e6,
+        (double)allocations / documents, peak_rss());
+    return 0;
+}
+
+static int run_case(const BenchShape* shape, size_t count) {
+    BenchCase bench = {.shape=shape, .count=count};
+    int result = prepare_case(&bench);
+    for (size_t i = 0; 0 == result && i < sizeof(TARGETS) / sizeof(TARGETS[0]);
+         ++i) {
+        result = run_target(&bench, &TARGETS[i]);
+    }
+    release_case(&bench);
+    return result;
+}
+
+// Whether the shape was selected on the command line. With no arguments,
+// every shape is.
+static bool selected(const BenchShape* shape, int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (0 == strcmp(shape->name, argv[i])) {
+            return true;
+        }
+    }
+    return 1 == argc;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Main
+////
+
+int main(int argc, char** argv) {
+    printf("%-8s %9s  %-12s %9s %11s %11s %10s\n", "shape", "size(KiB)",
+        "target", "MB/s", "Mevents/s", "allocs/doc", "peak(KiB)");
+    for (size_t i = 0; i < BENCH_SHAPE_COUNT; ++i) {
+        const BenchShape* shape = &BENCH_SHAPES[i];
+        if (!selected(shape, argc, argv)) {
+            continue;
+        }
+
+        for (size_t size = 0; size < BENCH_SIZE_COUNT; ++size) {
+            if (run_case(shape, shape->counts[size])) {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            allocator-ops.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Implementation of allocation through user-defined
+//                  allocators.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <serdec/allocator-ops.h>
+
+static void* default_alloc(void* ctx, size_t size) {
+    (void)ctx;
+    return malloc(size);
+}
+
+static void* default_realloc(void* ctx, void* pointer, size_t size) {
+    (void)ctx;
+    return realloc(pointer, size);
+}
+
+static void default_free(void* ctx, void* pointer) {
+    (void)ctx;
+    free(pointer);
+}
+
+static const SerdecAllocator DEFAULT_ALLOCATOR = {
+    .alloc = default_alloc,
+    .realloc = default_realloc,
+    .free = default_free,
+    .ctx = NULL,
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Public API
+////
+
+const SerdecAllocator* allocator_or_default(const SerdecAllocator* allocator)
+{
+    return NULL != allocator ? allocator : &DEFAULT_ALLOCATOR;
+}
+
+void* allocator_alloc(const SerdecAllocator* allocator, size_t size) {
+    void* pointer = allocator->alloc(allocator->ctx, size);
+    if (NULL == pointer) {
+        errno = ENOMEM;
+    }
+    return pointer;
+}
+
+void* allocator_realloc(const SerdecAllocator* allocator, void* pointer,
+    size_t size)
+{
+    void* resized = allocator->realloc(allocator->ctx, pointer, size);
+    if (NULL == resized) {
+        errno = ENOMEM;
+    }
+    return resized;
+}
+
+void allocator_free(const SerdecAllocator* allocator, void* pointer) {
+    if (NULL != pointer) {
+        allocator->free(allocator->ctx, pointer);
+    }
+}
+
+void* allocator_calloc(const SerdecAllocator* allocator, size_t count,
+    size_t size)
+{
+    if (0 != size && SIZE_MAX / size < count) {
+        errno = ENOMEM;
+        return NULL;
+    }
+
+    void* pointer = allocator_alloc(allocator, count * size);
+    if (NULL != pointer) {
+        memset(pointer, 0, count * size);
+    }
+    return pointer;
+}
+
+///////////////////////////////////////////////////////////////////////////////
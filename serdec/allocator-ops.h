@@ -0,0 +1,54 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            allocator-ops.h
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Allocation through user-defined allocators.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#ifndef SERDEC_ALLOCATOR_OPS_H
+#define SERDEC_ALLOCATOR_OPS_H
+
+#include <stddef.h>
+
+#include <serdec/allocator.h>
+
+// Return <allocator>, or the default allocator if it's NULL.
+const SerdecAllocator* allocator_or_default(const SerdecAllocator* allocator);
+
+void* allocator_alloc(const SerdecAllocator* allocator, size_t size);
+void* allocator_realloc(const SerdecAllocator* allocator, void* pointer,
+    size_t size);
+void allocator_free(const SerdecAllocator* allocator, void* pointer);
+
+// Allocate <count> * <size> zeroed bytes, checking for overflow.
+void* allocator_calloc(const SerdecAllocator* allocator, size_t count,
+    size_t size);
+
+#endif // SERDEC_ALLOCATOR_OPS_H
+
+///////////////////////////////////////////////////////////////////////////////
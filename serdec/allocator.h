@@ -0,0 +1,53 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            allocator.h
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     User-defined memory allocators.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#ifndef SERDEC_ALLOCATOR_H
+#define SERDEC_ALLOCATOR_H
+
+#include <stddef.h>
+
+// An allocator, for the memory serdec allocates on behalf of the caller: the
+// de/serializers themselves, their output buffers, arenas, and so on. The
+// functions have the semantics of malloc(3), realloc(3) and free(3), and each
+// receives <ctx> as its first argument. Constructors which accept an
+// allocator treat NULL as the default allocator (i.e. malloc(3) and friends).
+// Note that libyaml allocates its own internal state with malloc(3).
+typedef struct SerdecAllocator {
+    void* (*alloc)(void* ctx, size_t size);
+    void* (*realloc)(void* ctx, void* pointer, size_t size);
+    void (*free)(void* ctx, void* pointer);
+    void* ctx;
+} SerdecAllocator;
+
+#endif // SERDEC_ALLOCATOR_H
+
+///////////////////////////////////////////////////////////////////////////////
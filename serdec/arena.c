@@ -0,0 +1,174 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            arena.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Implementation of the bump allocator.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <stdint.h>
+#include <string.h>
+
+#include <serdec/allocator-ops.h>
+#include <serdec/arena.h>
+
+static const size_t SERDEC_ARENA_BLOCK_SIZE = 65536;
+
+#define ARENA_ALIGNMENT _Alignof(max_align_t)
+
+typedef struct ArenaBlock {
+    struct ArenaBlock* next;
+    size_t capacity;
+    size_t used;
+} ArenaBlock;
+
+typedef struct SerdecArena {
+    ArenaBlock* head;
+    ArenaBlock* current;
+    size_t block_size;
+    SerdecAllocator allocator;
+} SerdecArena;
+
+///////////////////////////////////////////////////////////////////////////////
+// Private API
+////
+
+static size_t align_up(size_t value) {
+    return (value + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+}
+
+// The data of each block follows its header, at the first aligned offset.
+static unsigned char* block_data(ArenaBlock* block) {
+    return (unsigned char*)block + align_up(sizeof(ArenaBlock));
+}
+
+static void* block_alloc(ArenaBlock* block, size_t size) {
+    size_t offset = align_up(block->used);
+    if (offset > block->capacity || size > block->capacity - offset) {
+        return NULL;
+    }
+
+    block->used = offset + size;
+    return block_data(block) + offset;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Public API
+////
+
+SerdecArena* serdec_arena_new(size_t block_size) {
+    return serdec_arena_new_with_allocator(block_size, NULL);
+}
+
+SerdecArena* serdec_arena_new_with_allocator(size_t block_size,
+    const SerdecAllocator* allocator)
+{
+    allocator = allocator_or_default(allocator);
+    SerdecArena* arena = allocator_alloc(allocator, sizeof(SerdecArena));
+    if (NULL == arena) {
+        return NULL;
+    }
+
+    arena->allocator = *allocator;
+    arena->head = NULL;
+    arena->current = NULL;
+    arena->block_size = 0 < block_size ? block_size : SERDEC_ARENA_BLOCK_SIZE;
+    return arena;
+}
+
+void* serdec_arena_alloc(SerdecArena* arena, size_t size) {
+    // Blocks after the current one are unused, since the last _reset().
+    for (ArenaBlock* block = arena->current; NULL != block;
+         block = block->next) {
+        void* memory = block_alloc(block, size);
+        if (NULL != memory) {
+            arena->current = block;
+            return memory;
+        }
+    }
+
+    size_t capacity = size > arena->block_size ? size : arena->block_size;
+    size_t header = align_up(sizeof(ArenaBlock));
+    if (SIZE_MAX - header < capacity) {
+        return NULL;
+    }
+
+    ArenaBlock* block = allocator_alloc(&arena->allocator, header + capacity);
+    if (NULL == block) {
+        return NULL;
+    }
+
+    block->capacity = capacity;
+    block->used = 0;
+    if (NULL == arena->current) {
+        block->next = arena->head;
+        arena->head = block;
+    } else {
+        block->next = arena->current->next;
+        arena->current->next = block;
+    }
+    arena->current = block;
+    return block_alloc(block, size);
+}
+
+char* serdec_arena_strndup(SerdecArena* arena, const char* string,
+    size_t length)
+{
+    if (SIZE_MAX == length) {
+        return NULL;
+    }
+
+    char* copy = serdec_arena_alloc(arena, length + 1);
+    if (NULL == copy) {
+        return NULL;
+    }
+
+    memcpy(copy, string, length);
+    copy[length] = '\0';
+    return copy;
+}
+
+void serdec_arena_reset(SerdecArena* arena) {
+    for (ArenaBlock* block = arena->head; NULL != block; block = block->next) {
+        block->used = 0;
+    }
+    arena->current = arena->head;
+}
+
+void serdec_arena_free(SerdecArena* arena) {
+    ArenaBlock* block = arena->head;
+    while (NULL != block) {
+        ArenaBlock* next = block->next;
+        allocator_free(&arena->allocator, block);
+        block = next;
+    }
+
+    SerdecAllocator allocator = arena->allocator;
+    allocator_free(&allocator, arena);
+}
+
+///////////////////////////////////////////////////////////////////////////////
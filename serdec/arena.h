@@ -0,0 +1,72 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            arena.h
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Bump allocator for the lifetimes of de-serialized values.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#ifndef SERDEC_ARENA_H
+#define SERDEC_ARENA_H
+
+#include <stddef.h>
+
+#include <serdec/allocator.h>
+
+// An arena hands out memory from large blocks, by bumping a pointer. Nothing
+// allocated from an arena is freed individually: everything is released at
+// once, by _reset() or _free(). This makes it a good fit for the strings of a
+// de-serialized object graph, which usually share a single lifetime.
+typedef struct SerdecArena SerdecArena;
+
+// Create an arena which allocates blocks of <block_size> bytes (or larger, for
+// larger allocations). A <block_size> of zero selects a default. Return NULL
+// if memory could not be allocated.
+SerdecArena* serdec_arena_new(size_t block_size);
+
+// Like _new(), but the arena and its blocks are allocated from <allocator>.
+SerdecArena* serdec_arena_new_with_allocator(size_t block_size,
+    const SerdecAllocator* allocator);
+
+// Allocate <size> bytes from the arena, aligned for any type. Return NULL if
+// memory could not be allocated.
+void* serdec_arena_alloc(SerdecArena* arena, size_t size);
+
+// Copy <length> bytes of <string> into the arena, and NUL-terminate the copy.
+char* serdec_arena_strndup(SerdecArena* arena, const char* string,
+    size_t length);
+
+// Release everything allocated from the arena. The arena keeps its blocks, so
+// that they can be reused, e.g. for the next document.
+void serdec_arena_reset(SerdecArena* arena);
+
+// Free the arena, and everything allocated from it.
+void serdec_arena_free(SerdecArena* arena);
+
+#endif // SERDEC_ARENA_H
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,276 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            codec.h
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Codec-agnostic serializer and de-serializer interface
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#ifndef SERDEC_CODEC_H
+#define SERDEC_CODEC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Every codec has the same shape: start/end, maps, lists and scalars, and
+// visitor callbacks for de-serialization. A SerdecSerializer or
+// SerdecDeserializer wraps one of them behind a table of operations, so that
+// the routine for a type can be written once and used with any codec. The
+// wrappers are values, not allocations: each codec has a routine which returns
+// one for an existing de/serializer, e.g. serdec_yaml_serializer_generic(),
+// and the wrapped object is still used (and freed) through its own API.
+//
+// The routines below dispatch through the table inline. The tables are const,
+// so once the wrapper is constructed where the compiler can see it (e.g. with
+// link-time optimization), the indirect calls resolve to the codec's routines
+// at compile time. Errors are reported by the codec, with its own error codes:
+// every routine returns zero on success, and _strerror() describes the last
+// failure.
+typedef struct SerdecSerializer SerdecSerializer;
+typedef struct SerdecDeserializer SerdecDeserializer;
+
+///////////////////////////////////////////////////////////////////////////////
+// Serializer Interface
+////
+
+// The operations of a serializer. Each receives the codec's serializer.
+typedef struct SerdecSerializerOps {
+    int (*start)(void* ser);
+    int (*end)(void* ser);
+    int (*map_start)(void* ser);
+    int (*map_end)(void* ser);
+    int (*map_key)(void* ser, const char* key, size_t length);
+    int (*list_start)(void* ser);
+    int (*list_end)(void* ser);
+    int (*boolean)(void* ser, bool value);
+    int (*integer)(void* ser, int value);
+    int (*int64)(void* ser, int64_t value);
+    int (*uint64)(void* ser, uint64_t value);
+    int (*size)(void* ser, size_t value);
+    int (*real)(void* ser, double value);
+    int (*string)(void* ser, const char* value, size_t length);
+    const char* (*strerror)(void* ser);
+} SerdecSerializerOps;
+
+struct SerdecSerializer {
+    const SerdecSerializerOps* ops;
+    void* codec;
+};
+
+static inline const char* serdec_serializer_strerror(SerdecSerializer* ser) {
+    return ser->ops->strerror(ser->codec);
+}
+
+static inline int serdec_serialize_start(SerdecSerializer* ser) {
+    return ser->ops->start(ser->codec);
+}
+
+static inline int serdec_serialize_end(SerdecSerializer* ser) {
+    return ser->ops->end(ser->codec);
+}
+
+static inline int serdec_serialize_map_start(SerdecSerializer* ser) {
+    return ser->ops->map_start(ser->codec);
+}
+
+static inline int serdec_serialize_map_end(SerdecSerializer* ser) {
+    return ser->ops->map_end(ser->codec);
+}
+
+static inline int serdec_serialize_map_key_n(SerdecSerializer* ser,
+    const char* key, size_t length)
+{
+    return ser->ops->map_key(ser->codec, key, length);
+}
+
+static inline int serdec_serialize_map_key(SerdecSerializer* ser,
+    const char* key)
+{
+    return ser->ops->map_key(ser->codec, key, strlen(key));
+}
+
+static inline int serdec_serialize_list_start(SerdecSerializer* ser) {
+    return ser->ops->list_start(ser->codec);
+}
+
+static inline int serdec_serialize_list_end(SerdecSerializer* ser) {
+    return ser->ops->list_end(ser->codec);
+}
+
+static inline int serdec_serialize_bool(SerdecSerializer* ser, bool value) {
+    return ser->ops->boolean(ser->codec, value);
+}
+
+static inline int serdec_serialize_int(SerdecSerializer* ser, int value) {
+    return ser->ops->integer(ser->codec, value);
+}
+
+static inline int serdec_serialize_int64(SerdecSerializer* ser,
+    int64_t value)
+{
+    return ser->ops->int64(ser->codec, value);
+}
+
+static inline int serdec_serialize_uint64(SerdecSerializer* ser,
+    uint64_t value)
+{
+    return ser->ops->uint64(ser->codec, value);
+}
+
+static inline int serdec_serialize_size_t(SerdecSerializer* ser,
+    size_t value)
+{
+    return ser->ops->size(ser->codec, value);
+}
+
+static inline int serdec_serialize_double(SerdecSerializer* ser,
+    double value)
+{
+    return ser->ops->real(ser->codec, value);
+}
+
+static inline int serdec_serialize_string_n(SerdecSerializer* ser,
+    const char* value, size_t length)
+{
+    return ser->ops->string(ser->codec, value, length);
+}
+
+static inline int serdec_serialize_string(SerdecSerializer* ser,
+    const char* value)
+{
+    return ser->ops->string(ser->codec, value, strlen(value));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// De-serializer Interface
+////
+
+// The visitor callbacks of the generic interface. As for each codec, they must
+// de-serialize (or skip) exactly one value. <key> is not necessarily
+// NUL-terminated, and is only valid for the duration of the call. Return
+// non-zero to stop de-serialization.
+typedef int serdec_visit_map_callback(SerdecDeserializer* deser,
+    void* user_data, const char* key, size_t length);
+typedef int serdec_visit_list_callback(SerdecDeserializer* deser,
+    void* user_data, size_t index);
+
+// The operations of a de-serializer. Visitors receive the generic
+// de-serializer, so the container operations receive it too. The others
+// receive the codec's de-serializer.
+typedef struct SerdecDeserializerOps {
+    int (*map)(SerdecDeserializer* deser, serdec_visit_map_callback* callback,
+        void* user_data);
+    int (*list)(SerdecDeserializer* deser,
+        serdec_visit_list_callback* callback, void* user_data);
+    int (*boolean)(void* deser, bool* value);
+    int (*integer)(void* deser, int* value);
+    int (*int64)(void* deser, int64_t* value);
+    int (*uint64)(void* deser, uint64_t* value);
+    int (*size)(void* deser, size_t* value);
+    int (*real)(void* deser, double* value);
+    int (*string)(void* deser, const char** value, size_t* length);
+    int (*skip)(void* deser);
+    const char* (*strerror)(void* deser);
+} SerdecDeserializerOps;
+
+struct SerdecDeserializer {
+    const SerdecDeserializerOps* ops;
+    void* codec;
+};
+
+static inline const char* serdec_deserializer_strerror(
+    SerdecDeserializer* deser)
+{
+    return deser->ops->strerror(deser->codec);
+}
+
+static inline int serdec_deserialize_map(SerdecDeserializer* deser,
+    serdec_visit_map_callback* callback, void* user_data)
+{
+    return deser->ops->map(deser, callback, user_data);
+}
+
+static inline int serdec_deserialize_list(SerdecDeserializer* deser,
+    serdec_visit_list_callback* callback, void* user_data)
+{
+    return deser->ops->list(deser, callback, user_data);
+}
+
+static inline int serdec_deserialize_bool(SerdecDeserializer* deser,
+    bool* value)
+{
+    return deser->ops->boolean(deser->codec, value);
+}
+
+static inline int serdec_deserialize_int(SerdecDeserializer* deser,
+    int* value)
+{
+    return deser->ops->integer(deser->codec, value);
+}
+
+static inline int serdec_deserialize_int64(SerdecDeserializer* deser,
+    int64_t* value)
+{
+    return deser->ops->int64(deser->codec, value);
+}
+
+static inline int serdec_deserialize_uint64(SerdecDeserializer* deser,
+    uint64_t* value)
+{
+    return deser->ops->uint64(deser->codec, value);
+}
+
+static inline int serdec_deserialize_size_t(SerdecDeserializer* deser,
+    size_t* value)
+{
+    return deser->ops->size(deser->codec, value);
+}
+
+static inline int serdec_deserialize_double(SerdecDeserializer* deser,
+    double* value)
+{
+    return deser->ops->real(deser->codec, value);
+}
+
+// The string is owned by the codec, and is only valid until the next call into
+// the de-serializer. It's not necessarily NUL-terminated. <length> may be
+// NULL.
+static inline int serdec_deserialize_string(SerdecDeserializer* deser,
+    const char** value, size_t* length)
+{
+    return deser->ops->string(deser->codec, value, length);
+}
+
+static inline int serdec_deserialize_skip(SerdecDeserializer* deser) {
+    return deser->ops->skip(deser->codec);
+}
+
+#endif // SERDEC_CODEC_H
+
+///////////////////////////////////////////////////////////////////////////////
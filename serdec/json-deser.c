@@ -0,0 +1,826 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            json-deser.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     JSON de-serializer
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <errno.h>
+#include <limits.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <serdec/allocator-ops.h>
+#include <serdec/json-error.h>
+#include <serdec/json.h>
+#include <serdec/number-ops.h>
+#include <serdec/string-ops.h>
+
+static const char* SERDEC_JSON_ERROR_STRINGS[] = {
+    [SERDEC_JSON_WRONG_TYPE]="value is not of the requested type",
+    [SERDEC_JSON_OUT_OF_RANGE]="value is out of range for the requested type",
+    [SERDEC_JSON_END_OF_INPUT]="input ends in the middle of a value",
+    [SERDEC_JSON_INVALID_SYNTAX]="input is not valid JSON",
+    [SERDEC_JSON_CALLBACK_SIGNALED_ERROR]="callback signaled an error",
+};
+
+typedef struct SerdecJsonDeserializer {
+    const char* cursor;
+    const char* end;
+    SerdecAllocator allocator;
+    int error;
+
+    // Strings with escapes are decoded into this.
+    StringBuffer scratch;
+} SerdecJsonDeserializer;
+
+///////////////////////////////////////////////////////////////////////////////
+// Private API
+////
+
+static int fail(SerdecJsonDeserializer* deser, int error) {
+    deser->error = error;
+    return error;
+}
+
+static bool is_whitespace(char character) {
+    return ' ' == character || '\n' == character || '\t' == character ||
+        '\r' == character;
+}
+
+static bool is_digit(char character) {
+    return '0' <= character && '9' >= character;
+}
+
+// Whether <character> ends a token which isn't a string.
+static bool is_delimiter(char character) {
+    return is_whitespace(character) || ',' == character ||
+        ':' == character || '[' == character || ']' == character ||
+        '{' == character || '}' == character || '"' == character;
+}
+
+static void skip_whitespace(SerdecJsonDeserializer* deser) {
+    while (deser->cursor < deser->end && is_whitespace(*deser->cursor)) {
+        deser->cursor += 1;
+    }
+}
+
+// Skip whitespace, and obtain the character which follows it, without
+// consuming it.
+static int peek(SerdecJsonDeserializer* deser, char* character) {
+    skip_whitespace(deser);
+    if (deser->cursor == deser->end) {
+        return fail(deser, SERDEC_JSON_END_OF_INPUT);
+    }
+
+    *character = *deser->cursor;
+    return 0;
+}
+
+// Consume the token <expected>, which must be the next one. A value of the
+// wrong type would begin with any other character.
+static int expect(SerdecJsonDeserializer* deser, char expected, int error) {
+    char character = 0;
+    if (peek(deser, &character)) {
+        return deser->error;
+    } else if (expected != character) {
+        return fail(deser, error);
+    }
+
+    deser->cursor += 1;
+    return 0;
+}
+
+static int hex_value(char character) {
+    if (is_digit(character)) {
+        return character - '0';
+    } else if ('a' <= character && 'f' >= character) {
+        return character - 'a' + 10;
+    } else if ('A' <= character && 'F' >= character) {
+        return character - 'A' + 10;
+    }
+    return -1;
+}
+
+// Read the four hex digits of a "\u" escape at <cursor>.
+static int read_code_unit(SerdecJsonDeserializer* deser, const char* cursor,
+    unsigned* code_unit)
+{
+    if (deser->end - cursor < 4) {
+        return fail(deser, SERDEC_JSON_END_OF_INPUT);
+    }
+
+    *code_unit = 0;
+    for (int i = 0; i < 4; ++i) {
+        int digit = hex_value(cursor[i]);
+        if (0 > digit) {
+            return fail(deser, SERDEC_JSON_INVALID_SYNTAX);
+        }
+        *code_unit = (*code_unit << 4) | (unsigned)digit;
+    }
+    return 0;
+}
+
+// Decode the "\u" escape at <*cursor> (just after the "u"), and any low
+// surrogate which follows it, into <output> as UTF-8.
+static int decode_unicode(SerdecJsonDeserializer* deser, const char** cursor,
+    StringBuffer* output)
+{
+    unsigned code_point = 0;
+    if (read_code_unit(deser, *cursor, &code_point)) {
+        return deser->error;
+    }
+    *cursor += 4;
+
+    if (0xdc00 <= code_point && 0xdfff >= code_point) {
+        return fail(deser, SERDEC_JSON_INVALID_SYNTAX);
+    } else if (0xd800 <= code_point && 0xdbff >= code_point) {
+        unsigned low = 0;
+        ptrdiff_t remaining = deser->end - *cursor;
+        if ((1 <= remaining && '\\' != (*cursor)[0]) ||
+            (2 <= remaining && 'u' != (*cursor)[1])) {
+            return fail(deser, SERDEC_JSON_INVALID_SYNTAX);
+        } else if (2 > remaining) {
+            return fail(deser, SERDEC_JSON_END_OF_INPUT);
+        } else if (read_code_unit(deser, *cursor + 2, &low)) {
+            return deser->error;
+        } else if (0xdc00 > low || 0xdfff < low) {
+            return fail(deser, SERDEC_JSON_INVALID_SYNTAX);
+        }
+        *cursor += 6;
+        code_point = 0x10000 + ((code_point - 0xd800) << 10) + (low - 0xdc00);
+    }
+
+    char encoded[4];
+    size_t length = 0;
+    if (0x80 > code_point) {
+        encoded[length++] = (char)code_point;
+    } else if (0x800 > code_point) {
+        encoded[length++] = (char)(0xc0 | (code_point >> 6));
+        encoded[length++] = (char)(0x80 | (code_point & 0x3f));
+    } else if (0x10000 > code_point) {
+        encoded[length++] = (char)(0xe0 | (code_point >> 12));
+        encoded[length++] = (char)(0x80 | ((code_point >> 6) & 0x3f));
+        encoded[length++] = (char)(0x80 | (code_point & 0x3f));
+    } else {
+        encoded[length++] = (char)(0xf0 | (code_point >> 18));
+        encoded[length++] = (char)(0x80 | ((code_point >> 12) & 0x3f));
+        encoded[length++] = (char)(0x80 | ((code_point >> 6) & 0x3f));
+        encoded[length++] = (char)(0x80 | (code_point & 0x3f));
+    }
+
+    if (string_buffer_append(output, encoded, length)) {
+        return fail(deser, SERDEC_JSON_SYSTEM_ERROR);
+    }
+    return 0;
+}
+
+// Decode the escaped string which begins at <cursor> (after its opening
+// quote) into <output>, and consume it.
+static int decode_string(SerdecJsonDeserializer* deser, const char* cursor,
+    StringBuffer* output)
+{
+    const char* run = cursor;
+    while (cursor < deser->end && '"' != *cursor) {
+        if (0x20 > (unsigned char)*cursor) {
+            return fail(deser, SERDEC_JSON_INVALID_SYNTAX);
+        } else if ('\\' != *cursor) {
+            cursor += 1;
+            continue;
+        }
+
+        if (string_buffer_append(output, run, (size_t)(cursor - run))) {
+            return fail(deser, SERDEC_JSON_SYSTEM_ERROR);
+        } else if (deser->end - cursor < 2) {
+            return fail(deser, SERDEC_JSON_END_OF_INPUT);
+        }
+
+        char escape = cursor[1];
+        cursor += 2;
+        char decoded = 0;
+        switch (escape) {
+        case '"': case '\\': case '/': decoded = escape; break;
+        case 'b': decoded = '\b'; break;
+        case 'f': decoded = '\f'; break;
+        case 'n': decoded = '\n'; break;
+        case 'r': decoded = '\r'; break;
+        case 't': decoded = '\t'; break;
+        case 'u':
+            if (decode_unicode(deser, &cursor, output)) {
+                return deser->error;
+            }
+            run = cursor;
+            continue;
+        default:
+            return fail(deser, SERDEC_JSON_INVALID_SYNTAX);
+        }
+
+        if (string_buffer_append(output, &decoded, 1)) {
+            return fail(deser, SERDEC_JSON_SYSTEM_ERROR);
+        }
+        run = cursor;
+    }
+
+    if (cursor == deser->end) {
+        return fail(deser, SERDEC_JSON_END_OF_INPUT);
+    } else if (string_buffer_append(output, run, (size_t)(cursor - run))) {
+        return fail(deser, SERDEC_JSON_SYSTEM_ERROR);
+    }
+
+    deser->cursor = cursor + 1;
+    return 0;
+}
+
+// Read the string at the cursor, which must have been peeked. If it contains
+// no escapes, <value> points into the input. Otherwise, it's decoded into
+// <output>, which is cleared first.
+static int read_string(SerdecJsonDeserializer* deser, StringBuffer* output,
+    const char** value, size_t* length)
+{
+    const char* start = deser->cursor + 1;
+    const char* cursor = start;
+    while (cursor < deser->end && '"' != *cursor && '\\' != *cursor &&
+        0x20 <= (unsigned char)*cursor) {
+        cursor += 1;
+    }
+
+    if (cursor == deser->end) {
+        return fail(deser, SERDEC_JSON_END_OF_INPUT);
+    } else if ('"' == *cursor) {
+        *value = start;
+        *length = (size_t)(cursor - start);
+        deser->cursor = cursor + 1;
+        return 0;
+    }
+
+    string_buffer_clear(output);
+    if (decode_string(deser, start, output)) {
+        return deser->error;
+    }
+
+    // Every escape produces at least one byte, so the string is allocated.
+    *value = output->string;
+    *length = output->length;
+    return 0;
+}
+
+// Measure the number at the cursor, which must follow the JSON grammar, and
+// report whether it's an integer (i.e. it has no fraction or exponent).
+static int scan_number(SerdecJsonDeserializer* deser, size_t* length,
+    bool* integral)
+{
+    char character = 0;
+    if (peek(deser, &character)) {
+        return deser->error;
+    } else if ('-' != character && !is_digit(character)) {
+        return fail(deser, SERDEC_JSON_WRONG_TYPE);
+    }
+
+    const char* cursor = deser->cursor;
+    const char* end = deser->end;
+    if ('-' == *cursor) {
+        cursor += 1;
+    }
+
+    // Leading zeros are not permitted.
+    if (cursor < end && '0' == *cursor) {
+        cursor += 1;
+    } else if (cursor < end && is_digit(*cursor)) {
+        while (cursor < end && is_digit(*cursor)) {
+            cursor += 1;
+        }
+    } else {
+        return fail(deser, SERDEC_JSON_INVALID_SYNTAX);
+    }
+
+    *integral = true;
+    if (cursor < end && '.' == *cursor) {
+        *integral = false;
+        cursor += 1;
+        if (cursor == end || !is_digit(*cursor)) {
+            return fail(deser, SERDEC_JSON_INVALID_SYNTAX);
+        }
+        while (cursor < end && is_digit(*cursor)) {
+            cursor += 1;
+        }
+    }
+
+    if (cursor < end && ('e' == *cursor || 'E' == *cursor)) {
+        *integral = false;
+        cursor += 1;
+        if (cursor < end && ('+' == *cursor || '-' == *cursor)) {
+            cursor += 1;
+        }
+        if (cursor == end || !is_digit(*cursor)) {
+            return fail(deser, SERDEC_JSON_INVALID_SYNTAX);
+        }
+        while (cursor < end && is_digit(*cursor)) {
+            cursor += 1;
+        }
+    }
+
+    // The number must end at a delimiter, so e.g. "01" and "1x" are invalid.
+    if (cursor < end && !is_delimiter(*cursor)) {
+        return fail(deser, SERDEC_JSON_INVALID_SYNTAX);
+    }
+
+    *length = (size_t)(cursor - deser->cursor);
+    return 0;
+}
+
+static int number_status(SerdecJsonDeserializer* deser,
+    NumberParseResult result)
+{
+    switch (result) {
+    case NUMBER_OK: return 0;
+    case NUMBER_OUT_OF_RANGE: return fail(deser, SERDEC_JSON_OUT_OF_RANGE);
+    default:
+        return fail(deser, SERDEC_JSON_INVALID_SYNTAX);
+    }
+}
+
+// Scan the integer at the cursor. Numbers with a fraction or an exponent are
+// of the wrong type, even if their value is integral.
+static int scan_integer(SerdecJsonDeserializer* deser, size_t* length) {
+    bool integral = false;
+    if (scan_number(deser, length, &integral)) {
+        return deser->error;
+    } else if (!integral) {
+        return fail(deser, SERDEC_JSON_WRONG_TYPE);
+    }
+    return 0;
+}
+
+// Consume the literal <word> (e.g. "true"), which must be followed by a
+// delimiter or the end of the input.
+static bool consume_literal(SerdecJsonDeserializer* deser, const char* word,
+    size_t length)
+{
+    if ((size_t)(deser->end - deser->cursor) < length ||
+        0 != memcmp(deser->cursor, word, length) ||
+        ((size_t)(deser->end - deser->cursor) > length &&
+         !is_delimiter(deser->cursor[length]))) {
+        return false;
+    }
+
+    deser->cursor += length;
+    return true;
+}
+
+// After an entry of a container, consume the "," which separates it from the
+// next one, or the <close> bracket of the container. Report whether there's
+// another entry.
+static int next_entry(SerdecJsonDeserializer* deser, char close, bool* more)
+{
+    char character = 0;
+    if (peek(deser, &character)) {
+        return deser->error;
+    } else if (',' != character && close != character) {
+        return fail(deser, SERDEC_JSON_INVALID_SYNTAX);
+    }
+
+    deser->cursor += 1;
+    *more = ',' == character;
+    return 0;
+}
+
+// Skip the string at the cursor, without decoding it.
+static int skip_string(SerdecJsonDeserializer* deser) {
+    const char* cursor = deser->cursor + 1;
+    while (cursor < deser->end && '"' != *cursor) {
+        cursor += '\\' == *cursor ? 2 : 1;
+    }
+
+    if (cursor >= deser->end) {
+        return fail(deser, SERDEC_JSON_END_OF_INPUT);
+    }
+    deser->cursor = cursor + 1;
+    return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Error Handling
+////
+
+const char* serdec_json_deserializer_strerror(SerdecJsonDeserializer* deser) {
+    if (0 > deser->error || SERDEC_JSON_MAX_ERROR <= deser->error) {
+        return NULL;
+    }
+
+    switch (deser->error) {
+    case SERDEC_JSON_SYSTEM_ERROR: return strerror(errno);
+    default:
+        return SERDEC_JSON_ERROR_STRINGS[deser->error];
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// De-serializer Initialization
+////
+
+SerdecJsonDeserializer* serdec_json_deserializer_new(const char* string,
+    size_t length)
+{
+    return serdec_json_deserializer_new_with_allocator(string, length, NULL);
+}
+
+SerdecJsonDeserializer* serdec_json_deserializer_new_with_allocator(
+    const char* string, size_t length, const SerdecAllocator* allocator)
+{
+    allocator = allocator_or_default(allocator);
+    SerdecJsonDeserializer* deser = allocator_calloc(allocator, 1,
+        sizeof(SerdecJsonDeserializer));
+    if (NULL == deser) {
+        return NULL;
+    }
+
+    deser->allocator = *allocator;
+    string_buffer_init(&deser->scratch, &deser->allocator);
+    serdec_json_deserializer_reset(deser, string, length);
+    return deser;
+}
+
+void serdec_json_deserializer_reset(SerdecJsonDeserializer* deser,
+    const char* string, size_t length)
+{
+    deser->cursor = string;
+    deser->end = string + length;
+    deser->error = 0;
+}
+
+bool serdec_json_deserializer_at_end(SerdecJsonDeserializer* deser) {
+    skip_whitespace(deser);
+    return deser->cursor == deser->end;
+}
+
+void serdec_json_deserializer_free(SerdecJsonDeserializer* deser) {
+    string_buffer_release(&deser->scratch);
+    SerdecAllocator allocator = deser->allocator;
+    allocator_free(&allocator, deser);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// De-serialization Routines
+////
+
+// Keys with escapes are decoded into a buffer of their own, since the
+// callback may decode values (and the keys of nested objects) before it's
+// done with the key.
+int serdec_json_deserialize_map(SerdecJsonDeserializer* deser,
+    json_visit_map_callback* callback, void* user_data)
+{
+    char character = 0;
+    if (expect(deser, '{', SERDEC_JSON_WRONG_TYPE) ||
+        peek(deser, &character)) {
+        return deser->error;
+    } else if ('}' == character) {
+        deser->cursor += 1;
+        return 0;
+    }
+
+    bool more = true;
+    while (more) {
+        if (peek(deser, &character)) {
+            return deser->error;
+        } else if ('"' != character) {
+            return fail(deser, SERDEC_JSON_INVALID_SYNTAX);
+        }
+
+        StringBuffer decoded;
+        string_buffer_init(&decoded, &deser->allocator);
+        const char* key = NULL;
+        size_t length = 0;
+        bool failed = read_string(deser, &decoded, &key, &length) ||
+            expect(deser, ':', SERDEC_JSON_INVALID_SYNTAX);
+        if (!failed && callback(deser, user_data, key, length)) {
+            failed = fail(deser, SERDEC_JSON_CALLBACK_SIGNALED_ERROR);
+        }
+
+        string_buffer_release(&decoded);
+        if (failed || next_entry(deser, '}', &more)) {
+            return deser->error;
+        }
+    }
+    return 0;
+}
+
+int serdec_json_deserialize_list(SerdecJsonDeserializer* deser,
+    json_visit_list_callback* callback, void* user_data)
+{
+    char character = 0;
+    if (expect(deser, '[', SERDEC_JSON_WRONG_TYPE) ||
+        peek(deser, &character)) {
+        return deser->error;
+    } else if (']' == character) {
+        deser->cursor += 1;
+        return 0;
+    }
+
+    bool more = true;
+    for (size_t index = 0; more; ++index) {
+        if (callback(deser, user_data, index)) {
+            return fail(deser, SERDEC_JSON_CALLBACK_SIGNALED_ERROR);
+        } else if (next_entry(deser, ']', &more)) {
+            return deser->error;
+        }
+    }
+    return 0;
+}
+
+int serdec_json_deserialize_bool(SerdecJsonDeserializer* deser, bool* value)
+{
+    char character = 0;
+    if (peek(deser, &character)) {
+        return deser->error;
+    } else if (consume_literal(deser, "true", 4)) {
+        *value = true;
+        return 0;
+    } else if (consume_literal(deser, "false", 5)) {
+        *value = false;
+        return 0;
+    }
+    return fail(deser, SERDEC_JSON_WRONG_TYPE);
+}
+
+int serdec_json_deserialize_int(SerdecJsonDeserializer* deser, int* value) {
+    int64_t result = 0;
+    if (serdec_json_deserialize_int64(deser, &result)) {
+        return deser->error;
+    } else if (INT_MIN > result || INT_MAX < result) {
+        return fail(deser, SERDEC_JSON_OUT_OF_RANGE);
+    }
+
+    *value = (int)result;
+    return 0;
+}
+
+int serdec_json_deserialize_int64(SerdecJsonDeserializer* deser,
+    int64_t* value)
+{
+    size_t length = 0;
+    if (scan_integer(deser, &length) ||
+        number_status(deser, parse_int64(deser->cursor, length, value))) {
+        return deser->error;
+    }
+
+    deser->cursor += length;
+    return 0;
+}
+
+int serdec_json_deserialize_uint64(SerdecJsonDeserializer* deser,
+    uint64_t* value)
+{
+    size_t length = 0;
+    if (scan_integer(deser, &length)) {
+        return deser->error;
+    } else if ('-' == *deser->cursor) {
+        return fail(deser, SERDEC_JSON_OUT_OF_RANGE);
+    } else if (number_status(deser,
+            parse_uint64(deser->cursor, length, value))) {
+        return deser->error;
+    }
+
+    deser->cursor += length;
+    return 0;
+}
+
+int serdec_json_deserialize_size_t(SerdecJsonDeserializer* deser,
+    size_t* value)
+{
+    uint64_t result = 0;
+    if (serdec_json_deserialize_uint64(deser, &result)) {
+        return deser->error;
+    } else if (SIZE_MAX < result) {
+        return fail(deser, SERDEC_JSON_OUT_OF_RANGE);
+    }
+
+    *value = (size_t)result;
+    return 0;
+}
+
+int serdec_json_deserialize_double(SerdecJsonDeserializer* deser,
+    double* value)
+{
+    size_t length = 0;
+    bool integral = false;
+    if (scan_number(deser, &length, &integral) ||
+        number_status(deser, parse_double(deser->cursor, length, value))) {
+        return deser->error;
+    }
+
+    deser->cursor += length;
+    return 0;
+}
+
+int serdec_json_deserialize_string(SerdecJsonDeserializer* deser,
+    const char** value, size_t* length)
+{
+    char character = 0;
+    if (peek(deser, &character)) {
+        return deser->error;
+    } else if ('"' != character) {
+        return fail(deser, SERDEC_JSON_WRONG_TYPE);
+    }
+
+    size_t string_length = 0;
+    if (read_string(deser, &deser->scratch, value, &string_length)) {
+        return deser->error;
+    }
+
+    if (NULL != length) {
+        *length = string_length;
+    }
+    return 0;
+}
+
+int serdec_json_deserialize_string_arena(SerdecJsonDeserializer* deser,
+    SerdecArena* arena, const char** value, size_t* length)
+{
+    const char* view = NULL;
+    size_t view_length = 0;
+    if (serdec_json_deserialize_string(deser, &view, &view_length)) {
+        return deser->error;
+    }
+
+    char* copy = serdec_arena_strndup(arena, view, view_length);
+    if (NULL == copy) {
+        errno = ENOMEM;
+        return fail(deser, SERDEC_JSON_SYSTEM_ERROR);
+    }
+
+    *value = copy;
+    if (NULL != length) {
+        *length = view_length;
+    }
+    return 0;
+}
+
+// Values are skipped one token at a time, counting the containers which remain
+// open, so that nesting doesn't cost stack.
+int serdec_json_deserialize_skip(SerdecJsonDeserializer* deser) {
+    size_t depth = 0;
+    do {
+        char character = 0;
+        if (peek(deser, &character)) {
+            return deser->error;
+        }
+
+        switch (character) {
+        case '"':
+            if (skip_string(deser)) {
+                return deser->error;
+            }
+            break;
+        case '{': case '[':
+            deser->cursor += 1;
+            depth += 1;
+            break;
+        case '}': case ']':
+            if (0 == depth) {
+                return fail(deser, SERDEC_JSON_INVALID_SYNTAX);
+            }
+            deser->cursor += 1;
+            depth -= 1;
+            break;
+        case ',': case ':':
+            if (0 == depth) {
+                return fail(deser, SERDEC_JSON_INVALID_SYNTAX);
+            }
+            deser->cursor += 1;
+            break;
+        default:
+            while (deser->cursor < deser->end &&
+                !is_delimiter(*deser->cursor)) {
+                deser->cursor += 1;
+            }
+            break;
+        }
+    } while (0 < depth);
+    return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Generic Interface
+////
+
+// The visitors of the generic interface are invoked from the codec's, which
+// receive the generic de-serializer and visitor through this.
+typedef struct GenericVisit {
+    SerdecDeserializer* deser;
+    serdec_visit_map_callback* map;
+    serdec_visit_list_callback* list;
+    void* user_data;
+} GenericVisit;
+
+static int visit_generic_map(SerdecJsonDeserializer* deser,
+    void* user_data, const char* key, size_t length)
+{
+    (void)deser;
+    GenericVisit* visit = user_data;
+    return visit->map(visit->deser, visit->user_data, key, length);
+}
+
+static int visit_generic_list(SerdecJsonDeserializer* deser,
+    void* user_data, size_t index)
+{
+    (void)deser;
+    GenericVisit* visit = user_data;
+    return visit->list(visit->deser, visit->user_data, index);
+}
+
+static int generic_map(SerdecDeserializer* deser,
+    serdec_visit_map_callback* callback, void* user_data)
+{
+    GenericVisit visit = {
+        .deser=deser, .map=callback, .user_data=user_data,
+    };
+    return serdec_json_deserialize_map(deser->codec, visit_generic_map,
+        &visit);
+}
+
+static int generic_list(SerdecDeserializer* deser,
+    serdec_visit_list_callback* callback, void* user_data)
+{
+    GenericVisit visit = {
+        .deser=deser, .list=callback, .user_data=user_data,
+    };
+    return serdec_json_deserialize_list(deser->codec, visit_generic_list,
+        &visit);
+}
+
+static int generic_bool(void* deser, bool* value) {
+    return serdec_json_deserialize_bool(deser, value);
+}
+
+static int generic_int(void* deser, int* value) {
+    return serdec_json_deserialize_int(deser, value);
+}
+
+static int generic_int64(void* deser, int64_t* value) {
+    return serdec_json_deserialize_int64(deser, value);
+}
+
+static int generic_uint64(void* deser, uint64_t* value) {
+    return serdec_json_deserialize_uint64(deser, value);
+}
+
+static int generic_size_t(void* deser, size_t* value) {
+    return serdec_json_deserialize_size_t(deser, value);
+}
+
+static int generic_double(void* deser, double* value) {
+    return serdec_json_deserialize_double(deser, value);
+}
+
+static int generic_string(void* deser, const char** value, size_t* length) {
+    return serdec_json_deserialize_string(deser, value, length);
+}
+
+static int generic_skip(void* deser) {
+    return serdec_json_deserialize_skip(deser);
+}
+
+static const char* generic_strerror(void* deser) {
+    return serdec_json_deserializer_strerror(deser);
+}
+
+const SerdecDeserializerOps SERDEC_JSON_DESERIALIZER_OPS = {
+    .map=generic_map,
+    .list=generic_list,
+    .boolean=generic_bool,
+    .integer=generic_int,
+    .int64=generic_int64,
+    .uint64=generic_uint64,
+    .size=generic_size_t,
+    .real=generic_double,
+    .string=generic_string,
+    .skip=generic_skip,
+    .strerror=generic_strerror,
+};
+
+///////////////////////////////////////////////////////////////////////////////
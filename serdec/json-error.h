@@ -0,0 +1,52 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            json-error.h
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Error codes for the JSON codec
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#ifndef SERDEC_JSON_ERROR_H
+#define SERDEC_JSON_ERROR_H
+
+enum {
+    SERDEC_JSON_NO_ERROR,
+    SERDEC_JSON_SYSTEM_ERROR,
+    SERDEC_JSON_UNEXPECTED_EVENT,
+    SERDEC_JSON_WRONG_TYPE,
+    SERDEC_JSON_OUT_OF_RANGE,
+    SERDEC_JSON_END_OF_INPUT,
+    SERDEC_JSON_INVALID_SYNTAX,
+    SERDEC_JSON_CALLBACK_SIGNALED_ERROR,
+
+    // Keep this last, so that the strerror routines cover every error.
+    SERDEC_JSON_MAX_ERROR,
+};
+
+#endif // SERDEC_JSON_ERROR_H
+
+///////////////////////////////////////////////////////////////////////////////
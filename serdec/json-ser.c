@@ -0,0 +1,459 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            json-ser.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     JSON serializer
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <errno.h>
+#include <math.h>
+#include <string.h>
+
+#include <serdec/allocator-ops.h>
+#include <serdec/json-error.h>
+#include <serdec/json.h>
+#include <serdec/number-ops.h>
+#include <serdec/string-ops.h>
+
+static const char* SERDEC_JSON_ERROR_STRINGS[] = {
+    [SERDEC_JSON_UNEXPECTED_EVENT]="operation is not valid at this point in "
+    "the output",
+    [SERDEC_JSON_OUT_OF_RANGE]="value can't be represented in JSON",
+};
+
+static const size_t JSON_INITIAL_DEPTH = 16;
+
+typedef struct JsonFrame {
+    bool map;
+    bool expect_value;
+    size_t count;
+} JsonFrame;
+
+typedef struct SerdecJsonSerializer {
+    StringBuffer output;
+    SerdecAllocator allocator;
+    int error;
+    bool started;
+
+    // The number of top-level values written so far.
+    size_t values;
+
+    JsonFrame* frames;
+    size_t depth;
+    size_t capacity;
+} SerdecJsonSerializer;
+
+///////////////////////////////////////////////////////////////////////////////
+// Private API
+////
+
+static int fail(SerdecJsonSerializer* ser, int error) {
+    ser->error = error;
+    return error;
+}
+
+static int put(SerdecJsonSerializer* ser, const char* data, size_t length) {
+    if (string_buffer_append(&ser->output, data, length)) {
+        return fail(ser, SERDEC_JSON_SYSTEM_ERROR);
+    }
+    return 0;
+}
+
+// Check that a value may begin here, and write the separator which precedes
+// it, if any.
+static int begin_value(SerdecJsonSerializer* ser) {
+    if (!ser->started) {
+        return fail(ser, SERDEC_JSON_UNEXPECTED_EVENT);
+    } else if (0 == ser->depth) {
+        return 0 < ser->values++ ? put(ser, "\n", 1) : 0;
+    }
+
+    JsonFrame* frame = &ser->frames[ser->depth - 1];
+    if (frame->map) {
+        if (!frame->expect_value) {
+            return fail(ser, SERDEC_JSON_UNEXPECTED_EVENT);
+        }
+        frame->expect_value = false;
+        return 0;
+    }
+    return 0 < frame->count++ ? put(ser, ",", 1) : 0;
+}
+
+static int begin_container(SerdecJsonSerializer* ser, bool map) {
+    if (begin_value(ser)) {
+        return ser->error;
+    }
+
+    if (ser->depth == ser->capacity) {
+        size_t capacity = 2 * ser->capacity;
+        if (0 == capacity) {
+            capacity = JSON_INITIAL_DEPTH;
+        }
+
+        JsonFrame* frames = allocator_realloc(&ser->allocator, ser->frames,
+            capacity * sizeof(JsonFrame));
+        if (NULL == frames) {
+            return fail(ser, SERDEC_JSON_SYSTEM_ERROR);
+        }
+        ser->frames = frames;
+        ser->capacity = capacity;
+    }
+
+    JsonFrame* frame = &ser->frames[ser->depth++];
+    frame->map = map;
+    frame->expect_value = false;
+    frame->count = 0;
+    return put(ser, map ? "{" : "[", 1);
+}
+
+static int end_container(SerdecJsonSerializer* ser, bool map) {
+    JsonFrame* frame = 0 < ser->depth ? &ser->frames[ser->depth - 1] : NULL;
+    if (NULL == frame || map != frame->map || frame->expect_value) {
+        return fail(ser, SERDEC_JSON_UNEXPECTED_EVENT);
+    }
+
+    ser->depth -= 1;
+    return put(ser, map ? "}" : "]", 1);
+}
+
+// Write <value> as a quoted string. Runs of characters which need no escape
+// are copied at once.
+static int put_string(SerdecJsonSerializer* ser, const char* value,
+    size_t length)
+{
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+    if (string_buffer_reserve(&ser->output, length + 2)) {
+        return fail(ser, SERDEC_JSON_SYSTEM_ERROR);
+    } else if (put(ser, "\"", 1)) {
+        return ser->error;
+    }
+
+    const char* run = value;
+    const char* end = value + length;
+    for (const char* cursor = value; cursor < end; ++cursor) {
+        unsigned char character = (unsigned char)*cursor;
+        if (0x20 <= character && '"' != character && '\\' != character) {
+            continue;
+        }
+
+        char escape[6] = {'\\', (char)character};
+        size_t escape_length = 2;
+        switch (character) {
+        case '"': case '\\': break;
+        case '\b': escape[1] = 'b'; break;
+        case '\f': escape[1] = 'f'; break;
+        case '\n': escape[1] = 'n'; break;
+        case '\r': escape[1] = 'r'; break;
+        case '\t': escape[1] = 't'; break;
+        default:
+            memcpy(escape + 1, "u00", 3);
+            escape[4] = HEX_DIGITS[character >> 4];
+            escape[5] = HEX_DIGITS[character & 0x0f];
+            escape_length = 6;
+            break;
+        }
+
+        if (put(ser, run, (size_t)(cursor - run)) ||
+            put(ser, escape, escape_length)) {
+            return ser->error;
+        }
+        run = cursor + 1;
+    }
+
+    if (put(ser, run, (size_t)(end - run))) {
+        return ser->error;
+    }
+    return put(ser, "\"", 1);
+}
+
+static int put_scalar(SerdecJsonSerializer* ser, const char* number,
+    size_t length)
+{
+    if (begin_value(ser)) {
+        return ser->error;
+    }
+    return put(ser, number, length);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Error Handling
+////
+
+const char* serdec_json_serializer_strerror(SerdecJsonSerializer* ser) {
+    if (0 > ser->error || SERDEC_JSON_MAX_ERROR <= ser->error) {
+        return NULL;
+    }
+
+    switch (ser->error) {
+    case SERDEC_JSON_SYSTEM_ERROR: return strerror(errno);
+    default:
+        return SERDEC_JSON_ERROR_STRINGS[ser->error];
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Serializer Initialization
+////
+
+SerdecJsonSerializer* serdec_json_serializer_new(void) {
+    return serdec_json_serializer_new_with_allocator(NULL);
+}
+
+SerdecJsonSerializer* serdec_json_serializer_new_with_allocator(
+    const SerdecAllocator* allocator)
+{
+    allocator = allocator_or_default(allocator);
+    SerdecJsonSerializer* ser = allocator_calloc(allocator, 1,
+        sizeof(SerdecJsonSerializer));
+    if (NULL == ser) {
+        return NULL;
+    }
+
+    ser->allocator = *allocator;
+    string_buffer_init(&ser->output, &ser->allocator);
+    return ser;
+}
+
+const char* serdec_json_serializer_borrow_string(SerdecJsonSerializer* ser,
+    size_t* length)
+{
+    if (NULL != length) {
+        *length = ser->output.length;
+    }
+    return NULL != ser->output.string ? ser->output.string : "";
+}
+
+char* serdec_json_serializer_take_string(SerdecJsonSerializer* ser,
+    size_t* length)
+{
+    char* string = string_buffer_take(&ser->output, length);
+    if (NULL == string) {
+        ser->error = SERDEC_JSON_SYSTEM_ERROR;
+    }
+    return string;
+}
+
+void serdec_json_serializer_reset(SerdecJsonSerializer* ser) {
+    string_buffer_clear(&ser->output);
+    ser->error = 0;
+    ser->started = false;
+    ser->values = 0;
+    ser->depth = 0;
+}
+
+void serdec_json_serializer_free(SerdecJsonSerializer* ser) {
+    string_buffer_release(&ser->output);
+    allocator_free(&ser->allocator, ser->frames);
+    SerdecAllocator allocator = ser->allocator;
+    allocator_free(&allocator, ser);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Serializer Routines
+////
+
+int serdec_json_serialize_start(SerdecJsonSerializer* ser) {
+    ser->started = true;
+    return 0;
+}
+
+int serdec_json_serialize_end(SerdecJsonSerializer* ser) {
+    if (!ser->started || 0 != ser->depth) {
+        return fail(ser, SERDEC_JSON_UNEXPECTED_EVENT);
+    }
+    return 0;
+}
+
+int serdec_json_serialize_map_start(SerdecJsonSerializer* ser) {
+    return begin_container(ser, true);
+}
+
+int serdec_json_serialize_map_end(SerdecJsonSerializer* ser) {
+    return end_container(ser, true);
+}
+
+int serdec_json_serialize_map_key(SerdecJsonSerializer* ser, const char* key)
+{
+    return serdec_json_serialize_map_key_n(ser, key, strlen(key));
+}
+
+int serdec_json_serialize_map_key_n(SerdecJsonSerializer* ser,
+    const char* key, size_t length)
+{
+    JsonFrame* frame = 0 < ser->depth ? &ser->frames[ser->depth - 1] : NULL;
+    if (NULL == frame || !frame->map || frame->expect_value) {
+        return fail(ser, SERDEC_JSON_UNEXPECTED_EVENT);
+    }
+
+    frame->expect_value = true;
+    if ((0 < frame->count++ && put(ser, ",", 1)) ||
+        put_string(ser, key, length)) {
+        return ser->error;
+    }
+    return put(ser, ":", 1);
+}
+
+int serdec_json_serialize_list_start(SerdecJsonSerializer* ser) {
+    return begin_container(ser, false);
+}
+
+int serdec_json_serialize_list_end(SerdecJsonSerializer* ser) {
+    return end_container(ser, false);
+}
+
+int serdec_json_serialize_bool(SerdecJsonSerializer* ser, bool value) {
+    return value ? put_scalar(ser, "true", 4) : put_scalar(ser, "false", 5);
+}
+
+int serdec_json_serialize_int(SerdecJsonSerializer* ser, int value) {
+    return serdec_json_serialize_int64(ser, value);
+}
+
+int serdec_json_serialize_int64(SerdecJsonSerializer* ser, int64_t value) {
+    char buffer[NUMBER_BUFFER_SIZE];
+    return put_scalar(ser, buffer, format_int64(buffer, value));
+}
+
+int serdec_json_serialize_uint64(SerdecJsonSerializer* ser, uint64_t value)
+{
+    char buffer[NUMBER_BUFFER_SIZE];
+    return put_scalar(ser, buffer, format_uint64(buffer, value));
+}
+
+int serdec_json_serialize_size_t(SerdecJsonSerializer* ser, size_t value) {
+    return serdec_json_serialize_uint64(ser, value);
+}
+
+// The YAML formatting of finite values (e.g. "3.0", "1.0e+30") is valid JSON.
+int serdec_json_serialize_double(SerdecJsonSerializer* ser, double value) {
+    if (!isfinite(value)) {
+        return fail(ser, SERDEC_JSON_OUT_OF_RANGE);
+    }
+
+    char buffer[NUMBER_BUFFER_SIZE];
+    return put_scalar(ser, buffer, format_double(buffer, value));
+}
+
+int serdec_json_serialize_string(SerdecJsonSerializer* ser,
+    const char* value)
+{
+    return serdec_json_serialize_string_n(ser, value, strlen(value));
+}
+
+int serdec_json_serialize_string_n(SerdecJsonSerializer* ser,
+    const char* value, size_t length)
+{
+    if (begin_value(ser)) {
+        return ser->error;
+    }
+    return put_string(ser, value, length);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Generic Interface
+////
+
+static int generic_start(void* ser) {
+    return serdec_json_serialize_start(ser);
+}
+
+static int generic_end(void* ser) {
+    return serdec_json_serialize_end(ser);
+}
+
+static int generic_map_start(void* ser) {
+    return serdec_json_serialize_map_start(ser);
+}
+
+static int generic_map_end(void* ser) {
+    return serdec_json_serialize_map_end(ser);
+}
+
+static int generic_map_key_n(void* ser, const char* key, size_t length) {
+    return serdec_json_serialize_map_key_n(ser, key, length);
+}
+
+static int generic_list_start(void* ser) {
+    return serdec_json_serialize_list_start(ser);
+}
+
+static int generic_list_end(void* ser) {
+    return serdec_json_serialize_list_end(ser);
+}
+
+static int generic_bool(void* ser, bool value) {
+    return serdec_json_serialize_bool(ser, value);
+}
+
+static int generic_int(void* ser, int value) {
+    return serdec_json_serialize_int(ser, value);
+}
+
+static int generic_int64(void* ser, int64_t value) {
+    return serdec_json_serialize_int64(ser, value);
+}
+
+static int generic_uint64(void* ser, uint64_t value) {
+    return serdec_json_serialize_uint64(ser, value);
+}
+
+static int generic_size_t(void* ser, size_t value) {
+    return serdec_json_serialize_size_t(ser, value);
+}
+
+static int generic_double(void* ser, double value) {
+    return serdec_json_serialize_double(ser, value);
+}
+
+static int generic_string_n(void* ser, const char* value, size_t length) {
+    return serdec_json_serialize_string_n(ser, value, length);
+}
+
+static const char* generic_strerror(void* ser) {
+    return serdec_json_serializer_strerror(ser);
+}
+
+const SerdecSerializerOps SERDEC_JSON_SERIALIZER_OPS = {
+    .start=generic_start,
+    .end=generic_end,
+    .map_start=generic_map_start,
+    .map_end=generic_map_end,
+    .map_key=generic_map_key_n,
+    .list_start=generic_list_start,
+    .list_end=generic_list_end,
+    .boolean=generic_bool,
+    .integer=generic_int,
+    .int64=generic_int64,
+    .uint64=generic_uint64,
+    .size=generic_size_t,
+    .real=generic_double,
+    .string=generic_string_n,
+    .strerror=generic_strerror,
+};
+
+///////////////////////////////////////////////////////////////////////////////
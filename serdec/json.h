@@ -0,0 +1,229 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            json.h
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     JSON serialization/deserialization
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#ifndef SERDEC_JSON_H
+#define SERDEC_JSON_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <serdec/allocator.h>
+#include <serdec/arena.h>
+#include <serdec/codec.h>
+
+// The JSON codec has the same shape as the others. Its output is compact: no
+// whitespace is written between tokens, and strings are escaped only where
+// JSON requires it. The de-serializer reads in place, so strings without
+// escapes are views into the input.
+typedef struct SerdecJsonDeserializer SerdecJsonDeserializer;
+typedef struct SerdecJsonSerializer SerdecJsonSerializer;
+
+///////////////////////////////////////////////////////////////////////////////
+// Error Handling
+////
+
+// Obtain error strings from the de/serializers.
+const char* serdec_json_deserializer_strerror(SerdecJsonDeserializer* deser);
+const char* serdec_json_serializer_strerror(SerdecJsonSerializer* ser);
+
+///////////////////////////////////////////////////////////////////////////////
+// De-serializer Initialization
+////
+
+// Initialize a de-serializer which reads the JSON text in <string>. The input
+// is not copied: it must outlive the de-serializer, and the strings which are
+// read from it.
+SerdecJsonDeserializer* serdec_json_deserializer_new(const char* string,
+    size_t length);
+SerdecJsonDeserializer* serdec_json_deserializer_new_with_allocator(
+    const char* string, size_t length, const SerdecAllocator* allocator);
+
+// Re-use the de-serializer for new input.
+void serdec_json_deserializer_reset(SerdecJsonDeserializer* deser,
+    const char* string, size_t length);
+
+// Whether every value in the input has been read, apart from trailing
+// whitespace. The input may hold several values one after another, e.g. one
+// per line.
+bool serdec_json_deserializer_at_end(SerdecJsonDeserializer* deser);
+
+// Free a de-serializer.
+void serdec_json_deserializer_free(SerdecJsonDeserializer* deser);
+
+///////////////////////////////////////////////////////////////////////////////
+// De-serialization Routines
+////
+
+// This callback is to "visit" (i.e. handle) entries of an object. It must
+// de-serialize (or skip) exactly one value: the value of the entry. <key> is
+// not NUL-terminated. It's a view into the input, unless it contains escapes,
+// in which case it's decoded into memory which is released once the callback
+// returns. Return non-zero to stop de-serialization.
+typedef int json_visit_map_callback(SerdecJsonDeserializer* deser,
+    void* user_data, const char* key, size_t length);
+
+// De-serialize an object from the input. Return non-zero if parsing
+// encountered an error, for any reason.
+int serdec_json_deserialize_map(SerdecJsonDeserializer* deser,
+    json_visit_map_callback* callback, void* user_data);
+
+// Like the map callback, for each element of an array.
+typedef int json_visit_list_callback(SerdecJsonDeserializer* deser,
+    void* user_data, size_t index);
+
+int serdec_json_deserialize_list(SerdecJsonDeserializer* deser,
+    json_visit_list_callback* callback, void* user_data);
+
+// De-serialize scalars from the input. Return SERDEC_JSON_WRONG_TYPE if the
+// next value is of a different type (including a number with a fraction or an
+// exponent, for the integer routines), or SERDEC_JSON_OUT_OF_RANGE if it does
+// not fit. A value of the wrong type is not consumed.
+int serdec_json_deserialize_bool(SerdecJsonDeserializer* deser, bool* value);
+int serdec_json_deserialize_int(SerdecJsonDeserializer* deser, int* value);
+int serdec_json_deserialize_int64(SerdecJsonDeserializer* deser,
+    int64_t* value);
+int serdec_json_deserialize_uint64(SerdecJsonDeserializer* deser,
+    uint64_t* value);
+int serdec_json_deserialize_size_t(SerdecJsonDeserializer* deser,
+    size_t* value);
+int serdec_json_deserialize_double(SerdecJsonDeserializer* deser,
+    double* value);
+
+// De-serialize a string value. <value> is not NUL-terminated. It points into
+// the input, unless the string contains escapes, in which case it's decoded
+// into a buffer owned by the de-serializer, which is only valid until the
+// next call into it. <length> may be NULL.
+int serdec_json_deserialize_string(SerdecJsonDeserializer* deser,
+    const char** value, size_t* length);
+
+// Like _string(), but the string is copied into <arena>, and NUL-terminated.
+int serdec_json_deserialize_string_arena(SerdecJsonDeserializer* deser,
+    SerdecArena* arena, const char** value, size_t* length);
+
+// Skip the next value, including everything nested in it (e.g. a null, which
+// none of the other routines accept). Skipping only checks that brackets
+// balance and strings are terminated, so a malformed subtree may go
+// unnoticed.
+int serdec_json_deserialize_skip(SerdecJsonDeserializer* deser);
+
+///////////////////////////////////////////////////////////////////////////////
+// Serializer Initialization
+////
+
+// Initialize a serializer which generates a string, which grows as needed.
+SerdecJsonSerializer* serdec_json_serializer_new(void);
+SerdecJsonSerializer* serdec_json_serializer_new_with_allocator(
+    const SerdecAllocator* allocator);
+
+// Obtain the output of the serializer, which is NUL-terminated. The string
+// from _borrow_string() is owned by the serializer. The one from
+// _take_string() is owned by the caller, and must be released with the
+// serializer's allocator. The serializer starts over with an empty string
+// afterwards. <length> may be NULL.
+const char* serdec_json_serializer_borrow_string(SerdecJsonSerializer* ser,
+    size_t* length);
+char* serdec_json_serializer_take_string(SerdecJsonSerializer* ser,
+    size_t* length);
+
+// Re-use the serializer for new output, keeping the memory it has allocated.
+void serdec_json_serializer_reset(SerdecJsonSerializer* ser);
+
+// Free a serializer.
+void serdec_json_serializer_free(SerdecJsonSerializer* ser);
+
+///////////////////////////////////////////////////////////////////////////////
+// Serializer Routines
+////
+
+// As for the other codecs, _start() must be called before serializing
+// anything, and _end() before extracting the output. Any number of values may
+// be serialized in between. They're separated by newlines.
+int serdec_json_serialize_start(SerdecJsonSerializer* ser);
+int serdec_json_serialize_end(SerdecJsonSerializer* ser);
+
+// Serialize an object. Call _map_key() before the value of each entry.
+int serdec_json_serialize_map_start(SerdecJsonSerializer* ser);
+int serdec_json_serialize_map_end(SerdecJsonSerializer* ser);
+int serdec_json_serialize_map_key(SerdecJsonSerializer* ser, const char* key);
+int serdec_json_serialize_map_key_n(SerdecJsonSerializer* ser,
+    const char* key, size_t length);
+
+// Serialize an array.
+int serdec_json_serialize_list_start(SerdecJsonSerializer* ser);
+int serdec_json_serialize_list_end(SerdecJsonSerializer* ser);
+
+// Serialize scalars. Doubles are written with a digit string which reads back
+// to the same value. It's usually, but not always, the shortest such string.
+// JSON has no infinities or NaN, so those return SERDEC_JSON_OUT_OF_RANGE.
+int serdec_json_serialize_bool(SerdecJsonSerializer* ser, bool value);
+int serdec_json_serialize_int(SerdecJsonSerializer* ser, int value);
+int serdec_json_serialize_int64(SerdecJsonSerializer* ser, int64_t value);
+int serdec_json_serialize_uint64(SerdecJsonSerializer* ser, uint64_t value);
+int serdec_json_serialize_size_t(SerdecJsonSerializer* ser, size_t value);
+int serdec_json_serialize_double(SerdecJsonSerializer* ser, double value);
+
+// Serialize a string. The string need not be valid UTF-8: bytes other than
+// '"', '\\' and control characters are copied verbatim.
+int serdec_json_serialize_string(SerdecJsonSerializer* ser,
+    const char* value);
+int serdec_json_serialize_string_n(SerdecJsonSerializer* ser,
+    const char* value, size_t length);
+
+///////////////////////////////////////////////////////////////////////////////
+// Generic Interface
+////
+
+// The operations of the generic interface (see serdec/codec.h), and routines
+// which wrap a de/serializer in it.
+extern const SerdecSerializerOps SERDEC_JSON_SERIALIZER_OPS;
+extern const SerdecDeserializerOps SERDEC_JSON_DESERIALIZER_OPS;
+
+static inline SerdecSerializer serdec_json_serializer_generic(
+    SerdecJsonSerializer* ser)
+{
+    return (SerdecSerializer){
+        .ops=&SERDEC_JSON_SERIALIZER_OPS, .codec=ser,
+    };
+}
+
+static inline SerdecDeserializer serdec_json_deserializer_generic(
+    SerdecJsonDeserializer* deser)
+{
+    return (SerdecDeserializer){
+        .ops=&SERDEC_JSON_DESERIALIZER_OPS, .codec=deser,
+    };
+}
+
+#endif // SERDEC_JSON_H
+
+///////////////////////////////////////////////////////////////////////////////
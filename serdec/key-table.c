@@ -0,0 +1,350 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            key-table.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Implementation of the perfect hash key tables.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <serdec/allocator-ops.h>
+#include <serdec/key-table.h>
+
+static const uint64_t HASH_MULTIPLIER = 0x9e3779b97f4a7c15ULL;
+static const uint32_t EMPTY_SLOT = UINT32_MAX;
+
+// Number of displacements tried for a bucket before giving up on the seed.
+static const uint32_t DISPLACEMENT_LIMIT = 1 << 16;
+
+// Number of seeds tried for a table size before doubling it, and the number
+// of times the table is doubled before giving up.
+static const unsigned SEEDS_PER_SIZE = 8;
+static const unsigned MAXIMUM_DOUBLINGS = 4;
+
+typedef enum BuildResult {
+    BUILD_OK,
+    BUILD_RETRY,
+    BUILD_DUPLICATE,
+} BuildResult;
+
+typedef struct Bucket {
+    uint32_t size;
+    uint32_t index;
+} Bucket;
+
+///////////////////////////////////////////////////////////////////////////////
+// Private API
+////
+
+// The finalizer from SplitMix64.
+static uint64_t mix(uint64_t value) {
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ULL;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebULL;
+    value ^= value >> 31;
+    return value;
+}
+
+static uint64_t hash_key(const char* key, size_t length, uint64_t seed) {
+    uint64_t hash = seed ^ (length * HASH_MULTIPLIER);
+    while (8 <= length) {
+        uint64_t word = 0;
+        memcpy(&word, key, sizeof(word));
+        hash = (hash ^ word) * HASH_MULTIPLIER;
+        hash ^= hash >> 32;
+        key += 8;
+        length -= 8;
+    }
+
+    // A variable-length memcpy() here would be a library call.
+    uint64_t tail = 0;
+    for (size_t i = 0; i < length; ++i) {
+        tail |= (uint64_t)(unsigned char)key[i] << (8 * i);
+    }
+    return mix((hash ^ tail) * HASH_MULTIPLIER);
+}
+
+static uint32_t bucket_of(const KeyTable* table, uint64_t hash) {
+    return (uint32_t)(hash >> 32) & table->bucket_mask;
+}
+
+static uint32_t slot_of(const KeyTable* table, uint64_t hash,
+    uint32_t displacement)
+{
+    uint64_t displaced = (hash ^ displacement) * HASH_MULTIPLIER;
+    return (uint32_t)(displaced >> 32) & table->slot_mask;
+}
+
+static uint32_t next_power_of_two(size_t value) {
+    uint32_t power = 1;
+    while (power < value) {
+        power <<= 1;
+    }
+    return power;
+}
+
+static int compare_buckets(const void* left, const void* right) {
+    const Bucket* left_bucket = (const Bucket*)left;
+    const Bucket* right_bucket = (const Bucket*)right;
+    if (left_bucket->size != right_bucket->size) {
+        return left_bucket->size > right_bucket->size ? -1 : 1;
+    }
+    return left_bucket->index < right_bucket->index ? -1 : 1;
+}
+
+// Find a displacement for the <size> keys in <members>, such that each of
+// them lands in an empty slot.
+static bool place_bucket(KeyTable* table, const uint64_t* hashes,
+    const uint32_t* members, uint32_t size, uint32_t* displacement)
+{
+    for (uint32_t candidate = 0; candidate < DISPLACEMENT_LIMIT; ++candidate) {
+        uint32_t placed = 0;
+        while (placed < size) {
+            uint32_t slot = slot_of(table, hashes[members[placed]], candidate);
+            if (EMPTY_SLOT != table->slots[slot]) {
+                break;
+            }
+            table->slots[slot] = members[placed++];
+        }
+
+        if (placed == size) {
+            *displacement = candidate;
+            return true;
+        }
+
+        while (0 < placed) {
+            --placed;
+            table->slots[slot_of(table, hashes[members[placed]], candidate)] =
+                EMPTY_SLOT;
+        }
+    }
+    return false;
+}
+
+static BuildResult try_build(KeyTable* table, uint64_t* hashes,
+    uint32_t* members, uint32_t* starts, Bucket* buckets)
+{
+    size_t bucket_count = (size_t)table->bucket_mask + 1;
+    for (size_t i = 0; i < table->count; ++i) {
+        hashes[i] = hash_key(table->entries[i].key, table->entries[i].length,
+            table->seed);
+    }
+
+    // Group the keys by bucket, with a counting sort.
+    memset(starts, 0, (bucket_count + 1) * sizeof(*starts));
+    for (size_t i = 0; i < table->count; ++i) {
+        ++starts[bucket_of(table, hashes[i]) + 1];
+    }
+    for (size_t i = 0; i < bucket_count; ++i) {
+        buckets[i].size = starts[i + 1];
+        buckets[i].index = (uint32_t)i;
+        starts[i + 1] += starts[i];
+    }
+    for (size_t i = 0; i < table->count; ++i) {
+        uint32_t bucket = bucket_of(table, hashes[i]);
+        members[starts[bucket] + --buckets[bucket].size] = (uint32_t)i;
+    }
+    for (size_t i = 0; i < bucket_count; ++i) {
+        buckets[i].size = starts[i + 1] - starts[i];
+    }
+
+    // Keys with identical hashes can never be separated. That's either a
+    // duplicate key, or a reason to try another seed.
+    for (size_t i = 0; i < bucket_count; ++i) {
+        const uint32_t* bucket = members + starts[i];
+        for (uint32_t j = 0; j < buckets[i].size; ++j) {
+            for (uint32_t k = j + 1; k < buckets[i].size; ++k) {
+                if (hashes[bucket[j]] != hashes[bucket[k]]) {
+                    continue;
+                }
+
+                const KeyTableEntry* left = &table->entries[bucket[j]];
+                const KeyTableEntry* right = &table->entries[bucket[k]];
+                if (left->length == right->length &&
+                    !memcmp(left->key, right->key, left->length)) {
+                    return BUILD_DUPLICATE;
+                }
+                return BUILD_RETRY;
+            }
+        }
+    }
+
+    // Place the largest buckets first, while the table is mostly empty.
+    qsort(buckets, bucket_count, sizeof(*buckets), compare_buckets);
+    for (size_t i = 0; i <= table->slot_mask; ++i) {
+        table->slots[i] = EMPTY_SLOT;
+    }
+    for (size_t i = 0; i < bucket_count && 0 < buckets[i].size; ++i) {
+        uint32_t index = buckets[i].index;
+        if (!place_bucket(table, hashes, members + starts[index],
+                buckets[i].size, &table->displacements[index])) {
+            return BUILD_RETRY;
+        }
+    }
+    return BUILD_OK;
+}
+
+// (Re)allocate the slots and displacements for a table of <slot_count>.
+static int resize(KeyTable* table, uint32_t slot_count) {
+    uint32_t bucket_count = 4 < slot_count ? slot_count / 4 : 1;
+    uint32_t* slots = allocator_realloc(table->allocator, table->slots,
+        slot_count * sizeof(*slots));
+    if (NULL == slots) {
+        return -1;
+    }
+    table->slots = slots;
+
+    uint32_t* displacements = allocator_calloc(table->allocator, bucket_count,
+        sizeof(*displacements));
+    if (NULL == displacements) {
+        return -1;
+    }
+    allocator_free(table->allocator, table->displacements);
+    table->displacements = displacements;
+    table->slot_mask = slot_count - 1;
+    table->bucket_mask = bucket_count - 1;
+    return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Public API
+////
+
+int key_table_initialize(KeyTable* table, const char* const* keys,
+    size_t count, const SerdecAllocator* allocator)
+{
+    memset(table, 0, sizeof(*table));
+    table->allocator = allocator;
+    if (0 == count) {
+        return 0;
+    }
+
+    // Slots are indexed by uint32_t, with room for the load factor below.
+    if (UINT32_MAX / 4 < count) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    table->entries = allocator_alloc(allocator,
+        count * sizeof(*table->entries));
+    if (NULL == table->entries) {
+        return -1;
+    }
+    table->count = count;
+    for (size_t i = 0; i < count; ++i) {
+        table->entries[i].key = keys[i];
+        table->entries[i].length = strlen(keys[i]);
+    }
+
+    // Keep the load factor below 0.8, so that displacements are found
+    // quickly.
+    uint32_t slot_count = next_power_of_two(count + count / 4 + 1);
+    uint64_t* hashes = allocator_alloc(allocator, count * sizeof(*hashes));
+    uint32_t* members = allocator_alloc(allocator, count * sizeof(*members));
+    uint32_t* starts = NULL;
+    Bucket* buckets = NULL;
+    BuildResult result = BUILD_RETRY;
+    for (unsigned attempt = 0; NULL != hashes && NULL != members &&
+             attempt < SEEDS_PER_SIZE * (MAXIMUM_DOUBLINGS + 1); ++attempt) {
+        if (0 == attempt % SEEDS_PER_SIZE) {
+            if (0 < attempt) {
+                slot_count <<= 1;
+            }
+
+            size_t bucket_count = 4 < slot_count ? slot_count / 4 : 1;
+            allocator_free(allocator, starts);
+            allocator_free(allocator, buckets);
+            starts = allocator_alloc(allocator,
+                (bucket_count + 1) * sizeof(*starts));
+            buckets = allocator_alloc(allocator,
+                bucket_count * sizeof(*buckets));
+            if (NULL == starts || NULL == buckets ||
+                resize(table, slot_count)) {
+                break;
+            }
+        }
+
+        table->seed = mix(attempt + 1);
+        result = try_build(table, hashes, members, starts, buckets);
+        if (BUILD_RETRY != result) {
+            break;
+        }
+    }
+
+    allocator_free(allocator, hashes);
+    allocator_free(allocator, members);
+    allocator_free(allocator, starts);
+    allocator_free(allocator, buckets);
+    if (BUILD_OK == result) {
+        return 0;
+    }
+
+    key_table_delete(table);
+    if (BUILD_DUPLICATE == result) {
+        errno = EINVAL;
+    } else {
+        errno = ENOMEM;
+    }
+    return -1;
+}
+
+void key_table_delete(KeyTable* table) {
+    if (NULL != table->allocator) {
+        allocator_free(table->allocator, table->displacements);
+        allocator_free(table->allocator, table->slots);
+        allocator_free(table->allocator, table->entries);
+    }
+    memset(table, 0, sizeof(*table));
+}
+
+size_t key_table_lookup(const KeyTable* table, const char* key,
+    size_t length)
+{
+    if (0 == table->count) {
+        return KEY_TABLE_NOT_FOUND;
+    }
+
+    uint64_t hash = hash_key(key, length, table->seed);
+    uint32_t index = table->slots[slot_of(table, hash,
+            table->displacements[bucket_of(table, hash)])];
+    if (EMPTY_SLOT == index) {
+        return KEY_TABLE_NOT_FOUND;
+    }
+
+    const KeyTableEntry* entry = &table->entries[index];
+    if (entry->length != length || memcmp(entry->key, key, length)) {
+        return KEY_TABLE_NOT_FOUND;
+    }
+    return index;
+}
+
+///////////////////////////////////////////////////////////////////////////////
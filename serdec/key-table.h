@@ -0,0 +1,79 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            key-table.h
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Perfect hash tables for dispatching map keys.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#ifndef SERDEC_KEY_TABLE_H
+#define SERDEC_KEY_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <serdec/allocator.h>
+
+// A key table maps a fixed set of strings to their indices, using a minimal
+// amount of work per lookup: the key is hashed once, a per-bucket
+// displacement selects its slot, and a single comparison confirms the match.
+// The displacements are searched for when the table is built, so that no two
+// keys share a slot (i.e. the hash is perfect for this set of keys).
+
+#define KEY_TABLE_NOT_FOUND SIZE_MAX
+
+typedef struct KeyTableEntry {
+    const char* key;
+    size_t length;
+} KeyTableEntry;
+
+typedef struct KeyTable {
+    uint64_t seed;
+    uint32_t bucket_mask;
+    uint32_t slot_mask;
+    uint32_t* displacements;
+    uint32_t* slots;
+    KeyTableEntry* entries;
+    size_t count;
+    const SerdecAllocator* allocator;
+} KeyTable;
+
+// Build the table for <count> keys, allocating from <allocator>. The keys are
+// not copied, so they must outlive the table. Return zero on success, or
+// non-zero if memory could not be allocated (errno is set), or the keys
+// contain duplicates (errno is set to EINVAL).
+int key_table_initialize(KeyTable* table, const char* const* keys,
+    size_t count, const SerdecAllocator* allocator);
+void key_table_delete(KeyTable* table);
+
+// Return the index of <key>, or KEY_TABLE_NOT_FOUND.
+size_t key_table_lookup(const KeyTable* table, const char* key,
+    size_t length);
+
+#endif // SERDEC_KEY_TABLE_H
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,635 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            msgpack-deser.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     De-serializer for MessagePack.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <errno.h>
+#include <limits.h>
+#include <string.h>
+
+#include <serdec/allocator-ops.h>
+#include <serdec/msgpack-error.h>
+#include <serdec/msgpack.h>
+
+static const char* SERDEC_MSGPACK_ERROR_STRINGS[] = {
+    [SERDEC_MSGPACK_WRONG_TYPE]="value is not of the requested type",
+    [SERDEC_MSGPACK_OUT_OF_RANGE]="value is out of range for the requested "
+    "type",
+    [SERDEC_MSGPACK_END_OF_INPUT]="input ends in the middle of a value",
+    [SERDEC_MSGPACK_INVALID_FORMAT]="input is not valid MessagePack",
+    [SERDEC_MSGPACK_CALLBACK_SIGNALED_ERROR]="callback signaled an error",
+};
+
+typedef enum MsgpackType {
+    MSGPACK_NIL,
+    MSGPACK_BOOL,
+    MSGPACK_UINT,
+    MSGPACK_INT,
+    MSGPACK_FLOAT,
+    MSGPACK_STRING,
+    MSGPACK_BINARY,
+    MSGPACK_EXTENSION,
+    MSGPACK_LIST,
+    MSGPACK_MAP,
+} MsgpackType;
+
+// The header of a value. Negative integers are MSGPACK_INT, and all others
+// MSGPACK_UINT. <length> is the number of bytes which follow the header, for
+// strings, binary and extension values, or the number of entries of a
+// container.
+typedef struct MsgpackHeader {
+    MsgpackType type;
+    size_t size;
+    size_t length;
+    union {
+        bool boolean;
+        uint64_t uint;
+        int64_t sint;
+        double real;
+    };
+} MsgpackHeader;
+
+typedef struct SerdecMsgpackDeserializer {
+    const unsigned char* cursor;
+    const unsigned char* end;
+    SerdecAllocator allocator;
+    int error;
+} SerdecMsgpackDeserializer;
+
+///////////////////////////////////////////////////////////////////////////////
+// Private API
+////
+
+static int fail(SerdecMsgpackDeserializer* deser, int error) {
+    deser->error = error;
+    return error;
+}
+
+static uint64_t load_big_endian(const unsigned char* buffer, size_t length) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < length; ++i) {
+        value = (value << 8) | buffer[i];
+    }
+    return value;
+}
+
+// Decode the header of the next value, without consuming it. A header with
+// <width> bytes of length follows the format byte of strings and containers.
+static int decode_length(SerdecMsgpackDeserializer* deser,
+    MsgpackHeader* header, MsgpackType type, size_t width)
+{
+    if ((size_t)(deser->end - deser->cursor) < 1 + width) {
+        return fail(deser, SERDEC_MSGPACK_END_OF_INPUT);
+    }
+
+    header->type = type;
+    header->size = 1 + width;
+    header->length = load_big_endian(deser->cursor + 1, width);
+    return 0;
+}
+
+static int decode_number(SerdecMsgpackDeserializer* deser,
+    MsgpackHeader* header, MsgpackType type, size_t width)
+{
+    if ((size_t)(deser->end - deser->cursor) < 1 + width) {
+        return fail(deser, SERDEC_MSGPACK_END_OF_INPUT);
+    }
+
+    header->type = type;
+    header->size = 1 + width;
+    header->length = 0;
+    header->uint = load_big_endian(deser->cursor + 1, width);
+    if (MSGPACK_INT == type) {
+        // Sign-extend the value, and treat non-negative ones as unsigned.
+        unsigned shift = 64 - 8 * (unsigned)width;
+        header->sint = (int64_t)(header->uint << shift) >> shift;
+        if (0 <= header->sint) {
+            header->type = MSGPACK_UINT;
+        }
+    } else if (MSGPACK_FLOAT == type) {
+        if (4 == width) {
+            uint32_t bits = (uint32_t)header->uint;
+            float single;
+            memcpy(&single, &bits, sizeof(single));
+            header->real = single;
+        } else {
+            uint64_t bits = header->uint;
+            memcpy(&header->real, &bits, sizeof(header->real));
+        }
+    }
+    return 0;
+}
+
+static int peek_header(SerdecMsgpackDeserializer* deser,
+    MsgpackHeader* header)
+{
+    if (deser->cursor == deser->end) {
+        return fail(deser, SERDEC_MSGPACK_END_OF_INPUT);
+    }
+
+    unsigned char format = *deser->cursor;
+    header->size = 1;
+    header->length = 0;
+    if (0x7f >= format) {
+        header->type = MSGPACK_UINT;
+        header->uint = format;
+        return 0;
+    } else if (0x8f >= format) {
+        header->type = MSGPACK_MAP;
+        header->length = format & 0x0f;
+        return 0;
+    } else if (0x9f >= format) {
+        header->type = MSGPACK_LIST;
+        header->length = format & 0x0f;
+        return 0;
+    } else if (0xbf >= format) {
+        header->type = MSGPACK_STRING;
+        header->length = format & 0x1f;
+        return 0;
+    } else if (0xe0 <= format) {
+        header->type = MSGPACK_INT;
+        header->sint = (int8_t)format;
+        return 0;
+    }
+
+    switch (format) {
+    case 0xc0: header->type = MSGPACK_NIL; return 0;
+    case 0xc2: case 0xc3:
+        header->type = MSGPACK_BOOL;
+        header->boolean = 0xc3 == format;
+        return 0;
+    case 0xc4: return decode_length(deser, header, MSGPACK_BINARY, 1);
+    case 0xc5: return decode_length(deser, header, MSGPACK_BINARY, 2);
+    case 0xc6: return decode_length(deser, header, MSGPACK_BINARY, 4);
+
+    // The type of an extension follows its length, and is counted as part of
+    // its data.
+    case 0xc7: case 0xc8: case 0xc9: {
+        size_t width = (size_t)1 << (format - 0xc7);
+        if (decode_length(deser, header, MSGPACK_EXTENSION, width)) {
+            return deser->error;
+        }
+        header->length += 1;
+        return 0;
+    }
+    case 0xca: return decode_number(deser, header, MSGPACK_FLOAT, 4);
+    case 0xcb: return decode_number(deser, header, MSGPACK_FLOAT, 8);
+    case 0xcc: case 0xcd: case 0xce: case 0xcf:
+        return decode_number(deser, header, MSGPACK_UINT,
+            (size_t)1 << (format - 0xcc));
+    case 0xd0: case 0xd1: case 0xd2: case 0xd3:
+        return decode_number(deser, header, MSGPACK_INT,
+            (size_t)1 << (format - 0xd0));
+    case 0xd4: case 0xd5: case 0xd6: case 0xd7: case 0xd8:
+        header->type = MSGPACK_EXTENSION;
+        header->length = 1 + ((size_t)1 << (format - 0xd4));
+        return 0;
+    case 0xd9: return decode_length(deser, header, MSGPACK_STRING, 1);
+    case 0xda: return decode_length(deser, header, MSGPACK_STRING, 2);
+    case 0xdb: return decode_length(deser, header, MSGPACK_STRING, 4);
+    case 0xdc: return decode_length(deser, header, MSGPACK_LIST, 2);
+    case 0xdd: return decode_length(deser, header, MSGPACK_LIST, 4);
+    case 0xde: return decode_length(deser, header, MSGPACK_MAP, 2);
+    case 0xdf: return decode_length(deser, header, MSGPACK_MAP, 4);
+    default:
+        return fail(deser, SERDEC_MSGPACK_INVALID_FORMAT);
+    }
+}
+
+// Consume the header of the next value, which must be of type <type>.
+static int read_header(SerdecMsgpackDeserializer* deser,
+    MsgpackHeader* header, MsgpackType type)
+{
+    if (peek_header(deser, header)) {
+        return deser->error;
+    }
+
+    // Non-negative integers may be stored in either kind of integer.
+    if (type != header->type &&
+        !(MSGPACK_INT == type && MSGPACK_UINT == header->type)) {
+        return fail(deser, SERDEC_MSGPACK_WRONG_TYPE);
+    }
+    deser->cursor += header->size;
+    return 0;
+}
+
+// Consume the data of a string, binary or extension value.
+static int read_data(SerdecMsgpackDeserializer* deser,
+    const MsgpackHeader* header, const char** data)
+{
+    if ((size_t)(deser->end - deser->cursor) < header->length) {
+        return fail(deser, SERDEC_MSGPACK_END_OF_INPUT);
+    }
+
+    *data = (const char*)deser->cursor;
+    deser->cursor += header->length;
+    return 0;
+}
+
+// Read an integer of either sign into <value>, reporting whether it's
+// negative (i.e. whether <value> holds an int64_t).
+static int read_integer(SerdecMsgpackDeserializer* deser, uint64_t* value,
+    bool* negative)
+{
+    MsgpackHeader header;
+    if (read_header(deser, &header, MSGPACK_INT)) {
+        return deser->error;
+    }
+
+    *negative = MSGPACK_INT == header.type;
+    *value = header.uint;
+    return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Error Handling
+////
+
+const char* serdec_msgpack_deserializer_strerror(
+    SerdecMsgpackDeserializer* deser)
+{
+    if (0 > deser->error || SERDEC_MSGPACK_MAX_ERROR <= deser->error) {
+        return NULL;
+    }
+
+    switch (deser->error) {
+    case SERDEC_MSGPACK_SYSTEM_ERROR: return strerror(errno);
+    default:
+        return SERDEC_MSGPACK_ERROR_STRINGS[deser->error];
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// De-serializer Initialization
+////
+
+SerdecMsgpackDeserializer* serdec_msgpack_deserializer_new(const void* data,
+    size_t length)
+{
+    return serdec_msgpack_deserializer_new_with_allocator(data, length, NULL);
+}
+
+SerdecMsgpackDeserializer* serdec_msgpack_deserializer_new_with_allocator(
+    const void* data, size_t length, const SerdecAllocator* allocator)
+{
+    allocator = allocator_or_default(allocator);
+    SerdecMsgpackDeserializer* deser = allocator_calloc(allocator, 1,
+        sizeof(SerdecMsgpackDeserializer));
+    if (NULL == deser) {
+        return NULL;
+    }
+
+    deser->allocator = *allocator;
+    serdec_msgpack_deserializer_reset(deser, data, length);
+    return deser;
+}
+
+void serdec_msgpack_deserializer_reset(SerdecMsgpackDeserializer* deser,
+    const void* data, size_t length)
+{
+    deser->cursor = data;
+    deser->end = deser->cursor + length;
+    deser->error = 0;
+}
+
+bool serdec_msgpack_deserializer_at_end(SerdecMsgpackDeserializer* deser) {
+    return deser->cursor == deser->end;
+}
+
+void serdec_msgpack_deserializer_free(SerdecMsgpackDeserializer* deser) {
+    SerdecAllocator allocator = deser->allocator;
+    allocator_free(&allocator, deser);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// De-serialization Routines
+////
+
+int serdec_msgpack_deserialize_map(SerdecMsgpackDeserializer* deser,
+    msgpack_visit_map_callback* callback, void* user_data)
+{
+    MsgpackHeader header;
+    if (read_header(deser, &header, MSGPACK_MAP)) {
+        return deser->error;
+    }
+
+    for (size_t i = 0; i < header.length; ++i) {
+        MsgpackHeader key_header;
+        const char* key = NULL;
+        if (read_header(deser, &key_header, MSGPACK_STRING) ||
+            read_data(deser, &key_header, &key)) {
+            return deser->error;
+        }
+
+        if (callback(deser, user_data, key, key_header.length)) {
+            return fail(deser, SERDEC_MSGPACK_CALLBACK_SIGNALED_ERROR);
+        }
+    }
+    return 0;
+}
+
+int serdec_msgpack_deserialize_list(SerdecMsgpackDeserializer* deser,
+    msgpack_visit_list_callback* callback, void* user_data)
+{
+    MsgpackHeader header;
+    if (read_header(deser, &header, MSGPACK_LIST)) {
+        return deser->error;
+    }
+
+    for (size_t i = 0; i < header.length; ++i) {
+        if (callback(deser, user_data, i)) {
+            return fail(deser, SERDEC_MSGPACK_CALLBACK_SIGNALED_ERROR);
+        }
+    }
+    return 0;
+}
+
+int serdec_msgpack_deserialize_bool(SerdecMsgpackDeserializer* deser,
+    bool* value)
+{
+    MsgpackHeader header;
+    if (read_header(deser, &header, MSGPACK_BOOL)) {
+        return deser->error;
+    }
+
+    *value = header.boolean;
+    return 0;
+}
+
+int serdec_msgpack_deserialize_int(SerdecMsgpackDeserializer* deser,
+    int* value)
+{
+    int64_t result = 0;
+    if (serdec_msgpack_deserialize_int64(deser, &result)) {
+        return deser->error;
+    } else if (INT_MIN > result || INT_MAX < result) {
+        return fail(deser, SERDEC_MSGPACK_OUT_OF_RANGE);
+    }
+
+    *value = (int)result;
+    return 0;
+}
+
+int serdec_msgpack_deserialize_int64(SerdecMsgpackDeserializer* deser,
+    int64_t* value)
+{
+    uint64_t result = 0;
+    bool negative = false;
+    if (read_integer(deser, &result, &negative)) {
+        return deser->error;
+    } else if (!negative && INT64_MAX < result) {
+        return fail(deser, SERDEC_MSGPACK_OUT_OF_RANGE);
+    }
+
+    *value = (int64_t)result;
+    return 0;
+}
+
+int serdec_msgpack_deserialize_uint64(SerdecMsgpackDeserializer* deser,
+    uint64_t* value)
+{
+    uint64_t result = 0;
+    bool negative = false;
+    if (read_integer(deser, &result, &negative)) {
+        return deser->error;
+    } else if (negative) {
+        return fail(deser, SERDEC_MSGPACK_OUT_OF_RANGE);
+    }
+
+    *value = result;
+    return 0;
+}
+
+int serdec_msgpack_deserialize_size_t(SerdecMsgpackDeserializer* deser,
+    size_t* value)
+{
+    uint64_t result = 0;
+    if (serdec_msgpack_deserialize_uint64(deser, &result)) {
+        return deser->error;
+    } else if (SIZE_MAX < result) {
+        return fail(deser, SERDEC_MSGPACK_OUT_OF_RANGE);
+    }
+
+    *value = (size_t)result;
+    return 0;
+}
+
+int serdec_msgpack_deserialize_double(SerdecMsgpackDeserializer* deser,
+    double* value)
+{
+    MsgpackHeader header;
+    if (peek_header(deser, &header)) {
+        return deser->error;
+    }
+
+    switch (header.type) {
+    case MSGPACK_FLOAT: *value = header.real; break;
+    case MSGPACK_UINT: *value = (double)header.uint; break;
+    case MSGPACK_INT: *value = (double)header.sint; break;
+    default:
+        return fail(deser, SERDEC_MSGPACK_WRONG_TYPE);
+    }
+
+    deser->cursor += header.size;
+    return 0;
+}
+
+int serdec_msgpack_deserialize_string(SerdecMsgpackDeserializer* deser,
+    const char** value, size_t* length)
+{
+    MsgpackHeader header;
+    if (peek_header(deser, &header)) {
+        return deser->error;
+    } else if (MSGPACK_STRING != header.type &&
+        MSGPACK_BINARY != header.type) {
+        return fail(deser, SERDEC_MSGPACK_WRONG_TYPE);
+    }
+
+    deser->cursor += header.size;
+    if (read_data(deser, &header, value)) {
+        return deser->error;
+    }
+
+    if (NULL != length) {
+        *length = header.length;
+    }
+    return 0;
+}
+
+int serdec_msgpack_deserialize_string_arena(SerdecMsgpackDeserializer* deser,
+    SerdecArena* arena, const char** value, size_t* length)
+{
+    const char* view = NULL;
+    size_t view_length = 0;
+    if (serdec_msgpack_deserialize_string(deser, &view, &view_length)) {
+        return deser->error;
+    }
+
+    char* copy = serdec_arena_strndup(arena, view, view_length);
+    if (NULL == copy) {
+        errno = ENOMEM;
+        return fail(deser, SERDEC_MSGPACK_SYSTEM_ERROR);
+    }
+
+    *value = copy;
+    if (NULL != length) {
+        *length = view_length;
+    }
+    return 0;
+}
+
+// Values are skipped one header at a time, counting the entries of containers
+// which remain to be skipped, so that nesting doesn't cost stack.
+int serdec_msgpack_deserialize_skip(SerdecMsgpackDeserializer* deser) {
+    size_t remaining = 1;
+    while (0 < remaining) {
+        MsgpackHeader header;
+        if (peek_header(deser, &header)) {
+            return deser->error;
+        }
+
+        remaining -= 1;
+        deser->cursor += header.size;
+        switch (header.type) {
+        case MSGPACK_STRING: case MSGPACK_BINARY: case MSGPACK_EXTENSION: {
+            const char* data = NULL;
+            if (read_data(deser, &header, &data)) {
+                return deser->error;
+            }
+            break;
+        }
+        case MSGPACK_LIST: remaining += header.length; break;
+        case MSGPACK_MAP: remaining += 2 * header.length; break;
+        default: break;
+        }
+    }
+    return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Generic Interface
+////
+
+// The visitors of the generic interface are invoked from the codec's, which
+// receive the generic de-serializer and visitor through this.
+typedef struct GenericVisit {
+    SerdecDeserializer* deser;
+    serdec_visit_map_callback* map;
+    serdec_visit_list_callback* list;
+    void* user_data;
+} GenericVisit;
+
+static int visit_generic_map(SerdecMsgpackDeserializer* deser,
+    void* user_data, const char* key, size_t length)
+{
+    (void)deser;
+    GenericVisit* visit = user_data;
+    return visit->map(visit->deser, visit->user_data, key, length);
+}
+
+static int visit_generic_list(SerdecMsgpackDeserializer* deser,
+    void* user_data, size_t index)
+{
+    (void)deser;
+    GenericVisit* visit = user_data;
+    return visit->list(visit->deser, visit->user_data, index);
+}
+
+static int generic_map(SerdecDeserializer* deser,
+    serdec_visit_map_callback* callback, void* user_data)
+{
+    GenericVisit visit = {
+        .deser=deser, .map=callback, .user_data=user_data,
+    };
+    return serdec_msgpack_deserialize_map(deser->codec, visit_generic_map,
+        &visit);
+}
+
+static int generic_list(SerdecDeserializer* deser,
+    serdec_visit_list_callback* callback, void* user_data)
+{
+    GenericVisit visit = {
+        .deser=deser, .list=callback, .user_data=user_data,
+    };
+    return serdec_msgpack_deserialize_list(deser->codec, visit_generic_list,
+        &visit);
+}
+
+static int generic_bool(void* deser, bool* value) {
+    return serdec_msgpack_deserialize_bool(deser, value);
+}
+
+static int generic_int(void* deser, int* value) {
+    return serdec_msgpack_deserialize_int(deser, value);
+}
+
+static int generic_int64(void* deser, int64_t* value) {
+    return serdec_msgpack_deserialize_int64(deser, value);
+}
+
+static int generic_uint64(void* deser, uint64_t* value) {
+    return serdec_msgpack_deserialize_uint64(deser, value);
+}
+
+static int generic_size_t(void* deser, size_t* value) {
+    return serdec_msgpack_deserialize_size_t(deser, value);
+}
+
+static int generic_double(void* deser, double* value) {
+    return serdec_msgpack_deserialize_double(deser, value);
+}
+
+static int generic_string(void* deser, const char** value, size_t* length) {
+    return serdec_msgpack_deserialize_string(deser, value, length);
+}
+
+static int generic_skip(void* deser) {
+    return serdec_msgpack_deserialize_skip(deser);
+}
+
+static const char* generic_strerror(void* deser) {
+    return serdec_msgpack_deserializer_strerror(deser);
+}
+
+const SerdecDeserializerOps SERDEC_MSGPACK_DESERIALIZER_OPS = {
+    .map=generic_map,
+    .list=generic_list,
+    .boolean=generic_bool,
+    .integer=generic_int,
+    .int64=generic_int64,
+    .uint64=generic_uint64,
+    .size=generic_size_t,
+    .real=generic_double,
+    .string=generic_string,
+    .skip=generic_skip,
+    .strerror=generic_strerror,
+};
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,573 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            msgpack-ser.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Serializer for MessagePack.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <errno.h>
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+#include <serdec/allocator-ops.h>
+#include <serdec/msgpack-error.h>
+#include <serdec/msgpack.h>
+#include <serdec/string-ops.h>
+
+static const char* SERDEC_MSGPACK_ERROR_STRINGS[] = {
+    [SERDEC_MSGPACK_UNEXPECTED_EVENT]="operation is not valid at this point in "
+    "the output",
+    [SERDEC_MSGPACK_OUT_OF_RANGE]="value is too large to be encoded",
+};
+
+// The header of a container is written before its entries are known, so room
+// is left for the largest one. When the container ends, its header is written
+// in the smallest format, which leaves a gap after it. The gaps are closed in
+// a single pass once the outermost container ends, so that each byte is moved
+// at most once however deeply the containers are nested.
+static const size_t MSGPACK_HEADER_SIZE = 5;
+static const size_t MSGPACK_INITIAL_DEPTH = 16;
+
+typedef struct MsgpackFrame {
+    bool map;
+    bool expect_value;
+    size_t gap;
+    size_t count;
+} MsgpackFrame;
+
+// The placeholder for the header of a container, in the order the containers
+// began, which is also the order of their offsets in the output.
+typedef struct MsgpackGap {
+    size_t offset;
+    size_t length;
+} MsgpackGap;
+
+typedef struct SerdecMsgpackSerializer {
+    StringBuffer output;
+    SerdecAllocator allocator;
+    int error;
+    bool started;
+
+    MsgpackFrame* frames;
+    size_t depth;
+    size_t capacity;
+
+    MsgpackGap* gaps;
+    size_t gap_count;
+    size_t gap_capacity;
+} SerdecMsgpackSerializer;
+
+///////////////////////////////////////////////////////////////////////////////
+// Private API
+////
+
+static int fail(SerdecMsgpackSerializer* ser, int error) {
+    ser->error = error;
+    return error;
+}
+
+// Store the low <length> bytes of <value> in big-endian order.
+static void store_big_endian(unsigned char* buffer, uint64_t value,
+    size_t length)
+{
+    for (size_t i = 0; i < length; ++i) {
+        buffer[length - 1 - i] = (unsigned char)(value >> (8 * i));
+    }
+}
+
+static int put(SerdecMsgpackSerializer* ser, const void* data, size_t length)
+{
+    if (string_buffer_append(&ser->output, data, length)) {
+        return fail(ser, SERDEC_MSGPACK_SYSTEM_ERROR);
+    }
+    return 0;
+}
+
+// Write a format byte, followed by <length> bytes of <value>.
+static int put_format(SerdecMsgpackSerializer* ser, unsigned char format,
+    uint64_t value, size_t length)
+{
+    unsigned char buffer[9] = {format};
+    store_big_endian(buffer + 1, value, length);
+    return put(ser, buffer, length + 1);
+}
+
+// Check that a value may begin here, and count it as an entry of the
+// container it's in.
+static int begin_value(SerdecMsgpackSerializer* ser) {
+    if (!ser->started) {
+        return fail(ser, SERDEC_MSGPACK_UNEXPECTED_EVENT);
+    } else if (0 == ser->depth) {
+        return 0;
+    }
+
+    MsgpackFrame* frame = &ser->frames[ser->depth - 1];
+    if (frame->map) {
+        if (!frame->expect_value) {
+            return fail(ser, SERDEC_MSGPACK_UNEXPECTED_EVENT);
+        }
+        frame->expect_value = false;
+    } else {
+        frame->count += 1;
+    }
+    return 0;
+}
+
+static int begin_container(SerdecMsgpackSerializer* ser, bool map) {
+    if (begin_value(ser)) {
+        return ser->error;
+    }
+
+    if (ser->depth == ser->capacity) {
+        size_t capacity = 2 * ser->capacity;
+        if (0 == capacity) {
+            capacity = MSGPACK_INITIAL_DEPTH;
+        }
+
+        MsgpackFrame* frames = allocator_realloc(&ser->allocator, ser->frames,
+            capacity * sizeof(MsgpackFrame));
+        if (NULL == frames) {
+            return fail(ser, SERDEC_MSGPACK_SYSTEM_ERROR);
+        }
+        ser->frames = frames;
+        ser->capacity = capacity;
+    }
+
+    if (ser->gap_count == ser->gap_capacity) {
+        size_t capacity = 2 * ser->gap_capacity;
+        if (0 == capacity) {
+            capacity = MSGPACK_INITIAL_DEPTH;
+        }
+
+        MsgpackGap* gaps = allocator_realloc(&ser->allocator, ser->gaps,
+            capacity * sizeof(MsgpackGap));
+        if (NULL == gaps) {
+            return fail(ser, SERDEC_MSGPACK_SYSTEM_ERROR);
+        }
+        ser->gaps = gaps;
+        ser->gap_capacity = capacity;
+    }
+
+    MsgpackFrame* frame = &ser->frames[ser->depth++];
+    frame->map = map;
+    frame->expect_value = false;
+    frame->gap = ser->gap_count++;
+    frame->count = 0;
+
+    MsgpackGap* gap = &ser->gaps[frame->gap];
+    gap->offset = ser->output.length;
+    gap->length = MSGPACK_HEADER_SIZE;
+    return put_format(ser, 0, 0, MSGPACK_HEADER_SIZE - 1);
+}
+
+// Move the output up over the unused bytes of every header placeholder.
+static void close_gaps(SerdecMsgpackSerializer* ser) {
+    char* output = ser->output.string;
+    size_t read = 0;
+    size_t write = 0;
+    for (size_t i = 0; i < ser->gap_count; ++i) {
+        const MsgpackGap* gap = &ser->gaps[i];
+        size_t end = gap->offset + gap->length;
+        if (write != read) {
+            memmove(output + write, output + read, end - read);
+        }
+        write += end - read;
+        read = gap->offset + MSGPACK_HEADER_SIZE;
+    }
+
+    if (write != read) {
+        memmove(output + write, output + read, ser->output.length - read);
+        ser->output.length -= read - write;
+        output[ser->output.length] = '\0';
+    }
+    ser->gap_count = 0;
+}
+
+// Write the header of the container which is ending, in the smallest format
+// which holds its number of entries.
+static int end_container(SerdecMsgpackSerializer* ser, bool map) {
+    MsgpackFrame* frame = 0 < ser->depth ? &ser->frames[ser->depth - 1] : NULL;
+    if (NULL == frame || map != frame->map || frame->expect_value) {
+        return fail(ser, SERDEC_MSGPACK_UNEXPECTED_EVENT);
+    } else if (UINT32_MAX < frame->count) {
+        return fail(ser, SERDEC_MSGPACK_OUT_OF_RANGE);
+    }
+
+    unsigned char header[MSGPACK_HEADER_SIZE];
+    size_t length = 1;
+    if (15 >= frame->count) {
+        header[0] = (map ? 0x80 : 0x90) | (unsigned char)frame->count;
+    } else if (UINT16_MAX >= frame->count) {
+        header[0] = map ? 0xde : 0xdc;
+        store_big_endian(header + 1, frame->count, 2);
+        length = 3;
+    } else {
+        header[0] = map ? 0xdf : 0xdd;
+        store_big_endian(header + 1, frame->count, 4);
+        length = 5;
+    }
+
+    MsgpackGap* gap = &ser->gaps[frame->gap];
+    memcpy(ser->output.string + gap->offset, header, length);
+    gap->length = length;
+    ser->depth -= 1;
+    if (0 == ser->depth) {
+        close_gaps(ser);
+    }
+    return 0;
+}
+
+static int put_string(SerdecMsgpackSerializer* ser, const char* value,
+    size_t length)
+{
+    int result = 0;
+    if (31 >= length) {
+        result = put_format(ser, 0xa0 | (unsigned char)length, 0, 0);
+    } else if (UINT8_MAX >= length) {
+        result = put_format(ser, 0xd9, length, 1);
+    } else if (UINT16_MAX >= length) {
+        result = put_format(ser, 0xda, length, 2);
+    } else if (UINT32_MAX >= length) {
+        result = put_format(ser, 0xdb, length, 4);
+    } else {
+        result = fail(ser, SERDEC_MSGPACK_OUT_OF_RANGE);
+    }
+
+    if (result) {
+        return result;
+    }
+    return put(ser, value, length);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Error Handling
+////
+
+const char* serdec_msgpack_serializer_strerror(SerdecMsgpackSerializer* ser) {
+    if (0 > ser->error || SERDEC_MSGPACK_MAX_ERROR <= ser->error) {
+        return NULL;
+    }
+
+    switch (ser->error) {
+    case SERDEC_MSGPACK_SYSTEM_ERROR: return strerror(errno);
+    default:
+        return SERDEC_MSGPACK_ERROR_STRINGS[ser->error];
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Serializer Initialization
+////
+
+SerdecMsgpackSerializer* serdec_msgpack_serializer_new(void) {
+    return serdec_msgpack_serializer_new_with_allocator(NULL);
+}
+
+SerdecMsgpackSerializer* serdec_msgpack_serializer_new_with_allocator(
+    const SerdecAllocator* allocator)
+{
+    allocator = allocator_or_default(allocator);
+    SerdecMsgpackSerializer* ser = allocator_calloc(allocator, 1,
+        sizeof(SerdecMsgpackSerializer));
+    if (NULL == ser) {
+        return NULL;
+    }
+
+    ser->allocator = *allocator;
+    string_buffer_init(&ser->output, &ser->allocator);
+    return ser;
+}
+
+const char* serdec_msgpack_serializer_borrow_buffer(
+    SerdecMsgpackSerializer* ser, size_t* length)
+{
+    if (NULL != length) {
+        *length = ser->output.length;
+    }
+    return NULL != ser->output.string ? ser->output.string : "";
+}
+
+char* serdec_msgpack_serializer_take_buffer(SerdecMsgpackSerializer* ser,
+    size_t* length)
+{
+    char* buffer = string_buffer_take(&ser->output, length);
+    if (NULL == buffer) {
+        ser->error = SERDEC_MSGPACK_SYSTEM_ERROR;
+    }
+    return buffer;
+}
+
+void serdec_msgpack_serializer_reset(SerdecMsgpackSerializer* ser) {
+    string_buffer_clear(&ser->output);
+    ser->error = 0;
+    ser->started = false;
+    ser->depth = 0;
+    ser->gap_count = 0;
+}
+
+void serdec_msgpack_serializer_free(SerdecMsgpackSerializer* ser) {
+    string_buffer_release(&ser->output);
+    allocator_free(&ser->allocator, ser->frames);
+    allocator_free(&ser->allocator, ser->gaps);
+    SerdecAllocator allocator = ser->allocator;
+    allocator_free(&allocator, ser);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Serializer Routines
+////
+
+int serdec_msgpack_serialize_start(SerdecMsgpackSerializer* ser) {
+    ser->started = true;
+    return 0;
+}
+
+int serdec_msgpack_serialize_end(SerdecMsgpackSerializer* ser) {
+    if (!ser->started || 0 != ser->depth) {
+        return fail(ser, SERDEC_MSGPACK_UNEXPECTED_EVENT);
+    }
+    return 0;
+}
+
+int serdec_msgpack_serialize_map_start(SerdecMsgpackSerializer* ser) {
+    return begin_container(ser, true);
+}
+
+int serdec_msgpack_serialize_map_end(SerdecMsgpackSerializer* ser) {
+    return end_container(ser, true);
+}
+
+int serdec_msgpack_serialize_map_key(SerdecMsgpackSerializer* ser,
+    const char* key)
+{
+    return serdec_msgpack_serialize_map_key_n(ser, key, strlen(key));
+}
+
+int serdec_msgpack_serialize_map_key_n(SerdecMsgpackSerializer* ser,
+    const char* key, size_t length)
+{
+    MsgpackFrame* frame = 0 < ser->depth ? &ser->frames[ser->depth - 1] : NULL;
+    if (NULL == frame || !frame->map || frame->expect_value) {
+        return fail(ser, SERDEC_MSGPACK_UNEXPECTED_EVENT);
+    }
+
+    frame->count += 1;
+    frame->expect_value = true;
+    return put_string(ser, key, length);
+}
+
+int serdec_msgpack_serialize_list_start(SerdecMsgpackSerializer* ser) {
+    return begin_container(ser, false);
+}
+
+int serdec_msgpack_serialize_list_end(SerdecMsgpackSerializer* ser) {
+    return end_container(ser, false);
+}
+
+int serdec_msgpack_serialize_bool(SerdecMsgpackSerializer* ser, bool value) {
+    if (begin_value(ser)) {
+        return ser->error;
+    }
+    return put_format(ser, value ? 0xc3 : 0xc2, 0, 0);
+}
+
+int serdec_msgpack_serialize_int(SerdecMsgpackSerializer* ser, int value) {
+    return serdec_msgpack_serialize_int64(ser, value);
+}
+
+int serdec_msgpack_serialize_int64(SerdecMsgpackSerializer* ser,
+    int64_t value)
+{
+    if (0 <= value) {
+        return serdec_msgpack_serialize_uint64(ser, (uint64_t)value);
+    } else if (begin_value(ser)) {
+        return ser->error;
+    }
+
+    // Negative values are stored in two's complement.
+    uint64_t bits = (uint64_t)value;
+    if (-32 <= value) {
+        return put_format(ser, (unsigned char)bits, 0, 0);
+    } else if (INT8_MIN <= value) {
+        return put_format(ser, 0xd0, bits, 1);
+    } else if (INT16_MIN <= value) {
+        return put_format(ser, 0xd1, bits, 2);
+    } else if (INT32_MIN <= value) {
+        return put_format(ser, 0xd2, bits, 4);
+    }
+    return put_format(ser, 0xd3, bits, 8);
+}
+
+int serdec_msgpack_serialize_uint64(SerdecMsgpackSerializer* ser,
+    uint64_t value)
+{
+    if (begin_value(ser)) {
+        return ser->error;
+    }
+
+    if (0x7f >= value) {
+        return put_format(ser, (unsigned char)value, 0, 0);
+    } else if (UINT8_MAX >= value) {
+        return put_format(ser, 0xcc, value, 1);
+    } else if (UINT16_MAX >= value) {
+        return put_format(ser, 0xcd, value, 2);
+    } else if (UINT32_MAX >= value) {
+        return put_format(ser, 0xce, value, 4);
+    }
+    return put_format(ser, 0xcf, value, 8);
+}
+
+int serdec_msgpack_serialize_size_t(SerdecMsgpackSerializer* ser,
+    size_t value)
+{
+    return serdec_msgpack_serialize_uint64(ser, value);
+}
+
+int serdec_msgpack_serialize_double(SerdecMsgpackSerializer* ser,
+    double value)
+{
+    if (begin_value(ser)) {
+        return ser->error;
+    }
+
+    // Finite values outside the range of a float can't be converted to one.
+    float single = 0;
+    if (isinf(value) || (-FLT_MAX <= value && FLT_MAX >= value)) {
+        single = (float)value;
+    }
+
+    if ((double)single == value) {
+        uint32_t bits;
+        memcpy(&bits, &single, sizeof(bits));
+        return put_format(ser, 0xca, bits, 4);
+    }
+
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return put_format(ser, 0xcb, bits, 8);
+}
+
+int serdec_msgpack_serialize_string(SerdecMsgpackSerializer* ser,
+    const char* value)
+{
+    return serdec_msgpack_serialize_string_n(ser, value, strlen(value));
+}
+
+int serdec_msgpack_serialize_string_n(SerdecMsgpackSerializer* ser,
+    const char* value, size_t length)
+{
+    if (begin_value(ser)) {
+        return ser->error;
+    }
+    return put_string(ser, value, length);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Generic Interface
+////
+
+static int generic_start(void* ser) {
+    return serdec_msgpack_serialize_start(ser);
+}
+
+static int generic_end(void* ser) {
+    return serdec_msgpack_serialize_end(ser);
+}
+
+static int generic_map_start(void* ser) {
+    return serdec_msgpack_serialize_map_start(ser);
+}
+
+static int generic_map_end(void* ser) {
+    return serdec_msgpack_serialize_map_end(ser);
+}
+
+static int generic_map_key_n(void* ser, const char* key, size_t length) {
+    return serdec_msgpack_serialize_map_key_n(ser, key, length);
+}
+
+static int generic_list_start(void* ser) {
+    return serdec_msgpack_serialize_list_start(ser);
+}
+
+static int generic_list_end(void* ser) {
+    return serdec_msgpack_serialize_list_end(ser);
+}
+
+static int generic_bool(void* ser, bool value) {
+    return serdec_msgpack_serialize_bool(ser, value);
+}
+
+static int generic_int(void* ser, int value) {
+    return serdec_msgpack_serialize_int(ser, value);
+}
+
+static int generic_int64(void* ser, int64_t value) {
+    return serdec_msgpack_serialize_int64(ser, value);
+}
+
+static int generic_uint64(void* ser, uint64_t value) {
+    return serdec_msgpack_serialize_uint64(ser, value);
+}
+
+static int generic_size_t(void* ser, size_t value) {
+    return serdec_msgpack_serialize_size_t(ser, value);
+}
+
+static int generic_double(void* ser, double value) {
+    return serdec_msgpack_serialize_double(ser, value);
+}
+
+static int generic_string_n(void* ser, const char* value, size_t length) {
+    return serdec_msgpack_serialize_string_n(ser, value, length);
+}
+
+static const char* generic_strerror(void* ser) {
+    return serdec_msgpack_serializer_strerror(ser);
+}
+
+const SerdecSerializerOps SERDEC_MSGPACK_SERIALIZER_OPS = {
+    .start=generic_start,
+    .end=generic_end,
+    .map_start=generic_map_start,
+    .map_end=generic_map_end,
+    .map_key=generic_map_key_n,
+    .list_start=generic_list_start,
+    .list_end=generic_list_end,
+    .boolean=generic_bool,
+    .integer=generic_int,
+    .int64=generic_int64,
+    .uint64=generic_uint64,
+    .size=generic_size_t,
+    .real=generic_double,
+    .string=generic_string_n,
+    .strerror=generic_strerror,
+};
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,228 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            msgpack.h
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Public interface of the MessagePack codec.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#ifndef SERDEC_MSGPACK_H
+#define SERDEC_MSGPACK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <serdec/allocator.h>
+#include <serdec/arena.h>
+#include <serdec/codec.h>
+
+// The MessagePack codec has the same shape as the YAML one: routines which
+// serialize maps, lists and scalars, and de-serialization routines driven by
+// visitor callbacks. Its output is standard MessagePack. Every container is
+// prefixed with its number of entries, and every string with its length, so
+// a subtree can be skipped by reading only its headers.
+typedef struct SerdecMsgpackDeserializer SerdecMsgpackDeserializer;
+typedef struct SerdecMsgpackSerializer SerdecMsgpackSerializer;
+
+///////////////////////////////////////////////////////////////////////////////
+// Error Handling
+////
+
+// Obtain error strings from the de/serializers.
+const char* serdec_msgpack_deserializer_strerror(
+    SerdecMsgpackDeserializer* deser);
+const char* serdec_msgpack_serializer_strerror(SerdecMsgpackSerializer* ser);
+
+///////////////////////////////////////////////////////////////////////////////
+// De-serializer Initialization
+////
+
+// Initialize a de-serializer which reads the encoded values in <data>. The
+// input is not copied: it must outlive the de-serializer, and the strings
+// which are read from it.
+SerdecMsgpackDeserializer* serdec_msgpack_deserializer_new(const void* data,
+    size_t length);
+SerdecMsgpackDeserializer* serdec_msgpack_deserializer_new_with_allocator(
+    const void* data, size_t length, const SerdecAllocator* allocator);
+
+// Re-use the de-serializer for new input.
+void serdec_msgpack_deserializer_reset(SerdecMsgpackDeserializer* deser,
+    const void* data, size_t length);
+
+// Whether every value in the input has been read. The input may hold several
+// values one after another.
+bool serdec_msgpack_deserializer_at_end(SerdecMsgpackDeserializer* deser);
+
+// Free a de-serializer.
+void serdec_msgpack_deserializer_free(SerdecMsgpackDeserializer* deser);
+
+///////////////////////////////////////////////////////////////////////////////
+// De-serialization Routines
+////
+
+// This callback is to "visit" (i.e. handle) entries of a map. It must
+// de-serialize (or skip) exactly one value: the value of the entry. <key> is a
+// view into the input, which is not NUL-terminated. Return non-zero to stop
+// de-serialization.
+typedef int msgpack_visit_map_callback(SerdecMsgpackDeserializer* deser,
+    void* user_data, const char* key, size_t length);
+
+// De-serialize a map from the input. Its keys must be strings. Return non-zero
+// if parsing encountered an error, for any reason.
+int serdec_msgpack_deserialize_map(SerdecMsgpackDeserializer* deser,
+    msgpack_visit_map_callback* callback, void* user_data);
+
+// Like the map callback, for each element of a list.
+typedef int msgpack_visit_list_callback(SerdecMsgpackDeserializer* deser,
+    void* user_data, size_t index);
+
+int serdec_msgpack_deserialize_list(SerdecMsgpackDeserializer* deser,
+    msgpack_visit_list_callback* callback, void* user_data);
+
+// De-serialize scalars from the input. Return SERDEC_MSGPACK_WRONG_TYPE if the
+// next value is of a different type, or SERDEC_MSGPACK_OUT_OF_RANGE if an
+// integer does not fit. Floating point values may be read from integers.
+int serdec_msgpack_deserialize_bool(SerdecMsgpackDeserializer* deser,
+    bool* value);
+int serdec_msgpack_deserialize_int(SerdecMsgpackDeserializer* deser,
+    int* value);
+int serdec_msgpack_deserialize_int64(SerdecMsgpackDeserializer* deser,
+    int64_t* value);
+int serdec_msgpack_deserialize_uint64(SerdecMsgpackDeserializer* deser,
+    uint64_t* value);
+int serdec_msgpack_deserialize_size_t(SerdecMsgpackDeserializer* deser,
+    size_t* value);
+int serdec_msgpack_deserialize_double(SerdecMsgpackDeserializer* deser,
+    double* value);
+
+// De-serialize a string (or binary) value. <value> points into the input, and
+// is not NUL-terminated. <length> may be NULL.
+int serdec_msgpack_deserialize_string(SerdecMsgpackDeserializer* deser,
+    const char** value, size_t* length);
+
+// Like _string(), but the string is copied into <arena>, and NUL-terminated.
+int serdec_msgpack_deserialize_string_arena(SerdecMsgpackDeserializer* deser,
+    SerdecArena* arena, const char** value, size_t* length);
+
+// Skip the next value, including everything nested in it. Strings are skipped
+// without being read, and containers by reading only the headers of their
+// entries.
+int serdec_msgpack_deserialize_skip(SerdecMsgpackDeserializer* deser);
+
+///////////////////////////////////////////////////////////////////////////////
+// Serializer Initialization
+////
+
+// Initialize a serializer which encodes into a buffer, which grows as needed.
+SerdecMsgpackSerializer* serdec_msgpack_serializer_new(void);
+SerdecMsgpackSerializer* serdec_msgpack_serializer_new_with_allocator(
+    const SerdecAllocator* allocator);
+
+// Obtain the output of the serializer. The buffer from _borrow_buffer() is
+// owned by the serializer. The one from _take_buffer() is owned by the caller,
+// and must be released with the serializer's allocator. The serializer starts
+// over with an empty buffer afterwards. <length> may be NULL.
+const char* serdec_msgpack_serializer_borrow_buffer(
+    SerdecMsgpackSerializer* ser, size_t* length);
+char* serdec_msgpack_serializer_take_buffer(SerdecMsgpackSerializer* ser,
+    size_t* length);
+
+// Re-use the serializer for new output, keeping the memory it has allocated.
+void serdec_msgpack_serializer_reset(SerdecMsgpackSerializer* ser);
+
+// Free a serializer.
+void serdec_msgpack_serializer_free(SerdecMsgpackSerializer* ser);
+
+///////////////////////////////////////////////////////////////////////////////
+// Serializer Routines
+////
+
+// As for YAML, _start() must be called before serializing anything, and
+// _end() before extracting the output. Any number of values may be serialized
+// in between, one after another.
+int serdec_msgpack_serialize_start(SerdecMsgpackSerializer* ser);
+int serdec_msgpack_serialize_end(SerdecMsgpackSerializer* ser);
+
+// Serialize a map. Call _map_key() before the value of each entry. The number
+// of entries doesn't need to be known in advance.
+int serdec_msgpack_serialize_map_start(SerdecMsgpackSerializer* ser);
+int serdec_msgpack_serialize_map_end(SerdecMsgpackSerializer* ser);
+int serdec_msgpack_serialize_map_key(SerdecMsgpackSerializer* ser,
+    const char* key);
+int serdec_msgpack_serialize_map_key_n(SerdecMsgpackSerializer* ser,
+    const char* key, size_t length);
+
+// Serialize a list. Its number of elements doesn't need to be known either.
+int serdec_msgpack_serialize_list_start(SerdecMsgpackSerializer* ser);
+int serdec_msgpack_serialize_list_end(SerdecMsgpackSerializer* ser);
+
+// Serialize scalars. Integers are written with the smallest encoding which
+// holds them, and doubles as 32-bit floats when that's exact.
+int serdec_msgpack_serialize_bool(SerdecMsgpackSerializer* ser, bool value);
+int serdec_msgpack_serialize_int(SerdecMsgpackSerializer* ser, int value);
+int serdec_msgpack_serialize_int64(SerdecMsgpackSerializer* ser,
+    int64_t value);
+int serdec_msgpack_serialize_uint64(SerdecMsgpackSerializer* ser,
+    uint64_t value);
+int serdec_msgpack_serialize_size_t(SerdecMsgpackSerializer* ser,
+    size_t value);
+int serdec_msgpack_serialize_double(SerdecMsgpackSerializer* ser,
+    double value);
+int serdec_msgpack_serialize_string(SerdecMsgpackSerializer* ser,
+    const char* value);
+int serdec_msgpack_serialize_string_n(SerdecMsgpackSerializer* ser,
+    const char* value, size_t length);
+
+///////////////////////////////////////////////////////////////////////////////
+// Generic Interface
+////
+
+// The operations of the generic interface (see serdec/codec.h), and routines
+// which wrap a de/serializer in it.
+extern const SerdecSerializerOps SERDEC_MSGPACK_SERIALIZER_OPS;
+extern const SerdecDeserializerOps SERDEC_MSGPACK_DESERIALIZER_OPS;
+
+static inline SerdecSerializer serdec_msgpack_serializer_generic(
+    SerdecMsgpackSerializer* ser)
+{
+    return (SerdecSerializer){
+        .ops=&SERDEC_MSGPACK_SERIALIZER_OPS, .codec=ser,
+    };
+}
+
+static inline SerdecDeserializer serdec_msgpack_deserializer_generic(
+    SerdecMsgpackDeserializer* deser)
+{
+    return (SerdecDeserializer){
+        .ops=&SERDEC_MSGPACK_DESERIALIZER_OPS, .codec=deser,
+    };
+}
+
+#endif // SERDEC_MSGPACK_H
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,700 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            number-ops.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Implementation of numeric formatting.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#define _GNU_SOURCE // For strtod_l(3)
+
+#include <errno.h>
+#include <locale.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <serdec/number-ops.h>
+
+static const char DIGIT_PAIRS[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// Every power of ten which fits in 64 bits. Grisu2 scales its bounds by ten for
+// each fractional digit it generates, which can be up to 19 of them.
+#define POWERS_OF_TEN_COUNT 20
+static const uint64_t POWERS_OF_TEN[POWERS_OF_TEN_COUNT] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+    10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+    100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL,
+    1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+    1000000000000000000ULL, 10000000000000000000ULL,
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Grisu2
+////
+
+// The implementation follows Florian Loitsch, "Printing Floating-Point Numbers
+// Quickly and Accurately with Integers" (PLDI 2010).
+
+typedef struct DiyFp {
+    uint64_t f;
+    int e;
+} DiyFp;
+
+static const uint64_t DOUBLE_EXPONENT_MASK = 0x7ff0000000000000ULL;
+static const uint64_t DOUBLE_SIGNIFICAND_MASK = 0x000fffffffffffffULL;
+static const uint64_t DOUBLE_HIDDEN_BIT = 0x0010000000000000ULL;
+static const int DOUBLE_SIGNIFICAND_SIZE = 52;
+static const int DOUBLE_EXPONENT_BIAS = 0x3ff + 52;
+
+// Normalized 64-bit approximations of 10^-348, 10^-340, ..., 10^340.
+static const DiyFp CACHED_POWERS[] = {
+    {0xfa8fd5a0081c0288, -1220}, // 1e-348
+    {0xbaaee17fa23ebf76, -1193}, // 1e-340
+    {0x8b16fb203055ac76, -1166}, // 1e-332
+    {0xcf42894a5dce35ea, -1140}, // 1e-324
+    {0x9a6bb0aa55653b2d, -1113}, // 1e-316
+    {0xe61acf033d1a45df, -1087}, // 1e-308
+    {0xab70fe17c79ac6ca, -1060}, // 1e-300
+    {0xff77b1fcbebcdc4f, -1034}, // 1e-292
+    {0xbe5691ef416bd60c, -1007}, // 1e-284
+    {0x8dd01fad907ffc3c, -980}, // 1e-276
+    {0xd3515c2831559a83, -954}, // 1e-268
+    {0x9d71ac8fada6c9b5, -927}, // 1e-260
+    {0xea9c227723ee8bcb, -901}, // 1e-252
+    {0xaecc49914078536d, -874}, // 1e-244
+    {0x823c12795db6ce57, -847}, // 1e-236
+    {0xc21094364dfb5637, -821}, // 1e-228
+    {0x9096ea6f3848984f, -794}, // 1e-220
+    {0xd77485cb25823ac7, -768}, // 1e-212
+    {0xa086cfcd97bf97f4, -741}, // 1e-204
+    {0xef340a98172aace5, -715}, // 1e-196
+    {0xb23867fb2a35b28e, -688}, // 1e-188
+    {0x84c8d4dfd2c63f3b, -661}, // 1e-180
+    {0xc5dd44271ad3cdba, -635}, // 1e-172
+    {0x936b9fcebb25c996, -608}, // 1e-164
+    {0xdbac6c247d62a584, -582}, // 1e-156
+    {0xa3ab66580d5fdaf6, -555}, // 1e-148
+    {0xf3e2f893dec3f126, -529}, // 1e-140
+    {0xb5b5ada8aaff80b8, -502}, // 1e-132
+    {0x87625f056c7c4a8b, -475}, // 1e-124
+    {0xc9bcff6034c13053, -449}, // 1e-116
+    {0x964e858c91ba2655, -422}, // 1e-108
+    {0xdff9772470297ebd, -396}, // 1e-100
+    {0xa6dfbd9fb8e5b88f, -369}, // 1e-92
+    {0xf8a95fcf88747d94, -343}, // 1e-84
+    {0xb94470938fa89bcf, -316}, // 1e-76
+    {0x8a08f0f8bf0f156b, -289}, // 1e-68
+    {0xcdb02555653131b6, -263}, // 1e-60
+    {0x993fe2c6d07b7fac, -236}, // 1e-52
+    {0xe45c10c42a2b3b06, -210}, // 1e-44
+    {0xaa242499697392d3, -183}, // 1e-36
+    {0xfd87b5f28300ca0e, -157}, // 1e-28
+    {0xbce5086492111aeb, -130}, // 1e-20
+    {0x8cbccc096f5088cc, -103}, // 1e-12
+    {0xd1b71758e219652c, -77}, // 1e-4
+    {0x9c40000000000000, -50}, // 1e4
+    {0xe8d4a51000000000, -24}, // 1e12
+    {0xad78ebc5ac620000, 3}, // 1e20
+    {0x813f3978f8940984, 30}, // 1e28
+    {0xc097ce7bc90715b3, 56}, // 1e36
+    {0x8f7e32ce7bea5c70, 83}, // 1e44
+    {0xd5d238a4abe98068, 109}, // 1e52
+    {0x9f4f2726179a2245, 136}, // 1e60
+    {0xed63a231d4c4fb27, 162}, // 1e68
+    {0xb0de65388cc8ada8, 189}, // 1e76
+    {0x83c7088e1aab65db, 216}, // 1e84
+    {0xc45d1df942711d9a, 242}, // 1e92
+    {0x924d692ca61be758, 269}, // 1e100
+    {0xda01ee641a708dea, 295}, // 1e108
+    {0xa26da3999aef774a, 322}, // 1e116
+    {0xf209787bb47d6b85, 348}, // 1e124
+    {0xb454e4a179dd1877, 375}, // 1e132
+    {0x865b86925b9bc5c2, 402}, // 1e140
+    {0xc83553c5c8965d3d, 428}, // 1e148
+    {0x952ab45cfa97a0b3, 455}, // 1e156
+    {0xde469fbd99a05fe3, 481}, // 1e164
+    {0xa59bc234db398c25, 508}, // 1e172
+    {0xf6c69a72a3989f5c, 534}, // 1e180
+    {0xb7dcbf5354e9bece, 561}, // 1e188
+    {0x88fcf317f22241e2, 588}, // 1e196
+    {0xcc20ce9bd35c78a5, 614}, // 1e204
+    {0x98165af37b2153df, 641}, // 1e212
+    {0xe2a0b5dc971f303a, 667}, // 1e220
+    {0xa8d9d1535ce3b396, 694}, // 1e228
+    {0xfb9b7cd9a4a7443c, 720}, // 1e236
+    {0xbb764c4ca7a44410, 747}, // 1e244
+    {0x8bab8eefb6409c1a, 774}, // 1e252
+    {0xd01fef10a657842c, 800}, // 1e260
+    {0x9b10a4e5e9913129, 827}, // 1e268
+    {0xe7109bfba19c0c9d, 853}, // 1e276
+    {0xac2820d9623bf429, 880}, // 1e284
+    {0x80444b5e7aa7cf85, 907}, // 1e292
+    {0xbf21e44003acdd2d, 933}, // 1e300
+    {0x8e679c2f5e44ff8f, 960}, // 1e308
+    {0xd433179d9c8cb841, 986}, // 1e316
+    {0x9e19db92b4e31ba9, 1013}, // 1e324
+    {0xeb96bf6ebadf77d9, 1039}, // 1e332
+    {0xaf87023b9bf0ee6b, 1066}, // 1e340
+};
+
+static DiyFp diy_fp_from_double(double value) {
+    uint64_t bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+    int biased_exponent = (int)((bits & DOUBLE_EXPONENT_MASK)
+        >> DOUBLE_SIGNIFICAND_SIZE);
+    uint64_t significand = bits & DOUBLE_SIGNIFICAND_MASK;
+    if (0 != biased_exponent) {
+        return (DiyFp){significand + DOUBLE_HIDDEN_BIT,
+            biased_exponent - DOUBLE_EXPONENT_BIAS};
+    }
+    return (DiyFp){significand, 1 - DOUBLE_EXPONENT_BIAS};
+}
+
+// The upper 64 bits of the 128-bit product, rounded.
+static DiyFp diy_fp_multiply(DiyFp x, DiyFp y) {
+    const uint64_t mask = 0xffffffffULL;
+    uint64_t a = x.f >> 32, b = x.f & mask;
+    uint64_t c = y.f >> 32, d = y.f & mask;
+    uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+    uint64_t middle = (bd >> 32) + (ad & mask) + (bc & mask);
+    middle += 1ULL << 31;
+    return (DiyFp){ac + (ad >> 32) + (bc >> 32) + (middle >> 32),
+        x.e + y.e + 64};
+}
+
+static DiyFp diy_fp_normalize(DiyFp value) {
+    int shift = __builtin_clzll(value.f);
+    return (DiyFp){value.f << shift, value.e - shift};
+}
+
+// Compute the boundaries m- and m+ of <value>, with the same exponent.
+static void normalized_boundaries(DiyFp value, DiyFp* minus, DiyFp* plus) {
+    DiyFp upper = diy_fp_normalize((DiyFp){(value.f << 1) + 1, value.e - 1});
+    DiyFp lower = {(value.f << 1) - 1, value.e - 1};
+    if (DOUBLE_HIDDEN_BIT == value.f) {
+        // The lower boundary is closer for powers of two
+        lower = (DiyFp){(value.f << 2) - 1, value.e - 2};
+    }
+
+    lower.f <<= lower.e - upper.e;
+    lower.e = upper.e;
+    *minus = lower;
+    *plus = upper;
+}
+
+// Find a cached power c = 10^-k such that the exponent of <e> * c lands in
+// the range Grisu needs. Write k to <decimal_exponent>.
+static DiyFp cached_power(int e, int* decimal_exponent) {
+    double estimate = (-61 - e) * 0.30102999566398114 + 347;
+    int k = (int)estimate;
+    if (estimate - k > 0.0) {
+        k += 1;
+    }
+
+    unsigned index = (unsigned)((k >> 3) + 1);
+    *decimal_exponent = -(-348 + (int)index * 8);
+    return CACHED_POWERS[index];
+}
+
+static void grisu_round(char* buffer, size_t length, uint64_t delta,
+    uint64_t rest, uint64_t ten_kappa, uint64_t wp_w)
+{
+    while (rest < wp_w && delta - rest >= ten_kappa &&
+        (rest + ten_kappa < wp_w || wp_w - rest > rest + ten_kappa - wp_w)) {
+        buffer[length - 1] -= 1;
+        rest += ten_kappa;
+    }
+}
+
+static unsigned count_digits(uint32_t value) {
+    unsigned digits = 1;
+    while (digits < 10 && value >= POWERS_OF_TEN[digits]) {
+        digits += 1;
+    }
+    return digits;
+}
+
+static size_t digit_gen(DiyFp w, DiyFp mp, uint64_t delta, char* buffer,
+    int* decimal_exponent)
+{
+    DiyFp one = {1ULL << -mp.e, mp.e};
+    uint64_t wp_w = mp.f - w.f;
+    uint32_t p1 = (uint32_t)(mp.f >> -one.e);
+    uint64_t p2 = mp.f & (one.f - 1);
+    int kappa = (int)count_digits(p1);
+    size_t length = 0;
+
+    while (0 < kappa) {
+        uint32_t divisor = (uint32_t)POWERS_OF_TEN[kappa - 1];
+        uint32_t digit = p1 / divisor;
+        p1 %= divisor;
+        if (digit || length) {
+            buffer[length++] = (char)('0' + digit);
+        }
+
+        kappa -= 1;
+        uint64_t rest = ((uint64_t)p1 << -one.e) + p2;
+        if (rest <= delta) {
+            *decimal_exponent += kappa;
+            grisu_round(buffer, length, delta, rest,
+                POWERS_OF_TEN[kappa] << -one.e, wp_w);
+            return length;
+        }
+    }
+
+    for (;;) {
+        p2 *= 10;
+        delta *= 10;
+        char digit = (char)(p2 >> -one.e);
+        if (digit || length) {
+            buffer[length++] = (char)('0' + digit);
+        }
+
+        p2 &= one.f - 1;
+        kappa -= 1;
+        if (p2 < delta) {
+            *decimal_exponent += kappa;
+            grisu_round(buffer, length, delta, p2, one.f,
+                -kappa < POWERS_OF_TEN_COUNT ? wp_w * POWERS_OF_TEN[-kappa]
+                : 0);
+            return length;
+        }
+    }
+}
+
+// Write the digits of positive, finite, non-zero <value> to <buffer>, such
+// that value = digits * 10^decimal_exponent.
+static size_t grisu2(double value, char* buffer, int* decimal_exponent) {
+    DiyFp v = diy_fp_from_double(value);
+    DiyFp minus, plus;
+    normalized_boundaries(v, &minus, &plus);
+
+    DiyFp c_mk = cached_power(plus.e, decimal_exponent);
+    DiyFp w = diy_fp_multiply(diy_fp_normalize(v), c_mk);
+    DiyFp wp = diy_fp_multiply(plus, c_mk);
+    DiyFp wm = diy_fp_multiply(minus, c_mk);
+    wm.f += 1;
+    wp.f -= 1;
+    return digit_gen(w, wp, wp.f - wm.f, buffer, decimal_exponent);
+}
+
+static size_t format_exponent(char* buffer, int exponent) {
+    size_t length = 0;
+    buffer[length++] = 'e';
+    if (0 > exponent) {
+        buffer[length++] = '-';
+        exponent = -exponent;
+    } else {
+        buffer[length++] = '+';
+    }
+    return length + format_uint64(buffer + length, (uint64_t)exponent);
+}
+
+// Lay out <length> digits with decimal exponent <exponent> in place.
+static size_t prettify(char* buffer, size_t length, int exponent) {
+    int point = (int)length + exponent; // Position of the decimal point
+
+    if (0 <= exponent && point <= 17) {
+        // 1234e3 -> 1234000.0
+        memset(buffer + length, '0', exponent);
+        memcpy(buffer + point, ".0", 2);
+        return point + 2;
+    } else if (0 < point && point <= 17) {
+        // 1234e-2 -> 12.34
+        memmove(buffer + point + 1, buffer + point, length - point);
+        buffer[point] = '.';
+        return length + 1;
+    } else if (-6 < point && point <= 0) {
+        // 1234e-6 -> 0.001234
+        size_t offset = 2 - point;
+        memmove(buffer + offset, buffer, length);
+        buffer[0] = '0';
+        buffer[1] = '.';
+        memset(buffer + 2, '0', -point);
+        return length + offset;
+    } else if (1 == length) {
+        // 1e30 -> 1.0e+30
+        memcpy(buffer + 1, ".0", 2);
+        return 3 + format_exponent(buffer + 3, point - 1);
+    }
+
+    // 1234e30 -> 1.234e+33
+    memmove(buffer + 2, buffer + 1, length - 1);
+    buffer[1] = '.';
+    return length + 1 + format_exponent(buffer + length + 1, point - 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Decimal Parsing
+////
+
+static uint64_t load_eight_bytes(const char* string) {
+    uint64_t value = 0;
+    memcpy(&value, string, sizeof(value));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap64(value);
+#endif
+    return value;
+}
+
+// Whether all eight bytes of <value> are ASCII digits.
+static bool is_eight_digits(uint64_t value) {
+    return !(((value & 0xf0f0f0f0f0f0f0f0ULL) |
+            (((value + 0x0606060606060606ULL) & 0xf0f0f0f0f0f0f0f0ULL) >> 4))
+        ^ 0x3333333333333333ULL);
+}
+
+// Convert eight ASCII digits, in memory order, to their value with three
+// multiplications.
+static uint32_t parse_eight_digits(uint64_t value) {
+    const uint64_t mask = 0x000000ff000000ffULL;
+    const uint64_t multiplier1 = 100 + (1000000ULL << 32);
+    const uint64_t multiplier2 = 1 + (10000ULL << 32);
+    value -= 0x3030303030303030ULL;
+    value = (value * 10) + (value >> 8);
+    value = ((value & mask) * multiplier1 +
+        ((value >> 16) & mask) * multiplier2) >> 32;
+    return (uint32_t)value;
+}
+
+static bool is_digit(char character) {
+    return '0' <= character && character <= '9';
+}
+
+// Parse the digits in [string, end) into <value>. Every character must be a
+// digit, and there must be at least one.
+static NumberParseResult parse_digits(const char* string, const char* end,
+    uint64_t* value)
+{
+    if (string == end) {
+        return NUMBER_INVALID;
+    }
+
+    uint64_t result = 0;
+    bool overflow = false;
+    while (8 <= end - string && is_eight_digits(load_eight_bytes(string))) {
+        uint32_t digits = parse_eight_digits(load_eight_bytes(string));
+        if (result > (UINT64_MAX - digits) / 100000000) {
+            overflow = true;
+        }
+        result = result * 100000000 + digits;
+        string += 8;
+    }
+
+    for (; string < end; ++string) {
+        if (!is_digit(*string)) {
+            return NUMBER_INVALID;
+        }
+
+        unsigned digit = (unsigned)(*string - '0');
+        if (result > (UINT64_MAX - digit) / 10) {
+            overflow = true;
+        }
+        result = result * 10 + digit;
+    }
+
+    *value = result;
+    return overflow ? NUMBER_OUT_OF_RANGE : NUMBER_OK;
+}
+
+static const double EXACT_POWERS_OF_TEN[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13,
+    1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+static bool matches_ignoring_case(const char* string, size_t length,
+    const char* lower, const char* title, const char* upper)
+{
+    return !strncmp(string, lower, length) || !strncmp(string, title, length)
+        || !strncmp(string, upper, length);
+}
+
+static locale_t c_locale() {
+    static locale_t locale = (locale_t)0;
+    locale_t current = __atomic_load_n(&locale, __ATOMIC_ACQUIRE);
+    if ((locale_t)0 != current) {
+        return current;
+    }
+
+    locale_t created = newlocale(LC_ALL_MASK, "C", (locale_t)0);
+    if (!__atomic_compare_exchange_n(&locale, &current, created, false,
+            __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        freelocale(created); // Another thread won the race
+        return current;
+    }
+    return created;
+}
+
+// Correctly rounded conversion for the inputs the fast path can't handle.
+static NumberParseResult parse_double_slow(const char* string, size_t length,
+    double* value)
+{
+    char stack_buffer[128];
+    char* buffer = stack_buffer;
+    if (length >= sizeof(stack_buffer)) {
+        buffer = malloc(length + 1);
+        if (NULL == buffer) {
+            return NUMBER_INVALID;
+        }
+    }
+
+    memcpy(buffer, string, length);
+    buffer[length] = '\0';
+    errno = 0;
+    double result = strtod_l(buffer, NULL, c_locale());
+    bool overflow = ERANGE == errno && isinf(result);
+    if (buffer != stack_buffer) {
+        free(buffer);
+    }
+
+    if (overflow) {
+        return NUMBER_OUT_OF_RANGE;
+    }
+    *value = result;
+    return NUMBER_OK;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Public API
+////
+
+size_t format_uint64(char* buffer, uint64_t value) {
+    char digits[20];
+    char* start = digits + sizeof(digits);
+    while (100 <= value) {
+        unsigned pair = (unsigned)(value % 100) * 2;
+        value /= 100;
+        start -= 2;
+        memcpy(start, DIGIT_PAIRS + pair, 2);
+    }
+
+    if (10 <= value) {
+        start -= 2;
+        memcpy(start, DIGIT_PAIRS + value * 2, 2);
+    } else {
+        *--start = (char)('0' + value);
+    }
+
+    size_t length = digits + sizeof(digits) - start;
+    memcpy(buffer, start, length);
+    return length;
+}
+
+size_t format_int64(char* buffer, int64_t value) {
+    if (0 > value) {
+        *buffer = '-';
+        return 1 + format_uint64(buffer + 1, 0 - (uint64_t)value);
+    }
+    return format_uint64(buffer, (uint64_t)value);
+}
+
+NumberParseResult parse_uint64(const char* string, size_t length,
+    uint64_t* value)
+{
+    if (0 < length && '+' == *string) {
+        string += 1;
+        length -= 1;
+    }
+    return parse_digits(string, string + length, value);
+}
+
+NumberParseResult parse_int64(const char* string, size_t length,
+    int64_t* value)
+{
+    bool negative = false;
+    if (0 < length && ('+' == *string || '-' == *string)) {
+        negative = '-' == *string;
+        string += 1;
+        length -= 1;
+    }
+
+    uint64_t magnitude = 0;
+    NumberParseResult result = parse_digits(string, string + length,
+        &magnitude);
+    if (NUMBER_OK != result) {
+        return result;
+    }
+
+    if (negative) {
+        if (magnitude > (uint64_t)INT64_MAX + 1) {
+            return NUMBER_OUT_OF_RANGE;
+        }
+        *value = (int64_t)(0 - magnitude);
+    } else {
+        if (magnitude > (uint64_t)INT64_MAX) {
+            return NUMBER_OUT_OF_RANGE;
+        }
+        *value = (int64_t)magnitude;
+    }
+    return NUMBER_OK;
+}
+
+NumberParseResult parse_double(const char* string, size_t length,
+    double* value)
+{
+    const char* end = string + length;
+    const char* cursor = string;
+    bool negative = false;
+    if (cursor < end && ('+' == *cursor || '-' == *cursor)) {
+        negative = '-' == *cursor;
+        cursor += 1;
+    }
+
+    size_t remaining = end - cursor;
+    if (4 == remaining && matches_ignoring_case(cursor, 4, ".inf", ".Inf",
+            ".INF")) {
+        *value = negative ? -INFINITY : INFINITY;
+        return NUMBER_OK;
+    } else if (4 == length && matches_ignoring_case(string, 4, ".nan",
+            ".NaN", ".NAN")) {
+        *value = NAN;
+        return NUMBER_OK;
+    }
+
+    // Accumulate up to 19 significant digits. Any more only matter to the
+    // slow path.
+    uint64_t mantissa = 0;
+    int significant_digits = 0;
+    int exponent = 0;
+    bool any_digits = false;
+    bool truncated = false;
+    for (; cursor < end && is_digit(*cursor); ++cursor) {
+        any_digits = true;
+        if (0 == mantissa && '0' == *cursor) {
+            continue;
+        } else if (19 > significant_digits) {
+            mantissa = mantissa * 10 + (unsigned)(*cursor - '0');
+            significant_digits += 1;
+        } else {
+            exponent += 1;
+            truncated = truncated || '0' != *cursor;
+        }
+    }
+
+    if (cursor < end && '.' == *cursor) {
+        cursor += 1;
+        for (; cursor < end && is_digit(*cursor); ++cursor) {
+            any_digits = true;
+            if (0 == mantissa && '0' == *cursor) {
+                exponent -= 1;
+            } else if (19 > significant_digits) {
+                mantissa = mantissa * 10 + (unsigned)(*cursor - '0');
+                significant_digits += 1;
+                exponent -= 1;
+            } else {
+                truncated = truncated || '0' != *cursor;
+            }
+        }
+    }
+
+    if (!any_digits) {
+        return NUMBER_INVALID;
+    }
+
+    if (cursor < end && ('e' == *cursor || 'E' == *cursor)) {
+        cursor += 1;
+        bool negative_exponent = false;
+        if (cursor < end && ('+' == *cursor || '-' == *cursor)) {
+            negative_exponent = '-' == *cursor;
+            cursor += 1;
+        }
+
+        if (cursor == end) {
+            return NUMBER_INVALID;
+        }
+
+        int explicit_exponent = 0;
+        for (; cursor < end && is_digit(*cursor); ++cursor) {
+            if (100000 > explicit_exponent) {
+                explicit_exponent = explicit_exponent * 10 + (*cursor - '0');
+            }
+        }
+        exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+    }
+
+    if (cursor != end) {
+        return NUMBER_INVALID;
+    }
+
+    // Clinger's fast path: when the mantissa and the power of ten are both
+    // exactly representable, one IEEE operation is correctly rounded.
+    if (!truncated && mantissa <= (1ULL << 53) && -22 <= exponent &&
+        exponent <= 22) {
+        double result = (double)mantissa;
+        if (0 > exponent) {
+            result /= EXACT_POWERS_OF_TEN[-exponent];
+        } else {
+            result *= EXACT_POWERS_OF_TEN[exponent];
+        }
+        *value = negative ? -result : result;
+        return NUMBER_OK;
+    } else if (0 == mantissa) {
+        *value = negative ? -0.0 : 0.0;
+        return NUMBER_OK;
+    }
+
+    return parse_double_slow(string, length, value);
+}
+
+size_t format_double(char* buffer, double value) {
+    if (isnan(value)) {
+        memcpy(buffer, ".nan", 4);
+        return 4;
+    }
+
+    size_t length = 0;
+    if (signbit(value)) {
+        buffer[length++] = '-';
+        value = -value;
+    }
+
+    if (isinf(value)) {
+        memcpy(buffer + length, ".inf", 4);
+        return length + 4;
+    } else if (0.0 == value) {
+        memcpy(buffer + length, "0.0", 3);
+        return length + 3;
+    }
+
+    int exponent = 0;
+    size_t digits = grisu2(value, buffer + length, &exponent);
+    return length + prettify(buffer + length, digits, exponent);
+}
+
+///////////////////////////////////////////////////////////////////////////////
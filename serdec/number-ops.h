@@ -0,0 +1,76 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            number-ops.h
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Header of numeric formatting for codec convenience.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#ifndef SERDEC_NUMBER_OPS_H
+#define SERDEC_NUMBER_OPS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Large enough for any value produced by the formatting routines below. They
+// do not NUL-terminate their output.
+#define NUMBER_BUFFER_SIZE 32
+
+// Format an integer in decimal, exactly as printf(3) would with "%d" and
+// friends. Return the number of characters written.
+size_t format_uint64(char* buffer, uint64_t value);
+size_t format_int64(char* buffer, int64_t value);
+
+// Format a double as a YAML 1.1 float, using a digit string which reads back
+// to the same value (Grisu2). This is usually the shortest such string, but
+// for a small fraction of values it's one digit longer: 1e23 is written as
+// 9.999999999999999e+22. Integral values keep a ".0", and exponents are always
+// signed, so the result is never mistaken for an int.
+// Infinities and NaN are written as .inf, -.inf and .nan.
+size_t format_double(char* buffer, double value);
+
+typedef enum NumberParseResult {
+    NUMBER_OK,
+    NUMBER_INVALID,
+    NUMBER_OUT_OF_RANGE,
+} NumberParseResult;
+
+// Parse exactly <length> characters of <string> as a base-10 integer, with an
+// optional sign. No other characters (including whitespace) are permitted.
+NumberParseResult parse_int64(const char* string, size_t length,
+    int64_t* value);
+NumberParseResult parse_uint64(const char* string, size_t length,
+    uint64_t* value);
+
+// Parse exactly <length> characters of <string> as a YAML float, including
+// .inf and .nan. The result is independent of the current locale.
+NumberParseResult parse_double(const char* string, size_t length,
+    double* value);
+
+#endif // SERDEC_NUMBER_OPS_H
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,150 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            push-input.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Buffering of pushed input into complete documents
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <string.h>
+
+#include <serdec/push-input.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// Private API
+////
+
+// Whether the line consists of the three-character document <marker>, and
+// (optionally) whitespace or other content separated from it.
+static bool is_marker(const char* line, size_t length, const char* marker) {
+    return 3 <= length && !memcmp(line, marker, 3) &&
+        (3 == length || ' ' == line[3] || '\t' == line[3] ||
+            '\r' == line[3]);
+}
+
+// Whether the line is blank, or contains only a comment.
+static bool is_blank(const char* line, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        if ('#' == line[i]) {
+            return true;
+        } else if (' ' != line[i] && '\t' != line[i] && '\r' != line[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Public API
+////
+
+size_t document_scan_next(DocumentScan* scan, const char* data, size_t length,
+    bool finished)
+{
+    while (scan->scanned < length) {
+        const char* line = data + scan->scanned;
+        const char* newline = memchr(line, '\n', length - scan->scanned);
+        if (NULL == newline && !finished) {
+            return DOCUMENT_SCAN_INCOMPLETE;
+        }
+
+        size_t line_length = NULL != newline ? (size_t)(newline - line)
+            : length - scan->scanned;
+        size_t line_start = scan->scanned;
+        size_t next = NULL != newline ? line_start + line_length + 1 : length;
+        if (is_marker(line, line_length, "---")) {
+            // This line begins the next document. It's scanned again by the
+            // scan for that document.
+            if (scan->content) {
+                return line_start;
+            }
+            scan->content = true;
+        } else if (is_marker(line, line_length, "...")) {
+            if (scan->content) {
+                scan->scanned = next;
+                return next;
+            }
+
+            // libyaml rejects a stream which begins with "...", and there's
+            // nothing before it to end, so it's dropped.
+            scan->start = next;
+        } else if (!scan->content && (0 == line_length || '%' != line[0]) &&
+            !is_blank(line, line_length)) {
+            scan->content = true;
+        }
+        scan->scanned = next;
+    }
+    return finished ? length : DOCUMENT_SCAN_INCOMPLETE;
+}
+
+void push_input_init(PushInput* input, const SerdecAllocator* allocator) {
+    memset(input, 0, sizeof(*input));
+    string_buffer_init(&input->document, allocator);
+    string_buffer_init(&input->pending, allocator);
+}
+
+void push_input_release(PushInput* input) {
+    string_buffer_release(&input->document);
+    string_buffer_release(&input->pending);
+}
+
+int push_input_append(PushInput* input, const char* data, size_t length) {
+    return string_buffer_append(&input->pending, data, length);
+}
+
+PushResult push_input_next(PushInput* input, const char** document,
+    size_t* length)
+{
+    size_t boundary = document_scan_next(&input->scan, input->pending.string,
+        input->pending.length, input->finished);
+    if (DOCUMENT_SCAN_INCOMPLETE == boundary) {
+        return PUSH_NEED_MORE_DATA;
+    } else if (input->scan.start >= boundary) {
+        return PUSH_END_OF_STREAM;
+    }
+
+    // The pending buffer becomes the document, so only the input which
+    // follows the document is copied.
+    size_t remainder = input->pending.length - boundary;
+    string_buffer_clear(&input->document);
+    if (string_buffer_reserve(&input->document, remainder)) {
+        return PUSH_ERROR;
+    }
+
+    StringBuffer taken = input->pending;
+    input->pending = input->document;
+    input->document = taken;
+    string_buffer_append(&input->pending, taken.string + boundary, remainder);
+    input->document.length = boundary;
+
+    *document = taken.string + input->scan.start;
+    *length = boundary - input->scan.start;
+    memset(&input->scan, 0, sizeof(input->scan));
+    return PUSH_DOCUMENT;
+}
+
+///////////////////////////////////////////////////////////////////////////////
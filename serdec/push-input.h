@@ -0,0 +1,109 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            push-input.h
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Buffering of pushed input into complete documents
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#ifndef SERDEC_PUSH_INPUT_H
+#define SERDEC_PUSH_INPUT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <serdec/allocator.h>
+#include <serdec/string-ops.h>
+
+// Input which is pushed to a de-serializer in arbitrary chunks is collected
+// here until a complete document is available. Documents are delimited by the
+// "---" and "..." markers, which YAML only permits at the start of a line, so
+// the input can be split without parsing it.
+
+typedef enum PushResult {
+    PUSH_DOCUMENT,
+    PUSH_NEED_MORE_DATA,
+    PUSH_END_OF_STREAM,
+    PUSH_ERROR,
+} PushResult;
+
+// The state of a scan for the end of a document. Lines before <scanned> have
+// been checked for markers, and the document begins at <start>.
+typedef struct DocumentScan {
+    size_t start;
+    size_t scanned;
+
+    // Whether the document contains anything but directives, blank lines and
+    // comments.
+    bool content;
+} DocumentScan;
+
+// Returned by document_scan_next() while the end of the document is unknown.
+#define DOCUMENT_SCAN_INCOMPLETE SIZE_MAX
+
+typedef struct PushInput {
+    // The document which was returned by the last call to _next().
+    StringBuffer document;
+
+    // Input which has been pushed, but not yet returned, and the scan for
+    // the end of the pending document within it.
+    StringBuffer pending;
+    DocumentScan scan;
+
+    // Set once the end of the input has been signaled.
+    bool finished;
+
+    // Set while the parser is reading the current document.
+    bool parsing;
+} PushInput;
+
+// Scan the lines of <data> which haven't been scanned yet, and return the
+// offset at which the document ends. If <finished> is false, the last line is
+// only scanned once it's complete, and DOCUMENT_SCAN_INCOMPLETE is returned if
+// the end hasn't been found. Otherwise, the document ends with the data. The
+// next document is found by a new scan, which starts at the returned offset.
+size_t document_scan_next(DocumentScan* scan, const char* data, size_t length,
+    bool finished);
+
+void push_input_init(PushInput* input, const SerdecAllocator* allocator);
+void push_input_release(PushInput* input);
+
+// Add <length> bytes to the pending input. Return non-zero if allocation
+// fails.
+int push_input_append(PushInput* input, const char* data, size_t length);
+
+// Make the next complete document the current one, and return it in
+// <document> and <length>. It remains valid until the next call, regardless
+// of any input appended in the meantime. The document may be empty of nodes
+// (e.g. trailing comments at the end of the input).
+PushResult push_input_next(PushInput* input, const char** document,
+    size_t* length);
+
+#endif // SERDEC_PUSH_INPUT_H
+
+///////////////////////////////////////////////////////////////////////////////
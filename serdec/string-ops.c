@@ -7,7 +7,7 @@
 //
 // CREATED:         02/04/2022
 //
-// LAST EDITED:     02/05/2022
+// LAST EDITED:     10/14/2026
 //
 // Copyright 2022, Ethan D. Twardy
 //
@@ -30,25 +30,99 @@
 // IN THE SOFTWARE.
 ////
 
-#include <stdlib.h>
+#include <errno.h>
+#include <stdint.h>
 #include <string.h>
 
+#include <serdec/allocator-ops.h>
 #include <serdec/string-ops.h>
 
+static const size_t STRING_BUFFER_MINIMUM_CAPACITY = 64;
+
 ///////////////////////////////////////////////////////////////////////////////
 // Public API
 ////
 
-char* string_append_new_with_length(char* restrict string,
-    const char* restrict buffer, size_t length)
+void string_buffer_init(StringBuffer* buffer,
+    const SerdecAllocator* allocator)
+{
+    buffer->string = NULL;
+    buffer->length = 0;
+    buffer->capacity = 0;
+    buffer->allocator = allocator;
+}
+
+int string_buffer_reserve(StringBuffer* buffer, size_t length) {
+    if (length >= SIZE_MAX - buffer->length) {
+        errno = ENOMEM;
+        return -1;
+    }
+
+    size_t required = buffer->length + length + 1;
+    if (required <= buffer->capacity) {
+        return 0;
+    }
+
+    size_t capacity = buffer->capacity;
+    if (capacity < STRING_BUFFER_MINIMUM_CAPACITY) {
+        capacity = STRING_BUFFER_MINIMUM_CAPACITY;
+    }
+    while (capacity < required) {
+        if (capacity > SIZE_MAX / 2) {
+            capacity = required;
+            break;
+        }
+        capacity *= 2;
+    }
+
+    char* string = allocator_realloc(buffer->allocator, buffer->string,
+        capacity);
+    if (NULL == string) {
+        return -1;
+    }
+
+    string[buffer->length] = '\0';
+    buffer->string = string;
+    buffer->capacity = capacity;
+    return 0;
+}
+
+int string_buffer_append(StringBuffer* restrict buffer,
+    const char* restrict data, size_t length)
 {
-    size_t new_length = strlen(string) + length + 1;
-    char* result = malloc(new_length);
-    memset(result, 0, new_length);
-    strcat(result, string);
-    strncat(result, buffer, length);
-    free(string);
-    return result;
+    if (string_buffer_reserve(buffer, length)) {
+        return -1;
+    }
+
+    memcpy(buffer->string + buffer->length, data, length);
+    buffer->length += length;
+    buffer->string[buffer->length] = '\0';
+    return 0;
+}
+
+char* string_buffer_take(StringBuffer* buffer, size_t* length) {
+    if (NULL == buffer->string && string_buffer_reserve(buffer, 0)) {
+        return NULL;
+    }
+
+    char* string = buffer->string;
+    if (NULL != length) {
+        *length = buffer->length;
+    }
+    string_buffer_init(buffer, buffer->allocator);
+    return string;
+}
+
+void string_buffer_clear(StringBuffer* buffer) {
+    buffer->length = 0;
+    if (NULL != buffer->string) {
+        buffer->string[0] = '\0';
+    }
+}
+
+void string_buffer_release(StringBuffer* buffer) {
+    allocator_free(buffer->allocator, buffer->string);
+    string_buffer_init(buffer, buffer->allocator);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
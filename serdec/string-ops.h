@@ -7,7 +7,7 @@
 //
 // CREATED:         02/04/2022
 //
-// LAST EDITED:     02/04/2022
+// LAST EDITED:     10/14/2026
 //
 // Copyright 2022, Ethan D. Twardy
 //
@@ -35,8 +35,40 @@
 
 #include <stddef.h>
 
-char* string_append_new_with_length(char* restrict string,
-    const char* restrict buffer, size_t length);
+#include <serdec/allocator.h>
+
+// A length-tracking string buffer which grows geometrically. Once anything
+// has been appended, <string> is always NUL-terminated.
+typedef struct StringBuffer {
+    char* string;
+    size_t length;
+    size_t capacity;
+    const SerdecAllocator* allocator;
+} StringBuffer;
+
+// Initialize an empty string buffer, which allocates from <allocator>. This
+// does not allocate.
+void string_buffer_init(StringBuffer* buffer,
+    const SerdecAllocator* allocator);
+
+// Ensure that at least <length> more bytes (plus the NUL terminator) can be
+// appended without reallocating. Return non-zero if allocation fails.
+int string_buffer_reserve(StringBuffer* buffer, size_t length);
+
+// Append <length> bytes from <data>. Return non-zero if allocation fails.
+int string_buffer_append(StringBuffer* restrict buffer,
+    const char* restrict data, size_t length);
+
+// Hand the allocated string (and its length) to the caller, who must free it
+// with the buffer's allocator. The buffer is left empty. Return NULL if
+// allocation fails.
+char* string_buffer_take(StringBuffer* buffer, size_t* length);
+
+// Empty the buffer, but keep its memory for re-use.
+void string_buffer_clear(StringBuffer* buffer);
+
+// Release the memory held by the buffer.
+void string_buffer_release(StringBuffer* buffer);
 
 #endif // SERDEC_STRING_OPS_H
 
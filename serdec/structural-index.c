@@ -0,0 +1,305 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            structural-index.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Bitmap of the bytes which may be structural in YAML input
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define STRUCTURAL_INDEX_X86
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define STRUCTURAL_INDEX_NEON
+#endif
+
+#include <serdec/allocator-ops.h>
+#include <serdec/structural-index.h>
+
+#define BLOCK_SIZE 64
+
+///////////////////////////////////////////////////////////////////////////////
+// Private API
+////
+
+// Every kernel classifies bytes the same way. Line breaks are compared
+// exactly, but the other characters are compared with bit 5 set, which
+// halves the number of comparisons for the brackets: '[' and '{', ']' and
+// '}', and '\' and '|' only differ in that bit. It also admits a few control
+// characters, which are rare, and harmless.
+static const unsigned char FOLD = 0x20;
+static const unsigned char FOLDED[] = {
+    '"', '#', '\'', ',', ':', '{', '|', '}',
+};
+
+static bool is_candidate(unsigned char c) {
+    if ('\n' == c || '\r' == c) {
+        return true;
+    }
+
+    unsigned char folded = c | FOLD;
+    for (size_t i = 0; i < sizeof(FOLDED); ++i) {
+        if (FOLDED[i] == folded) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint64_t classify_scalar(const unsigned char* input, size_t length) {
+    uint64_t mask = 0;
+    for (size_t i = 0; i < length; ++i) {
+        mask |= (uint64_t)is_candidate(input[i]) << i;
+    }
+    return mask;
+}
+
+static void index_scalar(const unsigned char* input, size_t blocks,
+    uint64_t* bits)
+{
+    for (size_t i = 0; i < blocks; ++i) {
+        bits[i] = classify_scalar(input + i * BLOCK_SIZE, BLOCK_SIZE);
+    }
+}
+
+#if defined(STRUCTURAL_INDEX_X86) && defined(__SSE2__)
+static uint64_t classify_sse2(const unsigned char* input) {
+    uint64_t mask = 0;
+    for (int i = 0; i < BLOCK_SIZE / 16; ++i) {
+        __m128i bytes = _mm_loadu_si128((const __m128i*)(input + 16 * i));
+        __m128i folded = _mm_or_si128(bytes, _mm_set1_epi8((char)FOLD));
+        __m128i matches = _mm_or_si128(
+            _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n')),
+            _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\r')));
+        for (size_t j = 0; j < sizeof(FOLDED); ++j) {
+            matches = _mm_or_si128(matches, _mm_cmpeq_epi8(folded,
+                    _mm_set1_epi8((char)FOLDED[j])));
+        }
+        uint64_t lane = (uint16_t)_mm_movemask_epi8(matches);
+        mask |= lane << (16 * i);
+    }
+    return mask;
+}
+
+static void index_sse2(const unsigned char* input, size_t blocks,
+    uint64_t* bits)
+{
+    for (size_t i = 0; i < blocks; ++i) {
+        bits[i] = classify_sse2(input + i * BLOCK_SIZE);
+    }
+}
+#endif
+
+#if defined(STRUCTURAL_INDEX_X86)
+__attribute__((target("avx2")))
+static uint64_t classify_avx2(const unsigned char* input) {
+    uint64_t mask = 0;
+    for (int i = 0; i < BLOCK_SIZE / 32; ++i) {
+        __m256i bytes = _mm256_loadu_si256((const __m256i*)(input + 32 * i));
+        __m256i folded = _mm256_or_si256(bytes,
+            _mm256_set1_epi8((char)FOLD));
+        __m256i matches = _mm256_or_si256(
+            _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\n')),
+            _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\r')));
+        for (size_t j = 0; j < sizeof(FOLDED); ++j) {
+            matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(folded,
+                    _mm256_set1_epi8((char)FOLDED[j])));
+        }
+        uint64_t lane = (uint32_t)_mm256_movemask_epi8(matches);
+        mask |= lane << (32 * i);
+    }
+    return mask;
+}
+
+__attribute__((target("avx2")))
+static void index_avx2(const unsigned char* input, size_t blocks,
+    uint64_t* bits)
+{
+    for (size_t i = 0; i < blocks; ++i) {
+        bits[i] = classify_avx2(input + i * BLOCK_SIZE);
+    }
+}
+#endif
+
+#if defined(STRUCTURAL_INDEX_NEON)
+static uint8x16_t match_neon(uint8x16_t bytes) {
+    uint8x16_t folded = vorrq_u8(bytes, vdupq_n_u8(FOLD));
+    uint8x16_t matches = vorrq_u8(vceqq_u8(bytes, vdupq_n_u8('\n')),
+        vceqq_u8(bytes, vdupq_n_u8('\r')));
+    for (size_t j = 0; j < sizeof(FOLDED); ++j) {
+        matches = vorrq_u8(matches, vceqq_u8(folded, vdupq_n_u8(FOLDED[j])));
+    }
+    return matches;
+}
+
+// NEON has no movemask, so each byte of the matches is reduced to its bit
+// by pairwise addition.
+static uint64_t classify_neon(const unsigned char* input) {
+    static const uint8_t BITS[16] = {
+        0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+        0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+    };
+    uint8x16_t bits = vld1q_u8(BITS);
+    uint8x16_t first = vandq_u8(match_neon(vld1q_u8(input)), bits);
+    uint8x16_t second = vandq_u8(match_neon(vld1q_u8(input + 16)), bits);
+    uint8x16_t third = vandq_u8(match_neon(vld1q_u8(input + 32)), bits);
+    uint8x16_t fourth = vandq_u8(match_neon(vld1q_u8(input + 48)), bits);
+    uint8x16_t sum = vpaddq_u8(vpaddq_u8(first, second),
+        vpaddq_u8(third, fourth));
+    sum = vpaddq_u8(sum, sum);
+    return vgetq_lane_u64(vreinterpretq_u64_u8(sum), 0);
+}
+
+static void index_neon(const unsigned char* input, size_t blocks,
+    uint64_t* bits)
+{
+    for (size_t i = 0; i < blocks; ++i) {
+        bits[i] = classify_neon(input + i * BLOCK_SIZE);
+    }
+}
+#endif
+
+static StructuralKernel best_kernel() {
+    if (structural_index_supports(STRUCTURAL_KERNEL_AVX2)) {
+        return STRUCTURAL_KERNEL_AVX2;
+    } else if (structural_index_supports(STRUCTURAL_KERNEL_SSE2)) {
+        return STRUCTURAL_KERNEL_SSE2;
+    } else if (structural_index_supports(STRUCTURAL_KERNEL_NEON)) {
+        return STRUCTURAL_KERNEL_NEON;
+    }
+    return STRUCTURAL_KERNEL_SCALAR;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Public API
+////
+
+void structural_index_init(StructuralIndex* index,
+    const SerdecAllocator* allocator)
+{
+    memset(index, 0, sizeof(*index));
+    index->allocator = allocator_or_default(allocator);
+}
+
+void structural_index_release(StructuralIndex* index) {
+    allocator_free(index->allocator, index->bits);
+    index->bits = NULL;
+    index->capacity = 0;
+    index->length = 0;
+}
+
+bool structural_index_supports(StructuralKernel kernel) {
+    switch (kernel) {
+    case STRUCTURAL_KERNEL_BEST:
+    case STRUCTURAL_KERNEL_SCALAR:
+        return true;
+#if defined(STRUCTURAL_INDEX_X86) && defined(__SSE2__)
+    case STRUCTURAL_KERNEL_SSE2:
+        return true;
+#endif
+#if defined(STRUCTURAL_INDEX_X86)
+    case STRUCTURAL_KERNEL_AVX2:
+        return __builtin_cpu_supports("avx2");
+#endif
+#if defined(STRUCTURAL_INDEX_NEON)
+    case STRUCTURAL_KERNEL_NEON:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+int structural_index_build(StructuralIndex* index, const char* input,
+    size_t length, StructuralKernel kernel)
+{
+    index->length = 0;
+    size_t words = length / BLOCK_SIZE + (0 != length % BLOCK_SIZE);
+    if (words > index->capacity) {
+        uint64_t* bits = allocator_realloc(index->allocator, index->bits,
+            words * sizeof(uint64_t));
+        if (NULL == bits) {
+            return -1;
+        }
+        index->bits = bits;
+        index->capacity = words;
+    }
+
+    const unsigned char* bytes = (const unsigned char*)input;
+    size_t blocks = length / BLOCK_SIZE;
+    if (STRUCTURAL_KERNEL_BEST == kernel) {
+        kernel = best_kernel();
+    }
+
+    switch (kernel) {
+#if defined(STRUCTURAL_INDEX_X86) && defined(__SSE2__)
+    case STRUCTURAL_KERNEL_SSE2: index_sse2(bytes, blocks, index->bits); break;
+#endif
+#if defined(STRUCTURAL_INDEX_X86)
+    case STRUCTURAL_KERNEL_AVX2: index_avx2(bytes, blocks, index->bits); break;
+#endif
+#if defined(STRUCTURAL_INDEX_NEON)
+    case STRUCTURAL_KERNEL_NEON: index_neon(bytes, blocks, index->bits); break;
+#endif
+    default: index_scalar(bytes, blocks, index->bits); break;
+    }
+
+    // The bits past the end of the input are left clear.
+    if (blocks < words) {
+        index->bits[blocks] = classify_scalar(bytes + blocks * BLOCK_SIZE,
+            length % BLOCK_SIZE);
+    }
+    index->length = length;
+    return 0;
+}
+
+void structural_index_clear(StructuralIndex* index) {
+    index->length = 0;
+}
+
+size_t structural_index_next(const StructuralIndex* index, size_t offset) {
+    if (offset >= index->length) {
+        return index->length;
+    }
+
+    size_t words = index->length / BLOCK_SIZE
+        + (0 != index->length % BLOCK_SIZE);
+    size_t word = offset / BLOCK_SIZE;
+    uint64_t bits = index->bits[word] & (UINT64_MAX << (offset % BLOCK_SIZE));
+    while (0 == bits) {
+        if (++word == words) {
+            return index->length;
+        }
+        bits = index->bits[word];
+    }
+    return word * BLOCK_SIZE + (size_t)__builtin_ctzll(bits);
+}
+
+///////////////////////////////////////////////////////////////////////////////
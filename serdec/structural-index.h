@@ -0,0 +1,89 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            structural-index.h
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Bitmap of the bytes which may be structural in YAML input
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#ifndef SERDEC_STRUCTURAL_INDEX_H
+#define SERDEC_STRUCTURAL_INDEX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <serdec/allocator.h>
+
+// A structural index holds one bit for every byte of the input, which is set
+// if the byte may end a token: line breaks, quotes, backslashes, ':', '#',
+// ',' and the flow brackets. It's a superset (e.g. '|' is also set), so the
+// scanner still examines each byte the index points it to, but it can skip
+// every byte in between without looking at it. The index is built in a
+// single pass, which classifies 64 bytes at a time with SIMD where the CPU
+// supports it.
+
+// The implementations of the classification pass. STRUCTURAL_KERNEL_BEST
+// selects the fastest which the CPU supports, at runtime.
+typedef enum StructuralKernel {
+    STRUCTURAL_KERNEL_BEST,
+    STRUCTURAL_KERNEL_SCALAR,
+    STRUCTURAL_KERNEL_SSE2,
+    STRUCTURAL_KERNEL_AVX2,
+    STRUCTURAL_KERNEL_NEON,
+} StructuralKernel;
+
+typedef struct StructuralIndex {
+    uint64_t* bits;
+    size_t capacity;
+    size_t length;
+    const SerdecAllocator* allocator;
+} StructuralIndex;
+
+void structural_index_init(StructuralIndex* index,
+    const SerdecAllocator* allocator);
+void structural_index_release(StructuralIndex* index);
+
+// Whether <kernel> can be used on this CPU.
+bool structural_index_supports(StructuralKernel kernel);
+
+// Index <length> bytes of <input> with <kernel>, which must be supported. The
+// memory of a previous index is re-used. Return non-zero if allocation fails,
+// in which case the index is empty.
+int structural_index_build(StructuralIndex* index, const char* input,
+    size_t length, StructuralKernel kernel);
+
+// Empty the index, but keep its memory for re-use.
+void structural_index_clear(StructuralIndex* index);
+
+// Return the offset of the first byte at or after <offset> which may be
+// structural, or the length of the input if there is none.
+size_t structural_index_next(const StructuralIndex* index, size_t offset);
+
+#endif // SERDEC_STRUCTURAL_INDEX_H
+
+///////////////////////////////////////////////////////////////////////////////
@@ -7,7 +7,7 @@
 //
 // CREATED:         12/20/2021
 //
-// LAST EDITED:     02/06/2022
+// LAST EDITED:     10/14/2026
 //
 // Copyright 2021, Ethan D. Twardy
 //
@@ -30,209 +30,457 @@
 // IN THE SOFTWARE.
 ////
 
-#include <assert.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <yaml.h>
 
+#include <serdec/allocator-ops.h>
+#include <serdec/key-table.h>
+#include <serdec/number-ops.h>
+#include <serdec/push-input.h>
+#include <serdec/string-ops.h>
 #include <serdec/yaml.h>
 #include <serdec/yaml-error.h>
+#include <serdec/yaml-projection.h>
+#include <serdec/yaml-scanner.h>
+#include <serdec/yaml-stats.h>
+#include <serdec/yaml-tape.h>
+#include <serdec/yaml-type.h>
 
-static const char* SERDEC_YAML_ERROR_STRINGS[] = {
+// The de-serializer looks at most one event ahead of the current one.
+#define EVENT_RING_SIZE 2
+
+// Keys of at most this length are NUL-terminated on the stack, when they're
+// read by the native scanner.
+#define KEY_BUFFER_SIZE 128
+
+static const char* SERDEC_YAML_ERROR_STRINGS[SERDEC_YAML_MAX_ERROR] = {
     [SERDEC_YAML_UNKNOWN_ERROR]="unknown error in libyaml",
     [SERDEC_YAML_WRONG_TYPE]="serializer is the wrong type for the operation",
     [SERDEC_YAML_UNEXPECTED_EVENT]="expected a different event in the stream",
     [SERDEC_YAML_INVALID_BOOLEAN_TOKEN]="expected either 'true' or 'false'",
     [SERDEC_YAML_CALLBACK_SIGNALED_ERROR]="callback returned non-zero",
+    [SERDEC_YAML_INVALID_NUMBER]="expected a numeric value",
+    [SERDEC_YAML_OUT_OF_RANGE]="numeric value is out of range for the type",
+    [SERDEC_YAML_UNKNOWN_KEY]="map contains a key which isn't in the table",
+    [SERDEC_YAML_END_OF_STREAM]="there are no more documents in the stream",
+    [SERDEC_YAML_NEED_MORE_DATA]="the next document has not been fed yet",
+    [SERDEC_YAML_INVALID_STATE]="the end of the input has already been fed",
+    [SERDEC_YAML_INVALID_PATH]="the path is malformed",
+    [SERDEC_YAML_NOT_FOUND]="the path does not refer to a node",
+    [SERDEC_YAML_NOT_SUPPORTED]="the library was built without support for "
+    "the operation",
 };
 
+// Where the events of a de-serializer come from.
+typedef enum EventSource {
+    SOURCE_LIBYAML,
+    SOURCE_NATIVE,
+    SOURCE_TAPE,
+} EventSource;
+
 // This struct maintains all internal state of the deserializer.
 typedef struct SerdecYamlDeserializer {
     yaml_parser_t parser;
-    yaml_event_t event;
-    yaml_event_t event_buffer;
+
+    // Events are parsed in place into a ring. <event> points to the slot of
+    // the current event, and the <lookahead> slots after it hold events which
+    // have been peeked, but not consumed.
+    yaml_event_t ring[EVENT_RING_SIZE];
+    size_t head;
+    size_t lookahead;
+    yaml_event_t* event;
     int error;
+    SerdecArena* arena;
+    SerdecAllocator allocator;
+
+    // Input which was opened by _new_path(), and is owned by the
+    // de-serializer: either a mapping of the file, or a stream for files which
+    // can't be mapped.
+    void* mapping;
+    size_t mapping_length;
+    FILE* file;
+
+    // Non-NULL for de-serializers created by _new_push().
+    PushInput* push;
+
+    // The native scanner is allocated the first time that it's used. <source>
+    // selects it while it's reading the input, rather than libyaml, and
+    // selects the tape reader while a tape is replayed.
+    SerdecYamlBackend backend;
+    NativeScanner* scanner;
+    TapeReader tape;
+    EventSource source;
+
+    // The native scanner refers to scalars in the input, which aren't
+    // NUL-terminated, so strings are copied here before they're returned.
+    StringBuffer scratch;
+
+#ifdef SERDEC_ENABLE_STATS
+    Stats stats;
+#endif
 } SerdecYamlDeserializer;
 
+typedef struct SerdecYamlFieldTable {
+    KeyTable keys;
+    const SerdecYamlField* fields;
+    bool skip_unknown;
+    SerdecAllocator allocator;
+} SerdecYamlFieldTable;
+
 ///////////////////////////////////////////////////////////////////////////////
 // Private API
 ////
 
-static int yaml_peek_event(SerdecYamlDeserializer* deser) {
-    if (YAML_NO_EVENT != deser->event_buffer.type) {
-        yaml_event_delete(&deser->event_buffer);
+// Produce the next event from whichever backend is reading the input.
+static int read_event(SerdecYamlDeserializer* deser, yaml_event_t* event) {
+    if (SOURCE_NATIVE == deser->source) {
+        int result = native_scanner_next(deser->scanner, event);
+        if (result) {
+            deser->error = result;
+        }
+        return result;
+    } else if (SOURCE_TAPE == deser->source) {
+        tape_reader_next(&deser->tape, event);
+        return 0;
     }
 
-    if (!yaml_parser_parse(&deser->parser, &deser->event_buffer)) {
+    if (!yaml_parser_parse(&deser->parser, event)) {
         deser->error = SERDEC_YAML_UNKNOWN_ERROR;
         return deser->error;
     }
     return 0;
 }
 
-static int yaml_next_event(SerdecYamlDeserializer* deser) {
-    yaml_event_delete(&deser->event);
-    if (YAML_NO_EVENT == deser->event_buffer.type) {
-        if (!yaml_parser_parse(&deser->parser, &deser->event)) {
-            deser->error = SERDEC_YAML_UNKNOWN_ERROR;
-            return deser->error;
-        }
-    } else {
-        memcpy(&deser->event, &deser->event_buffer, sizeof(yaml_event_t));
-        memset(&deser->event_buffer, 0, sizeof(yaml_event_t));
+#ifdef SERDEC_ENABLE_STATS
+// The offset in the input which the parser has reached after <event>. A tape
+// isn't read from the input, so it stays where it is.
+static uint64_t input_position(const SerdecYamlDeserializer* deser,
+    const yaml_event_t* event)
+{
+    switch (deser->source) {
+    case SOURCE_NATIVE:
+        return (uint64_t)(deser->scanner->cursor - deser->scanner->input);
+    case SOURCE_TAPE: return deser->stats.position;
+    default: return event->end_mark.index;
     }
-
-    return 0;
 }
+#endif
 
-static int prepare_deserializer(SerdecYamlDeserializer* deser) {
-    bool done = false;
-    while (!done) {
-        if (yaml_peek_event(deser)) {
-            return deser->error;
-        }
+// Like read_event(), but the event is counted in the statistics.
+static int parse_event(SerdecYamlDeserializer* deser, yaml_event_t* event) {
+    STATS_TIMER(start);
+    int result = read_event(deser, event);
+    STATS_ADD_TIME(deser, codec_ns, start);
+    if (0 == result) {
+        STATS_EVENT(deser, event->type);
+        STATS_POSITION(deser, input_position(deser, event));
+    }
+    return result;
+}
 
-        if (YAML_STREAM_START_EVENT == deser->event_buffer.type ||
-            YAML_DOCUMENT_START_EVENT == deser->event_buffer.type) {
-            if (yaml_next_event(deser)) {
-                return deser->error;
-            }
-        } else {
-            done = true;
-        }
+// The events of the native scanner and the tape reader don't own any memory.
+static void delete_event(SerdecYamlDeserializer* deser, yaml_event_t* event) {
+    if (SOURCE_LIBYAML != deser->source) {
+        memset(event, 0, sizeof(yaml_event_t));
+    } else {
+        yaml_event_delete(event);
     }
-    return 0;
 }
 
-///////////////////////////////////////////////////////////////////////////////
-// Error Handling
-////
+// The slot of the event after the current one.
+static yaml_event_t* peeked_event(SerdecYamlDeserializer* deser) {
+    return &deser->ring[(deser->head + 1) % EVENT_RING_SIZE];
+}
 
-const char* serdec_yaml_deserializer_strerror(SerdecYamlDeserializer* deser) {
-    if (0 > deser->error || SERDEC_YAML_MAX_ERROR <= deser->error) {
-        return NULL;
+// Parse the event after the current one, unless it has been peeked already,
+// so that peeking again is free.
+static int yaml_peek_event(SerdecYamlDeserializer* deser) {
+    if (0 < deser->lookahead) {
+        return 0;
     }
 
-    switch (deser->error) {
-    case SERDEC_YAML_SYSTEM_ERROR: return strerror(errno);
-    case SERDEC_YAML_UNKNOWN_ERROR: return deser->parser.problem;
-    default:
-        return SERDEC_YAML_ERROR_STRINGS[deser->error];
+    if (parse_event(deser, peeked_event(deser))) {
+        return deser->error;
     }
+    deser->lookahead = 1;
+    return 0;
 }
 
-///////////////////////////////////////////////////////////////////////////////
-// De-serializer Initialization
-////
-
-// Initialize a de-serializer from the given input string.
-SerdecYamlDeserializer* serdec_yaml_deserializer_new_string(const char* string,
-    size_t string_length)
-{
-    SerdecYamlDeserializer* deser = malloc(sizeof(SerdecYamlDeserializer));
-    if (NULL == deser) {
-        return NULL;
+// Free the current event, and advance to the next one, which is parsed into
+// its slot unless it has been peeked.
+static int yaml_next_event(SerdecYamlDeserializer* deser) {
+    delete_event(deser, deser->event);
+    deser->head = (deser->head + 1) % EVENT_RING_SIZE;
+    deser->event = &deser->ring[deser->head];
+    if (0 < deser->lookahead) {
+        --deser->lookahead;
+        return 0;
     }
+    return parse_event(deser, deser->event);
+}
 
-    memset(deser, 0, sizeof(SerdecYamlDeserializer));
-    yaml_parser_initialize(&deser->parser);
-    yaml_parser_set_input_string(&deser->parser, (const unsigned char*)string,
-        string_length);
-
-    if (prepare_deserializer(deser)) {
-        yaml_parser_delete(&deser->parser);
-        free(deser);
-        return NULL;
+// Consume the next event into <event>, which is then owned by the caller. It's
+// parsed there directly, unless it has been peeked already. The current event
+// is left alone.
+static int take_event(SerdecYamlDeserializer* deser, yaml_event_t* event) {
+    if (0 == deser->lookahead) {
+        return parse_event(deser, event);
     }
 
-    return deser;
+    yaml_event_t* peeked = peeked_event(deser);
+    *event = *peeked;
+    memset(peeked, 0, sizeof(yaml_event_t));
+    deser->lookahead = 0;
+    return 0;
 }
 
-// Create a YAML deserializer from the input file.
-SerdecYamlDeserializer* serdec_yaml_deserializer_new_file(FILE* input_file) {
-    SerdecYamlDeserializer* deser = malloc(sizeof(SerdecYamlDeserializer));
-    if (NULL == deser) {
-        return NULL;
+// Free every event in the ring.
+static void delete_events(SerdecYamlDeserializer* deser) {
+    for (size_t i = 0; i < EVENT_RING_SIZE; ++i) {
+        delete_event(deser, &deser->ring[i]);
     }
+    deser->head = 0;
+    deser->lookahead = 0;
+    deser->event = &deser->ring[0];
+}
 
-    memset(deser, 0, sizeof(SerdecYamlDeserializer));
-    yaml_parser_initialize(&deser->parser);
-    yaml_parser_set_input_file(&deser->parser, input_file);
-
-    if (prepare_deserializer(deser)) {
-        yaml_parser_delete(&deser->parser);
-        free(deser);
-        return NULL;
+// Advance to the next event, which must be a scalar.
+static int next_scalar(SerdecYamlDeserializer* deser) {
+    if (yaml_next_event(deser)) {
+        return deser->error;
     }
 
-    return deser;
+    if (YAML_SCALAR_EVENT != deser->event->type) {
+        deser->error = SERDEC_YAML_UNEXPECTED_EVENT;
+        return deser->error;
+    }
+    return 0;
 }
 
-// Free a de-serializer.
-void serdec_yaml_deserializer_free(SerdecYamlDeserializer* deser) {
-    yaml_event_delete(&deser->event);
-    yaml_event_delete(&deser->event_buffer);
-    yaml_parser_delete(&deser->parser);
-    free(deser);
+static int number_status(SerdecYamlDeserializer* deser,
+    NumberParseResult result)
+{
+    switch (result) {
+    case NUMBER_OK: return 0;
+    case NUMBER_OUT_OF_RANGE: deser->error = SERDEC_YAML_OUT_OF_RANGE; break;
+    default: deser->error = SERDEC_YAML_INVALID_NUMBER; break;
+    }
+    return deser->error;
 }
 
-///////////////////////////////////////////////////////////////////////////////
-// De-serialization Routines
-////
+// Convert the current event, which must be a scalar, to a value of <kind>.
+static int convert_scalar(SerdecYamlDeserializer* deser, SerdecYamlKind kind,
+    void* value)
+{
+    const char* string = (const char*)deser->event->data.scalar.value;
+    size_t length = deser->event->data.scalar.length;
+    NumberParseResult result = NUMBER_OK;
+    switch (kind) {
+    case SERDEC_YAML_KIND_BOOL:
+        if (4 == length && !memcmp(string, "true", 4)) {
+            *(bool*)value = true;
+        } else if (5 == length && !memcmp(string, "false", 5)) {
+            *(bool*)value = false;
+        } else {
+            deser->error = SERDEC_YAML_INVALID_BOOLEAN_TOKEN;
+            return deser->error;
+        }
+        return 0;
+    case SERDEC_YAML_KIND_INT: {
+        int64_t value_int = 0;
+        result = parse_int64(string, length, &value_int);
+        if (NUMBER_OK == result &&
+            (INT_MIN > value_int || INT_MAX < value_int)) {
+            result = NUMBER_OUT_OF_RANGE;
+        } else if (NUMBER_OK == result) {
+            *(int*)value = (int)value_int;
+        }
+        break;
+    }
+    case SERDEC_YAML_KIND_INT64:
+        result = parse_int64(string, length, (int64_t*)value);
+        break;
+    case SERDEC_YAML_KIND_UINT64:
+        result = parse_uint64(string, length, (uint64_t*)value);
+        break;
+    case SERDEC_YAML_KIND_SIZE_T: {
+        uint64_t value_uint = 0;
+        result = parse_uint64(string, length, &value_uint);
+        if (NUMBER_OK == result && SIZE_MAX < value_uint) {
+            result = NUMBER_OUT_OF_RANGE;
+        } else if (NUMBER_OK == result) {
+            *(size_t*)value = (size_t)value_uint;
+        }
+        break;
+    }
+    case SERDEC_YAML_KIND_DOUBLE:
+        result = parse_double(string, length, (double*)value);
+        break;
+    default:
+        deser->error = SERDEC_YAML_WRONG_TYPE;
+        return deser->error;
+    }
 
-// This callback is to "visit" (i.e. handle) entries of a map. This is a
-// user-defined callback.
-typedef int yaml_visit_map_callback(SerdecYamlDeserializer* deser,
-    void* user_data, const char* key);
+    return number_status(deser, result);
+}
 
-// De-serialize a map from the input stream. Return non-zero if parsing
-// encountered an error, for any reason.
-int serdec_yaml_deserialize_map(SerdecYamlDeserializer* deser,
-    yaml_visit_map_callback* callback, void* user_data)
+// Convert the elements of a list of scalars, storing them contiguously at
+// <values>. If <grow> is non-NULL, the array is reallocated as needed, and
+// <capacity> is its initial capacity.
+static int convert_list(SerdecYamlDeserializer* deser, SerdecYamlKind kind,
+    char* values, size_t element_size, size_t capacity, size_t* count,
+    char** grow)
 {
     if (yaml_next_event(deser)) {
         return deser->error;
     }
 
-    if (YAML_MAPPING_START_EVENT != deser->event.type) {
+    if (YAML_SEQUENCE_START_EVENT != deser->event->type) {
         deser->error = SERDEC_YAML_UNEXPECTED_EVENT;
         return deser->error;
     }
 
-    yaml_event_t key_event = {0};
+    size_t index = 0;
     int result = 0;
-    while (!(result = yaml_peek_event(deser)) &&
-        YAML_MAPPING_END_EVENT != deser->event_buffer.type)
+    while (!(result = yaml_next_event(deser)) &&
+        YAML_SEQUENCE_END_EVENT != deser->event->type)
     {
-        // Event in event_buffer is key event
-        memcpy(&key_event, &deser->event_buffer, sizeof(deser->event_buffer));
-        memset(&deser->event_buffer, 0, sizeof(deser->event_buffer));
-        result = callback(deser, user_data,
-            (const char*)key_event.data.scalar.value);
-        yaml_event_delete(&key_event);
-        if (result) {
-            deser->error = SERDEC_YAML_CALLBACK_SIGNALED_ERROR;
+        if (YAML_SCALAR_EVENT != deser->event->type) {
+            deser->error = SERDEC_YAML_UNEXPECTED_EVENT;
+            return deser->error;
+        }
+
+        if (capacity <= index) {
+            if (NULL == grow || SIZE_MAX / 2 / element_size < capacity) {
+                deser->error = SERDEC_YAML_OUT_OF_RANGE;
+                return deser->error;
+            }
+
+            capacity = 0 < capacity ? capacity * 2 : 16;
+            char* resized = allocator_realloc(&deser->allocator, values,
+                capacity * element_size);
+            if (NULL == resized) {
+                deser->error = SERDEC_YAML_SYSTEM_ERROR;
+                return deser->error;
+            }
+            values = resized;
+            *grow = values;
+        }
+
+        if (convert_scalar(deser, kind, values + index * element_size)) {
             return deser->error;
         }
+        ++index;
+    }
+
+    if (result) {
+        return result;
     }
 
-    yaml_event_delete(&deser->event_buffer);
+    *count = index;
     return 0;
 }
 
-// Deserialize a list from the input stream. The callback is invoked for every
-// list entry, and it's the responsibility of the callback to drive the
-// deserializer to de-serialize interesting types from the input stream.
-int serdec_yaml_deserialize_list(SerdecYamlDeserializer* deser,
-    yaml_visit_list_callback* callback, void* user_data)
+static int deserialize_array(SerdecYamlDeserializer* deser,
+    SerdecYamlKind kind, void* values, size_t element_size, size_t capacity,
+    size_t* count)
+{
+    return convert_list(deser, kind, values, element_size, capacity, count,
+        NULL);
+}
+
+static int deserialize_vector(SerdecYamlDeserializer* deser,
+    SerdecYamlKind kind, void** values, size_t element_size, size_t* count)
+{
+    char* vector = NULL;
+    if (convert_list(deser, kind, NULL, element_size, 0, count, &vector)) {
+        allocator_free(&deser->allocator, vector);
+        return deser->error;
+    }
+
+    *values = vector;
+    return 0;
+}
+
+// De-serialize a single value of a struct field (i.e. an array element, if the
+// field is an array).
+static int deserialize_element(SerdecYamlDeserializer* deser,
+    const PreparedField* field, char* element)
+{
+    switch (field->descriptor->kind) {
+    case SERDEC_YAML_KIND_BOOL:
+        return serdec_yaml_deserialize_bool(deser, (bool*)element);
+    case SERDEC_YAML_KIND_INT:
+        return serdec_yaml_deserialize_int(deser, (int*)element);
+    case SERDEC_YAML_KIND_INT64:
+        return serdec_yaml_deserialize_int64(deser, (int64_t*)element);
+    case SERDEC_YAML_KIND_UINT64:
+        return serdec_yaml_deserialize_uint64(deser, (uint64_t*)element);
+    case SERDEC_YAML_KIND_SIZE_T:
+        return serdec_yaml_deserialize_size_t(deser, (size_t*)element);
+    case SERDEC_YAML_KIND_DOUBLE:
+        return serdec_yaml_deserialize_double(deser, (double*)element);
+    case SERDEC_YAML_KIND_STRING: {
+        if (next_scalar(deser)) {
+            return deser->error;
+        }
+
+        // The scalar needn't be NUL-terminated, since it's copied anyway.
+        const char* value = (const char*)deser->event->data.scalar.value;
+        size_t length = deser->event->data.scalar.length;
+        char* string = NULL;
+        STATS_ADD(deser, scalar_bytes, length);
+        if (NULL != deser->arena) {
+            string = serdec_arena_strndup(deser->arena, value, length);
+        } else if (NULL != (string = allocator_alloc(&deser->allocator,
+                        length + 1))) {
+            memcpy(string, value, length);
+            string[length] = '\0';
+        }
+
+        if (NULL == string) {
+            errno = ENOMEM;
+            deser->error = SERDEC_YAML_SYSTEM_ERROR;
+            return deser->error;
+        }
+        *(char**)element = string;
+        return 0;
+    }
+    case SERDEC_YAML_KIND_STRUCT:
+        return serdec_yaml_deserialize_struct(deser, field->type, element);
+    default:
+        deser->error = SERDEC_YAML_WRONG_TYPE;
+        return deser->error;
+    }
+}
+
+static int deserialize_field(SerdecYamlDeserializer* deser,
+    const PreparedField* field, char* member)
 {
+    size_t count = field->descriptor->array_length;
+    SerdecYamlKind kind = field->descriptor->kind;
+    if (0 == count) {
+        return deserialize_element(deser, field, member);
+    } else if (SERDEC_YAML_KIND_STRING != kind &&
+        SERDEC_YAML_KIND_STRUCT != kind) {
+        size_t length = 0;
+        return deserialize_array(deser, kind, member, field->element_size,
+            count, &length);
+    }
+
     if (yaml_next_event(deser)) {
         return deser->error;
     }
 
-    if (YAML_SEQUENCE_START_EVENT != deser->event.type) {
+    if (YAML_SEQUENCE_START_EVENT != deser->event->type) {
         deser->error = SERDEC_YAML_UNEXPECTED_EVENT;
         return deser->error;
     }
@@ -240,85 +488,1358 @@ int serdec_yaml_deserialize_list(SerdecYamlDeserializer* deser,
     size_t index = 0;
     int result = 0;
     while (!(result = yaml_peek_event(deser)) &&
-        YAML_SEQUENCE_END_EVENT != deser->event_buffer.type)
+        YAML_SEQUENCE_END_EVENT != peeked_event(deser)->type)
     {
-        if (callback(deser, user_data, index++)) {
-            deser->error = SERDEC_YAML_CALLBACK_SIGNALED_ERROR;
+        if (count <= index) {
+            deser->error = SERDEC_YAML_OUT_OF_RANGE;
+            return deser->error;
+        }
+
+        if (deserialize_element(deser, field,
+                member + index++ * field->element_size)) {
             return deser->error;
         }
     }
 
-    yaml_event_delete(&deser->event_buffer);
-    return result;
+    return result ? result : yaml_next_event(deser);
 }
 
-// De-serialize a boolean from the input stream. Return non-zero if parsing
-// encountered an error, for any reason. This callback requires that booleans
-// be either "true" or "false", and cannot be a value of "0" or non-zero.
-int serdec_yaml_deserialize_bool(SerdecYamlDeserializer* deser, bool* value) {
-    if (yaml_next_event(deser)) {
-        return deser->error;
+// Allocate a de-serializer, which is prepared by prepare_deserializer() once
+// its input has been set.
+static SerdecYamlDeserializer* allocate_deserializer(
+    const SerdecYamlDeserializerOptions* options)
+{
+    const SerdecAllocator* allocator = allocator_or_default(
+        NULL != options ? options->allocator : NULL);
+    SerdecYamlDeserializer* deser = allocator_alloc(allocator,
+        sizeof(SerdecYamlDeserializer));
+    if (NULL == deser) {
+        return NULL;
     }
 
-    if (YAML_SCALAR_EVENT != deser->event.type) {
-        deser->error = SERDEC_YAML_UNEXPECTED_EVENT;
-        return deser->error;
+    memset(deser, 0, sizeof(SerdecYamlDeserializer));
+    deser->event = &deser->ring[0];
+    deser->allocator = *allocator;
+#ifdef SERDEC_ENABLE_STATS
+    stats_initialize(&deser->stats, &deser->allocator);
+#endif
+    if (NULL != options) {
+        deser->backend = options->backend;
+    }
+    string_buffer_init(&deser->scratch, &deser->allocator);
+    if (!yaml_parser_initialize(&deser->parser)) {
+        allocator_free(allocator, deser);
+        errno = ENOMEM;
+        return NULL;
+    }
+    return deser;
+}
+
+// Set the input of the de-serializer to <string>, which is read by the
+// selected backend. Return non-zero if the native scanner can't be allocated.
+static int set_string_input(SerdecYamlDeserializer* deser, const char* string,
+    size_t length)
+{
+    if (SERDEC_YAML_BACKEND_NATIVE != deser->backend) {
+        yaml_parser_set_input_string(&deser->parser,
+            (const unsigned char*)string, length);
+        return 0;
     }
 
-    bool value_bool = false;
-    if (!strcmp((const char*)deser->event.data.scalar.value, "true")) {
-        value_bool = true;
-    } else if (!strcmp((const char*)deser->event.data.scalar.value, "false")) {
-        value_bool = false;
-    } else {
-        deser->error = SERDEC_YAML_INVALID_BOOLEAN_TOKEN;
-        return deser->error;
+    if (NULL == deser->scanner) {
+        deser->scanner = allocator_alloc(&deser->allocator,
+            sizeof(NativeScanner));
+        if (NULL == deser->scanner) {
+            errno = ENOMEM;
+            deser->error = SERDEC_YAML_SYSTEM_ERROR;
+            return deser->error;
+        }
+        native_scanner_initialize(deser->scanner, &deser->allocator);
     }
 
-    *value = value_bool;
+    native_scanner_set_input(deser->scanner, string, length);
+    deser->source = SOURCE_NATIVE;
     return 0;
 }
 
-// De-serialize an integer value from the input stream. Return non-zero if
-// parsing encountered an error, for any reason.
-int serdec_yaml_deserialize_int(SerdecYamlDeserializer* deser, int* value) {
-    if (yaml_next_event(deser)) {
-        return deser->error;
+static int prepare_deserializer(SerdecYamlDeserializer* deser) {
+    bool done = false;
+    while (!done) {
+        if (yaml_peek_event(deser)) {
+            return deser->error;
+        }
+
+        int type = peeked_event(deser)->type;
+        if (YAML_STREAM_START_EVENT == type ||
+            YAML_DOCUMENT_START_EVENT == type) {
+            if (yaml_next_event(deser)) {
+                return deser->error;
+            }
+        } else {
+            done = true;
+        }
     }
+    return 0;
+}
 
-    if (YAML_SCALAR_EVENT != deser->event.type) {
-        deser->error = SERDEC_YAML_UNEXPECTED_EVENT;
-        return deser->error;
+// Return the parser to the state yaml_parser_initialize() leaves it in, but
+// keep the buffers and stacks it has allocated. libyaml has no API for this,
+// so it mirrors yaml_parser_delete(), which releases the pending tokens and
+// tag directives with free(3).
+static void reset_parser(yaml_parser_t* parser) {
+    while (parser->tokens.head != parser->tokens.tail) {
+        yaml_token_delete(parser->tokens.head++);
+    }
+    while (parser->tag_directives.top != parser->tag_directives.start) {
+        yaml_tag_directive_t* directive = --parser->tag_directives.top;
+        free(directive->handle);
+        free(directive->prefix);
     }
 
-    char* end_pointer = NULL;
-    int value_int = strtol((const char*)deser->event.data.scalar.value,
-        &end_pointer, 10);
-    if (NULL != end_pointer && 0 != *end_pointer) {
-        deser->error = SERDEC_YAML_SYSTEM_ERROR;
-        return deser->error;
+    yaml_parser_t reset = {0};
+    reset.raw_buffer = parser->raw_buffer;
+    reset.raw_buffer.pointer = reset.raw_buffer.last = reset.raw_buffer.start;
+    reset.buffer = parser->buffer;
+    reset.buffer.pointer = reset.buffer.last = reset.buffer.start;
+    reset.tokens = parser->tokens;
+    reset.tokens.head = reset.tokens.tail = reset.tokens.start;
+    reset.indents = parser->indents;
+    reset.indents.top = reset.indents.start;
+    reset.simple_keys = parser->simple_keys;
+    reset.simple_keys.top = reset.simple_keys.start;
+    reset.states = parser->states;
+    reset.states.top = reset.states.start;
+    reset.marks = parser->marks;
+    reset.marks.top = reset.marks.start;
+    reset.tag_directives = parser->tag_directives;
+    memcpy(parser, &reset, sizeof(reset));
+}
+
+// Close any input which is owned by the de-serializer.
+static void release_input(SerdecYamlDeserializer* deser) {
+    if (NULL != deser->mapping) {
+        munmap(deser->mapping, deser->mapping_length);
+        deser->mapping = NULL;
+        deser->mapping_length = 0;
+    }
+    if (NULL != deser->file) {
+        fclose(deser->file);
+        deser->file = NULL;
+    }
+    if (NULL != deser->push) {
+        push_input_release(deser->push);
+        allocator_free(&deser->allocator, deser->push);
+        deser->push = NULL;
     }
+}
 
-    *value = value_int;
-    return 0;
+// Discard the state of the parser, so that it can read new input. Until the
+// input is set, libyaml is selected.
+static void rewind_parser(SerdecYamlDeserializer* deser) {
+    delete_events(deser);
+    if (SOURCE_LIBYAML == deser->source) {
+        reset_parser(&deser->parser);
+    }
+    deser->source = SOURCE_LIBYAML;
+    deser->error = 0;
+    STATS_REWIND(deser);
 }
 
-// De-serialize a string value from the input stream. Return non-zero if
-// parsing encounters an error.
-int serdec_yaml_deserialize_string(SerdecYamlDeserializer* deser,
-    const char** value)
-{
-    if (yaml_next_event(deser)) {
-        return deser->error;
+// Discard the state of the previous input, so that new input can be set.
+static void reset_deserializer(SerdecYamlDeserializer* deser) {
+    rewind_parser(deser);
+    release_input(deser);
+}
+
+// Between documents, the parser of a push de-serializer reads an empty
+// string, so that attempts to de-serialize fail cleanly.
+static void await_push_document(SerdecYamlDeserializer* deser, int status) {
+    rewind_parser(deser);
+    yaml_parser_set_input_string(&deser->parser, (const unsigned char*)"", 0);
+    deser->error = status;
+}
+
+// Begin parsing the next complete document which has been pushed, if there
+// is one.
+static int start_push_document(SerdecYamlDeserializer* deser) {
+    PushInput* push = deser->push;
+    push->parsing = false;
+    while (true) {
+        const char* document = NULL;
+        size_t length = 0;
+        switch (push_input_next(push, &document, &length)) {
+        case PUSH_DOCUMENT: break;
+        case PUSH_NEED_MORE_DATA:
+            await_push_document(deser, SERDEC_YAML_NEED_MORE_DATA);
+            return deser->error;
+        case PUSH_END_OF_STREAM:
+            await_push_document(deser, SERDEC_YAML_END_OF_STREAM);
+            return deser->error;
+        default:
+            await_push_document(deser, SERDEC_YAML_SYSTEM_ERROR);
+            return deser->error;
+        }
+
+        rewind_parser(deser);
+        if (set_string_input(deser, document, length) ||
+            prepare_deserializer(deser)) {
+            return deser->error;
+        }
+
+        // Skip input which contains no document, e.g. only comments.
+        if (YAML_STREAM_END_EVENT != peeked_event(deser)->type) {
+            push->parsing = true;
+            return 0;
+        }
+    }
+}
+
+// Set the input of the parser to the file at <path>. Regular files are mapped,
+// and parsed as a string. Anything else (e.g. a pipe) is read with stdio.
+// Return non-zero, with errno set, if the file could not be opened.
+static int open_path(SerdecYamlDeserializer* deser, const char* path) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (0 > fd) {
+        return -1;
     }
 
-    if (YAML_SCALAR_EVENT != deser->event.type) {
-        deser->error = SERDEC_YAML_UNEXPECTED_EVENT;
-        return deser->error;
+    struct stat status = {0};
+    if (fstat(fd, &status)) {
+        close(fd);
+        return -1;
     }
 
-    *value = (const char*)deser->event.data.scalar.value;
+    if (S_ISREG(status.st_mode) && 0 < status.st_size &&
+        SIZE_MAX >= (uintmax_t)status.st_size) {
+        size_t length = (size_t)status.st_size;
+        void* mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (MAP_FAILED != mapping) {
+            close(fd);
+            // This is only a hint, so its failure doesn't matter.
+            madvise(mapping, length, MADV_SEQUENTIAL);
+            deser->mapping = mapping;
+            deser->mapping_length = length;
+            return set_string_input(deser, mapping, length);
+        }
+    } else if (S_ISREG(status.st_mode) && 0 == status.st_size) {
+        // Empty files can't be mapped.
+        close(fd);
+        return set_string_input(deser, "", 0);
+    }
+
+    deser->file = fdopen(fd, "r");
+    if (NULL == deser->file) {
+        close(fd);
+        return -1;
+    }
+    yaml_parser_set_input_file(&deser->parser, deser->file);
     return 0;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
+// Error Handling
+////
+
+const char* serdec_yaml_deserializer_strerror(SerdecYamlDeserializer* deser) {
+    if (0 > deser->error || SERDEC_YAML_MAX_ERROR <= deser->error) {
+        return NULL;
+    }
+
+    switch (deser->error) {
+    case SERDEC_YAML_SYSTEM_ERROR: return strerror(errno);
+    case SERDEC_YAML_UNKNOWN_ERROR: return deser->parser.problem;
+    case SERDEC_YAML_SYNTAX_ERROR: return deser->scanner->problem;
+    default:
+        return SERDEC_YAML_ERROR_STRINGS[deser->error];
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// De-serializer Initialization
+////
+
+// Initialize a de-serializer from the given input string.
+SerdecYamlDeserializer* serdec_yaml_deserializer_new_string(const char* string,
+    size_t string_length)
+{
+    return serdec_yaml_deserializer_new_string_with_allocator(string,
+        string_length, NULL);
+}
+
+SerdecYamlDeserializer* serdec_yaml_deserializer_new_string_with_allocator(
+    const char* string, size_t string_length,
+    const SerdecAllocator* allocator)
+{
+    SerdecYamlDeserializerOptions options = {.allocator = allocator};
+    return serdec_yaml_deserializer_new_string_with_options(string,
+        string_length, &options);
+}
+
+SerdecYamlDeserializer* serdec_yaml_deserializer_new_string_with_options(
+    const char* string, size_t string_length,
+    const SerdecYamlDeserializerOptions* options)
+{
+    SerdecYamlDeserializer* deser = allocate_deserializer(options);
+    if (NULL == deser) {
+        return NULL;
+    }
+
+    if (set_string_input(deser, string, string_length) ||
+        prepare_deserializer(deser)) {
+        serdec_yaml_deserializer_free(deser);
+        return NULL;
+    }
+
+    return deser;
+}
+
+// Create a YAML deserializer from the input file.
+SerdecYamlDeserializer* serdec_yaml_deserializer_new_file(FILE* input_file) {
+    return serdec_yaml_deserializer_new_file_with_allocator(input_file, NULL);
+}
+
+SerdecYamlDeserializer* serdec_yaml_deserializer_new_file_with_allocator(
+    FILE* input_file, const SerdecAllocator* allocator)
+{
+    SerdecYamlDeserializerOptions options = {.allocator = allocator};
+    SerdecYamlDeserializer* deser = allocate_deserializer(&options);
+    if (NULL == deser) {
+        return NULL;
+    }
+
+    yaml_parser_set_input_file(&deser->parser, input_file);
+
+    if (prepare_deserializer(deser)) {
+        serdec_yaml_deserializer_free(deser);
+        return NULL;
+    }
+
+    return deser;
+}
+
+// Create a YAML deserializer from the file at <path>.
+SerdecYamlDeserializer* serdec_yaml_deserializer_new_path(const char* path) {
+    return serdec_yaml_deserializer_new_path_with_allocator(path, NULL);
+}
+
+SerdecYamlDeserializer* serdec_yaml_deserializer_new_path_with_allocator(
+    const char* path, const SerdecAllocator* allocator)
+{
+    SerdecYamlDeserializerOptions options = {.allocator = allocator};
+    return serdec_yaml_deserializer_new_path_with_options(path, &options);
+}
+
+SerdecYamlDeserializer* serdec_yaml_deserializer_new_path_with_options(
+    const char* path, const SerdecYamlDeserializerOptions* options)
+{
+    SerdecYamlDeserializer* deser = allocate_deserializer(options);
+    if (NULL == deser) {
+        return NULL;
+    }
+
+    if (open_path(deser, path)) {
+        int error = errno;
+        serdec_yaml_deserializer_free(deser);
+        errno = error;
+        return NULL;
+    }
+
+    if (prepare_deserializer(deser)) {
+        serdec_yaml_deserializer_free(deser);
+        return NULL;
+    }
+
+    return deser;
+}
+
+// Create a YAML deserializer which is fed its input in chunks.
+SerdecYamlDeserializer* serdec_yaml_deserializer_new_push() {
+    return serdec_yaml_deserializer_new_push_with_allocator(NULL);
+}
+
+SerdecYamlDeserializer* serdec_yaml_deserializer_new_push_with_allocator(
+    const SerdecAllocator* allocator)
+{
+    SerdecYamlDeserializerOptions options = {.allocator = allocator};
+    return serdec_yaml_deserializer_new_push_with_options(&options);
+}
+
+SerdecYamlDeserializer* serdec_yaml_deserializer_new_push_with_options(
+    const SerdecYamlDeserializerOptions* options)
+{
+    SerdecYamlDeserializer* deser = allocate_deserializer(options);
+    if (NULL == deser) {
+        return NULL;
+    }
+
+    deser->push = allocator_alloc(&deser->allocator, sizeof(PushInput));
+    if (NULL == deser->push) {
+        serdec_yaml_deserializer_free(deser);
+        return NULL;
+    }
+
+    push_input_init(deser->push, &deser->allocator);
+    await_push_document(deser, 0);
+    return deser;
+}
+
+int serdec_yaml_deserializer_feed(SerdecYamlDeserializer* deser,
+    const char* data, size_t length)
+{
+    if (NULL == deser->push) {
+        deser->error = SERDEC_YAML_WRONG_TYPE;
+        return deser->error;
+    } else if (deser->push->finished) {
+        deser->error = SERDEC_YAML_INVALID_STATE;
+        return deser->error;
+    }
+
+    if (push_input_append(deser->push, data, length)) {
+        deser->error = SERDEC_YAML_SYSTEM_ERROR;
+        return deser->error;
+    }
+
+    // Input for later documents is buffered until they're reached.
+    if (deser->push->parsing) {
+        return 0;
+    }
+    return start_push_document(deser);
+}
+
+int serdec_yaml_deserializer_feed_end(SerdecYamlDeserializer* deser) {
+    if (NULL == deser->push) {
+        deser->error = SERDEC_YAML_WRONG_TYPE;
+        return deser->error;
+    }
+
+    deser->push->finished = true;
+    if (deser->push->parsing) {
+        return 0;
+    }
+    return start_push_document(deser);
+}
+
+// Re-use the de-serializer for new input.
+int serdec_yaml_deserializer_reset_string(SerdecYamlDeserializer* deser,
+    const char* string, size_t string_length)
+{
+    reset_deserializer(deser);
+    if (set_string_input(deser, string, string_length)) {
+        return deser->error;
+    }
+    return prepare_deserializer(deser);
+}
+
+int serdec_yaml_deserializer_reset_file(SerdecYamlDeserializer* deser,
+    FILE* input_file)
+{
+    reset_deserializer(deser);
+    yaml_parser_set_input_file(&deser->parser, input_file);
+    return prepare_deserializer(deser);
+}
+
+// Free a de-serializer.
+void serdec_yaml_deserializer_free(SerdecYamlDeserializer* deser) {
+    delete_events(deser);
+    yaml_parser_delete(&deser->parser);
+    release_input(deser);
+    if (NULL != deser->scanner) {
+        native_scanner_delete(deser->scanner);
+        allocator_free(&deser->allocator, deser->scanner);
+    }
+    string_buffer_release(&deser->scratch);
+    SerdecAllocator allocator = *CALLER_ALLOCATOR(deser);
+    allocator_free(&allocator, deser);
+}
+
+// Allocate the strings of de-serialized structs from the arena.
+void serdec_yaml_deserializer_set_arena(SerdecYamlDeserializer* deser,
+    SerdecArena* arena)
+{
+    deser->arena = arena;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// De-serialization Routines
+////
+
+// Advance to the root of the next document in the stream, skipping whatever
+// remains of the current one.
+int serdec_yaml_deserializer_next_document(SerdecYamlDeserializer* deser) {
+    // Each document which is pushed is parsed on its own.
+    if (NULL != deser->push) {
+        return start_push_document(deser);
+    }
+
+    do {
+        if (yaml_next_event(deser)) {
+            return deser->error;
+        }
+
+        // Once the stream has ended, the parser produces empty events.
+        if (YAML_STREAM_END_EVENT == deser->event->type ||
+            YAML_NO_EVENT == deser->event->type) {
+            deser->error = SERDEC_YAML_END_OF_STREAM;
+            return deser->error;
+        }
+    } while (YAML_DOCUMENT_END_EVENT != deser->event->type);
+
+    if (yaml_peek_event(deser)) {
+        return deser->error;
+    }
+
+    if (YAML_DOCUMENT_START_EVENT != peeked_event(deser)->type) {
+        deser->error = SERDEC_YAML_END_OF_STREAM;
+        return deser->error;
+    }
+    return yaml_next_event(deser);
+}
+
+// This callback is to "visit" (i.e. handle) entries of a map. This is a
+// user-defined callback.
+typedef int yaml_visit_map_callback(SerdecYamlDeserializer* deser,
+    void* user_data, const char* key);
+
+// The keys of the native scanner aren't NUL-terminated, so they're copied
+// before they're passed to the callback: into <buffer>, if they're short, or
+// else into memory from the allocator. Return NULL if allocation fails.
+static char* terminate_key(SerdecYamlDeserializer* deser,
+    const yaml_event_t* key_event, char* buffer)
+{
+    size_t length = key_event->data.scalar.length;
+    char* key = buffer;
+    if (KEY_BUFFER_SIZE <= length) {
+        key = allocator_alloc(&deser->allocator, length + 1);
+        if (NULL == key) {
+            errno = ENOMEM;
+            deser->error = SERDEC_YAML_SYSTEM_ERROR;
+            return NULL;
+        }
+    }
+
+    memcpy(key, key_event->data.scalar.value, length);
+    key[length] = '\0';
+    STATS_ADD(deser, scalar_bytes, length);
+    return key;
+}
+
+// De-serialize a map from the input stream. Return non-zero if parsing
+// encountered an error, for any reason.
+int serdec_yaml_deserialize_map(SerdecYamlDeserializer* deser,
+    yaml_visit_map_callback* callback, void* user_data)
+{
+    if (yaml_next_event(deser)) {
+        return deser->error;
+    }
+
+    if (YAML_MAPPING_START_EVENT != deser->event->type) {
+        deser->error = SERDEC_YAML_UNEXPECTED_EVENT;
+        return deser->error;
+    }
+
+    // The key is taken out of the ring, so that it outlives the events of
+    // its value, which the callback consumes.
+    yaml_event_t key_event = {0};
+    int result = 0;
+    while (!(result = take_event(deser, &key_event)) &&
+        YAML_MAPPING_END_EVENT != key_event.type)
+    {
+        if (SOURCE_NATIVE != deser->source) {
+            STATS_CALLBACK_ENTER(deser);
+            result = callback(deser, user_data,
+                (const char*)key_event.data.scalar.value);
+            STATS_CALLBACK_LEAVE(deser);
+            delete_event(deser, &key_event);
+        } else {
+            char buffer[KEY_BUFFER_SIZE];
+            char* key = terminate_key(deser, &key_event, buffer);
+            if (NULL == key) {
+                return deser->error;
+            }
+
+            STATS_CALLBACK_ENTER(deser);
+            result = callback(deser, user_data, key);
+            STATS_CALLBACK_LEAVE(deser);
+            if (buffer != key) {
+                allocator_free(&deser->allocator, key);
+            }
+        }
+
+        if (result) {
+            deser->error = SERDEC_YAML_CALLBACK_SIGNALED_ERROR;
+            return deser->error;
+        }
+    }
+
+    delete_event(deser, &key_event);
+    return result;
+}
+
+// Deserialize a list from the input stream. The callback is invoked for every
+// list entry, and it's the responsibility of the callback to drive the
+// deserializer to de-serialize interesting types from the input stream.
+int serdec_yaml_deserialize_list(SerdecYamlDeserializer* deser,
+    yaml_visit_list_callback* callback, void* user_data)
+{
+    if (yaml_next_event(deser)) {
+        return deser->error;
+    }
+
+    if (YAML_SEQUENCE_START_EVENT != deser->event->type) {
+        deser->error = SERDEC_YAML_UNEXPECTED_EVENT;
+        return deser->error;
+    }
+
+    size_t index = 0;
+    int result = 0;
+    while (!(result = yaml_peek_event(deser)) &&
+        YAML_SEQUENCE_END_EVENT != peeked_event(deser)->type)
+    {
+        STATS_CALLBACK_ENTER(deser);
+        int failed = callback(deser, user_data, index++);
+        STATS_CALLBACK_LEAVE(deser);
+        if (failed) {
+            deser->error = SERDEC_YAML_CALLBACK_SIGNALED_ERROR;
+            return deser->error;
+        }
+    }
+
+    return result ? result : yaml_next_event(deser);
+}
+
+// De-serialize a boolean from the input stream. Return non-zero if parsing
+// encountered an error, for any reason. This callback requires that booleans
+// be either "true" or "false", and cannot be a value of "0" or non-zero.
+int serdec_yaml_deserialize_bool(SerdecYamlDeserializer* deser, bool* value) {
+    if (next_scalar(deser)) {
+        return deser->error;
+    }
+    return convert_scalar(deser, SERDEC_YAML_KIND_BOOL, value);
+}
+
+// De-serialize an integer value from the input stream. Return non-zero if
+// parsing encountered an error, for any reason.
+int serdec_yaml_deserialize_int(SerdecYamlDeserializer* deser, int* value) {
+    if (next_scalar(deser)) {
+        return deser->error;
+    }
+    return convert_scalar(deser, SERDEC_YAML_KIND_INT, value);
+}
+
+int serdec_yaml_deserialize_int64(SerdecYamlDeserializer* deser,
+    int64_t* value)
+{
+    if (next_scalar(deser)) {
+        return deser->error;
+    }
+    return convert_scalar(deser, SERDEC_YAML_KIND_INT64, value);
+}
+
+int serdec_yaml_deserialize_uint64(SerdecYamlDeserializer* deser,
+    uint64_t* value)
+{
+    if (next_scalar(deser)) {
+        return deser->error;
+    }
+    return convert_scalar(deser, SERDEC_YAML_KIND_UINT64, value);
+}
+
+int serdec_yaml_deserialize_size_t(SerdecYamlDeserializer* deser,
+    size_t* value)
+{
+    if (next_scalar(deser)) {
+        return deser->error;
+    }
+    return convert_scalar(deser, SERDEC_YAML_KIND_SIZE_T, value);
+}
+
+// De-serialize a floating point value from the input stream. Integers, .inf
+// and .nan are also accepted.
+int serdec_yaml_deserialize_double(SerdecYamlDeserializer* deser,
+    double* value)
+{
+    if (next_scalar(deser)) {
+        return deser->error;
+    }
+    return convert_scalar(deser, SERDEC_YAML_KIND_DOUBLE, value);
+}
+
+// De-serialize a list of scalars into an array. The whole list is converted
+// in a single loop, without invoking any callbacks.
+int serdec_yaml_deserialize_int_array(SerdecYamlDeserializer* deser,
+    int* values, size_t capacity, size_t* count)
+{
+    return deserialize_array(deser, SERDEC_YAML_KIND_INT, values,
+        sizeof(*values), capacity, count);
+}
+
+int serdec_yaml_deserialize_int64_array(SerdecYamlDeserializer* deser,
+    int64_t* values, size_t capacity, size_t* count)
+{
+    return deserialize_array(deser, SERDEC_YAML_KIND_INT64, values,
+        sizeof(*values), capacity, count);
+}
+
+int serdec_yaml_deserialize_double_array(SerdecYamlDeserializer* deser,
+    double* values, size_t capacity, size_t* count)
+{
+    return deserialize_array(deser, SERDEC_YAML_KIND_DOUBLE, values,
+        sizeof(*values), capacity, count);
+}
+
+int serdec_yaml_deserialize_bool_array(SerdecYamlDeserializer* deser,
+    bool* values, size_t capacity, size_t* count)
+{
+    return deserialize_array(deser, SERDEC_YAML_KIND_BOOL, values,
+        sizeof(*values), capacity, count);
+}
+
+// De-serialize a list of scalars into an array allocated from the
+// de-serializer's allocator, which grows to fit the list.
+int serdec_yaml_deserialize_int_vector(SerdecYamlDeserializer* deser,
+    int** values, size_t* count)
+{
+    return deserialize_vector(deser, SERDEC_YAML_KIND_INT, (void**)values,
+        sizeof(**values), count);
+}
+
+int serdec_yaml_deserialize_int64_vector(SerdecYamlDeserializer* deser,
+    int64_t** values, size_t* count)
+{
+    return deserialize_vector(deser, SERDEC_YAML_KIND_INT64, (void**)values,
+        sizeof(**values), count);
+}
+
+int serdec_yaml_deserialize_double_vector(SerdecYamlDeserializer* deser,
+    double** values, size_t* count)
+{
+    return deserialize_vector(deser, SERDEC_YAML_KIND_DOUBLE, (void**)values,
+        sizeof(**values), count);
+}
+
+int serdec_yaml_deserialize_bool_vector(SerdecYamlDeserializer* deser,
+    bool** values, size_t* count)
+{
+    return deserialize_vector(deser, SERDEC_YAML_KIND_BOOL, (void**)values,
+        sizeof(**values), count);
+}
+
+// De-serialize a struct from the input stream, according to its type.
+int serdec_yaml_deserialize_struct(SerdecYamlDeserializer* deser,
+    const SerdecYamlType* type, void* value)
+{
+    if (yaml_next_event(deser)) {
+        return deser->error;
+    }
+
+    if (YAML_MAPPING_START_EVENT != deser->event->type) {
+        deser->error = SERDEC_YAML_UNEXPECTED_EVENT;
+        return deser->error;
+    }
+
+    int result = 0;
+    while (!(result = yaml_next_event(deser)) &&
+        YAML_MAPPING_END_EVENT != deser->event->type)
+    {
+        if (YAML_SCALAR_EVENT != deser->event->type) {
+            deser->error = SERDEC_YAML_UNEXPECTED_EVENT;
+            return deser->error;
+        }
+
+        size_t index = key_table_lookup(&type->keys,
+            (const char*)deser->event->data.scalar.value,
+            deser->event->data.scalar.length);
+        if (KEY_TABLE_NOT_FOUND != index) {
+            const PreparedField* field = &type->fields[index];
+            if (deserialize_field(deser, field,
+                    (char*)value + field->descriptor->offset)) {
+                return deser->error;
+            }
+        } else if (!type->descriptor->skip_unknown) {
+            deser->error = SERDEC_YAML_UNKNOWN_KEY;
+            return deser->error;
+        } else if (serdec_yaml_deserialize_skip(deser)) {
+            return deser->error;
+        }
+    }
+
+    return result;
+}
+
+// Discard events until the end of the collection which is nested <depth>
+// levels deep, or the end of the next value, if <depth> is zero. Collections
+// are skipped by counting their start and end events, without dispatching
+// anything to the caller.
+static int skip_events(SerdecYamlDeserializer* deser, size_t depth) {
+    do {
+        if (yaml_next_event(deser)) {
+            return deser->error;
+        }
+
+        switch (deser->event->type) {
+        case YAML_MAPPING_START_EVENT:
+        case YAML_SEQUENCE_START_EVENT:
+            ++depth;
+            break;
+        case YAML_MAPPING_END_EVENT:
+        case YAML_SEQUENCE_END_EVENT:
+            if (0 == depth) {
+                deser->error = SERDEC_YAML_UNEXPECTED_EVENT;
+                return deser->error;
+            }
+            --depth;
+            break;
+        case YAML_SCALAR_EVENT:
+        case YAML_ALIAS_EVENT:
+            break;
+        default:
+            deser->error = SERDEC_YAML_UNEXPECTED_EVENT;
+            return deser->error;
+        }
+    } while (0 < depth);
+
+    return 0;
+}
+
+// Discard the next value in the input stream, whether it's a scalar or a
+// collection of any depth.
+int serdec_yaml_deserialize_skip(SerdecYamlDeserializer* deser) {
+    return skip_events(deser, 0);
+}
+
+// De-serialize a string value from the input stream. Return non-zero if
+// parsing encounters an error.
+int serdec_yaml_deserialize_string(SerdecYamlDeserializer* deser,
+    const char** value)
+{
+    return serdec_yaml_deserialize_string_n(deser, value, NULL);
+}
+
+int serdec_yaml_deserialize_string_n(SerdecYamlDeserializer* deser,
+    const char** value, size_t* length)
+{
+    if (next_scalar(deser)) {
+        return deser->error;
+    }
+
+    const char* scalar = (const char*)deser->event->data.scalar.value;
+    size_t scalar_length = deser->event->data.scalar.length;
+    if (SOURCE_NATIVE == deser->source) {
+        STATS_ADD(deser, scalar_bytes, scalar_length);
+        string_buffer_clear(&deser->scratch);
+        if (string_buffer_reserve(&deser->scratch, scalar_length) ||
+            string_buffer_append(&deser->scratch, scalar, scalar_length)) {
+            errno = ENOMEM;
+            deser->error = SERDEC_YAML_SYSTEM_ERROR;
+            return deser->error;
+        }
+        scalar = deser->scratch.string;
+    }
+
+    *value = scalar;
+    if (NULL != length) {
+        *length = scalar_length;
+    }
+    return 0;
+}
+
+// Like _string_n(), but the string is copied into the arena.
+int serdec_yaml_deserialize_string_arena(SerdecYamlDeserializer* deser,
+    SerdecArena* arena, const char** value, size_t* length)
+{
+    if (next_scalar(deser)) {
+        return deser->error;
+    }
+
+    // The arena's copy is NUL-terminated, so the scalar needn't be.
+    const char* scalar = (const char*)deser->event->data.scalar.value;
+    size_t scalar_length = deser->event->data.scalar.length;
+
+    STATS_ADD(deser, scalar_bytes, scalar_length);
+    char* copy = serdec_arena_strndup(arena, scalar, scalar_length);
+    if (NULL == copy) {
+        errno = ENOMEM;
+        deser->error = SERDEC_YAML_SYSTEM_ERROR;
+        return deser->error;
+    }
+
+    *value = copy;
+    if (NULL != length) {
+        *length = scalar_length;
+    }
+    return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Field Tables
+////
+
+// Build a field table from <count> fields.
+SerdecYamlFieldTable* serdec_yaml_field_table_new(
+    const SerdecYamlField* fields, size_t count, bool skip_unknown)
+{
+    return serdec_yaml_field_table_new_with_allocator(fields, count,
+        skip_unknown, NULL);
+}
+
+SerdecYamlFieldTable* serdec_yaml_field_table_new_with_allocator(
+    const SerdecYamlField* fields, size_t count, bool skip_unknown,
+    const SerdecAllocator* allocator)
+{
+    allocator = allocator_or_default(allocator);
+    SerdecYamlFieldTable* table = allocator_alloc(allocator,
+        sizeof(SerdecYamlFieldTable));
+    const char** keys = allocator_alloc(allocator,
+        (0 < count ? count : 1) * sizeof(const char*));
+    if (NULL == table || NULL == keys) {
+        allocator_free(allocator, table);
+        allocator_free(allocator, keys);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        keys[i] = fields[i].key;
+    }
+
+    table->allocator = *allocator;
+    int result = key_table_initialize(&table->keys, keys, count,
+        &table->allocator);
+    allocator_free(allocator, keys);
+    if (result) {
+        allocator_free(allocator, table);
+        return NULL;
+    }
+
+    table->fields = fields;
+    table->skip_unknown = skip_unknown;
+    return table;
+}
+
+void serdec_yaml_field_table_free(SerdecYamlFieldTable* table) {
+    key_table_delete(&table->keys);
+    SerdecAllocator allocator = table->allocator;
+    allocator_free(&allocator, table);
+}
+
+// De-serialize a map from the input stream, dispatching each entry through the
+// field table.
+int serdec_yaml_deserialize_map_table(SerdecYamlDeserializer* deser,
+    const SerdecYamlFieldTable* table, void* user_data)
+{
+    if (yaml_next_event(deser)) {
+        return deser->error;
+    }
+
+    if (YAML_MAPPING_START_EVENT != deser->event->type) {
+        deser->error = SERDEC_YAML_UNEXPECTED_EVENT;
+        return deser->error;
+    }
+
+    int result = 0;
+    while (!(result = yaml_next_event(deser)) &&
+        YAML_MAPPING_END_EVENT != deser->event->type)
+    {
+        if (YAML_SCALAR_EVENT != deser->event->type) {
+            deser->error = SERDEC_YAML_UNEXPECTED_EVENT;
+            return deser->error;
+        }
+
+        size_t index = key_table_lookup(&table->keys,
+            (const char*)deser->event->data.scalar.value,
+            deser->event->data.scalar.length);
+        if (KEY_TABLE_NOT_FOUND != index) {
+            STATS_CALLBACK_ENTER(deser);
+            int failed = table->fields[index].callback(deser, user_data,
+                index);
+            STATS_CALLBACK_LEAVE(deser);
+            if (failed) {
+                deser->error = SERDEC_YAML_CALLBACK_SIGNALED_ERROR;
+                return deser->error;
+            }
+        } else if (!table->skip_unknown) {
+            deser->error = SERDEC_YAML_UNKNOWN_KEY;
+            return deser->error;
+        } else if (serdec_yaml_deserialize_skip(deser)) {
+            return deser->error;
+        }
+    }
+
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Projections
+////
+
+// The visited paths of projections with at most this many paths are tracked on
+// the stack.
+#define PROJECTION_STACK_PATHS 256
+
+// The state of a call to _deserialize_projection(). A path is only counted
+// the first time that it's visited, in case its key appears more than once.
+typedef struct ProjectionWalk {
+    const SerdecYamlProjection* projection;
+    void* user_data;
+    size_t remaining;
+    uint64_t* visited;
+} ProjectionWalk;
+
+static int project_node(SerdecYamlDeserializer* deser, ProjectionWalk* walk,
+    size_t node);
+
+// Project the entries of a map, whose start has been consumed, onto the
+// children of <node>.
+static int project_map(SerdecYamlDeserializer* deser, ProjectionWalk* walk,
+    size_t node)
+{
+    const ProjectionNode* record = &walk->projection->nodes[node];
+    while (0 < walk->remaining) {
+        if (yaml_next_event(deser)) {
+            return deser->error;
+        } else if (YAML_MAPPING_END_EVENT == deser->event->type) {
+            return 0;
+        } else if (YAML_SCALAR_EVENT != deser->event->type) {
+            deser->error = SERDEC_YAML_UNEXPECTED_EVENT;
+            return deser->error;
+        }
+
+        size_t index = key_table_lookup(&record->keys,
+            (const char*)deser->event->data.scalar.value,
+            deser->event->data.scalar.length);
+        int result = KEY_TABLE_NOT_FOUND == index
+            ? serdec_yaml_deserialize_skip(deser)
+            : project_node(deser, walk, record->key_nodes[index]);
+        if (result) {
+            return deser->error;
+        }
+    }
+    return 0;
+}
+
+// Project the elements of a list, whose start has been consumed, onto the
+// children of <node>. Both are in ascending order of index.
+static int project_list(SerdecYamlDeserializer* deser, ProjectionWalk* walk,
+    size_t node)
+{
+    const ProjectionNode* record = &walk->projection->nodes[node];
+    size_t child = 0;
+    for (size_t index = 0; 0 < walk->remaining; ++index) {
+        if (yaml_peek_event(deser)) {
+            return deser->error;
+        } else if (YAML_SEQUENCE_END_EVENT == peeked_event(deser)->type) {
+            return yaml_next_event(deser);
+        }
+
+        int result = 0;
+        if (child < record->index_count &&
+            index == record->indices[child].index) {
+            result = project_node(deser, walk, record->indices[child++].node);
+        } else {
+            result = serdec_yaml_deserialize_skip(deser);
+        }
+        if (result) {
+            return deser->error;
+        }
+    }
+    return 0;
+}
+
+// Project the next value in the input stream onto <node>. Leaves are handed
+// to the callback of their path, and values which don't match the structure
+// of the projection are skipped.
+static int project_node(SerdecYamlDeserializer* deser, ProjectionWalk* walk,
+    size_t node)
+{
+    const ProjectionNode* record = &walk->projection->nodes[node];
+    if (PROJECTION_NO_PATH != record->path) {
+        size_t path = record->path;
+        STATS_CALLBACK_ENTER(deser);
+        int failed = walk->projection->paths[path].callback(deser,
+            walk->user_data, path);
+        STATS_CALLBACK_LEAVE(deser);
+        if (failed) {
+            deser->error = SERDEC_YAML_CALLBACK_SIGNALED_ERROR;
+            return deser->error;
+        }
+
+        uint64_t bit = (uint64_t)1 << (path % 64);
+        if (!(walk->visited[path / 64] & bit)) {
+            walk->visited[path / 64] |= bit;
+            --walk->remaining;
+        }
+        return 0;
+    }
+
+    if (yaml_next_event(deser)) {
+        return deser->error;
+    }
+
+    switch (deser->event->type) {
+    case YAML_MAPPING_START_EVENT:
+        if (NULL != record->key_nodes) {
+            return project_map(deser, walk, node);
+        }
+        return skip_events(deser, 1);
+    case YAML_SEQUENCE_START_EVENT:
+        if (0 < record->index_count) {
+            return project_list(deser, walk, node);
+        }
+        return skip_events(deser, 1);
+    case YAML_SCALAR_EVENT:
+    case YAML_ALIAS_EVENT:
+        return 0;
+    default:
+        deser->error = SERDEC_YAML_UNEXPECTED_EVENT;
+        return deser->error;
+    }
+}
+
+// Visit the paths of the projection, and stop once all of them have been
+// visited.
+int serdec_yaml_deserialize_projection(SerdecYamlDeserializer* deser,
+    const SerdecYamlProjection* projection, void* user_data)
+{
+    if (0 == projection->path_count) {
+        return 0;
+    }
+
+    uint64_t stack[PROJECTION_STACK_PATHS / 64] = {0};
+    ProjectionWalk walk = {
+        .projection = projection,
+        .user_data = user_data,
+        .remaining = projection->path_count,
+        .visited = stack,
+    };
+    if (PROJECTION_STACK_PATHS < projection->path_count) {
+        walk.visited = allocator_calloc(&deser->allocator,
+            (projection->path_count + 63) / 64, sizeof(uint64_t));
+        if (NULL == walk.visited) {
+            deser->error = SERDEC_YAML_SYSTEM_ERROR;
+            return deser->error;
+        }
+    }
+
+    int result = project_node(deser, &walk, 0);
+    if (stack != walk.visited) {
+        allocator_free(&deser->allocator, walk.visited);
+    }
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Tapes
+////
+
+// Replay <node> of <tape>. Return non-zero if the node doesn't exist.
+static int set_tape_input(SerdecYamlDeserializer* deser,
+    const SerdecYamlTape* tape, size_t node)
+{
+    if (node >= tape->count) {
+        deser->error = SERDEC_YAML_NOT_FOUND;
+        return deser->error;
+    }
+
+    tape_reader_init(&deser->tape, tape, node);
+    deser->source = SOURCE_TAPE;
+    return 0;
+}
+
+// Append the next value in the input stream to the tape.
+SerdecYamlTape* serdec_yaml_tape_new(SerdecYamlDeserializer* deser) {
+    SerdecYamlTape* tape = tape_new(CALLER_ALLOCATOR(deser));
+    if (NULL == tape) {
+        errno = ENOMEM;
+        deser->error = SERDEC_YAML_SYSTEM_ERROR;
+        return NULL;
+    }
+
+    int result = 0;
+    do {
+        if ((result = yaml_next_event(deser))) {
+            break;
+        }
+
+        const yaml_event_t* event = deser->event;
+        switch (event->type) {
+        case YAML_SCALAR_EVENT:
+            result = tape_append(tape, SERDEC_YAML_NODE_SCALAR,
+                (const char*)event->data.scalar.value,
+                event->data.scalar.length, event->data.scalar.style);
+            break;
+        case YAML_MAPPING_START_EVENT:
+            result = tape_append(tape, SERDEC_YAML_NODE_MAP, NULL, 0,
+                YAML_ANY_SCALAR_STYLE);
+            break;
+        case YAML_SEQUENCE_START_EVENT:
+            result = tape_append(tape, SERDEC_YAML_NODE_LIST, NULL, 0,
+                YAML_ANY_SCALAR_STYLE);
+            break;
+        case YAML_MAPPING_END_EVENT:
+        case YAML_SEQUENCE_END_EVENT:
+            if (tape_is_open(tape)) {
+                tape_close(tape);
+                break;
+            }
+            // fall through
+        default:
+            deser->error = SERDEC_YAML_UNEXPECTED_EVENT;
+            result = deser->error;
+            break;
+        }
+
+        if (0 > result) {
+            deser->error = SERDEC_YAML_SYSTEM_ERROR;
+            result = deser->error;
+        }
+    } while (!result && tape_is_open(tape));
+
+    if (result) {
+        serdec_yaml_tape_free(tape);
+        return NULL;
+    }
+    return tape;
+}
+
+SerdecYamlDeserializer* serdec_yaml_deserializer_new_tape(
+    const SerdecYamlTape* tape, size_t node)
+{
+    SerdecYamlDeserializerOptions options = {.allocator = &tape->allocator};
+    SerdecYamlDeserializer* deser = allocate_deserializer(&options);
+    if (NULL == deser) {
+        return NULL;
+    }
+
+    if (set_tape_input(deser, tape, node) || prepare_deserializer(deser)) {
+        serdec_yaml_deserializer_free(deser);
+        return NULL;
+    }
+    return deser;
+}
+
+int serdec_yaml_deserializer_reset_tape(SerdecYamlDeserializer* deser,
+    const SerdecYamlTape* tape, size_t node)
+{
+    reset_deserializer(deser);
+    if (set_tape_input(deser, tape, node)) {
+        return deser->error;
+    }
+    return prepare_deserializer(deser);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Statistics
+////
+
+int serdec_yaml_deserializer_stats(SerdecYamlDeserializer* deser,
+    SerdecYamlStats* stats)
+{
+#ifdef SERDEC_ENABLE_STATS
+    *stats = deser->stats.counters;
+    return 0;
+#else
+    (void)stats;
+    deser->error = SERDEC_YAML_NOT_SUPPORTED;
+    return deser->error;
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Generic Interface
+////
+
+// The visitors of the generic interface are invoked from the codec's, which
+// receive the generic de-serializer and visitor through this.
+typedef struct GenericVisit {
+    SerdecDeserializer* deser;
+    serdec_visit_map_callback* map;
+    serdec_visit_list_callback* list;
+    void* user_data;
+} GenericVisit;
+
+static int visit_generic_map(SerdecYamlDeserializer* deser,
+    void* user_data, const char* key)
+{
+    (void)deser;
+    GenericVisit* visit = user_data;
+    return visit->map(visit->deser, visit->user_data, key, strlen(key));
+}
+
+static int visit_generic_list(SerdecYamlDeserializer* deser,
+    void* user_data, size_t index)
+{
+    (void)deser;
+    GenericVisit* visit = user_data;
+    return visit->list(visit->deser, visit->user_data, index);
+}
+
+static int generic_map(SerdecDeserializer* deser,
+    serdec_visit_map_callback* callback, void* user_data)
+{
+    GenericVisit visit = {
+        .deser=deser, .map=callback, .user_data=user_data,
+    };
+    return serdec_yaml_deserialize_map(deser->codec, visit_generic_map,
+        &visit);
+}
+
+static int generic_list(SerdecDeserializer* deser,
+    serdec_visit_list_callback* callback, void* user_data)
+{
+    GenericVisit visit = {
+        .deser=deser, .list=callback, .user_data=user_data,
+    };
+    return serdec_yaml_deserialize_list(deser->codec, visit_generic_list,
+        &visit);
+}
+
+static int generic_bool(void* deser, bool* value) {
+    return serdec_yaml_deserialize_bool(deser, value);
+}
+
+static int generic_int(void* deser, int* value) {
+    return serdec_yaml_deserialize_int(deser, value);
+}
+
+static int generic_int64(void* deser, int64_t* value) {
+    return serdec_yaml_deserialize_int64(deser, value);
+}
+
+static int generic_uint64(void* deser, uint64_t* value) {
+    return serdec_yaml_deserialize_uint64(deser, value);
+}
+
+static int generic_size_t(void* deser, size_t* value) {
+    return serdec_yaml_deserialize_size_t(deser, value);
+}
+
+static int generic_double(void* deser, double* value) {
+    return serdec_yaml_deserialize_double(deser, value);
+}
+
+static int generic_string(void* deser, const char** value, size_t* length) {
+    return serdec_yaml_deserialize_string_n(deser, value, length);
+}
+
+static int generic_skip(void* deser) {
+    return serdec_yaml_deserialize_skip(deser);
+}
+
+static const char* generic_strerror(void* deser) {
+    return serdec_yaml_deserializer_strerror(deser);
+}
+
+const SerdecDeserializerOps SERDEC_YAML_DESERIALIZER_OPS = {
+    .map=generic_map,
+    .list=generic_list,
+    .boolean=generic_bool,
+    .integer=generic_int,
+    .int64=generic_int64,
+    .uint64=generic_uint64,
+    .size=generic_size_t,
+    .real=generic_double,
+    .string=generic_string,
+    .skip=generic_skip,
+    .strerror=generic_strerror,
+};
+
+///////////////////////////////////////////////////////////////////////////////
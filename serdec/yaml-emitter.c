@@ -0,0 +1,762 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            yaml-emitter.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Native emitter for the subset of YAML serdec produces.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <ctype.h>
+#include <string.h>
+#include <strings.h>
+
+#include <serdec/allocator-ops.h>
+#include <serdec/yaml-emitter.h>
+#include <serdec/yaml-error.h>
+
+static const size_t NATIVE_EMITTER_INITIAL_DEPTH = 16;
+
+///////////////////////////////////////////////////////////////////////////////
+// Private API
+////
+
+static int flush_buffer(NativeEmitter* emitter) {
+    if (0 == emitter->length) {
+        return 0;
+    }
+
+    size_t length = emitter->length;
+    emitter->length = 0;
+    if (!emitter->write(emitter->write_data, emitter->buffer, length)) {
+        emitter->write_failed = true;
+        return SERDEC_YAML_SYSTEM_ERROR;
+    }
+    return 0;
+}
+
+// Append raw bytes to the output. The bytes must not contain line breaks.
+static int put(NativeEmitter* emitter, const char* data, size_t length) {
+    emitter->column += (int)length;
+    if (length > NATIVE_EMITTER_BUFFER_SIZE - emitter->length) {
+        int result = flush_buffer(emitter);
+        if (result) {
+            return result;
+        }
+
+        if (length >= NATIVE_EMITTER_BUFFER_SIZE) {
+            if (!emitter->write(emitter->write_data, (unsigned char*)data,
+                    length)) {
+                emitter->write_failed = true;
+                return SERDEC_YAML_SYSTEM_ERROR;
+            }
+            return 0;
+        }
+    }
+
+    memcpy(emitter->buffer + emitter->length, data, length);
+    emitter->length += length;
+    return 0;
+}
+
+static int put_char(NativeEmitter* emitter, char character) {
+    if (NATIVE_EMITTER_BUFFER_SIZE == emitter->length) {
+        int result = flush_buffer(emitter);
+        if (result) {
+            return result;
+        }
+    }
+
+    emitter->buffer[emitter->length++] = (unsigned char)character;
+    emitter->column += 1;
+    return 0;
+}
+
+static int put_break(NativeEmitter* emitter) {
+    int result = put_char(emitter, '\n');
+    emitter->column = 0;
+    emitter->whitespace = true;
+    emitter->indention = true;
+    return result;
+}
+
+// Write text which is not part of the indentation.
+static int put_text(NativeEmitter* emitter, const char* data, size_t length) {
+    emitter->whitespace = false;
+    emitter->indention = false;
+    return put(emitter, data, length);
+}
+
+// Move to column <indent>, starting a new line if necessary. These are the
+// same rules libyaml applies in yaml_emitter_write_indent().
+static int write_indent(NativeEmitter* emitter, int indent) {
+    int result = 0;
+    if (!emitter->indention || emitter->column > indent ||
+        (emitter->column == indent && !emitter->whitespace)) {
+        result = put_break(emitter);
+    }
+
+    while (!result && emitter->column < indent) {
+        result = put_char(emitter, ' ');
+    }
+
+    emitter->whitespace = true;
+    emitter->indention = true;
+    return result;
+}
+
+// Write the "-" of a list item. This is an indentation indicator, so a block
+// collection in the item starts on the same line.
+static int write_item_indicator(NativeEmitter* emitter) {
+    int result = put_char(emitter, '-');
+    emitter->whitespace = false;
+    return result;
+}
+
+// Separate a node from the text before it, unless it's already separated.
+static int write_separator(NativeEmitter* emitter) {
+    if (emitter->whitespace) {
+        return 0;
+    }
+
+    int result = put_char(emitter, ' ');
+    emitter->whitespace = true;
+    return result;
+}
+
+// Write the indicator which opens a flow collection. The first entry follows
+// it without a space.
+static int write_flow_start(NativeEmitter* emitter, char indicator) {
+    int result = write_separator(emitter);
+    if (!result) {
+        result = put_char(emitter, indicator);
+    }
+    emitter->whitespace = true;
+    emitter->indention = false;
+    return result;
+}
+
+// Write the "," which separates an entry of a flow collection from the one
+// before it.
+static int write_flow_entry(NativeEmitter* emitter, const NativeFrame* frame) {
+    if (1 < frame->entries) {
+        return put_text(emitter, ",", 1);
+    }
+    return 0;
+}
+
+static NativeFrame* top_frame(NativeEmitter* emitter) {
+    if (0 == emitter->depth) {
+        return NULL;
+    }
+    return &emitter->frames[emitter->depth - 1];
+}
+
+static int push_frame(NativeEmitter* emitter, NativeFrameKind kind,
+    int indent)
+{
+    if (emitter->depth == emitter->capacity) {
+        size_t capacity = 2 * emitter->capacity;
+        if (0 == capacity) {
+            capacity = NATIVE_EMITTER_INITIAL_DEPTH;
+        }
+
+        NativeFrame* frames = allocator_realloc(emitter->allocator,
+            emitter->frames, capacity * sizeof(NativeFrame));
+        if (NULL == frames) {
+            return SERDEC_YAML_SYSTEM_ERROR;
+        }
+        emitter->frames = frames;
+        emitter->capacity = capacity;
+    }
+
+    NativeFrame* frame = &emitter->frames[emitter->depth++];
+    frame->kind = kind;
+    frame->indent = indent;
+    frame->entries = 0;
+    frame->expect_value = false;
+    frame->flow = false;
+    frame->pending = false;
+    return 0;
+}
+
+// Begin a node in the current collection: check that a node is allowed here,
+// and write the "-" (or ",") for list items. The first element of a pending
+// list decides its style: it's a flow list if the element is a <scalar>.
+static int begin_node(NativeEmitter* emitter, bool scalar) {
+    NativeFrame* frame = top_frame(emitter);
+    if (NULL == frame) {
+        return SERDEC_YAML_UNEXPECTED_EVENT;
+    }
+
+    switch (frame->kind) {
+    case NATIVE_FRAME_ROOT:
+        if (0 != frame->entries) {
+            return SERDEC_YAML_UNEXPECTED_EVENT;
+        }
+        frame->entries += 1;
+        return 0;
+    case NATIVE_FRAME_MAP:
+        if (!frame->expect_value) {
+            return SERDEC_YAML_UNEXPECTED_EVENT;
+        }
+        frame->expect_value = false;
+        return 0;
+    case NATIVE_FRAME_LIST: {
+        frame->entries += 1;
+        if (frame->pending) {
+            frame->pending = false;
+            if (scalar) {
+                frame->flow = true;
+                return write_flow_start(emitter, '[');
+            }
+        }
+
+        if (frame->flow) {
+            return write_flow_entry(emitter, frame);
+        }
+
+        int result = write_indent(emitter, frame->indent);
+        if (result) {
+            return result;
+        }
+        return write_item_indicator(emitter);
+    }
+    default:
+        return SERDEC_YAML_UNEXPECTED_EVENT;
+    }
+}
+
+// Indentation of a block collection nested in the current frame. Lists which
+// are the value of a map entry are not indented, like libyaml does.
+static int child_indent(NativeEmitter* emitter, NativeFrameKind kind) {
+    NativeFrame* parent = top_frame(emitter);
+    switch (parent->kind) {
+    case NATIVE_FRAME_MAP:
+        if (NATIVE_FRAME_LIST == kind) {
+            return parent->indent;
+        }
+        return parent->indent + emitter->style.indent;
+    case NATIVE_FRAME_LIST: return parent->indent + emitter->style.indent;
+    default: return 0;
+    }
+}
+
+// Begin a map or a list. Collections nested in a flow collection are flow
+// collections themselves, so they're opened right away.
+static int begin_collection(NativeEmitter* emitter, NativeFrameKind kind) {
+    int result = begin_node(emitter, false);
+    if (result) {
+        return result;
+    }
+
+    bool flow = top_frame(emitter)->flow;
+    result = push_frame(emitter, kind, child_indent(emitter, kind));
+    if (result) {
+        return result;
+    }
+
+    NativeFrame* frame = top_frame(emitter);
+    if (flow) {
+        frame->flow = true;
+        return write_flow_start(emitter, NATIVE_FRAME_MAP == kind ? '{' : '[');
+    }
+
+    frame->pending = NATIVE_FRAME_LIST == kind &&
+        emitter->style.flow_scalar_lists;
+    return 0;
+}
+
+static int end_collection(NativeEmitter* emitter, NativeFrameKind kind) {
+    NativeFrame* frame = top_frame(emitter);
+    if (NULL == frame || kind != frame->kind || frame->expect_value) {
+        return SERDEC_YAML_UNEXPECTED_EVENT;
+    }
+
+    // Empty block collections are written as empty flow collections.
+    int result = 0;
+    bool map = NATIVE_FRAME_MAP == kind;
+    if (!frame->flow && 0 == frame->entries) {
+        result = write_flow_start(emitter, map ? '{' : '[');
+    }
+    if (!result && (frame->flow || 0 == frame->entries)) {
+        result = put_text(emitter, map ? "}" : "]", 1);
+    }
+    emitter->depth -= 1;
+    return result;
+}
+
+// YAML 1.1 reads NEL, LS and PS as line breaks, and a BOM as the start of a
+// stream, so they can't be written raw. Return the escape which libyaml writes
+// for the one which begins at <value> (in UTF-8), and set <length> to its
+// length, or return NULL if there's none there.
+static const char* special_escape(const char* value, size_t remaining,
+    size_t* length)
+{
+    const unsigned char* bytes = (const unsigned char*)value;
+    if (2 <= remaining && 0xc2 == bytes[0] && 0x85 == bytes[1]) {
+        *length = 2;
+        return "\\N";
+    } else if (3 > remaining) {
+        return NULL;
+    }
+
+    *length = 3;
+    if (0xe2 == bytes[0] && 0x80 == bytes[1] && 0xa8 == bytes[2]) {
+        return "\\L";
+    } else if (0xe2 == bytes[0] && 0x80 == bytes[1] && 0xa9 == bytes[2]) {
+        return "\\P";
+    } else if (0xef == bytes[0] && 0xbb == bytes[1] && 0xbf == bytes[2]) {
+        return "\\uFEFF";
+    }
+    return NULL;
+}
+
+// Whether any character of <value> must be escaped.
+static bool needs_escapes(const char* value, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        unsigned char character = (unsigned char)value[i];
+        size_t special = 0;
+        if (0x20 > character || 0x7f == character ||
+            (0x80 <= character &&
+                NULL != special_escape(value + i, length - i, &special))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Whether <key> can be written as a plain scalar in a block mapping. This is a
+// conservative version of the analysis in yaml_emitter_analyze_scalar().
+static bool is_plain_key(const char* key, size_t length) {
+    if (0 == length || ' ' == key[0] || ' ' == key[length - 1]) {
+        return false;
+    }
+
+    if (3 <= length && (!memcmp(key, "---", 3) || !memcmp(key, "...", 3))) {
+        return false;
+    }
+
+    switch (key[0]) {
+    case '[': case ']': case '{': case '}': case ',': case '#': case '&':
+    case '*': case '!': case '|': case '>': case '\'': case '"': case '%':
+    case '@': case '`':
+        return false;
+    case '-': case '?': case ':':
+        if (1 == length || ' ' == key[1]) {
+            return false;
+        }
+        break;
+    default:
+        break;
+    }
+
+    if (needs_escapes(key, length)) {
+        return false;
+    }
+
+    for (size_t i = 0; i < length; ++i) {
+        unsigned char character = (unsigned char)key[i];
+        if (':' == character &&
+            (i + 1 == length || ' ' == key[i + 1])) {
+            return false;
+        } else if ('#' == character && 0 < i && ' ' == key[i - 1]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Whether <value> contains characters which end a plain scalar in a flow
+// collection.
+static bool has_flow_indicators(const char* value, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        if (NULL != memchr(",?[]{}:", value[i], 7)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Whether <value> is one of the words which YAML 1.1 resolves as a boolean or
+// a null, in any case.
+static bool is_reserved_word(const char* value, size_t length) {
+    static const char* WORDS[] = {"y", "n", "yes", "no", "on", "off", "true",
+        "false", "null"};
+    for (size_t i = 0; i < sizeof(WORDS) / sizeof(WORDS[0]); ++i) {
+        if (length == strlen(WORDS[i]) &&
+            !strncasecmp(value, WORDS[i], length)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool is_plain_string(const char* value, size_t length) {
+    // Numbers, and every indicator, begin with something else.
+    if (0 == length || !(isalpha((unsigned char)value[0]) ||
+            '_' == value[0] || '/' == value[0])) {
+        return false;
+    }
+
+    // libyaml quotes anything which isn't printable ASCII.
+    for (size_t i = 0; i < length; ++i) {
+        if (0x7f <= (unsigned char)value[i]) {
+            return false;
+        }
+    }
+    return is_plain_key(value, length) &&
+        !has_flow_indicators(value, length) &&
+        !is_reserved_word(value, length);
+}
+
+static int write_single_quoted(NativeEmitter* emitter, const char* value,
+    size_t length)
+{
+    int result = put_text(emitter, "'", 1);
+    const char* end = value + length;
+    while (!result && value < end) {
+        const char* quote = memchr(value, '\'', end - value);
+        if (NULL == quote) {
+            result = put(emitter, value, end - value);
+            break;
+        }
+
+        result = put(emitter, value, quote - value + 1);
+        if (!result) {
+            result = put_char(emitter, '\'');
+        }
+        value = quote + 1;
+    }
+
+    if (!result) {
+        result = put_char(emitter, '\'');
+    }
+    return result;
+}
+
+static int write_double_quoted(NativeEmitter* emitter, const char* value,
+    size_t length)
+{
+    static const char HEX[] = "0123456789ABCDEF";
+    int result = put_text(emitter, "\"", 1);
+    size_t run = 0;
+    for (size_t i = 0; !result && i < length; ++i) {
+        unsigned char character = (unsigned char)value[i];
+        const char* special = NULL;
+        size_t special_length = 1;
+        char escape = 0;
+        switch (character) {
+        case '\0': escape = '0'; break;
+        case '\a': escape = 'a'; break;
+        case '\b': escape = 'b'; break;
+        case '\t': escape = 't'; break;
+        case '\n': escape = 'n'; break;
+        case '\v': escape = 'v'; break;
+        case '\f': escape = 'f'; break;
+        case '\r': escape = 'r'; break;
+        case 0x1b: escape = 'e'; break;
+        case '"': escape = '"'; break;
+        case '\\': escape = '\\'; break;
+        default:
+            if (0x80 <= character) {
+                special = special_escape(value + i, length - i,
+                    &special_length);
+                if (NULL == special) {
+                    continue;
+                }
+            } else if (0x20 <= character && 0x7f != character) {
+                continue;
+            }
+            break;
+        }
+
+        // Write the run of characters which need no escaping.
+        result = put(emitter, value + run, i - run);
+        i += special_length - 1;
+        run = i + 1;
+        if (result) {
+            break;
+        }
+
+        if (NULL != special) {
+            result = put(emitter, special, strlen(special));
+        } else if (escape) {
+            char sequence[2] = {'\\', escape};
+            result = put(emitter, sequence, sizeof(sequence));
+        } else {
+            char sequence[4] = {'\\', 'x', HEX[character >> 4],
+                HEX[character & 0xf]};
+            result = put(emitter, sequence, sizeof(sequence));
+        }
+    }
+
+    if (!result) {
+        result = put(emitter, value + run, length - run);
+    }
+    if (!result) {
+        result = put_char(emitter, '"');
+    }
+    return result;
+}
+
+static int append_output(void* data, unsigned char* buffer, size_t size) {
+    return !string_buffer_append(data, (const char*)buffer, size);
+}
+
+static int write_quoted(NativeEmitter* emitter, const char* value,
+    size_t length)
+{
+    if (needs_escapes(value, length)) {
+        return write_double_quoted(emitter, value, length);
+    }
+    return write_single_quoted(emitter, value, length);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Public API
+////
+
+void native_emitter_initialize(NativeEmitter* emitter,
+    yaml_write_handler_t* write, void* write_data,
+    const NativeEmitterStyle* style, const SerdecAllocator* allocator)
+{
+    memset(emitter, 0, sizeof(*emitter));
+    emitter->allocator = allocator;
+    emitter->write = write;
+    emitter->write_data = write_data;
+    emitter->style = *style;
+    emitter->whitespace = true;
+    emitter->indention = true;
+}
+
+void native_emitter_delete(NativeEmitter* emitter) {
+    allocator_free(emitter->allocator, emitter->frames);
+    emitter->frames = NULL;
+    emitter->depth = 0;
+    emitter->capacity = 0;
+}
+
+void native_emitter_reset(NativeEmitter* emitter) {
+    emitter->column = 0;
+    emitter->whitespace = true;
+    emitter->indention = true;
+    emitter->write_failed = false;
+    emitter->open_ended = false;
+    emitter->depth = 0;
+    emitter->length = 0;
+}
+
+int native_emitter_document_start(NativeEmitter* emitter) {
+    if (0 != emitter->depth) {
+        return SERDEC_YAML_UNEXPECTED_EVENT;
+    }
+
+    // Without directives, the first document needs no "---" either, and the
+    // documents after it need no "...".
+    int result = 0;
+    if (emitter->style.omit_directives) {
+        if (emitter->open_ended) {
+            result = put_text(emitter, "---", 3);
+        }
+    } else {
+        if (emitter->open_ended) {
+            result = put_text(emitter, "...", 3);
+            if (!result) {
+                result = put_break(emitter);
+            }
+        }
+        if (!result) {
+            result = put_text(emitter, "%YAML 1.1", 9);
+        }
+        if (!result) {
+            result = put_break(emitter);
+        }
+        if (!result) {
+            result = put_text(emitter, "---", 3);
+        }
+    }
+
+    emitter->open_ended = false;
+    if (!result) {
+        result = push_frame(emitter, NATIVE_FRAME_ROOT, 0);
+    }
+    return result;
+}
+
+int native_emitter_document_end(NativeEmitter* emitter) {
+    NativeFrame* frame = top_frame(emitter);
+    if (NULL == frame || NATIVE_FRAME_ROOT != frame->kind) {
+        return SERDEC_YAML_UNEXPECTED_EVENT;
+    }
+
+    emitter->depth = 0;
+    emitter->open_ended = true;
+    int result = 0;
+    if (0 < emitter->column) {
+        result = put_break(emitter);
+    }
+    if (!result) {
+        result = flush_buffer(emitter);
+    }
+    return result;
+}
+
+int native_emitter_map_start(NativeEmitter* emitter) {
+    return begin_collection(emitter, NATIVE_FRAME_MAP);
+}
+
+int native_emitter_map_end(NativeEmitter* emitter) {
+    return end_collection(emitter, NATIVE_FRAME_MAP);
+}
+
+int native_emitter_map_key(NativeEmitter* emitter, const char* key,
+    size_t length)
+{
+    return native_emitter_map_key_analyzed(emitter, key, length,
+        is_plain_key(key, length));
+}
+
+int native_emitter_map_key_analyzed(NativeEmitter* emitter, const char* key,
+    size_t length, bool plain)
+{
+    NativeFrame* frame = top_frame(emitter);
+    if (NULL == frame || NATIVE_FRAME_MAP != frame->kind ||
+        frame->expect_value) {
+        return SERDEC_YAML_UNEXPECTED_EVENT;
+    }
+
+    frame->entries += 1;
+    frame->expect_value = true;
+    int result = 0;
+    if (frame->flow) {
+        plain = plain && !has_flow_indicators(key, length);
+        result = write_flow_entry(emitter, frame);
+        if (!result) {
+            result = write_separator(emitter);
+        }
+    } else {
+        result = write_indent(emitter, frame->indent);
+    }
+    if (result) {
+        return result;
+    }
+
+    if (plain) {
+        result = put_text(emitter, key, length);
+    } else {
+        result = write_quoted(emitter, key, length);
+    }
+
+    if (!result) {
+        result = put_char(emitter, ':');
+    }
+    return result;
+}
+
+int native_emitter_map_key_encoded(NativeEmitter* emitter, const char* key,
+    size_t length, const char* encoded, size_t encoded_length)
+{
+    NativeFrame* frame = top_frame(emitter);
+    if (NULL == frame || NATIVE_FRAME_MAP != frame->kind ||
+        frame->expect_value) {
+        return SERDEC_YAML_UNEXPECTED_EVENT;
+    } else if (frame->flow) {
+        return native_emitter_map_key(emitter, key, length);
+    }
+
+    frame->entries += 1;
+    frame->expect_value = true;
+    int result = write_indent(emitter, frame->indent);
+    if (result) {
+        return result;
+    }
+    return put_text(emitter, encoded, encoded_length);
+}
+
+int native_emitter_list_start(NativeEmitter* emitter) {
+    return begin_collection(emitter, NATIVE_FRAME_LIST);
+}
+
+int native_emitter_list_end(NativeEmitter* emitter) {
+    return end_collection(emitter, NATIVE_FRAME_LIST);
+}
+
+int native_emitter_scalar(NativeEmitter* emitter, const char* value,
+    size_t length, NativeScalarStyle style)
+{
+    int result = begin_node(emitter, true);
+    if (!result) {
+        result = write_separator(emitter);
+    }
+    if (result) {
+        return result;
+    }
+
+    if (NATIVE_SCALAR_PLAIN == style || (NATIVE_SCALAR_STRING == style &&
+            is_plain_string(value, length))) {
+        return put_text(emitter, value, length);
+    }
+    return write_quoted(emitter, value, length);
+}
+
+int native_emitter_flush(NativeEmitter* emitter) {
+    return flush_buffer(emitter);
+}
+
+bool native_emitter_is_plain_key(const char* key, size_t length) {
+    return is_plain_key(key, length);
+}
+
+bool native_emitter_is_plain_string(const char* value, size_t length) {
+    return is_plain_string(value, length);
+}
+
+int native_emitter_encode_key(const char* key, size_t length,
+    StringBuffer* output)
+{
+    NativeEmitter emitter;
+    NativeEmitterStyle style = {0};
+    native_emitter_initialize(&emitter, append_output, output, &style,
+        output->allocator);
+    int result = 0;
+    if (is_plain_key(key, length)) {
+        result = put_text(&emitter, key, length);
+    } else {
+        result = write_quoted(&emitter, key, length);
+    }
+
+    if (!result) {
+        result = put_char(&emitter, ':');
+    }
+    if (!result) {
+        result = flush_buffer(&emitter);
+    }
+    native_emitter_delete(&emitter);
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
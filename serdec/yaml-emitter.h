@@ -0,0 +1,168 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            yaml-emitter.h
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Native emitter for the subset of YAML serdec produces.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#ifndef SERDEC_YAML_EMITTER_H
+#define SERDEC_YAML_EMITTER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <yaml.h>
+
+#include <serdec/allocator.h>
+#include <serdec/string-ops.h>
+
+// The native emitter writes block maps, block lists, plain keys and quoted
+// strings directly, without building events or re-analyzing scalars. Its
+// layout matches libyaml's for the documents serdec produces. Every routine
+// returns zero on success, or one of the SERDEC_YAML_* error codes.
+
+#define NATIVE_EMITTER_BUFFER_SIZE 16384
+
+typedef enum NativeFrameKind {
+    NATIVE_FRAME_ROOT,
+    NATIVE_FRAME_MAP,
+    NATIVE_FRAME_LIST,
+} NativeFrameKind;
+
+// Frames of flow collections are <flow>. A <pending> list has written nothing
+// yet: its style is chosen when its first element begins.
+typedef struct NativeFrame {
+    NativeFrameKind kind;
+    int indent;
+    size_t entries;
+    bool expect_value;
+    bool flow;
+    bool pending;
+} NativeFrame;
+
+// Layout choices of the emitter. Lists whose first element is a scalar are
+// written in flow style if <flow_scalar_lists>, and so is everything nested in
+// a flow collection. Flow collections are never wrapped across lines.
+typedef struct NativeEmitterStyle {
+    int indent;
+    bool flow_scalar_lists;
+    bool omit_directives;
+} NativeEmitterStyle;
+
+typedef struct NativeEmitter {
+    yaml_write_handler_t* write;
+    void* write_data;
+    NativeEmitterStyle style;
+    const SerdecAllocator* allocator;
+
+    // Layout state, tracked the same way libyaml does.
+    int column;
+    bool whitespace;
+    bool indention;
+
+    // Set when the output handler fails. The handler records its own error.
+    bool write_failed;
+
+    // Set once a document has ended without a "..." marker, which must
+    // precede the directives of the next one.
+    bool open_ended;
+
+    NativeFrame* frames;
+    size_t depth;
+    size_t capacity;
+
+    size_t length;
+    unsigned char buffer[NATIVE_EMITTER_BUFFER_SIZE];
+} NativeEmitter;
+
+// Scalars with NATIVE_SCALAR_PLAIN are written verbatim (e.g. integers and
+// booleans). NATIVE_SCALAR_QUOTED scalars are single-quoted, unless they
+// contain characters which must be escaped, in which case they're
+// double-quoted. NATIVE_SCALAR_STRING scalars are written like
+// NATIVE_SCALAR_PLAIN ones if native_emitter_is_plain_string(), or else like
+// NATIVE_SCALAR_QUOTED ones.
+typedef enum NativeScalarStyle {
+    NATIVE_SCALAR_PLAIN,
+    NATIVE_SCALAR_QUOTED,
+    NATIVE_SCALAR_STRING,
+} NativeScalarStyle;
+
+void native_emitter_initialize(NativeEmitter* emitter,
+    yaml_write_handler_t* write, void* write_data,
+    const NativeEmitterStyle* style, const SerdecAllocator* allocator);
+void native_emitter_delete(NativeEmitter* emitter);
+
+// Discard any buffered output and open frames, as if the emitter had just
+// been initialized, but keep the memory it has allocated.
+void native_emitter_reset(NativeEmitter* emitter);
+
+int native_emitter_document_start(NativeEmitter* emitter);
+int native_emitter_document_end(NativeEmitter* emitter);
+
+int native_emitter_map_start(NativeEmitter* emitter);
+int native_emitter_map_end(NativeEmitter* emitter);
+int native_emitter_map_key(NativeEmitter* emitter, const char* key,
+    size_t length);
+
+// Like _map_key(), for keys which have already been analyzed with
+// native_emitter_is_plain_key(). <plain> is the result of that analysis.
+int native_emitter_map_key_analyzed(NativeEmitter* emitter, const char* key,
+    size_t length, bool plain);
+
+// Like _map_key(), for keys which have been encoded with
+// native_emitter_encode_key(). They're written with a single copy, except in
+// flow collections, where they're written like any other key.
+int native_emitter_map_key_encoded(NativeEmitter* emitter, const char* key,
+    size_t length, const char* encoded, size_t encoded_length);
+
+int native_emitter_list_start(NativeEmitter* emitter);
+int native_emitter_list_end(NativeEmitter* emitter);
+
+int native_emitter_scalar(NativeEmitter* emitter, const char* value,
+    size_t length, NativeScalarStyle style);
+
+// Pass any buffered output to the output handler.
+int native_emitter_flush(NativeEmitter* emitter);
+
+// Whether <key> can be written without quotes. Keys which are written many
+// times can be analyzed once, and passed to _map_key_analyzed().
+bool native_emitter_is_plain_key(const char* key, size_t length);
+
+// Whether <value> can be written without quotes anywhere, and reads back as
+// the same string, instead of e.g. a number or a boolean. This is stricter than
+// libyaml's analysis, so both backends make the same choice.
+bool native_emitter_is_plain_string(const char* value, size_t length);
+
+// Append <key> to <output>, exactly as _map_key() writes it after the
+// indentation of a block map, including the ":".
+int native_emitter_encode_key(const char* key, size_t length,
+    StringBuffer* output);
+
+#endif // SERDEC_YAML_EMITTER_H
+
+///////////////////////////////////////////////////////////////////////////////
@@ -7,7 +7,7 @@
 //
 // CREATED:         02/04/2022
 //
-// LAST EDITED:     02/05/2022
+// LAST EDITED:     10/14/2026
 //
 // Copyright 2022, Ethan D. Twardy
 //
@@ -39,10 +39,23 @@ enum {
     SERDEC_YAML_UNKNOWN_ERROR,
     SERDEC_YAML_SYSTEM_ERROR,
     SERDEC_YAML_WRONG_TYPE,
-    SERDEC_YAML_MAX_ERROR,
     SERDEC_YAML_UNEXPECTED_EVENT,
     SERDEC_YAML_INVALID_BOOLEAN_TOKEN,
     SERDEC_YAML_CALLBACK_SIGNALED_ERROR,
+    SERDEC_YAML_BUFFER_OVERFLOW,
+    SERDEC_YAML_INVALID_STATE,
+    SERDEC_YAML_INVALID_NUMBER,
+    SERDEC_YAML_OUT_OF_RANGE,
+    SERDEC_YAML_UNKNOWN_KEY,
+    SERDEC_YAML_END_OF_STREAM,
+    SERDEC_YAML_NEED_MORE_DATA,
+    SERDEC_YAML_SYNTAX_ERROR,
+    SERDEC_YAML_INVALID_PATH,
+    SERDEC_YAML_NOT_FOUND,
+    SERDEC_YAML_NOT_SUPPORTED,
+
+    // Keep this last, so that the strerror routines cover every error.
+    SERDEC_YAML_MAX_ERROR,
 };
 
 #endif // SERDEC_YAML_ERROR_H
@@ -0,0 +1,379 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            yaml-parallel.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Parallel de-serialization of multi-document streams.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <serdec/allocator-ops.h>
+#include <serdec/push-input.h>
+#include <serdec/string-ops.h>
+#include <serdec/yaml.h>
+#include <serdec/yaml-error.h>
+
+// Input which isn't a regular file is read in blocks of this size.
+#define READ_BLOCK_SIZE 65536
+
+typedef struct Document {
+    const char* start;
+    size_t length;
+
+    // The outcome of the document, which is valid once <done> is set.
+    void* result;
+    int status;
+    bool done;
+} Document;
+
+typedef struct ParallelRun {
+    yaml_visit_document_callback* visit;
+    void* user_data;
+    const SerdecAllocator* allocator;
+
+    Document* documents;
+    size_t count;
+    size_t capacity;
+
+    // The rest is guarded by <lock>. Documents before <started> have been
+    // taken by a worker, and the indices of those which are done are appended
+    // to <completed> in the order they finished. <progress> is signaled
+    // whenever a document is done.
+    pthread_mutex_t lock;
+    pthread_cond_t progress;
+    size_t started;
+    size_t* completed;
+    size_t completed_count;
+    bool stopped;
+} ParallelRun;
+
+typedef struct Worker {
+    ParallelRun* run;
+    SerdecYamlDeserializer* deser;
+    pthread_t thread;
+} Worker;
+
+///////////////////////////////////////////////////////////////////////////////
+// Private API
+////
+
+static int add_document(ParallelRun* run, const char* start, size_t length) {
+    if (run->count == run->capacity) {
+        size_t capacity = 0 == run->capacity ? 16 : run->capacity * 2;
+        if (capacity > SIZE_MAX / sizeof(Document)) {
+            errno = ENOMEM;
+            return -1;
+        }
+
+        Document* documents = allocator_realloc(run->allocator,
+            run->documents, capacity * sizeof(Document));
+        if (NULL == documents) {
+            return -1;
+        }
+        run->documents = documents;
+        run->capacity = capacity;
+    }
+
+    run->documents[run->count++] = (Document){.start = start,
+        .length = length};
+    return 0;
+}
+
+// Split <string> into its documents, with the scan used for pushed input.
+// Input which contains no document (e.g. trailing comments) is dropped.
+static int split_documents(ParallelRun* run, const char* string,
+    size_t length)
+{
+    size_t offset = 0;
+    while (offset < length) {
+        DocumentScan scan = {.start = offset, .scanned = offset};
+        size_t end = document_scan_next(&scan, string, length, true);
+        if (scan.content &&
+            add_document(run, string + scan.start, end - scan.start)) {
+            return -1;
+        }
+        offset = end;
+    }
+    return 0;
+}
+
+// Take documents from the run until there are none left, or it's stopped.
+static void* run_worker(void* argument) {
+    Worker* worker = argument;
+    ParallelRun* run = worker->run;
+    pthread_mutex_lock(&run->lock);
+    while (!run->stopped && run->started < run->count) {
+        size_t index = run->started++;
+        Document* document = &run->documents[index];
+        pthread_mutex_unlock(&run->lock);
+
+        void* result = NULL;
+        int status = serdec_yaml_deserializer_reset_string(worker->deser,
+            document->start, document->length);
+        if (0 == status) {
+            status = run->visit(worker->deser, run->user_data, index,
+                &result);
+        }
+
+        pthread_mutex_lock(&run->lock);
+        document->result = result;
+        document->status = status;
+        document->done = true;
+        run->completed[run->completed_count++] = index;
+        if (0 != status) {
+            run->stopped = true;
+        }
+        pthread_cond_signal(&run->progress);
+    }
+    pthread_mutex_unlock(&run->lock);
+    return NULL;
+}
+
+// Deliver every document which is started, on the calling thread, until the
+// workers have run out of documents.
+static int deliver_documents(ParallelRun* run,
+    yaml_deliver_document_callback* deliver, SerdecYamlDeliveryOrder order)
+{
+    int result = 0;
+    size_t delivered = 0;
+    pthread_mutex_lock(&run->lock);
+    while (delivered < run->started ||
+        (!run->stopped && run->started < run->count)) {
+        // Documents are started in order, so those which have been delivered
+        // in order are always a prefix of those which have been started.
+        Document* document = NULL;
+        size_t index = delivered;
+        if (SERDEC_YAML_DELIVER_IN_ORDER == order) {
+            if (delivered < run->started && run->documents[index].done) {
+                document = &run->documents[index];
+            }
+        } else if (delivered < run->completed_count) {
+            index = run->completed[delivered];
+            document = &run->documents[index];
+        }
+
+        if (NULL == document) {
+            pthread_cond_wait(&run->progress, &run->lock);
+            continue;
+        }
+
+        pthread_mutex_unlock(&run->lock);
+        int status = document->status;
+        if (NULL != deliver) {
+            int value = deliver(run->user_data, index, document->result,
+                status);
+            if (0 == status) {
+                status = value;
+            }
+        }
+        ++delivered;
+
+        pthread_mutex_lock(&run->lock);
+        if (0 != status) {
+            run->stopped = true;
+            if (0 == result) {
+                result = status;
+            }
+        }
+    }
+    pthread_mutex_unlock(&run->lock);
+    return result;
+}
+
+// The number of workers to start for <count> documents.
+static size_t count_workers(const SerdecYamlParallelOptions* options,
+    size_t count)
+{
+    size_t threads = options->threads;
+    if (0 == threads) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = 0 < online ? (size_t)online : 1;
+    }
+    return threads < count ? threads : count;
+}
+
+// Start the workers, deliver the documents, and wait for the workers to
+// finish.
+static int run_workers(ParallelRun* run,
+    yaml_deliver_document_callback* deliver,
+    const SerdecYamlParallelOptions* options)
+{
+    size_t threads = count_workers(options, run->count);
+    Worker* workers = allocator_calloc(run->allocator, threads,
+        sizeof(Worker));
+    if (NULL == workers) {
+        return SERDEC_YAML_SYSTEM_ERROR;
+    }
+
+    // If some of the workers can't be started, the others do all of the work.
+    size_t running = 0;
+    while (running < threads) {
+        Worker* worker = &workers[running];
+        worker->run = run;
+        worker->deser = serdec_yaml_deserializer_new_string_with_options("",
+            0, &options->deserializer);
+        if (NULL == worker->deser) {
+            break;
+        }
+
+        int error = pthread_create(&worker->thread, NULL, run_worker, worker);
+        if (0 != error) {
+            serdec_yaml_deserializer_free(worker->deser);
+            errno = error;
+            break;
+        }
+        ++running;
+    }
+
+    int result = SERDEC_YAML_SYSTEM_ERROR;
+    if (0 < running) {
+        result = deliver_documents(run, deliver, options->order);
+    }
+
+    for (size_t i = 0; i < running; ++i) {
+        pthread_join(workers[i].thread, NULL);
+        serdec_yaml_deserializer_free(workers[i].deser);
+    }
+    allocator_free(run->allocator, workers);
+    return result;
+}
+
+// Read the whole of <fd> into <buffer>.
+static int read_file(int fd, StringBuffer* buffer) {
+    while (true) {
+        if (string_buffer_reserve(buffer, READ_BLOCK_SIZE)) {
+            return -1;
+        }
+
+        ssize_t count = read(fd, buffer->string + buffer->length,
+            READ_BLOCK_SIZE);
+        if (0 > count && EINTR == errno) {
+            continue;
+        } else if (0 > count) {
+            return -1;
+        } else if (0 == count) {
+            return 0;
+        }
+        buffer->length += (size_t)count;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Public API
+////
+
+int serdec_yaml_parallel_for_each_document(const char* string, size_t length,
+    yaml_visit_document_callback* visit,
+    yaml_deliver_document_callback* deliver, void* user_data,
+    const SerdecYamlParallelOptions* options)
+{
+    SerdecYamlParallelOptions defaults = {0};
+    if (NULL == options) {
+        options = &defaults;
+    }
+
+    ParallelRun run = {
+        .visit = visit,
+        .user_data = user_data,
+        .allocator = allocator_or_default(options->deserializer.allocator),
+    };
+    if (split_documents(&run, string, length)) {
+        allocator_free(run.allocator, run.documents);
+        return SERDEC_YAML_SYSTEM_ERROR;
+    } else if (0 == run.count) {
+        return 0;
+    }
+
+    int result = SERDEC_YAML_SYSTEM_ERROR;
+    run.completed = allocator_calloc(run.allocator, run.count,
+        sizeof(size_t));
+    if (NULL != run.completed) {
+        pthread_mutex_init(&run.lock, NULL);
+        pthread_cond_init(&run.progress, NULL);
+        result = run_workers(&run, deliver, options);
+        pthread_cond_destroy(&run.progress);
+        pthread_mutex_destroy(&run.lock);
+    }
+
+    allocator_free(run.allocator, run.completed);
+    allocator_free(run.allocator, run.documents);
+    return result;
+}
+
+int serdec_yaml_parallel_for_each_document_path(const char* path,
+    yaml_visit_document_callback* visit,
+    yaml_deliver_document_callback* deliver, void* user_data,
+    const SerdecYamlParallelOptions* options)
+{
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (0 > fd) {
+        return SERDEC_YAML_SYSTEM_ERROR;
+    }
+
+    struct stat status = {0};
+    if (fstat(fd, &status)) {
+        close(fd);
+        return SERDEC_YAML_SYSTEM_ERROR;
+    }
+
+    if (S_ISREG(status.st_mode) && 0 < status.st_size &&
+        SIZE_MAX >= (uintmax_t)status.st_size) {
+        size_t length = (size_t)status.st_size;
+        void* mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (MAP_FAILED != mapping) {
+            close(fd);
+            int result = serdec_yaml_parallel_for_each_document(mapping,
+                length, visit, deliver, user_data, options);
+            munmap(mapping, length);
+            return result;
+        }
+    }
+
+    // Anything which can't be mapped (e.g. a pipe) is read into memory first,
+    // since the documents are split before they're parsed.
+    StringBuffer buffer;
+    string_buffer_init(&buffer, allocator_or_default(
+        NULL != options ? options->deserializer.allocator : NULL));
+    int result = SERDEC_YAML_SYSTEM_ERROR;
+    if (0 == read_file(fd, &buffer)) {
+        result = serdec_yaml_parallel_for_each_document(buffer.string,
+            buffer.length, visit, deliver, user_data, options);
+    }
+    close(fd);
+    string_buffer_release(&buffer);
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,90 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            yaml-path.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Parsing of paths to nodes within a document.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <stdint.h>
+#include <string.h>
+
+#include <serdec/yaml-error.h>
+#include <serdec/yaml-path.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// Public API
+////
+
+int path_parse_segment(const char* path, const char** cursor,
+    PathSegment* segment)
+{
+    const char* position = *cursor;
+    memset(segment, 0, sizeof(PathSegment));
+    if ('[' == *position) {
+        ++position;
+        if ('0' > *position || '9' < *position) {
+            return SERDEC_YAML_INVALID_PATH;
+        }
+
+        segment->is_index = true;
+        while ('0' <= *position && '9' >= *position) {
+            size_t digit = (size_t)(*position++ - '0');
+            segment->index = segment->index > (SIZE_MAX - digit) / 10
+                ? SIZE_MAX : segment->index * 10 + digit;
+        }
+        if (']' != *position) {
+            return SERDEC_YAML_INVALID_PATH;
+        }
+        *cursor = position + 1;
+        return 0;
+    }
+
+    // Keys after the first are separated by a '.'.
+    if (path != position && '.' != *position++) {
+        return SERDEC_YAML_INVALID_PATH;
+    }
+    segment->key = position;
+    segment->length = strcspn(position, ".[");
+    if (0 == segment->length) {
+        return SERDEC_YAML_INVALID_PATH;
+    }
+    *cursor = position + segment->length;
+    return 0;
+}
+
+bool path_segment_equal(const PathSegment* first, const PathSegment* second)
+{
+    if (first->is_index || second->is_index) {
+        return first->is_index == second->is_index &&
+            first->index == second->index;
+    }
+    return first->length == second->length &&
+        !memcmp(first->key, second->key, first->length);
+}
+
+///////////////////////////////////////////////////////////////////////////////
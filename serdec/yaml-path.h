@@ -0,0 +1,63 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            yaml-path.h
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Parsing of paths to nodes within a document.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#ifndef SERDEC_YAML_PATH_H
+#define SERDEC_YAML_PATH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// A path is a sequence of map keys separated by '.', and list indices in
+// brackets, e.g. "a.b[3].c". The empty path refers to the root.
+
+typedef struct PathSegment {
+    // Segments are either a list index, or a map key of <length> bytes, which
+    // refers to the path (so, it isn't NUL-terminated).
+    bool is_index;
+    size_t index;
+    const char* key;
+    size_t length;
+} PathSegment;
+
+// Parse the segment at <*cursor>, which must not be at the end of <path>, and
+// advance the cursor past it. Indices which don't fit in a size_t are clamped
+// to SIZE_MAX. Return non-zero (SERDEC_YAML_INVALID_PATH) if the path is
+// malformed.
+int path_parse_segment(const char* path, const char** cursor,
+    PathSegment* segment);
+
+// Whether two segments select the same node.
+bool path_segment_equal(const PathSegment* first, const PathSegment* second);
+
+#endif // SERDEC_YAML_PATH_H
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,255 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            yaml-projection.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Projections of a document onto a set of paths.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <errno.h>
+#include <string.h>
+
+#include <serdec/allocator-ops.h>
+#include <serdec/yaml-projection.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// Private API
+////
+
+// Return the child of <node> which is selected by <segment>, or
+// PROJECTION_NO_NODE. Children always follow their parent.
+static size_t find_child(const SerdecYamlProjection* projection, size_t node,
+    const PathSegment* segment)
+{
+    for (size_t i = node + 1; i < projection->node_count; ++i) {
+        const ProjectionNode* child = &projection->nodes[i];
+        if (node == child->parent &&
+            path_segment_equal(&child->segment, segment)) {
+            return i;
+        }
+    }
+    return PROJECTION_NO_NODE;
+}
+
+// Add the segments of path <path> to the tree, which has room for all of
+// them. Return non-zero if the path conflicts with one which was added before
+// it.
+static int insert_path(SerdecYamlProjection* projection, size_t path) {
+    const char* string = projection->paths[path].path;
+    const char* cursor = string;
+    size_t node = 0;
+    while ('\0' != *cursor) {
+        // The value at this node is consumed by the callback of a shorter
+        // path, so it can't be descended into.
+        if (PROJECTION_NO_PATH != projection->nodes[node].path) {
+            return -1;
+        }
+
+        PathSegment segment;
+        path_parse_segment(string, &cursor, &segment);
+        size_t child = find_child(projection, node, &segment);
+        if (PROJECTION_NO_NODE == child) {
+            child = projection->node_count++;
+            projection->nodes[child] = (ProjectionNode){
+                .path = PROJECTION_NO_PATH,
+                .parent = node,
+                .segment = segment,
+            };
+            if (segment.is_index) {
+                ++projection->nodes[node].index_count;
+            } else {
+                ++projection->nodes[node].key_count;
+            }
+        }
+        node = child;
+    }
+
+    ProjectionNode* leaf = &projection->nodes[node];
+    if (PROJECTION_NO_PATH != leaf->path ||
+        0 < leaf->key_count || 0 < leaf->index_count) {
+        return -1;
+    }
+    leaf->path = path;
+    return 0;
+}
+
+// Build the key table and the sorted indices for the children of <node>.
+// <keys> is the position at which the next key is copied.
+static int index_children(SerdecYamlProjection* projection, size_t node,
+    char** keys)
+{
+    ProjectionNode* parent = &projection->nodes[node];
+    const SerdecAllocator* allocator = &projection->allocator;
+    size_t* key_nodes = NULL;
+    const char** key_strings = NULL;
+    if (0 < parent->key_count) {
+        key_nodes = allocator_calloc(allocator, parent->key_count,
+            sizeof(size_t));
+        key_strings = allocator_calloc(allocator, parent->key_count,
+            sizeof(const char*));
+    }
+    if (0 < parent->index_count) {
+        parent->indices = allocator_calloc(allocator, parent->index_count,
+            sizeof(ProjectionIndex));
+    }
+
+    if ((0 < parent->key_count && (NULL == key_nodes || NULL == key_strings))
+        || (0 < parent->index_count && NULL == parent->indices)) {
+        allocator_free(allocator, key_nodes);
+        allocator_free(allocator, key_strings);
+        return -1;
+    }
+
+    size_t key_count = 0;
+    size_t index_count = 0;
+    for (size_t i = node + 1; i < projection->node_count; ++i) {
+        const PathSegment* segment = &projection->nodes[i].segment;
+        if (node != projection->nodes[i].parent) {
+            continue;
+        } else if (!segment->is_index) {
+            memcpy(*keys, segment->key, segment->length);
+            (*keys)[segment->length] = '\0';
+            key_strings[key_count] = *keys;
+            key_nodes[key_count++] = i;
+            *keys += segment->length + 1;
+            continue;
+        }
+
+        // Insertion sort, since there are usually only a few indices.
+        size_t position = index_count++;
+        while (0 < position &&
+            parent->indices[position - 1].index > segment->index) {
+            parent->indices[position] = parent->indices[position - 1];
+            --position;
+        }
+        parent->indices[position] = (ProjectionIndex){segment->index, i};
+    }
+
+    int result = 0;
+    if (0 < key_count) {
+        result = key_table_initialize(&parent->keys, key_strings, key_count,
+            allocator);
+        if (result) {
+            allocator_free(allocator, key_nodes);
+        } else {
+            parent->key_nodes = key_nodes;
+        }
+    }
+    allocator_free(allocator, key_strings);
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Public API
+////
+
+SerdecYamlProjection* serdec_yaml_projection_new(const SerdecYamlPath* paths,
+    size_t count)
+{
+    return serdec_yaml_projection_new_with_allocator(paths, count, NULL);
+}
+
+SerdecYamlProjection* serdec_yaml_projection_new_with_allocator(
+    const SerdecYamlPath* paths, size_t count,
+    const SerdecAllocator* allocator)
+{
+    // Each segment adds at most one node (and one key) to the tree.
+    size_t capacity = 1;
+    size_t key_bytes = 1;
+    for (size_t i = 0; i < count; ++i) {
+        const char* cursor = paths[i].path;
+        while ('\0' != *cursor) {
+            PathSegment segment;
+            if (path_parse_segment(paths[i].path, &cursor, &segment)) {
+                errno = EINVAL;
+                return NULL;
+            }
+            ++capacity;
+            key_bytes += segment.is_index ? 0 : segment.length + 1;
+        }
+    }
+
+    allocator = allocator_or_default(allocator);
+    SerdecYamlProjection* projection = allocator_calloc(allocator, 1,
+        sizeof(SerdecYamlProjection));
+    if (NULL == projection) {
+        return NULL;
+    }
+
+    projection->allocator = *allocator;
+    projection->paths = paths;
+    projection->path_count = count;
+    projection->nodes = allocator_calloc(allocator, capacity,
+        sizeof(ProjectionNode));
+    projection->keys = allocator_alloc(allocator, key_bytes);
+    if (NULL == projection->nodes || NULL == projection->keys) {
+        serdec_yaml_projection_free(projection);
+        return NULL;
+    }
+
+    projection->nodes[0] = (ProjectionNode){
+        .path = PROJECTION_NO_PATH,
+        .parent = PROJECTION_NO_NODE,
+    };
+    projection->node_count = 1;
+    for (size_t i = 0; i < count; ++i) {
+        if (insert_path(projection, i)) {
+            serdec_yaml_projection_free(projection);
+            errno = EINVAL;
+            return NULL;
+        }
+    }
+
+    char* keys = projection->keys;
+    for (size_t i = 0; i < projection->node_count; ++i) {
+        if (index_children(projection, i, &keys)) {
+            serdec_yaml_projection_free(projection);
+            return NULL;
+        }
+    }
+    return projection;
+}
+
+void serdec_yaml_projection_free(SerdecYamlProjection* projection) {
+    const SerdecAllocator* allocator = &projection->allocator;
+    for (size_t i = 0; NULL != projection->nodes &&
+             i < projection->node_count; ++i) {
+        ProjectionNode* node = &projection->nodes[i];
+        if (NULL != node->key_nodes) {
+            key_table_delete(&node->keys);
+            allocator_free(allocator, node->key_nodes);
+        }
+        allocator_free(allocator, node->indices);
+    }
+
+    allocator_free(allocator, projection->nodes);
+    allocator_free(allocator, projection->keys);
+    SerdecAllocator copy = projection->allocator;
+    allocator_free(&copy, projection);
+}
+
+///////////////////////////////////////////////////////////////////////////////
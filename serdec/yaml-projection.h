@@ -0,0 +1,88 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            yaml-projection.h
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Projections of a document onto a set of paths.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#ifndef SERDEC_YAML_PROJECTION_H
+#define SERDEC_YAML_PROJECTION_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <serdec/key-table.h>
+#include <serdec/yaml.h>
+#include <serdec/yaml-path.h>
+
+// The paths of a projection are merged into a tree, whose root is node zero,
+// and whose leaves are the last segments of each path. Map keys are matched
+// against the children of a node through a key table, and list indices by
+// walking the (sorted) indices of the children alongside the list.
+
+#define PROJECTION_NO_NODE SIZE_MAX
+#define PROJECTION_NO_PATH SIZE_MAX
+
+typedef struct ProjectionIndex {
+    size_t index;
+    size_t node;
+} ProjectionIndex;
+
+typedef struct ProjectionNode {
+    // The path which ends at this node, or PROJECTION_NO_PATH.
+    size_t path;
+
+    // The parent of the node, and the segment of the path which leads to it.
+    size_t parent;
+    PathSegment segment;
+
+    // Key <i> of <keys> leads to key_nodes[i]. The table is only initialized
+    // if <key_nodes> is non-NULL.
+    KeyTable keys;
+    size_t* key_nodes;
+    size_t key_count;
+
+    // Children which are selected by list index, in ascending order.
+    ProjectionIndex* indices;
+    size_t index_count;
+} ProjectionNode;
+
+struct SerdecYamlProjection {
+    const SerdecYamlPath* paths;
+    size_t path_count;
+    ProjectionNode* nodes;
+    size_t node_count;
+
+    // NUL-terminated copies of the keys in the key tables.
+    char* keys;
+    SerdecAllocator allocator;
+};
+
+#endif // SERDEC_YAML_PROJECTION_H
+
+///////////////////////////////////////////////////////////////////////////////
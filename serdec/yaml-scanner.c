@@ -0,0 +1,1270 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            yaml-scanner.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Native scanner for the subset of YAML serdec consumes
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <stdint.h>
+#include <string.h>
+
+#include <serdec/allocator-ops.h>
+#include <serdec/yaml-error.h>
+#include <serdec/yaml-scanner.h>
+
+static const size_t NATIVE_SCANNER_INITIAL_DEPTH = 16;
+
+// The value of every empty scalar.
+static const char EMPTY_SCALAR[] = "";
+
+///////////////////////////////////////////////////////////////////////////////
+// Private API
+////
+
+static int fail(NativeScanner* scanner, const char* problem) {
+    scanner->problem = problem;
+    return SERDEC_YAML_SYNTAX_ERROR;
+}
+
+// The character at <offset> from the cursor, or NUL past the end of input.
+static char peek(NativeScanner* scanner, size_t offset) {
+    if ((size_t)(scanner->end - scanner->cursor) <= offset) {
+        return '\0';
+    }
+    return scanner->cursor[offset];
+}
+
+static bool at_end(NativeScanner* scanner) {
+    return scanner->cursor >= scanner->end;
+}
+
+static bool is_break(char c) {
+    return '\n' == c || '\r' == c;
+}
+
+static bool is_blank(char c) {
+    return ' ' == c || '\t' == c;
+}
+
+static bool is_blank_or_end(char c) {
+    return is_blank(c) || is_break(c) || '\0' == c;
+}
+
+static bool is_flow_indicator(char c) {
+    return ',' == c || '[' == c || ']' == c || '{' == c || '}' == c;
+}
+
+static size_t column(NativeScanner* scanner) {
+    return (size_t)(scanner->cursor - scanner->line_start);
+}
+
+static void skip_break(NativeScanner* scanner) {
+    if ('\r' == peek(scanner, 0) && '\n' == peek(scanner, 1)) {
+        scanner->cursor += 2;
+    } else {
+        scanner->cursor += 1;
+    }
+    scanner->line += 1;
+    scanner->line_start = scanner->cursor;
+}
+
+static void skip_blanks(NativeScanner* scanner) {
+    while (!at_end(scanner) && is_blank(*scanner->cursor)) {
+        scanner->cursor += 1;
+    }
+}
+
+// Return the first byte at or after <from> which may end a token. Without an
+// index, any byte may.
+static const char* next_candidate(NativeScanner* scanner, const char* from) {
+    if (!scanner->indexed) {
+        return from;
+    }
+    return scanner->input + structural_index_next(&scanner->index,
+        (size_t)(from - scanner->input));
+}
+
+// Return the end of the bytes in [start, end) once trailing blanks have been
+// removed.
+static const char* trim_blanks(const char* start, const char* end) {
+    while (end > start && is_blank(end[-1])) {
+        end -= 1;
+    }
+    return end;
+}
+
+static void skip_line(NativeScanner* scanner) {
+    while (!at_end(scanner)) {
+        scanner->cursor = next_candidate(scanner, scanner->cursor);
+        if (at_end(scanner) || is_break(*scanner->cursor)) {
+            break;
+        }
+        scanner->cursor += 1;
+    }
+}
+
+// Whether nothing but whitespace, or a comment, follows on this line.
+static bool at_line_end(NativeScanner* scanner) {
+    return at_end(scanner) || is_break(*scanner->cursor)
+        || '#' == *scanner->cursor;
+}
+
+// Whether the cursor is at the document marker <marker> ("---" or "...").
+static bool at_marker(NativeScanner* scanner, const char* marker) {
+    return 0 == column(scanner) && 3 <= scanner->end - scanner->cursor
+        && 0 == memcmp(scanner->cursor, marker, 3)
+        && is_blank_or_end(peek(scanner, 3));
+}
+
+static bool at_any_marker(NativeScanner* scanner) {
+    return at_marker(scanner, "---") || at_marker(scanner, "...");
+}
+
+static bool at_bom(NativeScanner* scanner) {
+    return 3 <= scanner->end - scanner->cursor
+        && 0 == memcmp(scanner->cursor, "\xef\xbb\xbf", 3);
+}
+
+// Skip whitespace, comments and line breaks up to the next content, or the
+// end of input. Like libyaml, in block context, tabs may not begin a line,
+// even one which is otherwise empty.
+static int seek_content(NativeScanner* scanner, bool flow) {
+    while (!at_end(scanner)) {
+        // libyaml treats a BOM at the start of a line as whitespace in some
+        // places, and as content in others.
+        if (scanner->cursor == scanner->line_start && at_bom(scanner)) {
+            return fail(scanner, "byte order marks within the stream are not"
+                " supported");
+        }
+
+        const char* start = scanner->cursor;
+        bool indentation = start == scanner->line_start;
+        while (!at_end(scanner) && is_blank(*scanner->cursor)) {
+            if ('\t' == *scanner->cursor && indentation && !flow) {
+                return fail(scanner, "found a tab character that violates"
+                    " indentation");
+            }
+            scanner->cursor += 1;
+        }
+
+        if (at_end(scanner)) {
+            break;
+        }
+
+        char c = *scanner->cursor;
+        if ('#' == c && (scanner->cursor > start || indentation
+                || is_blank(scanner->cursor[-1]))) {
+            skip_line(scanner);
+            continue;
+        }
+
+        if (is_break(c)) {
+            skip_break(scanner);
+            continue;
+        }
+        break;
+    }
+    return 0;
+}
+
+static int push_frame(NativeScanner* scanner, ScannerFrameKind kind,
+    size_t indent)
+{
+    if (scanner->depth == scanner->capacity) {
+        size_t capacity = 2 * scanner->capacity;
+        if (0 == capacity) {
+            capacity = NATIVE_SCANNER_INITIAL_DEPTH;
+        }
+
+        ScannerFrame* frames = allocator_realloc(scanner->allocator,
+            scanner->frames, capacity * sizeof(ScannerFrame));
+        if (NULL == frames) {
+            return SERDEC_YAML_SYSTEM_ERROR;
+        }
+        scanner->frames = frames;
+        scanner->capacity = capacity;
+    }
+
+    ScannerFrame* frame = &scanner->frames[scanner->depth++];
+    frame->kind = kind;
+    frame->indent = indent;
+    frame->first = true;
+    frame->expect_value = false;
+    frame->has_value = false;
+    return 0;
+}
+
+static int pop_frame(NativeScanner* scanner, yaml_event_t* event,
+    yaml_event_type_t type)
+{
+    scanner->depth -= 1;
+    if (0 == scanner->depth) {
+        scanner->state = SCANNER_DOCUMENT_END;
+    }
+    event->type = type;
+    return 0;
+}
+
+static int start_collection(NativeScanner* scanner, yaml_event_t* event,
+    ScannerFrameKind kind, size_t indent)
+{
+    int result = push_frame(scanner, kind, indent);
+    if (0 != result) {
+        return result;
+    }
+
+    if (SCANNER_BLOCK_MAP == kind || SCANNER_FLOW_MAP == kind) {
+        event->type = YAML_MAPPING_START_EVENT;
+        event->data.mapping_start.implicit = 1;
+        event->data.mapping_start.style = SCANNER_FLOW_MAP == kind
+            ? YAML_FLOW_MAPPING_STYLE : YAML_BLOCK_MAPPING_STYLE;
+    } else {
+        event->type = YAML_SEQUENCE_START_EVENT;
+        event->data.sequence_start.implicit = 1;
+        event->data.sequence_start.style = SCANNER_FLOW_LIST == kind
+            ? YAML_FLOW_SEQUENCE_STYLE : YAML_BLOCK_SEQUENCE_STYLE;
+    }
+    return 0;
+}
+
+static int scalar_event(yaml_event_t* event, const NativeScalar* scalar) {
+    event->type = YAML_SCALAR_EVENT;
+    // The scanner never writes through the pointer. libyaml's event doesn't
+    // distinguish between the scalars it owns and those it doesn't.
+    event->data.scalar.value = (yaml_char_t*)(uintptr_t)scalar->value;
+    event->data.scalar.length = scalar->length;
+    event->data.scalar.plain_implicit = YAML_PLAIN_SCALAR_STYLE
+        == scalar->style;
+    event->data.scalar.quoted_implicit = YAML_PLAIN_SCALAR_STYLE
+        != scalar->style;
+    event->data.scalar.style = scalar->style;
+    return 0;
+}
+
+// Produce the empty scalar of a node which has no content, e.g. a map value
+// at the end of a line, without updating <token_line>.
+static int empty_scalar(yaml_event_t* event) {
+    NativeScalar scalar = {EMPTY_SCALAR, 0, YAML_PLAIN_SCALAR_STYLE};
+    return scalar_event(event, &scalar);
+}
+
+////
+// Scalars
+////
+
+static int scan_plain(NativeScanner* scanner, bool flow,
+    NativeScalar* scalar)
+{
+    const char* start = scanner->cursor;
+    const char* last = scanner->cursor;
+    while (!at_end(scanner)) {
+        // None of the bytes before the next candidate end the scalar.
+        const char* candidate = next_candidate(scanner, scanner->cursor);
+        if (candidate != scanner->cursor) {
+            const char* content = trim_blanks(scanner->cursor, candidate);
+            if (content != scanner->cursor) {
+                last = content;
+            }
+            scanner->cursor = candidate;
+            continue;
+        }
+
+        char c = *scanner->cursor;
+        if (is_break(c)) {
+            break;
+        }
+
+        if (':' == c) {
+            char next = peek(scanner, 1);
+            if (is_blank_or_end(next)) {
+                break;
+            } else if (flow && (is_flow_indicator(next) || '?' == next)) {
+                return fail(scanner, "found unexpected ':'");
+            }
+        } else if (flow && is_flow_indicator(c)) {
+            break;
+        } else if ('#' == c && is_blank(scanner->cursor[-1])) {
+            break;
+        }
+
+        scanner->cursor += 1;
+        if (!is_blank(c)) {
+            last = scanner->cursor;
+        }
+    }
+
+    scalar->value = start;
+    scalar->length = (size_t)(last - start);
+    scalar->style = YAML_PLAIN_SCALAR_STYLE;
+    if (!flow || at_end(scanner) || !is_break(*scanner->cursor)) {
+        return 0;
+    }
+
+    // In flow context, libyaml folds plain scalars onto the next line, unless
+    // it begins with an indicator which ends them. It also rejects some of
+    // the tabs which indent that line, so all of them are rejected here.
+    int result = seek_content(scanner, false);
+    if (0 != result || at_end(scanner) || at_any_marker(scanner)) {
+        return result;
+    }
+
+    char c = *scanner->cursor;
+    if (is_flow_indicator(c)) {
+        return 0;
+    } else if (':' == c) {
+        return fail(scanner, "found unexpected ':'");
+    }
+    return fail(scanner, "plain scalars which span lines are not supported");
+}
+
+static int append_char(StringBuffer* buffer, char c) {
+    if (0 != string_buffer_append(buffer, &c, 1)) {
+        return SERDEC_YAML_SYSTEM_ERROR;
+    }
+    return 0;
+}
+
+static int append_utf8(NativeScanner* scanner, StringBuffer* buffer,
+    uint32_t point)
+{
+    char bytes[4];
+    size_t length = 0;
+    if (0x80 > point) {
+        bytes[length++] = (char)point;
+    } else if (0x800 > point) {
+        bytes[length++] = (char)(0xc0 | (point >> 6));
+        bytes[length++] = (char)(0x80 | (point & 0x3f));
+    } else if (0x10000 > point) {
+        if (0xd800 <= point && 0xdfff >= point) {
+            return fail(scanner, "found invalid Unicode character escape code");
+        }
+        bytes[length++] = (char)(0xe0 | (point >> 12));
+        bytes[length++] = (char)(0x80 | ((point >> 6) & 0x3f));
+        bytes[length++] = (char)(0x80 | (point & 0x3f));
+    } else if (0x110000 > point) {
+        bytes[length++] = (char)(0xf0 | (point >> 18));
+        bytes[length++] = (char)(0x80 | ((point >> 12) & 0x3f));
+        bytes[length++] = (char)(0x80 | ((point >> 6) & 0x3f));
+        bytes[length++] = (char)(0x80 | (point & 0x3f));
+    } else {
+        return fail(scanner, "found invalid Unicode character escape code");
+    }
+
+    if (0 != string_buffer_append(buffer, bytes, length)) {
+        return SERDEC_YAML_SYSTEM_ERROR;
+    }
+    return 0;
+}
+
+// Decode the escape sequence at the cursor, which is just past the '\'.
+static int scan_escape(NativeScanner* scanner, StringBuffer* buffer) {
+    char c = peek(scanner, 0);
+    scanner->cursor += 1;
+
+    const char* replacement = NULL;
+    size_t digits = 0;
+    switch (c) {
+    case '0': return append_char(buffer, '\0');
+    case 'a': return append_char(buffer, '\a');
+    case 'b': return append_char(buffer, '\b');
+    case 't': case '\t': return append_char(buffer, '\t');
+    case 'n': return append_char(buffer, '\n');
+    case 'v': return append_char(buffer, '\v');
+    case 'f': return append_char(buffer, '\f');
+    case 'r': return append_char(buffer, '\r');
+    case 'e': return append_char(buffer, '\x1b');
+    case ' ': case '"': case '/': case '\\': return append_char(buffer, c);
+    case 'N': replacement = "\xc2\x85"; break;
+    case '_': replacement = "\xc2\xa0"; break;
+    case 'L': replacement = "\xe2\x80\xa8"; break;
+    case 'P': replacement = "\xe2\x80\xa9"; break;
+    case 'x': digits = 2; break;
+    case 'u': digits = 4; break;
+    case 'U': digits = 8; break;
+    default:
+        return fail(scanner, "found unknown escape character");
+    }
+
+    if (NULL != replacement) {
+        if (0 != string_buffer_append(buffer, replacement,
+                strlen(replacement))) {
+            return SERDEC_YAML_SYSTEM_ERROR;
+        }
+        return 0;
+    }
+
+    uint32_t point = 0;
+    for (size_t i = 0; i < digits; ++i) {
+        char digit = peek(scanner, i);
+        uint32_t value = 0;
+        if ('0' <= digit && '9' >= digit) {
+            value = (uint32_t)(digit - '0');
+        } else if ('a' <= digit && 'f' >= digit) {
+            value = (uint32_t)(digit - 'a' + 10);
+        } else if ('A' <= digit && 'F' >= digit) {
+            value = (uint32_t)(digit - 'A' + 10);
+        } else {
+            return fail(scanner, "did not find expected hexdecimal number");
+        }
+        point = (point << 4) | value;
+    }
+    scanner->cursor += digits;
+    return append_utf8(scanner, buffer, point);
+}
+
+// Fold the line break at the cursor, and any empty lines which follow it.
+// <escaped> breaks were preceded by a '\', and are dropped entirely.
+static int fold_lines(NativeScanner* scanner, StringBuffer* buffer,
+    bool escaped)
+{
+    size_t empty = 0;
+    skip_break(scanner);
+    while (true) {
+        if (at_any_marker(scanner)) {
+            return fail(scanner, "found unexpected document indicator");
+        }
+        skip_blanks(scanner);
+        if (at_end(scanner)) {
+            return fail(scanner, "found unexpected end of stream");
+        }
+        if (!is_break(*scanner->cursor)) {
+            break;
+        }
+        skip_break(scanner);
+        empty += 1;
+    }
+
+    if (!escaped && 0 == empty) {
+        return append_char(buffer, ' ');
+    }
+
+    for (size_t i = 0; i < empty; ++i) {
+        int result = append_char(buffer, '\n');
+        if (0 != result) {
+            return result;
+        }
+    }
+    return 0;
+}
+
+// Unescape a quoted scalar into the next buffer of the ring. The cursor is
+// just past the opening quote.
+static int unescape_quoted(NativeScanner* scanner, char quote,
+    NativeScalar* scalar)
+{
+    StringBuffer* buffer = &scanner->ring[scanner->ring_next];
+    scanner->ring_next = (scanner->ring_next + 1) % NATIVE_SCANNER_RING;
+    string_buffer_clear(buffer);
+    if (0 != string_buffer_reserve(buffer, 0)) {
+        return SERDEC_YAML_SYSTEM_ERROR;
+    }
+
+    // Whitespace before a line break is trimmed, but not whitespace which was
+    // escaped, or produced by folding.
+    size_t trimmed = 0;
+    int result = 0;
+    while (0 == result) {
+        if (at_end(scanner)) {
+            return fail(scanner, "found unexpected end of stream");
+        }
+
+        // The bytes before the next candidate are copied as they are.
+        const char* candidate = next_candidate(scanner, scanner->cursor);
+        if (candidate != scanner->cursor) {
+            size_t length = (size_t)(candidate - scanner->cursor);
+            if (0 != string_buffer_append(buffer, scanner->cursor, length)) {
+                return SERDEC_YAML_SYSTEM_ERROR;
+            }
+
+            const char* content = trim_blanks(scanner->cursor, candidate);
+            if (content != scanner->cursor) {
+                trimmed = buffer->length - (size_t)(candidate - content);
+            }
+            scanner->cursor = candidate;
+            continue;
+        }
+
+        char c = *scanner->cursor;
+        if (quote == c) {
+            if ('\'' == quote && '\'' == peek(scanner, 1)) {
+                scanner->cursor += 2;
+                result = append_char(buffer, '\'');
+                trimmed = buffer->length;
+                continue;
+            }
+            scanner->cursor += 1;
+            break;
+        }
+
+        if ('"' == quote && '\\' == c) {
+            if (is_break(peek(scanner, 1))) {
+                scanner->cursor += 1;
+                result = fold_lines(scanner, buffer, true);
+            } else {
+                scanner->cursor += 1;
+                result = scan_escape(scanner, buffer);
+            }
+            trimmed = buffer->length;
+            continue;
+        }
+
+        if (is_break(c)) {
+            buffer->length = trimmed;
+            result = fold_lines(scanner, buffer, false);
+            trimmed = buffer->length;
+            continue;
+        }
+
+        result = append_char(buffer, c);
+        scanner->cursor += 1;
+        if (!is_blank(c)) {
+            trimmed = buffer->length;
+        }
+    }
+
+    if (0 != result) {
+        return result;
+    }
+
+    buffer->string[buffer->length] = '\0';
+    scalar->value = buffer->string;
+    scalar->length = buffer->length;
+    return 0;
+}
+
+static int scan_quoted(NativeScanner* scanner, NativeScalar* scalar) {
+    char quote = *scanner->cursor;
+    scanner->cursor += 1;
+    scalar->style = '\'' == quote ? YAML_SINGLE_QUOTED_SCALAR_STYLE
+        : YAML_DOUBLE_QUOTED_SCALAR_STYLE;
+
+    // Most quoted scalars contain no escapes or line breaks, and can be
+    // referred to where they are.
+    const char* start = scanner->cursor;
+    const char* position = start;
+    while (position < scanner->end) {
+        position = next_candidate(scanner, position);
+        if (position >= scanner->end || quote == *position
+            || is_break(*position) || ('"' == quote && '\\' == *position)) {
+            break;
+        }
+        position += 1;
+    }
+
+    if (position < scanner->end && quote == *position
+        && !('\'' == quote && position + 1 < scanner->end
+            && '\'' == position[1])) {
+        scanner->cursor = position + 1;
+        scalar->value = start;
+        scalar->length = (size_t)(position - start);
+        return 0;
+    }
+
+    return unescape_quoted(scanner, quote, scalar);
+}
+
+// Scan the scalar at the cursor, rejecting the syntax which isn't supported.
+static int scan_scalar(NativeScanner* scanner, bool flow,
+    NativeScalar* scalar)
+{
+    char c = *scanner->cursor;
+    char next = peek(scanner, 1);
+    switch (c) {
+    case '\'': case '"':
+        return scan_quoted(scanner, scalar);
+    case '&': case '*':
+        return fail(scanner, "anchors and aliases are not supported");
+    case '!':
+        return fail(scanner, "tags are not supported");
+    case '|': case '>':
+        return fail(scanner, "block scalars are not supported");
+    case '?':
+        if (flow || is_blank_or_end(next)) {
+            return fail(scanner, "complex keys are not supported");
+        }
+        break;
+    case ':':
+        if (flow || is_blank_or_end(next)) {
+            return fail(scanner, "empty keys are not supported");
+        }
+        break;
+    case '-':
+        if (is_blank_or_end(next)) {
+            return fail(scanner, "block sequence entries are not allowed in"
+                " this context");
+        }
+        break;
+    case ',': case '[': case ']': case '{': case '}': case '#': case '%':
+    case '@': case '`':
+        return fail(scanner, "found character that cannot start any token");
+    default:
+        break;
+    }
+
+    return scan_plain(scanner, flow, scalar);
+}
+
+////
+// Nodes
+////
+
+// Scan the node at the cursor. <block> is set where a block collection may
+// begin, i.e. where the node is the first content on its line.
+static int scan_node(NativeScanner* scanner, yaml_event_t* event, bool flow,
+    bool block)
+{
+    size_t indent = column(scanner);
+    char c = *scanner->cursor;
+    if ('[' == c || '{' == c) {
+        scanner->cursor += 1;
+        scanner->token_line = scanner->line;
+        return start_collection(scanner, event,
+            '[' == c ? SCANNER_FLOW_LIST : SCANNER_FLOW_MAP, indent);
+    }
+
+    if (!flow && '-' == c && is_blank_or_end(peek(scanner, 1))) {
+        if (!block) {
+            return fail(scanner, "block sequence entries are not allowed in"
+                " this context");
+        }
+        return start_collection(scanner, event, SCANNER_BLOCK_LIST, indent);
+    }
+
+    size_t line = scanner->line;
+    NativeScalar scalar;
+    int result = scan_scalar(scanner, flow, &scalar);
+    if (0 != result) {
+        return result;
+    }
+
+    if (!flow) {
+        skip_blanks(scanner);
+        if (':' == peek(scanner, 0) && is_blank_or_end(peek(scanner, 1))) {
+            if (!block) {
+                return fail(scanner, "mapping values are not allowed in this"
+                    " context");
+            }
+            if (line != scanner->line) {
+                return fail(scanner, "implicit keys must be on a single"
+                    " line");
+            }
+
+            scanner->cursor += 1;
+            scanner->token_line = scanner->line;
+            scanner->pending = true;
+            scanner->pending_key = scalar;
+            result = start_collection(scanner, event, SCANNER_BLOCK_MAP,
+                indent);
+            scanner->frames[scanner->depth - 1].expect_value = true;
+            return result;
+        }
+    }
+
+    scanner->token_line = scanner->line;
+    return scalar_event(event, &scalar);
+}
+
+// Whether a block node begins at the cursor, for an entry of a block
+// collection at <indent>.
+static bool at_block_node(NativeScanner* scanner, size_t indent, bool map) {
+    if (at_end(scanner) || at_any_marker(scanner)) {
+        return false;
+    }
+    if (column(scanner) > indent) {
+        return true;
+    }
+    // The entries of a list which is a map value may be at the map's indent.
+    return map && column(scanner) == indent && '-' == *scanner->cursor
+        && is_blank_or_end(peek(scanner, 1));
+}
+
+static int scan_block_value(NativeScanner* scanner, yaml_event_t* event,
+    size_t indent, bool map)
+{
+    // libyaml doesn't skip tabs after a list entry's '-', only spaces.
+    while (!at_end(scanner) && is_blank(*scanner->cursor)) {
+        if (!map && '\t' == *scanner->cursor) {
+            return fail(scanner, "found character that cannot start any"
+                " token");
+        }
+        scanner->cursor += 1;
+    }
+    if (!at_line_end(scanner)) {
+        // A list entry may contain a compact map or list, but a map value
+        // on the same line as its key may not.
+        return scan_node(scanner, event, false, !map);
+    }
+
+    int result = seek_content(scanner, false);
+    if (0 != result) {
+        return result;
+    }
+
+    if (at_block_node(scanner, indent, map)) {
+        return scan_node(scanner, event, false, true);
+    }
+    return empty_scalar(event);
+}
+
+static int scan_block_map(NativeScanner* scanner, yaml_event_t* event,
+    ScannerFrame* frame)
+{
+    if (scanner->pending) {
+        scanner->pending = false;
+        return scalar_event(event, &scanner->pending_key);
+    }
+
+    if (frame->expect_value) {
+        frame->expect_value = false;
+        return scan_block_value(scanner, event, frame->indent, true);
+    }
+
+    int result = seek_content(scanner, false);
+    if (0 != result) {
+        return result;
+    }
+
+    if (at_end(scanner) || at_any_marker(scanner)
+        || column(scanner) < frame->indent) {
+        return pop_frame(scanner, event, YAML_MAPPING_END_EVENT);
+    }
+
+    if (scanner->line == scanner->token_line) {
+        return fail(scanner, "did not find expected key");
+    }
+
+    if (column(scanner) > frame->indent) {
+        return fail(scanner, "bad indentation of a mapping entry");
+    }
+
+    char c = *scanner->cursor;
+    if ('[' == c || '{' == c) {
+        return fail(scanner, "complex keys are not supported");
+    }
+
+    size_t line = scanner->line;
+    NativeScalar key;
+    result = scan_scalar(scanner, false, &key);
+    if (0 != result) {
+        return result;
+    }
+
+    skip_blanks(scanner);
+    if (':' != peek(scanner, 0) || !is_blank_or_end(peek(scanner, 1))) {
+        return fail(scanner, "could not find expected ':'");
+    }
+    if (line != scanner->line) {
+        return fail(scanner, "implicit keys must be on a single line");
+    }
+
+    scanner->cursor += 1;
+    scanner->token_line = scanner->line;
+    frame->expect_value = true;
+    return scalar_event(event, &key);
+}
+
+static int scan_block_list(NativeScanner* scanner, yaml_event_t* event,
+    ScannerFrame* frame)
+{
+    int result = seek_content(scanner, false);
+    if (0 != result) {
+        return result;
+    }
+
+    if (at_end(scanner) || at_any_marker(scanner)
+        || column(scanner) < frame->indent) {
+        return pop_frame(scanner, event, YAML_SEQUENCE_END_EVENT);
+    }
+
+    if (!frame->first && scanner->line == scanner->token_line) {
+        return fail(scanner, "did not find expected '-' indicator");
+    }
+
+    if (column(scanner) > frame->indent) {
+        return fail(scanner, "bad indentation of a sequence entry");
+    }
+
+    if ('-' != *scanner->cursor || !is_blank_or_end(peek(scanner, 1))) {
+        // e.g. the next key of a map which this list is a value of.
+        return pop_frame(scanner, event, YAML_SEQUENCE_END_EVENT);
+    }
+
+    frame->first = false;
+    scanner->cursor += 1;
+    return scan_block_value(scanner, event, frame->indent, false);
+}
+
+// Seek the next token of a flow collection, which must not be the end of
+// input or a document marker.
+static int seek_flow(NativeScanner* scanner, const char* expected) {
+    int result = seek_content(scanner, true);
+    if (0 != result) {
+        return result;
+    }
+
+    if (at_end(scanner)) {
+        return fail(scanner, expected);
+    }
+    if (at_any_marker(scanner)) {
+        return fail(scanner, "found unexpected document indicator");
+    }
+    return 0;
+}
+
+// Consume the ',' between entries, or the closing <close> of the
+// collection. Set <closed> if the collection has ended.
+static int scan_flow_entry(NativeScanner* scanner, ScannerFrame* frame,
+    char close, const char* expected, bool* closed)
+{
+    int result = seek_flow(scanner, expected);
+    if (0 != result) {
+        return result;
+    }
+
+    if (!frame->first && close != *scanner->cursor) {
+        if (',' != *scanner->cursor) {
+            return fail(scanner, expected);
+        }
+        scanner->cursor += 1;
+        result = seek_flow(scanner, expected);
+        if (0 != result) {
+            return result;
+        }
+    }
+
+    *closed = close == *scanner->cursor;
+    if (*closed) {
+        scanner->cursor += 1;
+        scanner->token_line = scanner->line;
+    }
+    frame->first = false;
+    return 0;
+}
+
+static int scan_flow_list(NativeScanner* scanner, yaml_event_t* event,
+    ScannerFrame* frame)
+{
+    bool closed = false;
+    int result = scan_flow_entry(scanner, frame, ']',
+        "did not find expected ',' or ']'", &closed);
+    if (0 != result) {
+        return result;
+    }
+
+    if (closed) {
+        return pop_frame(scanner, event, YAML_SEQUENCE_END_EVENT);
+    }
+
+    result = scan_node(scanner, event, true, false);
+    if (0 != result || YAML_SCALAR_EVENT != event->type) {
+        return result;
+    }
+
+    // A scalar followed by a ':' would be the key of a single-pair map.
+    result = seek_content(scanner, true);
+    if (0 == result && ':' == peek(scanner, 0)) {
+        return fail(scanner, "single-pair maps in flow lists are not"
+            " supported");
+    }
+    return result;
+}
+
+static int scan_flow_map(NativeScanner* scanner, yaml_event_t* event,
+    ScannerFrame* frame)
+{
+    const char* expected = "did not find expected ',' or '}'";
+    int result = 0;
+    if (frame->expect_value) {
+        frame->expect_value = false;
+        if (!frame->has_value) {
+            return empty_scalar(event);
+        }
+
+        result = seek_flow(scanner, expected);
+        if (0 != result) {
+            return result;
+        }
+        if (',' == *scanner->cursor || '}' == *scanner->cursor) {
+            return empty_scalar(event);
+        }
+        return scan_node(scanner, event, true, false);
+    }
+
+    bool closed = false;
+    result = scan_flow_entry(scanner, frame, '}', expected, &closed);
+    if (0 != result) {
+        return result;
+    }
+
+    if (closed) {
+        return pop_frame(scanner, event, YAML_MAPPING_END_EVENT);
+    }
+
+    char c = *scanner->cursor;
+    if ('[' == c || '{' == c) {
+        return fail(scanner, "complex keys are not supported");
+    }
+
+    size_t line = scanner->line;
+    NativeScalar key;
+    result = scan_scalar(scanner, true, &key);
+    if (0 != result) {
+        return result;
+    }
+    scanner->token_line = scanner->line;
+
+    result = seek_flow(scanner, expected);
+    if (0 != result) {
+        return result;
+    }
+
+    // After a quoted key, the ':' needn't be followed by a space.
+    c = *scanner->cursor;
+    if (':' == c && YAML_PLAIN_SCALAR_STYLE == key.style
+        && !is_blank_or_end(peek(scanner, 1))) {
+        return fail(scanner, "found unexpected ':'");
+    } else if (':' == c && line != scanner->line) {
+        return fail(scanner, "implicit keys must be on a single line");
+    } else if (':' == c) {
+        scanner->cursor += 1;
+        frame->has_value = true;
+    } else if (',' == c || '}' == c) {
+        frame->has_value = false;
+    } else {
+        return fail(scanner, expected);
+    }
+
+    frame->expect_value = true;
+    return scalar_event(event, &key);
+}
+
+////
+// Documents
+////
+
+// Check that the input is well-formed UTF-8, as libyaml's reader does, since
+// scalars are otherwise passed through without examining their bytes.
+static int validate_utf8(NativeScanner* scanner) {
+    const unsigned char* cursor = (const unsigned char*)scanner->cursor;
+    const unsigned char* end = (const unsigned char*)scanner->end;
+    while (cursor < end) {
+        if (0x80 > *cursor) {
+            cursor += 1;
+            continue;
+        }
+
+        uint32_t point = 0;
+        size_t width = 0;
+        if (0xc0 == (*cursor & 0xe0)) {
+            point = *cursor & 0x1f;
+            width = 2;
+        } else if (0xe0 == (*cursor & 0xf0)) {
+            point = *cursor & 0x0f;
+            width = 3;
+        } else if (0xf0 == (*cursor & 0xf8)) {
+            point = *cursor & 0x07;
+            width = 4;
+        } else {
+            return fail(scanner, "invalid leading UTF-8 octet");
+        }
+
+        if ((size_t)(end - cursor) < width) {
+            return fail(scanner, "incomplete UTF-8 octet sequence");
+        }
+        for (size_t i = 1; i < width; ++i) {
+            if (0x80 != (cursor[i] & 0xc0)) {
+                return fail(scanner, "invalid trailing UTF-8 octet");
+            }
+            point = (point << 6) | (cursor[i] & 0x3f);
+        }
+
+        if ((2 == width && 0x80 > point) || (3 == width && 0x800 > point)
+            || (4 == width && 0x10000 > point)) {
+            return fail(scanner, "invalid length of a UTF-8 sequence");
+        }
+        if ((0xd800 <= point && 0xdfff >= point) || 0x10ffff < point) {
+            return fail(scanner, "invalid Unicode character");
+        }
+        cursor += width;
+    }
+    return 0;
+}
+
+static int scan_stream_start(NativeScanner* scanner, yaml_event_t* event) {
+    size_t remaining = (size_t)(scanner->end - scanner->cursor);
+    if (at_bom(scanner)) {
+        scanner->cursor += 3;
+        scanner->line_start = scanner->cursor;
+    } else if (2 <= remaining
+        && (0 == memcmp(scanner->cursor, "\xff\xfe", 2)
+            || 0 == memcmp(scanner->cursor, "\xfe\xff", 2))) {
+        return fail(scanner, "only UTF-8 input is supported");
+    }
+
+    int result = validate_utf8(scanner);
+    if (0 != result) {
+        return result;
+    }
+
+    scanner->state = SCANNER_DOCUMENT_START;
+    event->type = YAML_STREAM_START_EVENT;
+    event->data.stream_start.encoding = YAML_UTF8_ENCODING;
+    return 0;
+}
+
+static int scan_directive(NativeScanner* scanner, bool* version) {
+    size_t remaining = (size_t)(scanner->end - scanner->cursor);
+    if (5 <= remaining && 0 == memcmp(scanner->cursor, "%YAML", 5)
+        && is_blank(peek(scanner, 5))) {
+        if (*version) {
+            return fail(scanner, "found duplicate %YAML directive");
+        }
+        *version = true;
+        scanner->cursor += 5;
+        skip_blanks(scanner);
+        if ('1' != peek(scanner, 0) || '.' != peek(scanner, 1)
+            || '0' > peek(scanner, 2) || '9' < peek(scanner, 2)) {
+            return fail(scanner, "found incompatible YAML document");
+        }
+        scanner->cursor += 2;
+        while ('0' <= peek(scanner, 0) && '9' >= peek(scanner, 0)) {
+            scanner->cursor += 1;
+        }
+    } else if (4 <= remaining && 0 == memcmp(scanner->cursor, "%TAG", 4)) {
+        return fail(scanner, "tags are not supported");
+    } else {
+        return fail(scanner, "found unknown directive name");
+    }
+
+    // Only a comment may follow the version.
+    const char* end = scanner->cursor;
+    skip_blanks(scanner);
+    if (!at_line_end(scanner) || ('#' == *scanner->cursor
+            && end == scanner->cursor)) {
+        return fail(scanner, "did not find expected comment or line break");
+    }
+    skip_line(scanner);
+    return 0;
+}
+
+// Skip the "..." at the cursor. Only a comment may follow it.
+static int skip_end_marker(NativeScanner* scanner) {
+    scanner->cursor += 3;
+    skip_blanks(scanner);
+    if (!at_line_end(scanner)) {
+        return fail(scanner, "did not find expected <document start>");
+    }
+    return 0;
+}
+
+static int scan_document_start(NativeScanner* scanner, yaml_event_t* event) {
+    bool directives = false;
+    bool version = false;
+    while (true) {
+        int result = seek_content(scanner, false);
+        if (0 != result) {
+            return result;
+        }
+
+        if (at_end(scanner)) {
+            if (directives) {
+                return fail(scanner, "did not find expected <document start>");
+            }
+            scanner->state = SCANNER_DONE;
+            event->type = YAML_STREAM_END_EVENT;
+            return 0;
+        }
+
+        if (0 == column(scanner) && '%' == *scanner->cursor) {
+            result = scan_directive(scanner, &version);
+            if (0 != result) {
+                return result;
+            }
+            directives = true;
+            continue;
+        }
+
+        // Like libyaml, a stray "..." is only skipped after a document.
+        if (at_marker(scanner, "...")) {
+            if (!scanner->started || directives) {
+                return fail(scanner, "did not find expected node content");
+            }
+            result = skip_end_marker(scanner);
+            if (0 != result) {
+                return result;
+            }
+            continue;
+        }
+        break;
+    }
+
+    bool explicit = at_marker(scanner, "---");
+    if (explicit) {
+        scanner->cursor += 3;
+        scanner->token_line = scanner->line;
+    } else if (directives || scanner->started) {
+        // Only the first document may begin without a "---".
+        return fail(scanner, "did not find expected <document start>");
+    } else {
+        scanner->token_line = 0;
+    }
+
+    scanner->started = true;
+    scanner->state = SCANNER_DOCUMENT_CONTENT;
+    event->type = YAML_DOCUMENT_START_EVENT;
+    event->data.document_start.implicit = !explicit;
+    return 0;
+}
+
+static int scan_document_content(NativeScanner* scanner, yaml_event_t* event)
+{
+    // Block collections can't begin on the same line as the "---".
+    skip_blanks(scanner);
+    bool block = at_line_end(scanner) || scanner->line != scanner->token_line;
+    int result = seek_content(scanner, false);
+    if (0 != result) {
+        return result;
+    }
+
+    if (at_end(scanner) || at_any_marker(scanner)) {
+        scanner->state = SCANNER_DOCUMENT_END;
+        return empty_scalar(event);
+    }
+
+    result = scan_node(scanner, event, false, block);
+    scanner->state = 0 < scanner->depth ? SCANNER_BODY
+        : SCANNER_DOCUMENT_END;
+    return result;
+}
+
+static int scan_document_end(NativeScanner* scanner, yaml_event_t* event) {
+    int result = seek_content(scanner, false);
+    if (0 != result) {
+        return result;
+    }
+
+    bool explicit = at_marker(scanner, "...");
+    if (!at_end(scanner) && !at_any_marker(scanner)) {
+        return fail(scanner, "did not find expected <document start>");
+    }
+
+    if (explicit) {
+        result = skip_end_marker(scanner);
+        if (0 != result) {
+            return result;
+        }
+    }
+
+    scanner->state = SCANNER_DOCUMENT_START;
+    event->type = YAML_DOCUMENT_END_EVENT;
+    event->data.document_end.implicit = !explicit;
+    return 0;
+}
+
+static int scan_body(NativeScanner* scanner, yaml_event_t* event) {
+    ScannerFrame* frame = &scanner->frames[scanner->depth - 1];
+    switch (frame->kind) {
+    case SCANNER_BLOCK_MAP: return scan_block_map(scanner, event, frame);
+    case SCANNER_BLOCK_LIST: return scan_block_list(scanner, event, frame);
+    case SCANNER_FLOW_MAP: return scan_flow_map(scanner, event, frame);
+    case SCANNER_FLOW_LIST: return scan_flow_list(scanner, event, frame);
+    default: return fail(scanner, "scanner is in an invalid state");
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Public API
+////
+
+void native_scanner_initialize(NativeScanner* scanner,
+    const SerdecAllocator* allocator)
+{
+    memset(scanner, 0, sizeof(*scanner));
+    scanner->allocator = allocator_or_default(allocator);
+    for (size_t i = 0; i < NATIVE_SCANNER_RING; ++i) {
+        string_buffer_init(&scanner->ring[i], scanner->allocator);
+    }
+    structural_index_init(&scanner->index, scanner->allocator);
+    native_scanner_set_input(scanner, EMPTY_SCALAR, 0);
+}
+
+void native_scanner_delete(NativeScanner* scanner) {
+    for (size_t i = 0; i < NATIVE_SCANNER_RING; ++i) {
+        string_buffer_release(&scanner->ring[i]);
+    }
+    structural_index_release(&scanner->index);
+    scanner->indexed = false;
+    allocator_free(scanner->allocator, scanner->frames);
+    scanner->frames = NULL;
+    scanner->capacity = 0;
+    scanner->depth = 0;
+}
+
+void native_scanner_set_input(NativeScanner* scanner, const char* input,
+    size_t length)
+{
+    scanner->input = input;
+    scanner->cursor = input;
+    scanner->end = input + length;
+    scanner->line_start = input;
+    scanner->line = 1;
+    scanner->token_line = 0;
+    scanner->state = SCANNER_STREAM_START;
+    scanner->started = false;
+    scanner->problem = NULL;
+    scanner->depth = 0;
+    scanner->pending = false;
+    scanner->ring_next = 0;
+
+    scanner->indexed = NATIVE_SCANNER_INDEX_THRESHOLD <= length
+        && 0 == structural_index_build(&scanner->index, input, length,
+            STRUCTURAL_KERNEL_BEST);
+    if (!scanner->indexed) {
+        structural_index_clear(&scanner->index);
+    }
+}
+
+int native_scanner_next(NativeScanner* scanner, yaml_event_t* event) {
+    memset(event, 0, sizeof(*event));
+    if (NULL != scanner->problem) {
+        return SERDEC_YAML_SYNTAX_ERROR;
+    }
+
+    switch (scanner->state) {
+    case SCANNER_STREAM_START: return scan_stream_start(scanner, event);
+    case SCANNER_DOCUMENT_START: return scan_document_start(scanner, event);
+    case SCANNER_DOCUMENT_CONTENT:
+        return scan_document_content(scanner, event);
+    case SCANNER_BODY: return scan_body(scanner, event);
+    case SCANNER_DOCUMENT_END: return scan_document_end(scanner, event);
+    case SCANNER_DONE: return 0;
+    default: return fail(scanner, "scanner is in an invalid state");
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,147 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            yaml-scanner.h
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Native scanner for the subset of YAML serdec consumes
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#ifndef SERDEC_YAML_SCANNER_H
+#define SERDEC_YAML_SCANNER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <yaml.h>
+
+#include <serdec/allocator.h>
+#include <serdec/string-ops.h>
+#include <serdec/structural-index.h>
+
+// The native scanner reads block and flow maps and lists, and plain and
+// quoted scalars, from a string, and produces the same events as libyaml's
+// parser for them. Scalars are not copied: the events refer directly to the
+// input, except for quoted scalars which contain escapes or line breaks,
+// which are unescaped into buffers owned by the scanner. So, its events must
+// never be passed to yaml_event_delete(). Anchors, aliases, tags, block
+// scalars, complex keys and multi-line plain scalars are reported as errors.
+// Large inputs are first passed through a structural index, so that the
+// scanner can skip over the bytes inside scalars and comments without
+// examining each of them.
+
+// The number of buffers which hold unescaped scalars. Each buffer is re-used
+// for every NATIVE_SCANNER_RING'th unescaped scalar, so the events which
+// refer to them must be consumed before then. The de-serializer holds at most
+// two events at any one time.
+#define NATIVE_SCANNER_RING 4
+
+// Below this size, building the index costs more than it saves.
+#define NATIVE_SCANNER_INDEX_THRESHOLD 4096
+
+typedef enum ScannerFrameKind {
+    SCANNER_BLOCK_MAP,
+    SCANNER_BLOCK_LIST,
+    SCANNER_FLOW_MAP,
+    SCANNER_FLOW_LIST,
+} ScannerFrameKind;
+
+typedef struct ScannerFrame {
+    ScannerFrameKind kind;
+    size_t indent;
+    bool first;
+    bool expect_value;
+    bool has_value;
+} ScannerFrame;
+
+typedef enum ScannerState {
+    SCANNER_STREAM_START,
+    SCANNER_DOCUMENT_START,
+    SCANNER_DOCUMENT_CONTENT,
+    SCANNER_BODY,
+    SCANNER_DOCUMENT_END,
+    SCANNER_DONE,
+} ScannerState;
+
+typedef struct NativeScalar {
+    const char* value;
+    size_t length;
+    yaml_scalar_style_t style;
+} NativeScalar;
+
+typedef struct NativeScanner {
+    const char* input;
+    const char* cursor;
+    const char* end;
+    const char* line_start;
+    size_t line;
+
+    // The line on which the last scalar, or flow collection, ended. Entries
+    // of block collections must begin on a later line.
+    size_t token_line;
+
+    ScannerState state;
+    bool started;
+    const SerdecAllocator* allocator;
+    const char* problem;
+
+    ScannerFrame* frames;
+    size_t depth;
+    size_t capacity;
+
+    // The key of a block map is scanned before the start of the map is
+    // reported, so it's held here until the next call.
+    bool pending;
+    NativeScalar pending_key;
+
+    StringBuffer ring[NATIVE_SCANNER_RING];
+    size_t ring_next;
+
+    // Set if the input has been indexed. Indexing is only an optimization, so
+    // if the index can't be allocated, the input is scanned without it.
+    StructuralIndex index;
+    bool indexed;
+} NativeScanner;
+
+// A NULL <allocator> selects the default.
+void native_scanner_initialize(NativeScanner* scanner,
+    const SerdecAllocator* allocator);
+void native_scanner_delete(NativeScanner* scanner);
+
+// Begin scanning a new input. The memory the scanner has allocated is kept.
+// Inputs of at least NATIVE_SCANNER_INDEX_THRESHOLD bytes are indexed.
+void native_scanner_set_input(NativeScanner* scanner, const char* input,
+    size_t length);
+
+// Produce the next event. Return zero on success, SERDEC_YAML_SYNTAX_ERROR
+// (with <problem> describing the error) if the input is invalid, or uses YAML
+// which isn't supported, or SERDEC_YAML_SYSTEM_ERROR if allocation fails.
+// Once the stream has ended, events of type YAML_NO_EVENT are produced.
+int native_scanner_next(NativeScanner* scanner, yaml_event_t* event);
+
+#endif // SERDEC_YAML_SCANNER_H
+
+///////////////////////////////////////////////////////////////////////////////
@@ -7,7 +7,7 @@
 //
 // CREATED:         02/04/2022
 //
-// LAST EDITED:     02/05/2022
+// LAST EDITED:     10/14/2026
 //
 // Copyright 2022, Ethan D. Twardy
 //
@@ -30,52 +30,545 @@
 // IN THE SOFTWARE.
 ////
 
-#include <assert.h>
 #include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <unistd.h>
 
 #include <yaml.h>
 
+#include <serdec/allocator-ops.h>
+#include <serdec/number-ops.h>
+#include <serdec/yaml-emitter.h>
 #include <serdec/yaml-error.h>
+#include <serdec/yaml-stats.h>
+#include <serdec/yaml-type.h>
 #include <serdec/yaml.h>
 #include <serdec/string-ops.h>
 
 static const char* SERDEC_YAML_ERROR_STRINGS[] = {
     [SERDEC_YAML_UNKNOWN_ERROR]="unknown error in libyaml",
     [SERDEC_YAML_WRONG_TYPE]="serializer is the wrong type for the operation",
+    [SERDEC_YAML_BUFFER_OVERFLOW]="output does not fit in the buffer",
+    [SERDEC_YAML_UNEXPECTED_EVENT]="operation is not valid at this point in "
+    "the document",
+    [SERDEC_YAML_CALLBACK_SIGNALED_ERROR]="callback returned non-zero",
+    [SERDEC_YAML_INVALID_STATE]="operation is not permitted once the stream "
+    "has started",
+    [SERDEC_YAML_OUT_OF_RANGE]="option is out of range",
+    [SERDEC_YAML_NOT_SUPPORTED]="the library was built without support for "
+    "the operation",
 };
 
 static const int SERDEC_YAML_INDENT = 4;
+static const size_t SERDEC_YAML_FLUSH_THRESHOLD = 65536;
 
 typedef enum SerializerType {
     SERIALIZER_STRING,
+    SERIALIZER_BUFFER,
+    SERIALIZER_FILE,
+    SERIALIZER_FD,
+    SERIALIZER_SINK,
 } SerializerType;
 
+// State of a serializer writing into a caller-supplied buffer. <length> counts
+// every byte produced, even those which did not fit.
+typedef struct FixedBuffer {
+    char* buffer;
+    size_t capacity;
+    size_t length;
+} FixedBuffer;
+
+// State of a serializer which stages output in a fixed-size buffer, and
+// writes it to a file (or file descriptor) once the buffer is full.
+typedef struct StagedOutput {
+    char* buffer;
+    size_t length;
+    size_t capacity;
+    FILE* file;
+    int fd;
+} StagedOutput;
+
+// State of a serializer which hands its output to user-defined callbacks.
+typedef struct SinkOutput {
+    yaml_write_callback* write;
+    yaml_flush_callback* flush;
+    void* user_data;
+} SinkOutput;
+
 typedef struct SerdecYamlSerializer {
     yaml_emitter_t emitter;
     yaml_event_t event;
     int error;
+    bool started;
+    bool document_open;
+    SerdecAllocator allocator;
+    SerdecYamlSerializerOptions options;
+
+    // Set when a list has been started, but its start event has not yet been
+    // emitted, because its style depends on its first element.
+    bool list_pending;
+
+    // Non-NULL when the native backend is selected.
+    NativeEmitter* native;
+
     struct {
         SerializerType type;
-        void (*free)(void* serializer_data);
-        void* serializer_data;
+        yaml_write_handler_t* write;
+        void (*free)(SerdecYamlSerializer* ser);
+        int (*flush)(SerdecYamlSerializer* ser);
+        void (*reset)(SerdecYamlSerializer* ser);
+        union {
+            StringBuffer string;
+            FixedBuffer buffer;
+            StagedOutput staged;
+            SinkOutput sink;
+        };
     } serializer;
+
+#ifdef SERDEC_ENABLE_STATS
+    Stats stats;
+#endif
 } SerdecYamlSerializer;
 
+// A key is stored once as given (for libyaml, which analyzes it itself), and
+// once encoded by the native emitter. Both follow the struct.
+struct SerdecYamlKey {
+    SerdecAllocator allocator;
+    const char* key;
+    size_t length;
+    const char* encoded;
+    size_t encoded_length;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 // Private API
 ////
 
+static void set_output(SerdecYamlSerializer* ser,
+    yaml_write_handler_t* write)
+{
+    ser->serializer.write = write;
+    yaml_emitter_set_output(&ser->emitter, write, ser);
+}
+
 static int string_write(void* user_data, unsigned char* buffer, size_t length)
 {
     SerdecYamlSerializer* ser = (SerdecYamlSerializer*)user_data;
-    char** string = (char**)&(ser->serializer.serializer_data);
-    *string = string_append_new_with_length(*string, (const char*)buffer,
-        length);
+    StringBuffer* output = &ser->serializer.string;
+    STATS_ADD(ser, bytes, length);
+
+    // The buffer grows unless it has room for the chunk, and the NUL.
+    STATS_ADD(ser, buffer_grows, length >= output->capacity - output->length);
+    if (string_buffer_append(output, (const char*)buffer, length)) {
+        ser->error = SERDEC_YAML_SYSTEM_ERROR;
+        return 0; // libyaml reports this as a writer error
+    }
     return 1; // To indicate success
 }
 
+static void string_free(SerdecYamlSerializer* ser) {
+    string_buffer_release(&ser->serializer.string);
+}
+
+static void string_reset(SerdecYamlSerializer* ser) {
+    string_buffer_clear(&ser->serializer.string);
+}
+
+static int buffer_write(void* user_data, unsigned char* buffer, size_t length)
+{
+    SerdecYamlSerializer* ser = (SerdecYamlSerializer*)user_data;
+    FixedBuffer* output = &ser->serializer.buffer;
+    STATS_ADD(ser, bytes, length);
+
+    // Once the output has overflowed, keep counting so the caller can learn
+    // how large the buffer needs to be, but stop copying.
+    if (output->length < output->capacity &&
+        length < output->capacity - output->length) {
+        memcpy(output->buffer + output->length, buffer, length);
+        output->buffer[output->length + length] = '\0';
+    }
+    output->length += length;
+    return 1;
+}
+
+static void buffer_free(SerdecYamlSerializer* ser) { (void)ser; }
+
+static void buffer_reset(SerdecYamlSerializer* ser) {
+    FixedBuffer* output = &ser->serializer.buffer;
+    output->length = 0;
+    if (0 < output->capacity) {
+        *output->buffer = '\0';
+    }
+}
+
+// A buffer is full once the output and its NUL don't fit. A zero-length buffer
+// can't even hold the NUL, but it's only full once there's output, so that
+// serializing into one measures the output, like snprintf(NULL, 0, ...).
+static bool buffer_overflowed(const SerdecYamlSerializer* ser) {
+    if (SERIALIZER_BUFFER != ser->serializer.type) {
+        return false;
+    }
+
+    const FixedBuffer* output = &ser->serializer.buffer;
+    if (0 == output->capacity) {
+        return 0 < output->length;
+    }
+    return output->length >= output->capacity;
+}
+
+// Write <length> bytes straight to the file or file descriptor.
+static int staged_write_through(SerdecYamlSerializer* ser, const char* data,
+    size_t length)
+{
+    StagedOutput* output = &ser->serializer.staged;
+    if (SERIALIZER_FILE == ser->serializer.type) {
+        if (length != fwrite(data, 1, length, output->file)) {
+            ser->error = SERDEC_YAML_SYSTEM_ERROR;
+            return ser->error;
+        }
+        return 0;
+    }
+
+    while (0 < length) {
+        ssize_t written = write(output->fd, data, length);
+        if (0 > written) {
+            if (EINTR == errno) {
+                continue;
+            }
+            ser->error = SERDEC_YAML_SYSTEM_ERROR;
+            return ser->error;
+        }
+        data += written;
+        length -= (size_t)written;
+    }
+    return 0;
+}
+
+static int staged_flush(SerdecYamlSerializer* ser) {
+    StagedOutput* output = &ser->serializer.staged;
+    if (0 == output->length) {
+        return 0;
+    }
+
+    size_t length = output->length;
+    output->length = 0;
+    return staged_write_through(ser, output->buffer, length);
+}
+
+static int staged_write(void* user_data, unsigned char* buffer, size_t length)
+{
+    SerdecYamlSerializer* ser = (SerdecYamlSerializer*)user_data;
+    StagedOutput* output = &ser->serializer.staged;
+    STATS_ADD(ser, bytes, length);
+    if (length > output->capacity - output->length) {
+        if (staged_flush(ser)) {
+            return 0;
+        }
+
+        // Chunks at least as large as the buffer gain nothing from staging.
+        if (length >= output->capacity) {
+            return !staged_write_through(ser, (const char*)buffer, length);
+        }
+    }
+
+    memcpy(output->buffer + output->length, buffer, length);
+    output->length += length;
+    return 1;
+}
+
+static void staged_free(SerdecYamlSerializer* ser) {
+    staged_flush(ser);
+    allocator_free(&ser->allocator, ser->serializer.staged.buffer);
+}
+
+static void staged_reset(SerdecYamlSerializer* ser) {
+    ser->serializer.staged.length = 0;
+}
+
+// Allocate a serializer, and initialize its emitter to write with <write>.
+static SerdecYamlSerializer* allocate_serializer(
+    const SerdecAllocator* allocator, yaml_write_handler_t* write)
+{
+    allocator = allocator_or_default(allocator);
+    SerdecYamlSerializer* ser = allocator_alloc(allocator,
+        sizeof(SerdecYamlSerializer));
+    if (NULL == ser) {
+        return NULL;
+    }
+
+    memset(ser, 0, sizeof(*ser));
+    ser->allocator = *allocator;
+#ifdef SERDEC_ENABLE_STATS
+    stats_initialize(&ser->stats, &ser->allocator);
+#endif
+    ser->options.indent = SERDEC_YAML_INDENT;
+    if (!yaml_emitter_initialize(&ser->emitter)) {
+        allocator_free(allocator, ser);
+        errno = ENOMEM;
+        return NULL;
+    }
+
+    yaml_emitter_set_indent(&ser->emitter, SERDEC_YAML_INDENT);
+    set_output(ser, write);
+    return ser;
+}
+
+// Release a serializer which allocate_serializer() returned, before its
+// output has been initialized.
+static void release_serializer(SerdecYamlSerializer* ser) {
+    yaml_emitter_delete(&ser->emitter);
+    SerdecAllocator allocator = *CALLER_ALLOCATOR(ser);
+    allocator_free(&allocator, ser);
+}
+
+static SerdecYamlSerializer* staged_new(SerializerType type, FILE* file,
+    int fd, const SerdecAllocator* allocator)
+{
+    SerdecYamlSerializer* ser = allocate_serializer(allocator, staged_write);
+    if (NULL == ser) {
+        return NULL;
+    }
+
+    StagedOutput* output = &ser->serializer.staged;
+    output->buffer = allocator_alloc(&ser->allocator,
+        SERDEC_YAML_FLUSH_THRESHOLD);
+    if (NULL == output->buffer) {
+        release_serializer(ser);
+        return NULL;
+    }
+    output->capacity = SERDEC_YAML_FLUSH_THRESHOLD;
+    output->file = file;
+    output->fd = fd;
+
+    ser->serializer.free = staged_free;
+    ser->serializer.flush = staged_flush;
+    ser->serializer.reset = staged_reset;
+    ser->serializer.type = type;
+    return ser;
+}
+
+static int sink_write(void* user_data, unsigned char* buffer, size_t length) {
+    SerdecYamlSerializer* ser = (SerdecYamlSerializer*)user_data;
+    SinkOutput* output = &ser->serializer.sink;
+    STATS_ADD(ser, bytes, length);
+    STATS_TIMER(start);
+    int failed = output->write(output->user_data, (const char*)buffer, length);
+    STATS_ADD_TIME(ser, callback_ns, start);
+    if (failed) {
+        ser->error = SERDEC_YAML_CALLBACK_SIGNALED_ERROR;
+        return 0;
+    }
+    return 1;
+}
+
+static int sink_flush(SerdecYamlSerializer* ser) {
+    SinkOutput* output = &ser->serializer.sink;
+    if (NULL == output->flush) {
+        return 0;
+    }
+
+    STATS_TIMER(start);
+    int failed = output->flush(output->user_data);
+    STATS_ADD_TIME(ser, callback_ns, start);
+    if (failed) {
+        ser->error = SERDEC_YAML_CALLBACK_SIGNALED_ERROR;
+        return ser->error;
+    }
+    return 0;
+}
+
+static void sink_free(SerdecYamlSerializer* ser) { (void)ser; }
+
+// Return the emitter to the state yaml_emitter_initialize() leaves it in, but
+// keep its settings, and the buffers and stacks it has allocated. libyaml has
+// no API for this, so it mirrors yaml_emitter_delete(), which releases the
+// pending events and tag directives.
+static void reset_emitter(yaml_emitter_t* emitter) {
+    while (emitter->events.head != emitter->events.tail) {
+        yaml_event_delete(emitter->events.head++);
+    }
+    while (emitter->tag_directives.top != emitter->tag_directives.start) {
+        yaml_tag_directive_t* directive = --emitter->tag_directives.top;
+        free(directive->handle);
+        free(directive->prefix);
+    }
+    free(emitter->anchors);
+
+    yaml_emitter_t reset = {0};
+    reset.buffer = emitter->buffer;
+    reset.buffer.pointer = reset.buffer.last = reset.buffer.start;
+    reset.raw_buffer = emitter->raw_buffer;
+    reset.raw_buffer.pointer = reset.raw_buffer.last = reset.raw_buffer.start;
+    reset.states = emitter->states;
+    reset.states.top = reset.states.start;
+    reset.events = emitter->events;
+    reset.events.head = reset.events.tail = reset.events.start;
+    reset.indents = emitter->indents;
+    reset.indents.top = reset.indents.start;
+    reset.tag_directives = emitter->tag_directives;
+    reset.canonical = emitter->canonical;
+    reset.best_indent = emitter->best_indent;
+    reset.best_width = emitter->best_width;
+    reset.unicode = emitter->unicode;
+    reset.line_break = emitter->line_break;
+    memcpy(emitter, &reset, sizeof(reset));
+}
+
+static int emit(SerdecYamlSerializer* ser, yaml_event_t* event) {
+    STATS_ADD(ser, events, 1);
+    if (!yaml_emitter_emit(&ser->emitter, event)) {
+        // Output handlers record their own error before failing.
+        if (YAML_WRITER_ERROR != ser->emitter.error) {
+            ser->error = SERDEC_YAML_UNKNOWN_ERROR;
+        }
+        return ser->error;
+    }
+
+    if (buffer_overflowed(ser)) {
+        ser->error = SERDEC_YAML_BUFFER_OVERFLOW;
+        return ser->error;
+    }
+    return 0;
+}
+
+// Emit the start of a pending list, in flow style if <event> (its first
+// element, or its end) is a scalar.
+static int emit_pending_list(SerdecYamlSerializer* ser,
+    const yaml_event_t* event)
+{
+    ser->list_pending = false;
+    yaml_sequence_style_t style = YAML_ANY_SEQUENCE_STYLE;
+    if (YAML_SCALAR_EVENT == event->type) {
+        style = YAML_FLOW_SEQUENCE_STYLE;
+    }
+
+    yaml_event_t start;
+    yaml_sequence_start_event_initialize(&start, NULL, NULL, 0, style);
+    return emit(ser, &start);
+}
+
+static int emit_event(SerdecYamlSerializer* ser) {
+    if (ser->list_pending && emit_pending_list(ser, &ser->event)) {
+        yaml_event_delete(&ser->event);
+        return ser->error;
+    }
+    return emit(ser, &ser->event);
+}
+
+// The layout of the native emitter, according to the options.
+static NativeEmitterStyle native_style(const SerdecYamlSerializer* ser) {
+    NativeEmitterStyle style = {
+        .indent = ser->options.indent,
+        .flow_scalar_lists = ser->options.flow_scalar_lists,
+        .omit_directives = ser->options.omit_directives,
+    };
+    return style;
+}
+
+// Translate the result of a native emitter routine into the serializer's
+// error state.
+static int native_status(SerdecYamlSerializer* ser, int result) {
+    if (result) {
+        // Output handlers record their own error before failing.
+        if (!ser->native->write_failed) {
+            ser->error = result;
+        }
+        return ser->error;
+    }
+
+    if (buffer_overflowed(ser)) {
+        ser->error = SERDEC_YAML_BUFFER_OVERFLOW;
+        return ser->error;
+    }
+    return 0;
+}
+
+// Like native_status(), for the routines which emit an event.
+static int native_event(SerdecYamlSerializer* ser, int result) {
+    STATS_ADD(ser, events, 1);
+    return native_status(ser, result);
+}
+
+// Serialize a formatted number as a plain scalar.
+static int serialize_number(SerdecYamlSerializer* ser, const char* tag,
+    const char* buffer, size_t length)
+{
+    STATS_ADD(ser, scalar_bytes, length);
+    if (NULL != ser->native) {
+        return native_event(ser, native_emitter_scalar(ser->native, buffer,
+                length, NATIVE_SCALAR_PLAIN));
+    }
+
+    yaml_scalar_event_initialize(&ser->event, NULL, (const yaml_char_t*)tag,
+        (const yaml_char_t*)buffer, length, 1, 0, YAML_PLAIN_SCALAR_STYLE);
+    return emit_event(ser);
+}
+
+// Serialize a single value of a struct field (i.e. an array element, if the
+// field is an array).
+static int serialize_element(SerdecYamlSerializer* ser,
+    const PreparedField* field, const char* element)
+{
+    switch (field->descriptor->kind) {
+    case SERDEC_YAML_KIND_BOOL:
+        return serdec_yaml_serialize_bool(ser, *(const bool*)element);
+    case SERDEC_YAML_KIND_INT:
+        return serdec_yaml_serialize_int(ser, *(const int*)element);
+    case SERDEC_YAML_KIND_INT64:
+        return serdec_yaml_serialize_int64(ser, *(const int64_t*)element);
+    case SERDEC_YAML_KIND_UINT64:
+        return serdec_yaml_serialize_uint64(ser, *(const uint64_t*)element);
+    case SERDEC_YAML_KIND_SIZE_T:
+        return serdec_yaml_serialize_size_t(ser, *(const size_t*)element);
+    case SERDEC_YAML_KIND_DOUBLE:
+        return serdec_yaml_serialize_double(ser, *(const double*)element);
+    case SERDEC_YAML_KIND_STRING: {
+        const char* string = *(const char* const*)element;
+        return serdec_yaml_serialize_string(ser, NULL != string ? string : "");
+    }
+    case SERDEC_YAML_KIND_STRUCT:
+        return serdec_yaml_serialize_struct(ser, field->type, element);
+    default:
+        ser->error = SERDEC_YAML_WRONG_TYPE;
+        return ser->error;
+    }
+}
+
+static int serialize_field(SerdecYamlSerializer* ser,
+    const PreparedField* field, const char* member)
+{
+    int result = 0;
+    if (NULL != ser->native) {
+        STATS_ADD(ser, scalar_bytes, field->name_length);
+        result = native_event(ser, native_emitter_map_key_analyzed(
+                ser->native, field->descriptor->name, field->name_length,
+                field->plain_name));
+    } else {
+        result = serdec_yaml_serialize_map_key_n(ser, field->descriptor->name,
+            field->name_length);
+    }
+
+    if (result) {
+        return result;
+    }
+
+    size_t count = field->descriptor->array_length;
+    if (0 == count) {
+        return serialize_element(ser, field, member);
+    }
+
+    if (serdec_yaml_serialize_list_start(ser)) {
+        return ser->error;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (serialize_element(ser, field, member + i * field->element_size)) {
+            return ser->error;
+        }
+    }
+    return serdec_yaml_serialize_list_end(ser);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Error Handling
 ////
@@ -97,47 +590,399 @@ const char* serdec_yaml_serializer_strerror(SerdecYamlSerializer* ser) {
 // Serializer Initialization
 ////
 
-// Initialize a serializer from the given input string.
+// Initialize a serializer which writes to the buffer. If the buffer does not
+// contain enough space, an error is signaled.
 SerdecYamlSerializer* serdec_yaml_serializer_new_buffer(char* buffer,
-    size_t buffer_length);
+    size_t buffer_length)
+{
+    return serdec_yaml_serializer_new_buffer_with_allocator(buffer,
+        buffer_length, NULL);
+}
+
+SerdecYamlSerializer* serdec_yaml_serializer_new_buffer_with_allocator(
+    char* buffer, size_t buffer_length, const SerdecAllocator* allocator)
+{
+    SerdecYamlSerializer* ser = allocate_serializer(allocator, buffer_write);
+    if (NULL == ser) {
+        return NULL;
+    }
+
+    ser->serializer.buffer.buffer = buffer;
+    ser->serializer.buffer.capacity = buffer_length;
+    ser->serializer.buffer.length = 0;
+    if (0 < buffer_length) {
+        *buffer = '\0';
+    }
+
+    ser->serializer.free = buffer_free;
+    ser->serializer.reset = buffer_reset;
+    ser->serializer.type = SERIALIZER_BUFFER;
+    return ser;
+}
 
 // Initialize a serializer which will generate a string. The string will be
 // allocated with malloc(3), and can be borrowed with _borrow_string().
 SerdecYamlSerializer* serdec_yaml_serializer_new_string() {
-    SerdecYamlSerializer* ser = malloc(sizeof(SerdecYamlSerializer));
-    assert(NULL != ser);
-    memset(ser, 0, sizeof(*ser));
-    yaml_emitter_initialize(&ser->emitter);
-    yaml_emitter_set_indent(&ser->emitter, SERDEC_YAML_INDENT);
-    yaml_emitter_set_output(&ser->emitter, string_write, ser);
+    return serdec_yaml_serializer_new_string_with_allocator(NULL);
+}
 
-    char* string = malloc(sizeof(char));
-    assert(NULL != string);
-    *string = '\0';
-    ser->serializer.serializer_data = string;
+SerdecYamlSerializer* serdec_yaml_serializer_new_string_with_allocator(
+    const SerdecAllocator* allocator)
+{
+    SerdecYamlSerializer* ser = allocate_serializer(allocator, string_write);
+    if (NULL == ser) {
+        return NULL;
+    }
 
-    ser->serializer.free = free;
+    // The output buffer is allocated on the first write.
+    string_buffer_init(&ser->serializer.string, &ser->allocator);
+    ser->serializer.free = string_free;
+    ser->serializer.reset = string_reset;
     ser->serializer.type = SERIALIZER_STRING;
     return ser;
 }
 
 const char* serdec_yaml_serializer_borrow_string(SerdecYamlSerializer* ser)
 {
+    if (SERIALIZER_BUFFER == ser->serializer.type) {
+        if (buffer_overflowed(ser)) {
+            ser->error = SERDEC_YAML_BUFFER_OVERFLOW;
+            return NULL;
+        }
+        if (0 == ser->serializer.buffer.capacity) {
+            return "";
+        }
+        return ser->serializer.buffer.buffer;
+    }
+
     if (SERIALIZER_STRING != ser->serializer.type) {
         ser->error = SERDEC_YAML_WRONG_TYPE;
         return NULL;
     }
-    return ser->serializer.serializer_data;
+
+    if (NULL == ser->serializer.string.string) {
+        return "";
+    }
+    return ser->serializer.string.string;
 }
 
-// Initialize a serializer from the given input string.
-SerdecYamlSerializer* serdec_yaml_serializer_new_file(FILE* input_file);
+char* serdec_yaml_serializer_take_string(SerdecYamlSerializer* ser,
+    size_t* length)
+{
+    if (SERIALIZER_STRING != ser->serializer.type) {
+        ser->error = SERDEC_YAML_WRONG_TYPE;
+        return NULL;
+    }
+
+    char* string = string_buffer_take(&ser->serializer.string, length);
+    if (NULL == string) {
+        ser->error = SERDEC_YAML_SYSTEM_ERROR;
+    }
+    return string;
+}
+
+size_t serdec_yaml_serializer_required_size(SerdecYamlSerializer* ser) {
+    switch (ser->serializer.type) {
+    case SERIALIZER_STRING: return ser->serializer.string.length + 1;
+    case SERIALIZER_BUFFER: return ser->serializer.buffer.length + 1;
+    default: return 0;
+    }
+}
+
+int serdec_yaml_serializer_reserve(SerdecYamlSerializer* ser, size_t length) {
+    if (SERIALIZER_STRING != ser->serializer.type) {
+        return 0;
+    }
+
+    StringBuffer* string = &ser->serializer.string;
+    if (length <= string->length) {
+        return 0;
+    }
+
+    if (string_buffer_reserve(string, length - string->length)) {
+        ser->error = SERDEC_YAML_SYSTEM_ERROR;
+        return ser->error;
+    }
+    return 0;
+}
+
+// Initialize a serializer which writes to the file. Output is staged in an
+// internal buffer, which is written with a single fwrite(3) once it's full.
+SerdecYamlSerializer* serdec_yaml_serializer_new_file(FILE* output_file) {
+    return staged_new(SERIALIZER_FILE, output_file, -1, NULL);
+}
+
+SerdecYamlSerializer* serdec_yaml_serializer_new_file_with_allocator(
+    FILE* output_file, const SerdecAllocator* allocator)
+{
+    return staged_new(SERIALIZER_FILE, output_file, -1, allocator);
+}
+
+// Initialize a serializer which writes to the file descriptor with write(2),
+// bypassing stdio entirely.
+SerdecYamlSerializer* serdec_yaml_serializer_new_fd(int fd) {
+    return staged_new(SERIALIZER_FD, NULL, fd, NULL);
+}
+
+SerdecYamlSerializer* serdec_yaml_serializer_new_fd_with_allocator(int fd,
+    const SerdecAllocator* allocator)
+{
+    return staged_new(SERIALIZER_FD, NULL, fd, allocator);
+}
+
+// Initialize a serializer which passes its output to the user-defined write
+// callback as it's produced. The flush callback may be NULL.
+SerdecYamlSerializer* serdec_yaml_serializer_new_sink(
+    yaml_write_callback* write, yaml_flush_callback* flush, void* user_data)
+{
+    return serdec_yaml_serializer_new_sink_with_allocator(write, flush,
+        user_data, NULL);
+}
+
+SerdecYamlSerializer* serdec_yaml_serializer_new_sink_with_allocator(
+    yaml_write_callback* write, yaml_flush_callback* flush, void* user_data,
+    const SerdecAllocator* allocator)
+{
+    SerdecYamlSerializer* ser = allocate_serializer(allocator, sink_write);
+    if (NULL == ser) {
+        return NULL;
+    }
+
+    ser->serializer.sink.write = write;
+    ser->serializer.sink.flush = flush;
+    ser->serializer.sink.user_data = user_data;
+    ser->serializer.free = sink_free;
+    ser->serializer.flush = sink_flush;
+    ser->serializer.type = SERIALIZER_SINK;
+    return ser;
+}
+
+int serdec_yaml_serializer_set_flush_threshold(SerdecYamlSerializer* ser,
+    size_t threshold)
+{
+    if (SERIALIZER_FILE != ser->serializer.type &&
+        SERIALIZER_FD != ser->serializer.type) {
+        ser->error = SERDEC_YAML_WRONG_TYPE;
+        return ser->error;
+    }
+
+    if (staged_flush(ser)) {
+        return ser->error;
+    }
+
+    // realloc() to zero bytes needn't free the buffer, so it's done here.
+    StagedOutput* output = &ser->serializer.staged;
+    if (0 == threshold) {
+        allocator_free(&ser->allocator, output->buffer);
+        output->buffer = NULL;
+        output->capacity = 0;
+        return 0;
+    }
+
+    char* buffer = allocator_realloc(&ser->allocator, output->buffer,
+        threshold);
+    if (NULL == buffer) {
+        ser->error = SERDEC_YAML_SYSTEM_ERROR;
+        return ser->error;
+    }
+
+    output->buffer = buffer;
+    output->capacity = threshold;
+    return 0;
+}
+
+int serdec_yaml_serializer_set_backend(SerdecYamlSerializer* ser,
+    SerdecYamlBackend backend)
+{
+    if (ser->started) {
+        ser->error = SERDEC_YAML_INVALID_STATE;
+        return ser->error;
+    }
+
+    if (SERDEC_YAML_BACKEND_LIBYAML == backend) {
+        if (NULL != ser->native) {
+            native_emitter_delete(ser->native);
+            allocator_free(&ser->allocator, ser->native);
+            ser->native = NULL;
+        }
+        return 0;
+    }
+
+    if (NULL == ser->native) {
+        ser->native = allocator_alloc(&ser->allocator, sizeof(NativeEmitter));
+        if (NULL == ser->native) {
+            ser->error = SERDEC_YAML_SYSTEM_ERROR;
+            return ser->error;
+        }
+        NativeEmitterStyle style = native_style(ser);
+        native_emitter_initialize(ser->native, ser->serializer.write, ser,
+            &style, &ser->allocator);
+    }
+    return 0;
+}
+
+int serdec_yaml_serializer_set_options(SerdecYamlSerializer* ser,
+    const SerdecYamlSerializerOptions* options)
+{
+    if (ser->started) {
+        ser->error = SERDEC_YAML_INVALID_STATE;
+        return ser->error;
+    }
+
+    SerdecYamlSerializerOptions defaults = {0};
+    if (NULL == options) {
+        options = &defaults;
+    }
+
+    // These are the limits libyaml places on the indentation.
+    int indent = 0 != options->indent ? options->indent : SERDEC_YAML_INDENT;
+    if (2 > indent || 9 < indent) {
+        ser->error = SERDEC_YAML_OUT_OF_RANGE;
+        return ser->error;
+    }
+
+    ser->options = *options;
+    ser->options.indent = indent;
+
+    // libyaml folds flow collections which pass the line width. The native
+    // emitter never does, and unfolded collections are more compact.
+    yaml_emitter_set_indent(&ser->emitter, indent);
+    yaml_emitter_set_width(&ser->emitter, options->flow_scalar_lists ? -1 : 0);
+    if (NULL != ser->native) {
+        ser->native->style = native_style(ser);
+    }
+    return 0;
+}
+
+int serdec_yaml_serializer_flush(SerdecYamlSerializer* ser) {
+    if (NULL != ser->native) {
+        if (native_status(ser, native_emitter_flush(ser->native))) {
+            return ser->error;
+        }
+    } else if (!yaml_emitter_flush(&ser->emitter)) {
+        if (YAML_WRITER_ERROR != ser->emitter.error) {
+            ser->error = SERDEC_YAML_UNKNOWN_ERROR;
+        }
+        return ser->error;
+    }
+
+    if (NULL != ser->serializer.flush && ser->serializer.flush(ser)) {
+        return ser->error;
+    }
+
+    if (SERIALIZER_FILE == ser->serializer.type &&
+        fflush(ser->serializer.staged.file)) {
+        ser->error = SERDEC_YAML_SYSTEM_ERROR;
+        return ser->error;
+    }
+    return 0;
+}
+
+// Re-use the serializer for a new stream.
+int serdec_yaml_serializer_reset(SerdecYamlSerializer* ser) {
+    reset_emitter(&ser->emitter);
+    set_output(ser, ser->serializer.write);
+    if (NULL != ser->native) {
+        native_emitter_reset(ser->native);
+    }
+    if (NULL != ser->serializer.reset) {
+        ser->serializer.reset(ser);
+    }
+
+    ser->error = 0;
+    ser->started = false;
+    ser->document_open = false;
+    ser->list_pending = false;
+    STATS_REWIND(ser);
+    return 0;
+}
+
+int serdec_yaml_serializer_reset_buffer(SerdecYamlSerializer* ser,
+    char* buffer, size_t buffer_length)
+{
+    if (SERIALIZER_BUFFER != ser->serializer.type) {
+        ser->error = SERDEC_YAML_WRONG_TYPE;
+        return ser->error;
+    }
+
+    ser->serializer.buffer.buffer = buffer;
+    ser->serializer.buffer.capacity = buffer_length;
+    return serdec_yaml_serializer_reset(ser);
+}
 
 // Free a serializer.
 void serdec_yaml_serializer_free(SerdecYamlSerializer* ser) {
-    ser->serializer.free(ser->serializer.serializer_data);
+    if (NULL != ser->native) {
+        // Buffered output must reach the output handler before it's released.
+        native_emitter_flush(ser->native);
+        native_emitter_delete(ser->native);
+        allocator_free(&ser->allocator, ser->native);
+    }
+    ser->serializer.free(ser);
     yaml_emitter_delete(&ser->emitter);
-    free(ser);
+    SerdecAllocator allocator = *CALLER_ALLOCATOR(ser);
+    allocator_free(&allocator, ser);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Prepared Keys
+////
+
+SerdecYamlKey* serdec_yaml_key_prepare(const char* key) {
+    return serdec_yaml_key_prepare_n_with_allocator(key, strlen(key), NULL);
+}
+
+SerdecYamlKey* serdec_yaml_key_prepare_n(const char* key, size_t length) {
+    return serdec_yaml_key_prepare_n_with_allocator(key, length, NULL);
+}
+
+SerdecYamlKey* serdec_yaml_key_prepare_with_allocator(const char* key,
+    const SerdecAllocator* allocator)
+{
+    return serdec_yaml_key_prepare_n_with_allocator(key, strlen(key),
+        allocator);
+}
+
+SerdecYamlKey* serdec_yaml_key_prepare_n_with_allocator(const char* key,
+    size_t length, const SerdecAllocator* allocator)
+{
+    allocator = allocator_or_default(allocator);
+    StringBuffer encoded;
+    string_buffer_init(&encoded, allocator);
+    if (native_emitter_encode_key(key, length, &encoded)) {
+        string_buffer_release(&encoded);
+        errno = ENOMEM;
+        return NULL;
+    }
+
+    SerdecYamlKey* prepared = allocator_alloc(allocator,
+        sizeof(SerdecYamlKey) + length + 1 + encoded.length);
+    if (NULL == prepared) {
+        string_buffer_release(&encoded);
+        errno = ENOMEM;
+        return NULL;
+    }
+
+    char* storage = (char*)(prepared + 1);
+    memcpy(storage, key, length);
+    storage[length] = '\0';
+    memcpy(storage + length + 1, encoded.string, encoded.length);
+    prepared->allocator = *allocator;
+    prepared->key = storage;
+    prepared->length = length;
+    prepared->encoded = storage + length + 1;
+    prepared->encoded_length = encoded.length;
+    string_buffer_release(&encoded);
+    return prepared;
+}
+
+void serdec_yaml_key_free(SerdecYamlKey* key) {
+    if (NULL == key) {
+        return;
+    }
+
+    SerdecAllocator allocator = key->allocator;
+    allocator_free(&allocator, key);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -149,36 +994,69 @@ void serdec_yaml_serializer_free(SerdecYamlSerializer* ser) {
 // before extracting any output from the serializer, or else the stream may
 // not be terminated.
 int serdec_yaml_serialize_start(SerdecYamlSerializer* ser) {
-    yaml_stream_start_event_initialize(&ser->event, YAML_UTF8_ENCODING);
-    int result = 0;
-    if (!yaml_emitter_emit(&ser->emitter, &ser->event)) {
-        ser->error = SERDEC_YAML_UNKNOWN_ERROR;
-        result = ser->error;
+    ser->started = true;
+    if (NULL == ser->native) {
+        yaml_stream_start_event_initialize(&ser->event, YAML_UTF8_ENCODING);
+        if (emit_event(ser)) {
+            return ser->error;
+        }
     }
 
-    yaml_version_directive_t version = {.major=1, .minor=1};
-    yaml_document_start_event_initialize(&ser->event, &version, NULL, NULL, 0);
-    if (!yaml_emitter_emit(&ser->emitter, &ser->event)) {
-        ser->error = SERDEC_YAML_UNKNOWN_ERROR;
-        result = ser->error;
-    }
-    return result;
+    return serdec_yaml_serialize_document_start(ser);
 }
 
 int serdec_yaml_serialize_end(SerdecYamlSerializer* ser) {
-    yaml_document_end_event_initialize(&ser->event, 1);
-    int result = 0;
-    if (!yaml_emitter_emit(&ser->emitter, &ser->event)) {
-        ser->error = SERDEC_YAML_UNKNOWN_ERROR;
-        result = ser->error;
+    if (ser->document_open && serdec_yaml_serialize_document_end(ser)) {
+        return ser->error;
+    }
+
+    if (NULL == ser->native) {
+        yaml_stream_end_event_initialize(&ser->event);
+        if (emit_event(ser)) {
+            return ser->error;
+        }
+    }
+
+    if (NULL != ser->serializer.flush) {
+        return ser->serializer.flush(ser);
+    }
+    return 0;
+}
+
+// Begin a new document in the stream. _start() begins the first document, so
+// this is only needed once the previous document has been ended.
+int serdec_yaml_serialize_document_start(SerdecYamlSerializer* ser) {
+    if (!ser->started || ser->document_open) {
+        ser->error = SERDEC_YAML_UNEXPECTED_EVENT;
+        return ser->error;
     }
 
-    yaml_stream_end_event_initialize(&ser->event);
-    if (!yaml_emitter_emit(&ser->emitter, &ser->event)) {
-        ser->error = SERDEC_YAML_UNKNOWN_ERROR;
-        result = ser->error;
+    ser->document_open = true;
+    if (NULL != ser->native) {
+        return native_event(ser,
+            native_emitter_document_start(ser->native));
     }
-    return result;
+
+    yaml_version_directive_t version = {.major=1, .minor=1};
+    bool implicit = ser->options.omit_directives;
+    yaml_document_start_event_initialize(&ser->event,
+        implicit ? NULL : &version, NULL, NULL, implicit);
+    return emit_event(ser);
+}
+
+int serdec_yaml_serialize_document_end(SerdecYamlSerializer* ser) {
+    if (!ser->document_open) {
+        ser->error = SERDEC_YAML_UNEXPECTED_EVENT;
+        return ser->error;
+    }
+
+    ser->document_open = false;
+    if (NULL != ser->native) {
+        return native_event(ser, native_emitter_document_end(ser->native));
+    }
+
+    yaml_document_end_event_initialize(&ser->event, 1);
+    return emit_event(ser);
 }
 
 // Serialize a map to the output stream. To use this in an object serialization
@@ -187,35 +1065,53 @@ int serdec_yaml_serialize_end(SerdecYamlSerializer* ser) {
 // routines to serialize the value for the associated key into the output
 // stream. Finally, call _end().
 int serdec_yaml_serialize_map_start(SerdecYamlSerializer* ser) {
+    STATS_ENTER(ser);
+    if (NULL != ser->native) {
+        return native_event(ser, native_emitter_map_start(ser->native));
+    }
+
     yaml_mapping_start_event_initialize(&ser->event, NULL,
         (const yaml_char_t*)YAML_MAP_TAG, 1, YAML_ANY_MAPPING_STYLE);
-    int result = 0;
-    if (!yaml_emitter_emit(&ser->emitter, &ser->event)) {
-        ser->error = SERDEC_YAML_UNKNOWN_ERROR;
-        result = ser->error;
-    }
-    return result;
+    return emit_event(ser);
 }
 
 int serdec_yaml_serialize_map_end(SerdecYamlSerializer* ser) {
-    yaml_mapping_end_event_initialize(&ser->event);
-    int result = 0;
-    if (!yaml_emitter_emit(&ser->emitter, &ser->event)) {
-        ser->error = SERDEC_YAML_UNKNOWN_ERROR;
-        result = ser->error;
+    STATS_LEAVE(ser);
+    if (NULL != ser->native) {
+        return native_event(ser, native_emitter_map_end(ser->native));
     }
-    return result;
+
+    yaml_mapping_end_event_initialize(&ser->event);
+    return emit_event(ser);
 }
 
 int serdec_yaml_serialize_map_key(SerdecYamlSerializer* ser, const char* key) {
+    return serdec_yaml_serialize_map_key_n(ser, key, strlen(key));
+}
+
+int serdec_yaml_serialize_map_key_n(SerdecYamlSerializer* ser, const char* key,
+    size_t length)
+{
+    STATS_ADD(ser, scalar_bytes, length);
+    if (NULL != ser->native) {
+        return native_event(ser, native_emitter_map_key(ser->native, key,
+                length));
+    }
+
     yaml_scalar_event_initialize(&ser->event, NULL, (yaml_char_t*)YAML_STR_TAG,
-        (const yaml_char_t*)key, strlen(key), 1, 0, YAML_PLAIN_SCALAR_STYLE);
-    int result = 0;
-    if (!yaml_emitter_emit(&ser->emitter, &ser->event)) {
-        ser->error = SERDEC_YAML_UNKNOWN_ERROR;
-        result = ser->error;
+        (const yaml_char_t*)key, length, 1, 0, YAML_PLAIN_SCALAR_STYLE);
+    return emit_event(ser);
+}
+
+int serdec_yaml_serialize_map_key_prepared(SerdecYamlSerializer* ser,
+    const SerdecYamlKey* key)
+{
+    if (NULL != ser->native) {
+        STATS_ADD(ser, scalar_bytes, key->length);
+        return native_event(ser, native_emitter_map_key_encoded(ser->native,
+                key->key, key->length, key->encoded, key->encoded_length));
     }
-    return result;
+    return serdec_yaml_serialize_map_key_n(ser, key->key, key->length);
 }
 
 // Serialize a list to the output stream. To use this in an object
@@ -223,24 +1119,33 @@ int serdec_yaml_serialize_map_key(SerdecYamlSerializer* ser, const char* key) {
 // a serialization routine to serialize a single element into the output
 // stream. Finally, call _end().
 int serdec_yaml_serialize_list_start(SerdecYamlSerializer* ser) {
+    STATS_ENTER(ser);
+    if (NULL != ser->native) {
+        return native_event(ser, native_emitter_list_start(ser->native));
+    }
+
     yaml_sequence_start_event_initialize(&ser->event, NULL, NULL, 0,
         YAML_ANY_SEQUENCE_STYLE);
-    int result = 0;
-    if (!yaml_emitter_emit(&ser->emitter, &ser->event)) {
-        ser->error = SERDEC_YAML_UNKNOWN_ERROR;
-        result = ser->error;
+    if (!ser->options.flow_scalar_lists) {
+        return emit_event(ser);
+    }
+
+    // The start of the list is emitted with its first element.
+    if (ser->list_pending && emit_pending_list(ser, &ser->event)) {
+        return ser->error;
     }
-    return result;
+    ser->list_pending = true;
+    return 0;
 }
 
 int serdec_yaml_serialize_list_end(SerdecYamlSerializer* ser) {
-    yaml_sequence_end_event_initialize(&ser->event);
-    int result = 0;
-    if (!yaml_emitter_emit(&ser->emitter, &ser->event)) {
-        ser->error = SERDEC_YAML_UNKNOWN_ERROR;
-        result = ser->error;
+    STATS_LEAVE(ser);
+    if (NULL != ser->native) {
+        return native_event(ser, native_emitter_list_end(ser->native));
     }
-    return result;
+
+    yaml_sequence_end_event_initialize(&ser->event);
+    return emit_event(ser);
 }
 
 // Serialize a boolean to the output stream. Return non-zero if parsing
@@ -250,53 +1155,192 @@ int serdec_yaml_serialize_bool(SerdecYamlSerializer* ser, bool value) {
     if (value) {
         string_value = "true";
     }
+
+    STATS_ADD(ser, scalar_bytes, strlen(string_value));
+    if (NULL != ser->native) {
+        return native_event(ser, native_emitter_scalar(ser->native,
+                string_value, strlen(string_value), NATIVE_SCALAR_PLAIN));
+    }
     yaml_scalar_event_initialize(&ser->event, NULL,
         (const yaml_char_t*)YAML_STR_TAG, (const yaml_char_t*)string_value,
         strlen(string_value), 1, 0, YAML_PLAIN_SCALAR_STYLE);
-    int result = 0;
-    if (!yaml_emitter_emit(&ser->emitter, &ser->event)) {
-        ser->error = SERDEC_YAML_UNKNOWN_ERROR;
-        result = ser->error;
-    }
-    return result;
+    return emit_event(ser);
 }
 
 // Serialize an integer value to the output stream. Return non-zero if parsing
 // encountered an error, for any reason.
 int serdec_yaml_serialize_int(SerdecYamlSerializer* ser, int value) {
-    char buffer[64] = {0}; // May as well use a whole cache line?
-    int result = snprintf(buffer, sizeof(buffer), "%d", value);
-    if (0 > result) {
-        ser->error = SERDEC_YAML_SYSTEM_ERROR;
-        return result;
-    }
+    return serdec_yaml_serialize_int64(ser, value);
+}
 
-    yaml_scalar_event_initialize(&ser->event, NULL,
-        (const yaml_char_t*)YAML_INT_TAG, (const yaml_char_t*)buffer, result,
-        1, 0, YAML_PLAIN_SCALAR_STYLE);
-    result = 0;
-    if (!yaml_emitter_emit(&ser->emitter, &ser->event)) {
-        ser->error = SERDEC_YAML_UNKNOWN_ERROR;
-        result = ser->error;
-    }
-    return result;
+int serdec_yaml_serialize_int64(SerdecYamlSerializer* ser, int64_t value) {
+    char buffer[NUMBER_BUFFER_SIZE];
+    size_t length = format_int64(buffer, value);
+    return serialize_number(ser, YAML_INT_TAG, buffer, length);
+}
+
+int serdec_yaml_serialize_uint64(SerdecYamlSerializer* ser, uint64_t value) {
+    char buffer[NUMBER_BUFFER_SIZE];
+    size_t length = format_uint64(buffer, value);
+    return serialize_number(ser, YAML_INT_TAG, buffer, length);
+}
+
+int serdec_yaml_serialize_size_t(SerdecYamlSerializer* ser, size_t value) {
+    return serdec_yaml_serialize_uint64(ser, value);
+}
+
+// Serialize a floating point value to the output stream, using a
+// representation which reads back to the same value.
+int serdec_yaml_serialize_double(SerdecYamlSerializer* ser, double value) {
+    char buffer[NUMBER_BUFFER_SIZE];
+    size_t length = format_double(buffer, value);
+    return serialize_number(ser, YAML_FLOAT_TAG, buffer, length);
 }
 
 // Serialize a string value to the output stream. Return non-zero if parsing
 // encounters an error.
 int serdec_yaml_serialize_string(SerdecYamlSerializer* ser, const char* value)
 {
+    return serdec_yaml_serialize_string_n(ser, value, strlen(value));
+}
+
+int serdec_yaml_serialize_string_n(SerdecYamlSerializer* ser,
+    const char* value, size_t length)
+{
+    bool plain = ser->options.plain_strings;
+    STATS_ADD(ser, scalar_bytes, length);
+    if (NULL != ser->native) {
+        return native_event(ser, native_emitter_scalar(ser->native, value,
+                length, plain ? NATIVE_SCALAR_STRING : NATIVE_SCALAR_QUOTED));
+    }
+
     // TODO: Could use "YAML_LITERAL_SCALAR_STYLE" in here to get '|' for long
     // strings.
+    yaml_scalar_style_t style = YAML_SINGLE_QUOTED_SCALAR_STYLE;
+    if (plain && native_emitter_is_plain_string(value, length)) {
+        style = YAML_PLAIN_SCALAR_STYLE;
+    }
     yaml_scalar_event_initialize(&ser->event, NULL,
         (const yaml_char_t*)YAML_STR_TAG, (const yaml_char_t*)value,
-        strlen(value), 1, 1, YAML_SINGLE_QUOTED_SCALAR_STYLE);
-    int result = 0;
-    if (!yaml_emitter_emit(&ser->emitter, &ser->event)) {
-        ser->error = SERDEC_YAML_UNKNOWN_ERROR;
-        result = ser->error;
+        length, 1, 1, style);
+    return emit_event(ser);
+}
+
+// Serialize a struct to the output stream as a map, according to its type.
+int serdec_yaml_serialize_struct(SerdecYamlSerializer* ser,
+    const SerdecYamlType* type, const void* value)
+{
+    if (serdec_yaml_serialize_map_start(ser)) {
+        return ser->error;
     }
-    return result;
+
+    for (size_t i = 0; i < type->descriptor->field_count; ++i) {
+        const PreparedField* field = &type->fields[i];
+        if (serialize_field(ser, field,
+                (const char*)value + field->descriptor->offset)) {
+            return ser->error;
+        }
+    }
+    return serdec_yaml_serialize_map_end(ser);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Statistics
+////
+
+int serdec_yaml_serializer_stats(SerdecYamlSerializer* ser,
+    SerdecYamlStats* stats)
+{
+#ifdef SERDEC_ENABLE_STATS
+    *stats = ser->stats.counters;
+    return 0;
+#else
+    (void)stats;
+    ser->error = SERDEC_YAML_NOT_SUPPORTED;
+    return ser->error;
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Generic Interface
+////
+
+static int generic_start(void* ser) {
+    return serdec_yaml_serialize_start(ser);
+}
+
+static int generic_end(void* ser) {
+    return serdec_yaml_serialize_end(ser);
+}
+
+static int generic_map_start(void* ser) {
+    return serdec_yaml_serialize_map_start(ser);
+}
+
+static int generic_map_end(void* ser) {
+    return serdec_yaml_serialize_map_end(ser);
 }
 
+static int generic_map_key_n(void* ser, const char* key, size_t length) {
+    return serdec_yaml_serialize_map_key_n(ser, key, length);
+}
+
+static int generic_list_start(void* ser) {
+    return serdec_yaml_serialize_list_start(ser);
+}
+
+static int generic_list_end(void* ser) {
+    return serdec_yaml_serialize_list_end(ser);
+}
+
+static int generic_bool(void* ser, bool value) {
+    return serdec_yaml_serialize_bool(ser, value);
+}
+
+static int generic_int(void* ser, int value) {
+    return serdec_yaml_serialize_int(ser, value);
+}
+
+static int generic_int64(void* ser, int64_t value) {
+    return serdec_yaml_serialize_int64(ser, value);
+}
+
+static int generic_uint64(void* ser, uint64_t value) {
+    return serdec_yaml_serialize_uint64(ser, value);
+}
+
+static int generic_size_t(void* ser, size_t value) {
+    return serdec_yaml_serialize_size_t(ser, value);
+}
+
+static int generic_double(void* ser, double value) {
+    return serdec_yaml_serialize_double(ser, value);
+}
+
+static int generic_string_n(void* ser, const char* value, size_t length) {
+    return serdec_yaml_serialize_string_n(ser, value, length);
+}
+
+static const char* generic_strerror(void* ser) {
+    return serdec_yaml_serializer_strerror(ser);
+}
+
+const SerdecSerializerOps SERDEC_YAML_SERIALIZER_OPS = {
+    .start=generic_start,
+    .end=generic_end,
+    .map_start=generic_map_start,
+    .map_end=generic_map_end,
+    .map_key=generic_map_key_n,
+    .list_start=generic_list_start,
+    .list_end=generic_list_end,
+    .boolean=generic_bool,
+    .integer=generic_int,
+    .int64=generic_int64,
+    .uint64=generic_uint64,
+    .size=generic_size_t,
+    .real=generic_double,
+    .string=generic_string_n,
+    .strerror=generic_strerror,
+};
+
 ///////////////////////////////////////////////////////////////////////////////
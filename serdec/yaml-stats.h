@@ -0,0 +1,214 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            yaml-stats.h
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Optional instrumentation of the YAML de/serializers.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#ifndef SERDEC_YAML_STATS_H
+#define SERDEC_YAML_STATS_H
+
+// Statistics are collected only if SERDEC_ENABLE_STATS is defined, and timed
+// only if SERDEC_ENABLE_STATS_TIMING is too (see the "stats" build option).
+// Otherwise, the macros below expand to nothing, without evaluating their
+// arguments, and the contexts have no Stats member, so the instrumentation
+// costs nothing. Timing implies the counters.
+
+#if defined(SERDEC_ENABLE_STATS_TIMING) && !defined(SERDEC_ENABLE_STATS)
+#define SERDEC_ENABLE_STATS
+#endif
+
+#ifdef SERDEC_ENABLE_STATS
+
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include <yaml.h>
+
+#include <serdec/allocator.h>
+#include <serdec/yaml.h>
+
+typedef struct Stats {
+    SerdecYamlStats counters;
+
+    // The allocator which the context was created with. The context's own
+    // allocator counts each call, and forwards it here.
+    SerdecAllocator target;
+
+    // The current nesting of maps and lists, and the offset in the input
+    // which the parser had reached after its last event.
+    uint64_t depth;
+    uint64_t position;
+
+    // Callbacks may de-serialize values, and so re-enter the parser and other
+    // callbacks. Only the outermost callback is timed, and the time spent in
+    // the parser meanwhile is subtracted.
+    unsigned callbacks;
+    uint64_t callback_start;
+    uint64_t codec_start;
+} Stats;
+
+static inline void* stats_alloc(void* ctx, size_t size) {
+    Stats* stats = (Stats*)ctx;
+    ++stats->counters.allocations;
+    return stats->target.alloc(stats->target.ctx, size);
+}
+
+static inline void* stats_realloc(void* ctx, void* pointer, size_t size) {
+    Stats* stats = (Stats*)ctx;
+    ++stats->counters.reallocations;
+    return stats->target.realloc(stats->target.ctx, pointer, size);
+}
+
+// The Stats may be part of the memory which is freed.
+static inline void stats_free(void* ctx, void* pointer) {
+    SerdecAllocator target = ((Stats*)ctx)->target;
+    target.free(target.ctx, pointer);
+}
+
+// Clear the counters, and replace <allocator> with one which counts the calls
+// made through it, and forwards them to the original.
+static inline void stats_initialize(Stats* stats, SerdecAllocator* allocator)
+{
+    memset(stats, 0, sizeof(*stats));
+    stats->target = *allocator;
+    allocator->alloc = stats_alloc;
+    allocator->realloc = stats_realloc;
+    allocator->free = stats_free;
+    allocator->ctx = stats;
+}
+
+static inline void stats_enter(Stats* stats) {
+    if (++stats->depth > stats->counters.max_depth) {
+        stats->counters.max_depth = stats->depth;
+    }
+}
+
+static inline void stats_leave(Stats* stats) {
+    if (0 < stats->depth) {
+        --stats->depth;
+    }
+}
+
+// Count an event, and follow the nesting of the collections it opens or
+// closes.
+static inline void stats_event(Stats* stats, yaml_event_type_t type) {
+    ++stats->counters.events;
+    if (YAML_MAPPING_START_EVENT == type ||
+        YAML_SEQUENCE_START_EVENT == type) {
+        stats_enter(stats);
+    } else if (YAML_MAPPING_END_EVENT == type ||
+        YAML_SEQUENCE_END_EVENT == type) {
+        stats_leave(stats);
+    }
+}
+
+// Count the input consumed since the parser was at the previous <position>.
+static inline void stats_position(Stats* stats, uint64_t position) {
+    if (position > stats->position) {
+        stats->counters.bytes += position - stats->position;
+        stats->position = position;
+    }
+}
+
+// Forget the position and nesting, when the input is replaced.
+static inline void stats_rewind(Stats* stats) {
+    stats->depth = 0;
+    stats->position = 0;
+}
+
+#define STATS_ADD(context, counter, count)                  \
+    ((void)((context)->stats.counters.counter += (count)))
+#define STATS_EVENT(context, type) stats_event(&(context)->stats, (type))
+#define STATS_ENTER(context) stats_enter(&(context)->stats)
+#define STATS_LEAVE(context) stats_leave(&(context)->stats)
+#define STATS_POSITION(context, position)               \
+    stats_position(&(context)->stats, (position))
+#define STATS_REWIND(context) stats_rewind(&(context)->stats)
+
+// The allocator which the context was created with, for memory which may
+// outlive the context.
+#define CALLER_ALLOCATOR(context) (&(context)->stats.target)
+
+#else // SERDEC_ENABLE_STATS
+
+#define STATS_ADD(context, counter, count) ((void)0)
+#define STATS_EVENT(context, type) ((void)0)
+#define STATS_ENTER(context) ((void)0)
+#define STATS_LEAVE(context) ((void)0)
+#define STATS_POSITION(context, position) ((void)0)
+#define STATS_REWIND(context) ((void)0)
+#define CALLER_ALLOCATOR(context) (&(context)->allocator)
+
+#endif // SERDEC_ENABLE_STATS
+
+#ifdef SERDEC_ENABLE_STATS_TIMING
+
+static inline uint64_t stats_clock(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000 + (uint64_t)now.tv_nsec;
+}
+
+static inline void stats_callback_enter(Stats* stats) {
+    if (0 == stats->callbacks++) {
+        stats->callback_start = stats_clock();
+        stats->codec_start = stats->counters.codec_ns;
+    }
+}
+
+static inline void stats_callback_leave(Stats* stats) {
+    if (0 == --stats->callbacks) {
+        uint64_t elapsed = stats_clock() - stats->callback_start;
+        uint64_t parsing = stats->counters.codec_ns - stats->codec_start;
+        stats->counters.callback_ns += elapsed > parsing
+            ? elapsed - parsing : 0;
+    }
+}
+
+// Declare <name>, holding the time at which it's declared, so that the time
+// since can be added to a counter with STATS_ADD_TIME().
+#define STATS_TIMER(name) uint64_t name = stats_clock()
+#define STATS_ADD_TIME(context, counter, start)                         \
+    ((void)((context)->stats.counters.counter += stats_clock() - (start)))
+#define STATS_CALLBACK_ENTER(context) stats_callback_enter(&(context)->stats)
+#define STATS_CALLBACK_LEAVE(context) stats_callback_leave(&(context)->stats)
+
+#else // SERDEC_ENABLE_STATS_TIMING
+
+#define STATS_TIMER(name) ((void)0)
+#define STATS_ADD_TIME(context, counter, start) ((void)0)
+#define STATS_CALLBACK_ENTER(context) ((void)0)
+#define STATS_CALLBACK_LEAVE(context) ((void)0)
+
+#endif // SERDEC_ENABLE_STATS_TIMING
+
+#endif // SERDEC_YAML_STATS_H
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,332 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            yaml-tape.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Compact, random-access representation of a parsed value.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <errno.h>
+#include <string.h>
+
+#include <serdec/allocator-ops.h>
+#include <serdec/yaml-error.h>
+#include <serdec/yaml-path.h>
+#include <serdec/yaml-tape.h>
+
+#define TAPE_MINIMUM_CAPACITY 64
+
+///////////////////////////////////////////////////////////////////////////////
+// Private API
+////
+
+static const char* node_string(const SerdecYamlTape* tape,
+    const TapeNode* node)
+{
+    return tape->strings.string + node->offset;
+}
+
+// Return the value of the first entry in the map <node> with the key <key>,
+// or TAPE_NO_NODE.
+static size_t find_key(const SerdecYamlTape* tape, size_t node,
+    const char* key, size_t length)
+{
+    const TapeNode* nodes = tape->nodes;
+    size_t child = node + 1;
+    while (child < nodes[node].end) {
+        size_t value = nodes[child].end;
+        if (SERDEC_YAML_NODE_SCALAR == nodes[child].kind &&
+            length == nodes[child].length &&
+            !memcmp(node_string(tape, &nodes[child]), key, length)) {
+            return value;
+        }
+        child = nodes[value].end;
+    }
+    return TAPE_NO_NODE;
+}
+
+// Return element <index> of the list <node>, or TAPE_NO_NODE.
+static size_t find_index(const SerdecYamlTape* tape, size_t node,
+    size_t index)
+{
+    const TapeNode* nodes = tape->nodes;
+    size_t child = node + 1;
+    while (child < nodes[node].end) {
+        if (0 == index--) {
+            return child;
+        }
+        child = nodes[child].end;
+    }
+    return TAPE_NO_NODE;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Construction and Replay
+////
+
+SerdecYamlTape* tape_new(const SerdecAllocator* allocator) {
+    allocator = allocator_or_default(allocator);
+    SerdecYamlTape* tape = allocator_alloc(allocator, sizeof(SerdecYamlTape));
+    if (NULL == tape) {
+        return NULL;
+    }
+
+    memset(tape, 0, sizeof(SerdecYamlTape));
+    tape->allocator = *allocator;
+    string_buffer_init(&tape->strings, &tape->allocator);
+    tape->open = TAPE_NO_NODE;
+    return tape;
+}
+
+int tape_append(SerdecYamlTape* tape, SerdecYamlNodeKind kind,
+    const char* value, size_t length, yaml_scalar_style_t style)
+{
+    if (tape->count == tape->capacity) {
+        size_t capacity = TAPE_MINIMUM_CAPACITY > tape->capacity
+            ? TAPE_MINIMUM_CAPACITY : tape->capacity * 2;
+        if (capacity > SIZE_MAX / sizeof(TapeNode)) {
+            errno = ENOMEM;
+            return -1;
+        }
+
+        TapeNode* nodes = allocator_realloc(&tape->allocator, tape->nodes,
+            capacity * sizeof(TapeNode));
+        if (NULL == nodes) {
+            return -1;
+        }
+        tape->nodes = nodes;
+        tape->capacity = capacity;
+    }
+
+    size_t index = tape->count;
+    TapeNode* node = &tape->nodes[index];
+    *node = (TapeNode){
+        .kind = (unsigned char)kind,
+        .style = (unsigned char)style,
+        .parent = tape->open,
+        .end = index + 1,
+    };
+
+    // Each scalar is followed by a NUL, so that it can be handed out as a
+    // string.
+    if (SERDEC_YAML_NODE_SCALAR == kind) {
+        node->offset = tape->strings.length;
+        node->length = length;
+        if (string_buffer_append(&tape->strings, value, length) ||
+            string_buffer_append(&tape->strings, "", 1)) {
+            return -1;
+        }
+    }
+
+    if (TAPE_NO_NODE != tape->open) {
+        ++tape->nodes[tape->open].length;
+    }
+    if (SERDEC_YAML_NODE_SCALAR != kind) {
+        tape->open = index;
+    }
+    ++tape->count;
+    return 0;
+}
+
+void tape_close(SerdecYamlTape* tape) {
+    TapeNode* node = &tape->nodes[tape->open];
+    node->end = tape->count;
+    tape->open = node->parent;
+}
+
+bool tape_is_open(const SerdecYamlTape* tape) {
+    return TAPE_NO_NODE != tape->open;
+}
+
+void tape_reader_init(TapeReader* reader, const SerdecYamlTape* tape,
+    size_t root)
+{
+    memset(reader, 0, sizeof(TapeReader));
+    reader->tape = tape;
+    reader->root = root;
+    reader->next = root;
+    reader->open = TAPE_NO_NODE;
+    reader->stage = TAPE_STREAM_START;
+}
+
+void tape_reader_next(TapeReader* reader, yaml_event_t* event) {
+    memset(event, 0, sizeof(yaml_event_t));
+    switch (reader->stage) {
+    case TAPE_STREAM_START:
+        event->type = YAML_STREAM_START_EVENT;
+        event->data.stream_start.encoding = YAML_UTF8_ENCODING;
+        reader->stage = TAPE_DOCUMENT_START;
+        return;
+    case TAPE_DOCUMENT_START:
+        event->type = YAML_DOCUMENT_START_EVENT;
+        event->data.document_start.implicit = 1;
+        reader->stage = TAPE_NODES;
+        return;
+    case TAPE_NODES: break;
+    case TAPE_DOCUMENT_END:
+        event->type = YAML_DOCUMENT_END_EVENT;
+        event->data.document_end.implicit = 1;
+        reader->stage = TAPE_STREAM_END;
+        return;
+    case TAPE_STREAM_END:
+        event->type = YAML_STREAM_END_EVENT;
+        reader->stage = TAPE_DONE;
+        return;
+    default: return;
+    }
+
+    // The innermost open map or list ends once all of its nodes have been
+    // produced. The subtree ends with the root.
+    const TapeNode* nodes = reader->tape->nodes;
+    if (TAPE_NO_NODE != reader->open &&
+        reader->next == nodes[reader->open].end) {
+        const TapeNode* open = &nodes[reader->open];
+        event->type = SERDEC_YAML_NODE_MAP == open->kind
+            ? YAML_MAPPING_END_EVENT : YAML_SEQUENCE_END_EVENT;
+        if (reader->root == reader->open) {
+            reader->open = TAPE_NO_NODE;
+            reader->stage = TAPE_DOCUMENT_END;
+        } else {
+            reader->open = open->parent;
+        }
+        return;
+    }
+
+    const TapeNode* node = &nodes[reader->next];
+    switch (node->kind) {
+    case SERDEC_YAML_NODE_SCALAR:
+        event->type = YAML_SCALAR_EVENT;
+        event->data.scalar.value = (yaml_char_t*)node_string(reader->tape,
+            node);
+        event->data.scalar.length = node->length;
+        event->data.scalar.plain_implicit = 1;
+        event->data.scalar.quoted_implicit = 1;
+        event->data.scalar.style = (yaml_scalar_style_t)node->style;
+        if (reader->root == reader->next) {
+            reader->stage = TAPE_DOCUMENT_END;
+        }
+        break;
+    case SERDEC_YAML_NODE_MAP:
+        event->type = YAML_MAPPING_START_EVENT;
+        event->data.mapping_start.implicit = 1;
+        event->data.mapping_start.style = YAML_BLOCK_MAPPING_STYLE;
+        reader->open = reader->next;
+        break;
+    default:
+        event->type = YAML_SEQUENCE_START_EVENT;
+        event->data.sequence_start.implicit = 1;
+        event->data.sequence_start.style = YAML_BLOCK_SEQUENCE_STYLE;
+        reader->open = reader->next;
+        break;
+    }
+    ++reader->next;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Public API
+////
+
+void serdec_yaml_tape_free(SerdecYamlTape* tape) {
+    if (NULL == tape) {
+        return;
+    }
+
+    string_buffer_release(&tape->strings);
+    allocator_free(&tape->allocator, tape->nodes);
+    SerdecAllocator allocator = tape->allocator;
+    allocator_free(&allocator, tape);
+}
+
+int serdec_yaml_tape_get(const SerdecYamlTape* tape, const char* path,
+    size_t* node)
+{
+    return serdec_yaml_tape_get_from(tape, SERDEC_YAML_TAPE_ROOT, path, node);
+}
+
+int serdec_yaml_tape_get_from(const SerdecYamlTape* tape, size_t node,
+    const char* path, size_t* found)
+{
+    if (node >= tape->count) {
+        node = TAPE_NO_NODE;
+    }
+
+    // The whole path is parsed, even once it's known not to match, so that a
+    // malformed path is always reported as such.
+    const char* cursor = path;
+    while ('\0' != *cursor) {
+        PathSegment segment;
+        if (path_parse_segment(path, &cursor, &segment)) {
+            return SERDEC_YAML_INVALID_PATH;
+        } else if (TAPE_NO_NODE == node) {
+            continue;
+        }
+
+        const TapeNode* record = &tape->nodes[node];
+        if (segment.is_index) {
+            node = SERDEC_YAML_NODE_LIST == record->kind
+                ? find_index(tape, node, segment.index) : TAPE_NO_NODE;
+        } else {
+            node = SERDEC_YAML_NODE_MAP == record->kind
+                ? find_key(tape, node, segment.key, segment.length)
+                : TAPE_NO_NODE;
+        }
+    }
+
+    if (TAPE_NO_NODE == node) {
+        return SERDEC_YAML_NOT_FOUND;
+    }
+    *found = node;
+    return 0;
+}
+
+SerdecYamlNodeKind serdec_yaml_tape_kind(const SerdecYamlTape* tape,
+    size_t node)
+{
+    return (SerdecYamlNodeKind)tape->nodes[node].kind;
+}
+
+size_t serdec_yaml_tape_length(const SerdecYamlTape* tape, size_t node) {
+    const TapeNode* record = &tape->nodes[node];
+    return SERDEC_YAML_NODE_MAP == record->kind ? record->length / 2
+        : record->length;
+}
+
+const char* serdec_yaml_tape_scalar(const SerdecYamlTape* tape, size_t node,
+    size_t* length)
+{
+    const TapeNode* record = &tape->nodes[node];
+    if (SERDEC_YAML_NODE_SCALAR != record->kind) {
+        return NULL;
+    }
+
+    if (NULL != length) {
+        *length = record->length;
+    }
+    return node_string(tape, record);
+}
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,123 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            yaml-tape.h
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Compact, random-access representation of a parsed value.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#ifndef SERDEC_YAML_TAPE_H
+#define SERDEC_YAML_TAPE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <yaml.h>
+
+#include <serdec/allocator.h>
+#include <serdec/string-ops.h>
+#include <serdec/yaml.h>
+
+// The nodes of a tape are stored in document order, so the nodes of a subtree
+// are contiguous, and follow its root. Maps store their keys and values as
+// alternating children.
+
+#define TAPE_NO_NODE SIZE_MAX
+
+typedef struct TapeNode {
+    unsigned char kind;
+
+    // The yaml_scalar_style_t of a scalar.
+    unsigned char style;
+
+    // The enclosing map or list, or TAPE_NO_NODE for the root.
+    size_t parent;
+
+    // One past the last node in the subtree.
+    size_t end;
+
+    // Scalars refer to <length> bytes at <offset> in the tape's strings,
+    // which are followed by a NUL. For maps and lists, <length> is the number
+    // of children.
+    size_t offset;
+    size_t length;
+} TapeNode;
+
+struct SerdecYamlTape {
+    TapeNode* nodes;
+    size_t count;
+    size_t capacity;
+    StringBuffer strings;
+    SerdecAllocator allocator;
+
+    // The innermost map or list which is still being appended to.
+    size_t open;
+};
+
+// Allocate an empty tape.
+SerdecYamlTape* tape_new(const SerdecAllocator* allocator);
+
+// Append a node to the innermost open map or list. Maps and lists remain open
+// until they're closed by tape_close(). Return non-zero if allocation fails.
+int tape_append(SerdecYamlTape* tape, SerdecYamlNodeKind kind,
+    const char* value, size_t length, yaml_scalar_style_t style);
+void tape_close(SerdecYamlTape* tape);
+
+// Whether a map or list has been appended, but not closed.
+bool tape_is_open(const SerdecYamlTape* tape);
+
+typedef enum TapeStage {
+    TAPE_STREAM_START,
+    TAPE_DOCUMENT_START,
+    TAPE_NODES,
+    TAPE_DOCUMENT_END,
+    TAPE_STREAM_END,
+    TAPE_DONE,
+} TapeStage;
+
+// Produces the events for a subtree of a tape, as a document of its own.
+// Like those of the native scanner, the events refer to the tape, so they
+// must not be passed to yaml_event_delete(). <next> is the next node to
+// produce, and <open> is the innermost map or list which hasn't ended yet.
+typedef struct TapeReader {
+    const SerdecYamlTape* tape;
+    size_t root;
+    size_t next;
+    size_t open;
+    TapeStage stage;
+} TapeReader;
+
+void tape_reader_init(TapeReader* reader, const SerdecYamlTape* tape,
+    size_t root);
+
+// Produce the next event. Once the stream has ended, the events are empty.
+void tape_reader_next(TapeReader* reader, yaml_event_t* event);
+
+#endif // SERDEC_YAML_TAPE_H
+
+///////////////////////////////////////////////////////////////////////////////
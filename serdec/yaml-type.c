@@ -0,0 +1,178 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            yaml-type.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Preparation of type descriptors.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <stdint.h>
+#include <string.h>
+
+#include <serdec/allocator-ops.h>
+#include <serdec/yaml-emitter.h>
+#include <serdec/yaml-type.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// Private API
+////
+
+static size_t element_size(const SerdecYamlFieldDescriptor* field) {
+    switch (field->kind) {
+    case SERDEC_YAML_KIND_BOOL: return sizeof(bool);
+    case SERDEC_YAML_KIND_INT: return sizeof(int);
+    case SERDEC_YAML_KIND_INT64: return sizeof(int64_t);
+    case SERDEC_YAML_KIND_UINT64: return sizeof(uint64_t);
+    case SERDEC_YAML_KIND_SIZE_T: return sizeof(size_t);
+    case SERDEC_YAML_KIND_DOUBLE: return sizeof(double);
+    case SERDEC_YAML_KIND_STRING: return sizeof(char*);
+    case SERDEC_YAML_KIND_STRUCT:
+        return NULL != field->type ? field->type->size : 0;
+    default: return 0;
+    }
+}
+
+static void release_field(const SerdecYamlType* type,
+    const PreparedField* field, char* member)
+{
+    size_t count = field->descriptor->array_length;
+    if (0 == count) {
+        count = 1;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        char* element = member + i * field->element_size;
+        if (SERDEC_YAML_KIND_STRING == field->descriptor->kind) {
+            char** string = (char**)element;
+            allocator_free(&type->allocator, *string);
+            *string = NULL;
+        } else if (SERDEC_YAML_KIND_STRUCT == field->descriptor->kind) {
+            serdec_yaml_type_release(field->type, element);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Public API
+////
+
+SerdecYamlType* serdec_yaml_type_new(
+    const SerdecYamlTypeDescriptor* descriptor)
+{
+    return serdec_yaml_type_new_with_allocator(descriptor, NULL);
+}
+
+SerdecYamlType* serdec_yaml_type_new_with_allocator(
+    const SerdecYamlTypeDescriptor* descriptor,
+    const SerdecAllocator* allocator)
+{
+    allocator = allocator_or_default(allocator);
+    size_t count = descriptor->field_count;
+    SerdecYamlType* type = allocator_calloc(allocator, 1,
+        sizeof(SerdecYamlType));
+    if (NULL == type) {
+        return NULL;
+    }
+
+    type->allocator = *allocator;
+    type->descriptor = descriptor;
+    type->fields = allocator_calloc(allocator, 0 < count ? count : 1,
+        sizeof(PreparedField));
+    const char** names = allocator_alloc(allocator,
+        (0 < count ? count : 1) * sizeof(const char*));
+    if (NULL == type->fields || NULL == names) {
+        allocator_free(allocator, names);
+        serdec_yaml_type_free(type);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        const SerdecYamlFieldDescriptor* field = &descriptor->fields[i];
+        PreparedField* prepared = &type->fields[i];
+        prepared->descriptor = field;
+        prepared->name_length = strlen(field->name);
+        prepared->element_size = element_size(field);
+        prepared->plain_name = native_emitter_is_plain_key(field->name,
+            prepared->name_length);
+        names[i] = field->name;
+
+        // Structs must have a type, and nothing else may.
+        bool nested = SERDEC_YAML_KIND_STRUCT == field->kind;
+        if (0 == prepared->element_size || nested != (NULL != field->type)) {
+            allocator_free(allocator, names);
+            serdec_yaml_type_free(type);
+            return NULL;
+        }
+
+        if (nested) {
+            prepared->type = serdec_yaml_type_new_with_allocator(field->type,
+                allocator);
+            if (NULL == prepared->type) {
+                allocator_free(allocator, names);
+                serdec_yaml_type_free(type);
+                return NULL;
+            }
+        }
+    }
+
+    int result = key_table_initialize(&type->keys, names, count,
+        &type->allocator);
+    allocator_free(allocator, names);
+    if (result) {
+        serdec_yaml_type_free(type);
+        return NULL;
+    }
+    return type;
+}
+
+void serdec_yaml_type_free(SerdecYamlType* type) {
+    if (NULL != type->fields) {
+        for (size_t i = 0; i < type->descriptor->field_count; ++i) {
+            if (NULL != type->fields[i].type) {
+                serdec_yaml_type_free(type->fields[i].type);
+            }
+        }
+    }
+
+    key_table_delete(&type->keys);
+    SerdecAllocator allocator = type->allocator;
+    allocator_free(&allocator, type->fields);
+    allocator_free(&allocator, type);
+}
+
+void serdec_yaml_type_release(const SerdecYamlType* type, void* value) {
+    for (size_t i = 0; i < type->descriptor->field_count; ++i) {
+        const PreparedField* field = &type->fields[i];
+        if (SERDEC_YAML_KIND_STRING == field->descriptor->kind ||
+            SERDEC_YAML_KIND_STRUCT == field->descriptor->kind) {
+            release_field(type, field,
+                (char*)value + field->descriptor->offset);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
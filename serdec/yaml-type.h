@@ -0,0 +1,61 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            yaml-type.h
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Prepared type descriptors, shared by the serializer and
+//                  deserializer.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#ifndef SERDEC_YAML_TYPE_H
+#define SERDEC_YAML_TYPE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <serdec/key-table.h>
+#include <serdec/yaml.h>
+
+// Everything about a field which can be computed ahead of time.
+typedef struct PreparedField {
+    const SerdecYamlFieldDescriptor* descriptor;
+    size_t name_length;
+    size_t element_size;
+    bool plain_name;
+    SerdecYamlType* type;
+} PreparedField;
+
+struct SerdecYamlType {
+    const SerdecYamlTypeDescriptor* descriptor;
+    PreparedField* fields;
+    KeyTable keys;
+    SerdecAllocator allocator;
+};
+
+#endif // SERDEC_YAML_TYPE_H
+
+///////////////////////////////////////////////////////////////////////////////
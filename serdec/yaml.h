@@ -7,7 +7,7 @@
 //
 // CREATED:         12/20/2021
 //
-// LAST EDITED:     02/06/2022
+// LAST EDITED:     10/14/2026
 //
 // Copyright 2021, Ethan D. Twardy
 //
@@ -35,8 +35,13 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 
+#include <serdec/allocator.h>
+#include <serdec/arena.h>
+#include <serdec/codec.h>
+
 // This struct maintains all internal state of the deserializer.
 typedef struct SerdecYamlDeserializer SerdecYamlDeserializer;
 typedef struct SerdecYamlSerializer SerdecYamlSerializer;
@@ -49,6 +54,101 @@ typedef struct SerdecYamlSerializer SerdecYamlSerializer;
 const char* serdec_yaml_deserializer_strerror(SerdecYamlDeserializer* deser);
 const char* serdec_yaml_serializer_strerror(SerdecYamlSerializer* ser);
 
+///////////////////////////////////////////////////////////////////////////////
+// Backends
+////
+
+// The implementation which reads or writes YAML. libyaml is the default, and
+// supports all of YAML. The native backends handle only the subset of YAML
+// which serdec uses, but avoid libyaml's per-node overhead.
+typedef enum SerdecYamlBackend {
+    SERDEC_YAML_BACKEND_LIBYAML,
+    SERDEC_YAML_BACKEND_NATIVE,
+} SerdecYamlBackend;
+
+///////////////////////////////////////////////////////////////////////////////
+// Type Descriptors
+////
+
+// The kinds of values which can be described by a field descriptor. Strings
+// are char* members. They're allocated with the deserializer's allocator,
+// and NULL strings serialize as ''.
+typedef enum SerdecYamlKind {
+    SERDEC_YAML_KIND_BOOL,
+    SERDEC_YAML_KIND_INT,
+    SERDEC_YAML_KIND_INT64,
+    SERDEC_YAML_KIND_UINT64,
+    SERDEC_YAML_KIND_SIZE_T,
+    SERDEC_YAML_KIND_DOUBLE,
+    SERDEC_YAML_KIND_STRING,
+    SERDEC_YAML_KIND_STRUCT,
+} SerdecYamlKind;
+
+typedef struct SerdecYamlTypeDescriptor SerdecYamlTypeDescriptor;
+
+// Describes one member of a struct, which is serialized as the map entry
+// <name>. <type> describes the member for SERDEC_YAML_KIND_STRUCT, and is
+// otherwise NULL. If <array_length> is non-zero, the member is a fixed-length
+// array of that many elements of <kind>, which is serialized as a list.
+typedef struct SerdecYamlFieldDescriptor {
+    const char* name;
+    size_t offset;
+    SerdecYamlKind kind;
+    const SerdecYamlTypeDescriptor* type;
+    size_t array_length;
+} SerdecYamlFieldDescriptor;
+
+// Describes a struct, which is serialized as a map. If <skip_unknown> is true,
+// the deserializer skips map entries which don't match any of the fields.
+// Otherwise, they're reported as SERDEC_YAML_UNKNOWN_KEY.
+struct SerdecYamlTypeDescriptor {
+    size_t size;
+    const SerdecYamlFieldDescriptor* fields;
+    size_t field_count;
+    bool skip_unknown;
+};
+
+// Convenience macros for populating field descriptors, e.g.:
+//
+//     static const SerdecYamlFieldDescriptor INNER_FIELDS[] = {
+//         SERDEC_YAML_FIELD(InnerStruct, my_value, SERDEC_YAML_KIND_INT),
+//         SERDEC_YAML_ARRAY_FIELD(InnerStruct, values, SERDEC_YAML_KIND_INT),
+//         SERDEC_YAML_STRUCT_FIELD(InnerStruct, nested, &NESTED_TYPE),
+//     };
+#define SERDEC_YAML_FIELD(struct_type, member, kind)                    \
+    {#member, offsetof(struct_type, member), (kind), NULL, 0}
+#define SERDEC_YAML_ARRAY_FIELD(struct_type, member, kind)              \
+    {#member, offsetof(struct_type, member), (kind), NULL,              \
+     sizeof(((struct_type*)0)->member)                                  \
+     / sizeof(((struct_type*)0)->member[0])}
+#define SERDEC_YAML_STRUCT_FIELD(struct_type, member, descriptor)       \
+    {#member, offsetof(struct_type, member), SERDEC_YAML_KIND_STRUCT,   \
+     (descriptor), 0}
+
+// A type is a descriptor which has been prepared for use: the key table for
+// deserialization and the quoting of each key for serialization are computed
+// once, here, rather than for every record. The descriptor (and the
+// descriptors of any nested structs) must outlive the type. Return NULL if the
+// descriptor is invalid (e.g. it contains duplicate names), or memory could
+// not be allocated.
+typedef struct SerdecYamlType SerdecYamlType;
+SerdecYamlType* serdec_yaml_type_new(
+    const SerdecYamlTypeDescriptor* descriptor);
+
+// Like _type_new(), but the type's memory is obtained from <allocator>. A
+// NULL allocator selects the default.
+SerdecYamlType* serdec_yaml_type_new_with_allocator(
+    const SerdecYamlTypeDescriptor* descriptor,
+    const SerdecAllocator* allocator);
+void serdec_yaml_type_free(SerdecYamlType* type);
+
+// Free the strings in <value> (including those in nested structs and arrays)
+// which were allocated by _deserialize_struct(), and set them to NULL. The
+// strings are freed with the type's allocator, so it must be the allocator of
+// the de-serializer which produced them. Strings allocated from an arena are
+// released with the arena instead.
+void serdec_yaml_type_release(const SerdecYamlType* type, void* value);
+
 ///////////////////////////////////////////////////////////////////////////////
 // De-serializer Initialization
 ////
@@ -60,13 +160,106 @@ SerdecYamlDeserializer* serdec_yaml_deserializer_new_string(const char* string,
 // Initialize a de-serializer from the given input string.
 SerdecYamlDeserializer* serdec_yaml_deserializer_new_file(FILE* input_file);
 
+// Initialize a de-serializer from the file at <path>. Regular files are mapped
+// into memory with mmap(2), and parsed in place, which avoids copying the
+// input through stdio. Files which can't be mapped (e.g. pipes) are read with
+// stdio, like _new_file(). The file is closed when the de-serializer is freed
+// or reset. Return NULL, with errno set, if the file could not be opened.
+SerdecYamlDeserializer* serdec_yaml_deserializer_new_path(const char* path);
+
+// Initialize a de-serializer which is fed its input in chunks of any size,
+// e.g. as it arrives from a non-blocking socket. Input is buffered until a
+// complete document has been fed, and each document is then de-serialized as
+// usual, so callbacks never observe an incomplete document. Memory use is
+// bounded by the size of the largest document, rather than the stream.
+SerdecYamlDeserializer* serdec_yaml_deserializer_new_push();
+
+// Feed the next chunk of input to a push de-serializer. The data is copied.
+// Return zero if the de-serializer is at the root of a document, which can be
+// de-serialized, or SERDEC_YAML_NEED_MORE_DATA if the next document hasn't
+// been completed yet. Once a document has been de-serialized,
+// _next_document() advances to the next one, and reports
+// SERDEC_YAML_NEED_MORE_DATA in the same way, after which parsing resumes
+// with the next call to _feed().
+int serdec_yaml_deserializer_feed(SerdecYamlDeserializer* deser,
+    const char* data, size_t length);
+
+// Signal the end of the input to a push de-serializer, which completes the
+// last document. Return zero if the de-serializer is at the root of a
+// document, or SERDEC_YAML_END_OF_STREAM if there are no more documents.
+int serdec_yaml_deserializer_feed_end(SerdecYamlDeserializer* deser);
+
+// Like the constructors above, but the de-serializer, and the memory it hands
+// to the caller (vectors and struct strings), is obtained from <allocator>. A
+// NULL allocator selects the default.
+SerdecYamlDeserializer* serdec_yaml_deserializer_new_string_with_allocator(
+    const char* string, size_t string_length,
+    const SerdecAllocator* allocator);
+SerdecYamlDeserializer* serdec_yaml_deserializer_new_file_with_allocator(
+    FILE* input_file, const SerdecAllocator* allocator);
+SerdecYamlDeserializer* serdec_yaml_deserializer_new_path_with_allocator(
+    const char* path, const SerdecAllocator* allocator);
+SerdecYamlDeserializer* serdec_yaml_deserializer_new_push_with_allocator(
+    const SerdecAllocator* allocator);
+
+// Options for the _with_options() constructors. Zero-initialized options
+// select the defaults.
+typedef struct SerdecYamlDeserializerOptions {
+    // Where memory is obtained, as for the _with_allocator() constructors.
+    const SerdecAllocator* allocator;
+
+    // The native de-serializer reads block and flow maps and lists, and plain
+    // and quoted scalars. Anchors, aliases, tags, block scalars, complex keys
+    // and plain scalars which span lines are reported as errors. Scalars are
+    // not copied out of the input, except for quoted strings which contain
+    // escapes or line breaks, and string values, which are copied so that
+    // they're NUL-terminated. It applies to string input, mapped files and
+    // pushed documents: files which are read with stdio (including those
+    // given to _reset_file()) are always parsed by libyaml.
+    SerdecYamlBackend backend;
+} SerdecYamlDeserializerOptions;
+
+// Like the constructors above, configured by <options>, which may be NULL.
+SerdecYamlDeserializer* serdec_yaml_deserializer_new_string_with_options(
+    const char* string, size_t string_length,
+    const SerdecYamlDeserializerOptions* options);
+SerdecYamlDeserializer* serdec_yaml_deserializer_new_path_with_options(
+    const char* path, const SerdecYamlDeserializerOptions* options);
+SerdecYamlDeserializer* serdec_yaml_deserializer_new_push_with_options(
+    const SerdecYamlDeserializerOptions* options);
+
+// Re-use the de-serializer for new input, as if it had been freed and created
+// again, but without releasing the buffers which it (and libyaml) have
+// allocated. The allocator, backend and arena are kept. Return non-zero if
+// the start of the new input could not be parsed. A de-serializer in that
+// state may still be reset, or freed.
+int serdec_yaml_deserializer_reset_string(SerdecYamlDeserializer* deser,
+    const char* string, size_t string_length);
+int serdec_yaml_deserializer_reset_file(SerdecYamlDeserializer* deser,
+    FILE* input_file);
+
 // Free a de-serializer.
 void serdec_yaml_deserializer_free(SerdecYamlDeserializer* deser);
 
+// Allocate the strings of structs de-serialized by _deserialize_struct() from
+// <arena>, instead of with the de-serializer's allocator, so that they can be
+// released all at once with the arena. The arena is not owned by the
+// de-serializer. Pass NULL to go back to the allocator.
+void serdec_yaml_deserializer_set_arena(SerdecYamlDeserializer* deser,
+    SerdecArena* arena);
+
 ///////////////////////////////////////////////////////////////////////////////
 // De-serialization Routines
 ////
 
+// A de-serializer starts out at the root of the first document in its input.
+// Once a document has been de-serialized, advance to the root of the next one,
+// so that a stream of documents can be consumed one at a time. Any part of the
+// current document which has not been de-serialized is skipped. Return
+// SERDEC_YAML_END_OF_STREAM if there are no more documents. Only the current
+// document is held in memory, regardless of the length of the stream.
+int serdec_yaml_deserializer_next_document(SerdecYamlDeserializer* deser);
+
 // This callback is to "visit" (i.e. handle) entries of a map. This is a
 // user-defined callback.
 typedef int yaml_visit_map_callback(SerdecYamlDeserializer* deser,
@@ -77,6 +270,73 @@ typedef int yaml_visit_map_callback(SerdecYamlDeserializer* deser,
 int serdec_yaml_deserialize_map(SerdecYamlDeserializer* deser,
     yaml_visit_map_callback* callback, void* user_data);
 
+// This callback is invoked to "visit" the value for one of the keys in a field
+// table. <index> is the index of the key's entry in the table.
+typedef int yaml_visit_field_callback(SerdecYamlDeserializer* deser,
+    void* user_data, size_t index);
+
+// An entry in a field table: the callback is invoked for the value of <key>.
+typedef struct SerdecYamlField {
+    const char* key;
+    yaml_visit_field_callback* callback;
+} SerdecYamlField;
+
+// A field table dispatches map keys to their callbacks using a perfect hash,
+// so that each key costs a single lookup, regardless of the number of fields.
+typedef struct SerdecYamlFieldTable SerdecYamlFieldTable;
+
+// Build a field table from <count> fields. The fields are not copied, so they
+// must outlive the table (typically, they're static). If <skip_unknown> is
+// true, the values for keys which aren't in the table are skipped. Otherwise,
+// they're reported as SERDEC_YAML_UNKNOWN_KEY. Return NULL if the table could
+// not be allocated, or the fields contain duplicate keys.
+SerdecYamlFieldTable* serdec_yaml_field_table_new(
+    const SerdecYamlField* fields, size_t count, bool skip_unknown);
+SerdecYamlFieldTable* serdec_yaml_field_table_new_with_allocator(
+    const SerdecYamlField* fields, size_t count, bool skip_unknown,
+    const SerdecAllocator* allocator);
+void serdec_yaml_field_table_free(SerdecYamlFieldTable* table);
+
+// De-serialize a map from the input stream, dispatching each entry through the
+// field table. Return non-zero if parsing encountered an error, for any
+// reason.
+int serdec_yaml_deserialize_map_table(SerdecYamlDeserializer* deser,
+    const SerdecYamlFieldTable* table, void* user_data);
+
+// An entry in a projection: the callback is invoked for the value at <path>,
+// which has the same syntax as the paths of a tape (e.g. "a.b[3].c"). <index>
+// is the index of the entry.
+typedef struct SerdecYamlPath {
+    const char* path;
+    yaml_visit_field_callback* callback;
+} SerdecYamlPath;
+
+// A projection selects the values at a set of paths within a document, so
+// that everything else can be skipped without dispatching it to the caller.
+typedef struct SerdecYamlProjection SerdecYamlProjection;
+
+// Build a projection from <count> paths. The paths are not copied, so they
+// must outlive the projection. Return NULL if the projection could not be
+// allocated, or a path is malformed, appears more than once, or is a prefix of
+// another path (e.g. "a" and "a.b").
+SerdecYamlProjection* serdec_yaml_projection_new(const SerdecYamlPath* paths,
+    size_t count);
+SerdecYamlProjection* serdec_yaml_projection_new_with_allocator(
+    const SerdecYamlPath* paths, size_t count,
+    const SerdecAllocator* allocator);
+void serdec_yaml_projection_free(SerdecYamlProjection* projection);
+
+// De-serialize the next value from the input stream (typically, the root of
+// the document) through a projection. Subtrees which don't lead to any of the
+// paths are skipped, and paths which don't appear in the input are not
+// visited. If a key appears more than once, its path is visited each time it
+// appears. Once every path has been visited, parsing stops immediately, so
+// the rest of the value is left unread: afterwards, the de-serializer may only
+// be advanced to the next document, reset, or freed. Return non-zero if
+// parsing encountered an error, for any reason.
+int serdec_yaml_deserialize_projection(SerdecYamlDeserializer* deser,
+    const SerdecYamlProjection* projection, void* user_data);
+
 // This callback is invoked to "visit" (i.e. handle) entries of a list. This is
 // a user-defined callback. <index> is n - 1, where n is the number of times
 // the callback has been invoked.
@@ -95,20 +355,214 @@ int serdec_yaml_deserialize_list(SerdecYamlDeserializer* deser,
 int serdec_yaml_deserialize_bool(SerdecYamlDeserializer* deser, bool* value);
 
 // De-serialize an integer value from the input stream. Return non-zero if
-// parsing encountered an error, for any reason.
+// parsing encountered an error, for any reason. Values which don't fit in the
+// destination type are reported as SERDEC_YAML_OUT_OF_RANGE.
 int serdec_yaml_deserialize_int(SerdecYamlDeserializer* deser, int* value);
+int serdec_yaml_deserialize_int64(SerdecYamlDeserializer* deser,
+    int64_t* value);
+int serdec_yaml_deserialize_uint64(SerdecYamlDeserializer* deser,
+    uint64_t* value);
+int serdec_yaml_deserialize_size_t(SerdecYamlDeserializer* deser,
+    size_t* value);
+
+// De-serialize a floating point value from the input stream. Integers, .inf
+// and .nan are also accepted. Return non-zero if parsing encountered an error.
+int serdec_yaml_deserialize_double(SerdecYamlDeserializer* deser,
+    double* value);
+
+// De-serialize a struct from the input stream, according to its type. Fields
+// which don't appear in the input are left untouched, and arrays may contain
+// fewer elements than their length. Strings are overwritten, without freeing
+// their previous value.
+int serdec_yaml_deserialize_struct(SerdecYamlDeserializer* deser,
+    const SerdecYamlType* type, void* value);
+
+// Discard the next value in the input stream, which may be a scalar, or a map
+// or list of any depth. This is typically called from a map callback for keys
+// that it doesn't recognize, to keep the stream in step.
+int serdec_yaml_deserialize_skip(SerdecYamlDeserializer* deser);
+
+// De-serialize a list of scalars into the array <values>, which has room for
+// <capacity> elements. The whole list is converted in a single loop, without
+// invoking any callbacks. On success, the number of elements is written to
+// <count>. Lists with more than <capacity> elements are reported as
+// SERDEC_YAML_OUT_OF_RANGE.
+int serdec_yaml_deserialize_int_array(SerdecYamlDeserializer* deser,
+    int* values, size_t capacity, size_t* count);
+int serdec_yaml_deserialize_int64_array(SerdecYamlDeserializer* deser,
+    int64_t* values, size_t capacity, size_t* count);
+int serdec_yaml_deserialize_double_array(SerdecYamlDeserializer* deser,
+    double* values, size_t capacity, size_t* count);
+int serdec_yaml_deserialize_bool_array(SerdecYamlDeserializer* deser,
+    bool* values, size_t capacity, size_t* count);
+
+// Like the _array() routines, but the array is allocated with the
+// de-serializer's allocator and grown to fit the list. On success, the caller
+// must free *<values> with that allocator (free(3), by default). It's NULL if
+// the list is empty.
+int serdec_yaml_deserialize_int_vector(SerdecYamlDeserializer* deser,
+    int** values, size_t* count);
+int serdec_yaml_deserialize_int64_vector(SerdecYamlDeserializer* deser,
+    int64_t** values, size_t* count);
+int serdec_yaml_deserialize_double_vector(SerdecYamlDeserializer* deser,
+    double** values, size_t* count);
+int serdec_yaml_deserialize_bool_vector(SerdecYamlDeserializer* deser,
+    bool** values, size_t* count);
 
 // De-serialize a string value from the input stream. Return non-zero if
-// parsing encounters an error.
+// parsing encounters an error. The string is owned by the deserializer, and is
+// only valid until the next call into it.
 int serdec_yaml_deserialize_string(SerdecYamlDeserializer* deser,
     const char** value);
 
+// Like _string(), but also report the length of the string, so that callers
+// don't need to strlen(3) it. The string may contain NUL bytes (e.g. from a
+// "\0" escape), but it's always NUL-terminated. <length> may be NULL.
+int serdec_yaml_deserialize_string_n(SerdecYamlDeserializer* deser,
+    const char** value, size_t* length);
+
+// Like _string_n(), but the string is copied into <arena>, so it lives as long
+// as the arena does, rather than until the next call into the de-serializer.
+int serdec_yaml_deserialize_string_arena(SerdecYamlDeserializer* deser,
+    SerdecArena* arena, const char** value, size_t* length);
+
+///////////////////////////////////////////////////////////////////////////////
+// Tapes
+////
+
+// A tape is a value which has been parsed once into a contiguous array of
+// nodes, so that any part of it can be looked up directly, in any order, or
+// replayed through the de-serialization routines as many times as needed.
+// Scalars are copied into the tape, so it doesn't refer to the input. Nodes
+// are identified by their index in the tape, and the root is always
+// SERDEC_YAML_TAPE_ROOT.
+typedef struct SerdecYamlTape SerdecYamlTape;
+
+#define SERDEC_YAML_TAPE_ROOT ((size_t)0)
+
+typedef enum SerdecYamlNodeKind {
+    SERDEC_YAML_NODE_SCALAR,
+    SERDEC_YAML_NODE_MAP,
+    SERDEC_YAML_NODE_LIST,
+} SerdecYamlNodeKind;
+
+// De-serialize the next value from the input stream (typically, the root of
+// the document) into a tape, which is allocated with the de-serializer's
+// allocator. Anchors and tags are discarded. Return NULL if parsing
+// encountered an error, which is reported by the de-serializer, or if the
+// value contains an alias.
+SerdecYamlTape* serdec_yaml_tape_new(SerdecYamlDeserializer* deser);
+void serdec_yaml_tape_free(SerdecYamlTape* tape);
+
+// Look up the node at <path>, relative to the root. A path is a sequence of
+// map keys separated by '.', and list indices in brackets, e.g. "a.b[3].c".
+// The empty path refers to the root. The first entry is used for keys which
+// appear more than once. Return SERDEC_YAML_INVALID_PATH if the path is
+// malformed, or SERDEC_YAML_NOT_FOUND if it doesn't refer to a node.
+int serdec_yaml_tape_get(const SerdecYamlTape* tape, const char* path,
+    size_t* node);
+
+// Like _get(), for <path> relative to <node>.
+int serdec_yaml_tape_get_from(const SerdecYamlTape* tape, size_t node,
+    const char* path, size_t* found);
+
+SerdecYamlNodeKind serdec_yaml_tape_kind(const SerdecYamlTape* tape,
+    size_t node);
+
+// The number of entries in a map or list node, or the length of a scalar.
+size_t serdec_yaml_tape_length(const SerdecYamlTape* tape, size_t node);
+
+// The value of a scalar node, which is NUL-terminated and lives as long as the
+// tape, or NULL if the node isn't a scalar. <length> may be NULL.
+const char* serdec_yaml_tape_scalar(const SerdecYamlTape* tape, size_t node,
+    size_t* length);
+
+// Initialize a de-serializer which replays <node> of <tape> as though it were
+// the root of a document, so that it can be de-serialized with any of the
+// routines above. The de-serializer uses the tape's allocator, and the tape
+// must outlive it.
+SerdecYamlDeserializer* serdec_yaml_deserializer_new_tape(
+    const SerdecYamlTape* tape, size_t node);
+
+// Re-use the de-serializer to replay <node> of <tape>, like _reset_string().
+int serdec_yaml_deserializer_reset_tape(SerdecYamlDeserializer* deser,
+    const SerdecYamlTape* tape, size_t node);
+
+///////////////////////////////////////////////////////////////////////////////
+// Parallel De-serialization
+////
+
+// A stream of documents can be split at its "---" and "..." markers without
+// parsing it, and each document parsed on its own, so that the documents of
+// a large stream are de-serialized on all cores at once.
+
+// This callback is invoked on a worker thread to de-serialize document
+// <index>, from a de-serializer which is at the root of the document. Any
+// result it stores in <result> is passed to the delivery callback.
+typedef int yaml_visit_document_callback(SerdecYamlDeserializer* deser,
+    void* user_data, size_t index, void** result);
+
+// This callback is invoked on the calling thread with the result of document
+// <index>. <status> is the value returned by the document callback, or the
+// error encountered while parsing the start of the document, in which case the
+// document callback was not invoked and <result> is NULL.
+typedef int yaml_deliver_document_callback(void* user_data, size_t index,
+    void* result, int status);
+
+// The order in which results are delivered.
+typedef enum SerdecYamlDeliveryOrder {
+    // In the order of the documents in the input.
+    SERDEC_YAML_DELIVER_IN_ORDER,
+
+    // As soon as each document has been de-serialized.
+    SERDEC_YAML_DELIVER_AS_COMPLETED,
+} SerdecYamlDeliveryOrder;
+
+// Options for the _for_each_document() routines. Zero-initialized options
+// select the defaults.
+typedef struct SerdecYamlParallelOptions {
+    // Options for the de-serializers, one of which is created for each worker
+    // thread and re-used for each of its documents. The allocator is used by
+    // all of the workers at once, so it must be thread-safe.
+    SerdecYamlDeserializerOptions deserializer;
+
+    // The number of worker threads. Zero selects one per online processor.
+    size_t threads;
+
+    SerdecYamlDeliveryOrder order;
+} SerdecYamlParallelOptions;
+
+// De-serialize each document in <string> by invoking <visit> for it on a pool
+// of worker threads, and deliver the results to <deliver> (which may be NULL)
+// in the order selected by <options> (which may be NULL). Documents are
+// started in the order of the input. Once a document fails, or <deliver>
+// returns non-zero, no more documents are started, but every document which
+// was started is still delivered, so its result can be released. Return the
+// first non-zero status or value returned by <deliver>, in the order of
+// delivery, zero if every document succeeded, or SERDEC_YAML_SYSTEM_ERROR if
+// the workers could not be started. Since each document is parsed on its own,
+// directives only apply to the document which follows them.
+int serdec_yaml_parallel_for_each_document(const char* string, size_t length,
+    yaml_visit_document_callback* visit,
+    yaml_deliver_document_callback* deliver, void* user_data,
+    const SerdecYamlParallelOptions* options);
+
+// Like _for_each_document(), for the file at <path>, which is mapped into
+// memory if it's a regular file, and read into memory otherwise. Return
+// SERDEC_YAML_SYSTEM_ERROR, with errno set, if the file could not be read.
+int serdec_yaml_parallel_for_each_document_path(const char* path,
+    yaml_visit_document_callback* visit,
+    yaml_deliver_document_callback* deliver, void* user_data,
+    const SerdecYamlParallelOptions* options);
+
 ///////////////////////////////////////////////////////////////////////////////
 // Serializer Initialization
 ////
 
 // Initialize a serializer which writes to the buffer. If the buffer does not
-// contain enough space, an error is signaled.
+// contain enough space, an error is signaled. Like snprintf(3), the output is
+// NUL-terminated, and the serializer keeps counting after the buffer is full,
+// so _required_size() reports the size of buffer needed to retry.
 SerdecYamlSerializer* serdec_yaml_serializer_new_buffer(char* buffer,
     size_t buffer_length);
 
@@ -117,12 +571,148 @@ SerdecYamlSerializer* serdec_yaml_serializer_new_buffer(char* buffer,
 SerdecYamlSerializer* serdec_yaml_serializer_new_string();
 const char* serdec_yaml_serializer_borrow_string(SerdecYamlSerializer* ser);
 
-// Initialize a serializer from the given input string.
-SerdecYamlSerializer* serdec_yaml_serializer_new_file(FILE* input_file);
+// Take ownership of the string generated by the serializer, without copying.
+// The length of the string is written to <length>, if it's not NULL. The
+// caller must free the result with the serializer's allocator (free(3), by
+// default). The serializer is left with an empty string.
+char* serdec_yaml_serializer_take_string(SerdecYamlSerializer* ser,
+    size_t* length);
+
+// Return the number of bytes (including the NUL terminator) needed to hold the
+// output produced so far. For buffer serializers, this includes any output
+// which did not fit.
+size_t serdec_yaml_serializer_required_size(SerdecYamlSerializer* ser);
+
+// Hint that the output will be at least <length> bytes long, so that the
+// output buffer can be allocated up front. This has no effect on serializers
+// which do not allocate their output.
+int serdec_yaml_serializer_reserve(SerdecYamlSerializer* ser, size_t length);
+
+// Initialize a serializer which writes to the file. Output is staged in a
+// fixed-size internal buffer, which is written out once it fills up, so memory
+// use is constant regardless of the size of the document.
+SerdecYamlSerializer* serdec_yaml_serializer_new_file(FILE* output_file);
+
+// Like _new_file(), but output is written directly to the file descriptor with
+// write(2), which avoids stdio locking and buffering entirely.
+SerdecYamlSerializer* serdec_yaml_serializer_new_fd(int fd);
+
+// This callback receives each chunk of output from a sink serializer, in
+// order. The buffer is only valid for the duration of the call. Return
+// non-zero to signal an error.
+typedef int yaml_write_callback(void* user_data, const char* buffer,
+    size_t length);
+
+// This callback is invoked when the output of a sink serializer should be
+// pushed to its final destination: at the end of the stream, and by _flush().
+// Return non-zero to signal an error.
+typedef int yaml_flush_callback(void* user_data);
+
+// Initialize a serializer which hands its output to the write callback as it's
+// produced, e.g. to copy it directly into a socket's send buffers. <flush> may
+// be NULL.
+SerdecYamlSerializer* serdec_yaml_serializer_new_sink(
+    yaml_write_callback* write, yaml_flush_callback* flush, void* user_data);
+
+// Like the constructors above, but the serializer's memory (including the
+// string of a string serializer) is obtained from <allocator>. A NULL
+// allocator selects the default.
+SerdecYamlSerializer* serdec_yaml_serializer_new_buffer_with_allocator(
+    char* buffer, size_t buffer_length, const SerdecAllocator* allocator);
+SerdecYamlSerializer* serdec_yaml_serializer_new_string_with_allocator(
+    const SerdecAllocator* allocator);
+SerdecYamlSerializer* serdec_yaml_serializer_new_file_with_allocator(
+    FILE* output_file, const SerdecAllocator* allocator);
+SerdecYamlSerializer* serdec_yaml_serializer_new_fd_with_allocator(int fd,
+    const SerdecAllocator* allocator);
+SerdecYamlSerializer* serdec_yaml_serializer_new_sink_with_allocator(
+    yaml_write_callback* write, yaml_flush_callback* flush, void* user_data,
+    const SerdecAllocator* allocator);
+
+// Set the number of bytes which file and file descriptor serializers stage
+// before writing. Larger thresholds mean fewer, larger writes. A threshold of
+// zero writes output as soon as it's produced.
+int serdec_yaml_serializer_set_flush_threshold(SerdecYamlSerializer* ser,
+    size_t threshold);
+
+// Select the backend for the serializer. This must be done before _start().
+// The native serializer writes the subset of YAML which serdec generates
+// (block maps and lists, plain keys and quoted strings) directly, without
+// running each node through libyaml's emitter. Its output has the same layout
+// as libyaml's, except that long strings are not folded across lines, and
+// strings that need escapes are double-quoted.
+int serdec_yaml_serializer_set_backend(SerdecYamlSerializer* ser,
+    SerdecYamlBackend backend);
+
+// Options for the layout of the output. Zero-initialized options select the
+// defaults: a "%YAML 1.1" directive and a "---" for every document, block
+// collections indented by four spaces, and single-quoted strings. The native
+// backend applies the same options.
+typedef struct SerdecYamlSerializerOptions {
+    // Spaces per level of indentation, from 2 to 9.
+    int indent;
+
+    // Write lists whose first element is a scalar in flow style, e.g.
+    // "[1, 2, 3]", on a single line. Collections nested in a flow list are
+    // flow collections too.
+    bool flow_scalar_lists;
+
+    // Write strings without quotes when they can't be mistaken for anything
+    // else, e.g. a number, a boolean or a null.
+    bool plain_strings;
+
+    // Omit the "%YAML 1.1" directive. The first document then needs no "---",
+    // and the documents after it need no "...".
+    bool omit_directives;
+} SerdecYamlSerializerOptions;
+
+// Set the options of the serializer. This must be done before _start().
+// <options> may be NULL, to go back to the defaults. Return
+// SERDEC_YAML_OUT_OF_RANGE if the indentation is not supported.
+int serdec_yaml_serializer_set_options(SerdecYamlSerializer* ser,
+    const SerdecYamlSerializerOptions* options);
+
+// Write any output which has been staged by the serializer. _end() does this
+// automatically.
+int serdec_yaml_serializer_flush(SerdecYamlSerializer* ser);
+
+// Re-use the serializer for a new stream, as if it had been freed and created
+// again, but without releasing the buffers which it (and libyaml) have
+// allocated. The output destination, backend and flush threshold are kept.
+// Output which has not yet been written (e.g. if the previous stream was not
+// ended) is discarded. A string serializer starts over with an empty string.
+int serdec_yaml_serializer_reset(SerdecYamlSerializer* ser);
+
+// Like _reset(), but a buffer serializer writes to <buffer> from now on.
+int serdec_yaml_serializer_reset_buffer(SerdecYamlSerializer* ser,
+    char* buffer, size_t buffer_length);
 
 // Free a serializer.
 void serdec_yaml_serializer_free(SerdecYamlSerializer* ser);
 
+///////////////////////////////////////////////////////////////////////////////
+// Prepared Keys
+////
+
+// Keys which are serialized many times (e.g. the field names of a list of
+// records) can be prepared once: measured, analyzed and encoded, so that
+// writing them costs almost nothing. A prepared key may be used by any number
+// of serializers. Return NULL, with errno set, if allocation fails.
+typedef struct SerdecYamlKey SerdecYamlKey;
+SerdecYamlKey* serdec_yaml_key_prepare(const char* key);
+
+// Like _prepare(), for keys whose length is already known. The key need not
+// be NUL-terminated.
+SerdecYamlKey* serdec_yaml_key_prepare_n(const char* key, size_t length);
+
+// Like the routines above, but the key's memory is obtained from <allocator>.
+// A NULL allocator selects the default.
+SerdecYamlKey* serdec_yaml_key_prepare_with_allocator(const char* key,
+    const SerdecAllocator* allocator);
+SerdecYamlKey* serdec_yaml_key_prepare_n_with_allocator(const char* key,
+    size_t length, const SerdecAllocator* allocator);
+void serdec_yaml_key_free(SerdecYamlKey* key);
+
 ///////////////////////////////////////////////////////////////////////////////
 // Serializer Routines
 ////
@@ -134,6 +724,14 @@ void serdec_yaml_serializer_free(SerdecYamlSerializer* ser);
 int serdec_yaml_serialize_start(SerdecYamlSerializer* ser);
 int serdec_yaml_serialize_end(SerdecYamlSerializer* ser);
 
+// _start() begins the first document of the stream, and _end() ends the last
+// one. To write a stream of several documents, end each document with
+// _document_end(), and begin the next one with _document_start(). Documents
+// are handed to the output as they're completed, so the memory used by file,
+// file descriptor and sink serializers doesn't grow with the stream.
+int serdec_yaml_serialize_document_start(SerdecYamlSerializer* ser);
+int serdec_yaml_serialize_document_end(SerdecYamlSerializer* ser);
+
 // Serialize a map to the output stream. To use this in an object serialization
 // routine, first call _start(). For each map entry, call _key() with the key
 // to associate with the desired value. Call one of the other serialization
@@ -143,6 +741,15 @@ int serdec_yaml_serialize_map_start(SerdecYamlSerializer* ser);
 int serdec_yaml_serialize_map_end(SerdecYamlSerializer* ser);
 int serdec_yaml_serialize_map_key(SerdecYamlSerializer* ser, const char* key);
 
+// Like _map_key(), for keys whose length is already known.
+int serdec_yaml_serialize_map_key_n(SerdecYamlSerializer* ser, const char* key,
+    size_t length);
+
+// Like _map_key(), for keys which were prepared with serdec_yaml_key_prepare().
+// With the native backend, the key is written with a single copy.
+int serdec_yaml_serialize_map_key_prepared(SerdecYamlSerializer* ser,
+    const SerdecYamlKey* key);
+
 // Serialize a list to the output stream. To use this in an object
 // serialization routine, first call start. For each element in the list, call
 // a serialization routine to serialize a single element into the output
@@ -157,11 +764,105 @@ int serdec_yaml_serialize_bool(SerdecYamlSerializer* ser, bool value);
 // Serialize an integer value to the output stream. Return non-zero if parsing
 // encountered an error, for any reason.
 int serdec_yaml_serialize_int(SerdecYamlSerializer* ser, int value);
+int serdec_yaml_serialize_int64(SerdecYamlSerializer* ser, int64_t value);
+int serdec_yaml_serialize_uint64(SerdecYamlSerializer* ser, uint64_t value);
+int serdec_yaml_serialize_size_t(SerdecYamlSerializer* ser, size_t value);
+
+// Serialize a floating point value to the output stream. The output reads
+// back to the same value, and is usually, but not always, the shortest which
+// does. It always contains a decimal point (e.g. "3.0", "1.0e+30"), so it's
+// resolved as a float. Infinities and NaN are written as .inf, -.inf and .nan.
+int serdec_yaml_serialize_double(SerdecYamlSerializer* ser, double value);
 
 // Serialize a string value to the output stream. Return non-zero if parsing
 // encounters an error.
 int serdec_yaml_serialize_string(SerdecYamlSerializer* ser, const char* value);
 
+// Like _string(), for strings whose length is already known. The string need
+// not be NUL-terminated, and may contain NUL bytes, which are escaped.
+int serdec_yaml_serialize_string_n(SerdecYamlSerializer* ser,
+    const char* value, size_t length);
+
+// Serialize a struct to the output stream as a map, according to its type.
+int serdec_yaml_serialize_struct(SerdecYamlSerializer* ser,
+    const SerdecYamlType* type, const void* value);
+
+///////////////////////////////////////////////////////////////////////////////
+// Statistics
+////
+
+// Counters describing the work a de/serializer has done since it was created.
+// They're collected only if the library was built with -Dstats=counters or
+// -Dstats=timing; otherwise, the instrumentation is compiled out, and the
+// routines below return SERDEC_YAML_NOT_SUPPORTED. Resetting a de/serializer
+// doesn't clear its counters. Allocations made by libyaml itself aren't seen
+// by serdec's allocator, and aren't counted.
+typedef struct SerdecYamlStats {
+    // Events parsed or emitted, including the starts and ends of documents,
+    // maps and lists. libyaml also reports the start and end of each stream.
+    uint64_t events;
+
+    // Bytes of input consumed by the parser, or of output produced. A tape
+    // reads no input, so replaying one consumes no bytes.
+    uint64_t bytes;
+
+    // Bytes of scalars which serdec copied: into NUL-terminated keys and
+    // strings, struct strings and arenas, when de-serializing, and of keys and
+    // scalars written, when serializing.
+    uint64_t scalar_bytes;
+
+    // Calls to the allocator's alloc and realloc functions.
+    uint64_t allocations;
+    uint64_t reallocations;
+
+    // The deepest nesting of maps and lists.
+    uint64_t max_depth;
+
+    // Times the output of a string serializer was moved to a larger buffer.
+    uint64_t buffer_grows;
+
+    // With -Dstats=timing, the nanoseconds spent in user callbacks (the visit
+    // callbacks of a de-serializer, or the write and flush callbacks of a sink
+    // serializer), and in the parser of a de-serializer, not counting the time
+    // in the parser of callbacks which de-serialize values. Serializers only
+    // run when they're called, so callers can time them directly, and
+    // <codec_ns> is zero for them. Both are zero with -Dstats=counters.
+    uint64_t callback_ns;
+    uint64_t codec_ns;
+} SerdecYamlStats;
+
+// Copy the counters of the de/serializer into <stats>. Return zero on success,
+// or SERDEC_YAML_NOT_SUPPORTED if the library was built without statistics.
+int serdec_yaml_deserializer_stats(SerdecYamlDeserializer* deser,
+    SerdecYamlStats* stats);
+int serdec_yaml_serializer_stats(SerdecYamlSerializer* ser,
+    SerdecYamlStats* stats);
+
+///////////////////////////////////////////////////////////////////////////////
+// Generic Interface
+////
+
+// The operations of the generic interface (see serdec/codec.h), and routines
+// which wrap a de/serializer in it.
+extern const SerdecSerializerOps SERDEC_YAML_SERIALIZER_OPS;
+extern const SerdecDeserializerOps SERDEC_YAML_DESERIALIZER_OPS;
+
+static inline SerdecSerializer serdec_yaml_serializer_generic(
+    SerdecYamlSerializer* ser)
+{
+    return (SerdecSerializer){
+        .ops=&SERDEC_YAML_SERIALIZER_OPS, .codec=ser,
+    };
+}
+
+static inline SerdecDeserializer serdec_yaml_deserializer_generic(
+    SerdecYamlDeserializer* deser)
+{
+    return (SerdecDeserializer){
+        .ops=&SERDEC_YAML_DESERIALIZER_OPS, .codec=deser,
+    };
+}
+
 #endif // SERDEC_YAML_H
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -7,7 +7,7 @@
 //
 // CREATED:         02/04/2022
 //
-// LAST EDITED:     02/05/2022
+// LAST EDITED:     10/14/2026
 //
 // Copyright 2022, Ethan D. Twardy
 //
@@ -34,8 +34,16 @@
 
 int main() {
     UNITY_BEGIN();
+    RUN_TEST_GROUP(Allocator);
+    RUN_TEST_GROUP(Arena);
+    RUN_TEST_GROUP(Codec);
+    RUN_TEST_GROUP(Json);
+    RUN_TEST_GROUP(Msgpack);
+    RUN_TEST_GROUP(StructuralIndex);
     RUN_TEST_GROUP(YamlDeser);
+    RUN_TEST_GROUP(YamlScanner);
     RUN_TEST_GROUP(YamlSer);
+    RUN_TEST_GROUP(YamlTape);
     return UNITY_END();
 }
 
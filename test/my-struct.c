@@ -0,0 +1,64 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            my-struct.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Type descriptors for the example structs.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <stddef.h>
+
+#include <serdec/yaml.h>
+
+#include "my-struct.h"
+
+static const SerdecYamlFieldDescriptor INNER_STRUCT_FIELDS[] = {
+    SERDEC_YAML_FIELD(InnerStruct, my_value, SERDEC_YAML_KIND_INT),
+};
+
+const SerdecYamlTypeDescriptor INNER_STRUCT_TYPE = {
+    .size = sizeof(InnerStruct),
+    .fields = INNER_STRUCT_FIELDS,
+    .field_count = sizeof(INNER_STRUCT_FIELDS) / sizeof(*INNER_STRUCT_FIELDS),
+};
+
+static const SerdecYamlFieldDescriptor MY_STRUCT_FIELDS[] = {
+    SERDEC_YAML_FIELD(MyStruct, test, SERDEC_YAML_KIND_BOOL),
+    SERDEC_YAML_FIELD(MyStruct, a_number, SERDEC_YAML_KIND_INT),
+    SERDEC_YAML_FIELD(MyStruct, a_string, SERDEC_YAML_KIND_STRING),
+    SERDEC_YAML_ARRAY_FIELD(MyStruct, list_of_four, SERDEC_YAML_KIND_INT),
+    SERDEC_YAML_STRUCT_FIELD(MyStruct, my_inner, &INNER_STRUCT_TYPE),
+};
+
+const SerdecYamlTypeDescriptor MY_STRUCT_TYPE = {
+    .size = sizeof(MyStruct),
+    .fields = MY_STRUCT_FIELDS,
+    .field_count = sizeof(MY_STRUCT_FIELDS) / sizeof(*MY_STRUCT_FIELDS),
+    .skip_unknown = true,
+};
+
+///////////////////////////////////////////////////////////////////////////////
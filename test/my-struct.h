@@ -7,7 +7,7 @@
 //
 // CREATED:         02/04/2022
 //
-// LAST EDITED:     02/05/2022
+// LAST EDITED:     10/14/2026
 //
 // Copyright 2022, Ethan D. Twardy
 //
@@ -35,6 +35,8 @@
 
 #include <stdbool.h>
 
+#include <serdec/yaml.h>
+
 typedef struct InnerStruct {
     int my_value;
 } InnerStruct;
@@ -47,6 +49,10 @@ typedef struct MyStruct {
     InnerStruct my_inner;
 } MyStruct;
 
+// Type descriptors for the structs above, for the descriptor-driven codec.
+extern const SerdecYamlTypeDescriptor INNER_STRUCT_TYPE;
+extern const SerdecYamlTypeDescriptor MY_STRUCT_TYPE;
+
 #endif // SERDEC_MY_STRUCT_H
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,199 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            test-allocator.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Tests for custom allocators
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <serdec/yaml.h>
+
+#include "my-struct.h"
+
+#include <unity_fixture.h>
+
+// An allocator which counts outstanding allocations, and fails every
+// allocation once <remaining> reaches zero.
+typedef struct CountingAllocator {
+    size_t outstanding;
+    size_t allocations;
+    size_t remaining;
+} CountingAllocator;
+
+static void* counting_alloc(void* ctx, size_t size) {
+    CountingAllocator* counter = (CountingAllocator*)ctx;
+    if (0 == counter->remaining) {
+        return NULL;
+    }
+    --counter->remaining;
+    ++counter->outstanding;
+    ++counter->allocations;
+    return malloc(size);
+}
+
+static void* counting_realloc(void* ctx, void* pointer, size_t size) {
+    CountingAllocator* counter = (CountingAllocator*)ctx;
+    if (NULL == pointer) {
+        return counting_alloc(ctx, size);
+    }
+    if (0 == counter->remaining) {
+        return NULL;
+    }
+    --counter->remaining;
+    ++counter->allocations;
+    return realloc(pointer, size);
+}
+
+static void counting_free(void* ctx, void* pointer) {
+    CountingAllocator* counter = (CountingAllocator*)ctx;
+    if (NULL != pointer) {
+        --counter->outstanding;
+        free(pointer);
+    }
+}
+
+static CountingAllocator counter;
+static SerdecAllocator allocator = {
+    .alloc = counting_alloc,
+    .realloc = counting_realloc,
+    .free = counting_free,
+    .ctx = &counter,
+};
+
+TEST_GROUP(Allocator);
+TEST_SETUP(Allocator) {
+    memset(&counter, 0, sizeof(counter));
+    counter.remaining = SIZE_MAX;
+}
+TEST_TEAR_DOWN(Allocator) {}
+
+TEST(Allocator, Serializer) {
+    SerdecYamlType* type = serdec_yaml_type_new_with_allocator(&MY_STRUCT_TYPE,
+        &allocator);
+    TEST_ASSERT_NOT_NULL(type);
+    SerdecYamlSerializer* ser =
+        serdec_yaml_serializer_new_string_with_allocator(&allocator);
+    TEST_ASSERT_NOT_NULL(ser);
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serializer_set_backend(ser,
+            SERDEC_YAML_BACKEND_NATIVE));
+
+    MyStruct my_struct = {
+        .test = true, .a_number = 1, .a_string = "test",
+        .list_of_four = {1, 2, 3, 4}, .my_inner = {.my_value = 4},
+    };
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_struct(ser, type,
+            &my_struct));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_end(ser));
+
+    // The string is handed to the caller, who frees it with the allocator.
+    char* string = serdec_yaml_serializer_take_string(ser, NULL);
+    TEST_ASSERT_NOT_NULL(string);
+    serdec_yaml_serializer_free(ser);
+    serdec_yaml_type_free(type);
+    TEST_ASSERT_EQUAL_size_t(1, counter.outstanding);
+    allocator.free(allocator.ctx, string);
+    TEST_ASSERT_EQUAL_size_t(0, counter.outstanding);
+    TEST_ASSERT(counter.allocations > 0);
+}
+
+TEST(Allocator, Deserializer) {
+    static const char* document = "\
+a_string: 'test'\n\
+list_of_four: [1, 2, 3, 4]\n\
+";
+    SerdecYamlType* type = serdec_yaml_type_new_with_allocator(&MY_STRUCT_TYPE,
+        &allocator);
+    TEST_ASSERT_NOT_NULL(type);
+    SerdecYamlDeserializer* deser =
+        serdec_yaml_deserializer_new_string_with_allocator(document,
+            strlen(document), &allocator);
+    TEST_ASSERT_NOT_NULL(deser);
+    MyStruct my_struct = {0};
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserialize_struct(deser, type,
+            &my_struct));
+    TEST_ASSERT_EQUAL_STRING("test", my_struct.a_string);
+    serdec_yaml_deserializer_free(deser);
+
+    // The struct's strings are released with the type's allocator.
+    serdec_yaml_type_release(type, &my_struct);
+    serdec_yaml_type_free(type);
+    TEST_ASSERT_EQUAL_size_t(0, counter.outstanding);
+
+    const char* list = "[1, 2, 3]";
+    deser = serdec_yaml_deserializer_new_string_with_allocator(list,
+        strlen(list), &allocator);
+    TEST_ASSERT_NOT_NULL(deser);
+    int* values = NULL;
+    size_t count = 0;
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserialize_int_vector(deser,
+            &values, &count));
+    TEST_ASSERT_EQUAL_size_t(3, count);
+    serdec_yaml_deserializer_free(deser);
+    allocator.free(allocator.ctx, values);
+    TEST_ASSERT_EQUAL_size_t(0, counter.outstanding);
+}
+
+TEST(Allocator, Arena) {
+    SerdecArena* arena = serdec_arena_new_with_allocator(64, &allocator);
+    TEST_ASSERT_NOT_NULL(arena);
+    TEST_ASSERT_NOT_NULL(serdec_arena_alloc(arena, 1000));
+    TEST_ASSERT_EQUAL_STRING("test", serdec_arena_strndup(arena, "test", 4));
+    serdec_arena_free(arena);
+    TEST_ASSERT_EQUAL_size_t(0, counter.outstanding);
+}
+
+TEST(Allocator, Failure) {
+    // Constructors report allocation failures, rather than aborting.
+    counter.remaining = 0;
+    TEST_ASSERT_NULL(serdec_yaml_serializer_new_string_with_allocator(
+            &allocator));
+    TEST_ASSERT_NULL(serdec_yaml_deserializer_new_string_with_allocator("a",
+            1, &allocator));
+    TEST_ASSERT_NULL(serdec_yaml_type_new_with_allocator(&MY_STRUCT_TYPE,
+            &allocator));
+    TEST_ASSERT_NULL(serdec_arena_new_with_allocator(0, &allocator));
+
+    // ...including failures after the first allocation.
+    counter.remaining = 1;
+    TEST_ASSERT_NULL(serdec_yaml_serializer_new_fd_with_allocator(1,
+            &allocator));
+    TEST_ASSERT_EQUAL_size_t(0, counter.outstanding);
+}
+
+TEST_GROUP_RUNNER(Allocator) {
+    RUN_TEST_CASE(Allocator, Serializer);
+    RUN_TEST_CASE(Allocator, Deserializer);
+    RUN_TEST_CASE(Allocator, Arena);
+    RUN_TEST_CASE(Allocator, Failure);
+}
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,74 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            test-arena.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Tests for the arena allocator.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <stdint.h>
+#include <string.h>
+
+#include <serdec/arena.h>
+
+#include <unity_fixture.h>
+
+TEST_GROUP(Arena);
+TEST_SETUP(Arena) {}
+TEST_TEAR_DOWN(Arena) {}
+
+TEST(Arena, Allocate) {
+    SerdecArena* arena = serdec_arena_new(64);
+    TEST_ASSERT_NOT_NULL(arena);
+
+    // Allocations are aligned for any type, and don't overlap.
+    char* first = serdec_arena_alloc(arena, 3);
+    char* second = serdec_arena_alloc(arena, 8);
+    TEST_ASSERT_NOT_NULL(first);
+    TEST_ASSERT_NOT_NULL(second);
+    TEST_ASSERT_EQUAL_INT(0, (uintptr_t)second % _Alignof(max_align_t));
+    TEST_ASSERT(second >= first + 3);
+
+    // Allocations larger than a block get a block of their own.
+    char* large = serdec_arena_alloc(arena, 1000);
+    TEST_ASSERT_NOT_NULL(large);
+    memset(large, 'x', 1000);
+
+    char* string = serdec_arena_strndup(arena, "hello, world", 5);
+    TEST_ASSERT_EQUAL_STRING("hello", string);
+
+    // After a reset, the blocks are reused.
+    serdec_arena_reset(arena);
+    TEST_ASSERT(first == serdec_arena_alloc(arena, 3));
+    serdec_arena_free(arena);
+}
+
+TEST_GROUP_RUNNER(Arena) {
+    RUN_TEST_CASE(Arena, Allocate);
+}
+
+///////////////////////////////////////////////////////////////////////////////
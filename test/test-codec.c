@@ -0,0 +1,249 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            test-codec.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Unit tests of the generic codec interface.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <string.h>
+
+#include <serdec/codec.h>
+#include <serdec/json.h>
+#include <serdec/json-error.h>
+#include <serdec/msgpack.h>
+#include <serdec/yaml.h>
+
+#include <unity_fixture.h>
+
+TEST_GROUP(Codec);
+TEST_SETUP(Codec) {}
+TEST_TEAR_DOWN(Codec) {}
+
+typedef struct Record {
+    int a;
+    int64_t b[3];
+    size_t b_count;
+    char s[16];
+    bool t;
+    double d;
+    uint64_t u;
+} Record;
+
+static const Record RECORD = {
+    .a = -7,
+    .b = {1, -2, INT64_MAX},
+    .b_count = 3,
+    .s = "it's \"quoted\"",
+    .t = true,
+    .d = 0.1,
+    .u = UINT64_MAX,
+};
+
+// The routines for a Record are written once, against the generic interface.
+static int serialize_record(SerdecSerializer* ser, const Record* record) {
+    if (serdec_serialize_map_start(ser) ||
+        serdec_serialize_map_key(ser, "a") ||
+        serdec_serialize_int(ser, record->a) ||
+        serdec_serialize_map_key(ser, "b") ||
+        serdec_serialize_list_start(ser)) {
+        return 1;
+    }
+
+    for (size_t i = 0; i < record->b_count; ++i) {
+        if (serdec_serialize_int64(ser, record->b[i])) {
+            return 1;
+        }
+    }
+
+    return serdec_serialize_list_end(ser) ||
+        serdec_serialize_map_key(ser, "s") ||
+        serdec_serialize_string(ser, record->s) ||
+        serdec_serialize_map_key_n(ser, "tx", 1) ||
+        serdec_serialize_bool(ser, record->t) ||
+        serdec_serialize_map_key(ser, "d") ||
+        serdec_serialize_double(ser, record->d) ||
+        serdec_serialize_map_key(ser, "u") ||
+        serdec_serialize_uint64(ser, record->u) ||
+        serdec_serialize_map_key(ser, "ignored") ||
+        serdec_serialize_size_t(ser, 42) ||
+        serdec_serialize_map_end(ser);
+}
+
+static int record_visit_list_entry(SerdecDeserializer* deser,
+    void* user_data, size_t index)
+{
+    Record* record = (Record*)user_data;
+    if (3 <= index) {
+        return 1;
+    }
+
+    record->b_count = index + 1;
+    return serdec_deserialize_int64(deser, &record->b[index]);
+}
+
+static int record_visit_map_entry(SerdecDeserializer* deser,
+    void* user_data, const char* key, size_t length)
+{
+    Record* record = (Record*)user_data;
+    if (1 != length) {
+        return serdec_deserialize_skip(deser);
+    }
+
+    const char* string = NULL;
+    size_t string_length = 0;
+    switch (*key) {
+    case 'a': return serdec_deserialize_int(deser, &record->a);
+    case 'b':
+        return serdec_deserialize_list(deser, record_visit_list_entry,
+            record);
+    case 's':
+        if (serdec_deserialize_string(deser, &string, &string_length) ||
+            sizeof(record->s) <= string_length) {
+            return 1;
+        }
+        memcpy(record->s, string, string_length);
+        return 0;
+    case 't': return serdec_deserialize_bool(deser, &record->t);
+    case 'd': return serdec_deserialize_double(deser, &record->d);
+    case 'u': return serdec_deserialize_uint64(deser, &record->u);
+    default:
+        return serdec_deserialize_skip(deser);
+    }
+}
+
+static void serialize(SerdecSerializer* ser) {
+    TEST_ASSERT_EQUAL_INT(0, serdec_serialize_start(ser));
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, serialize_record(ser, &RECORD),
+        serdec_serializer_strerror(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_serialize_end(ser));
+}
+
+static void check_deserialize(SerdecDeserializer* deser) {
+    Record record = {0};
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, serdec_deserialize_map(deser,
+            record_visit_map_entry, &record),
+        serdec_deserializer_strerror(deser));
+    TEST_ASSERT_EQUAL_INT(RECORD.a, record.a);
+    TEST_ASSERT_EQUAL_size_t(RECORD.b_count, record.b_count);
+    TEST_ASSERT_EQUAL_MEMORY(RECORD.b, record.b, sizeof(RECORD.b));
+    TEST_ASSERT_EQUAL_STRING(RECORD.s, record.s);
+    TEST_ASSERT_EQUAL_INT(RECORD.t, record.t);
+    TEST_ASSERT_EQUAL_DOUBLE(RECORD.d, record.d);
+    TEST_ASSERT_EQUAL_UINT64(RECORD.u, record.u);
+}
+
+TEST(Codec, Yaml) {
+    SerdecYamlSerializer* yaml_ser = serdec_yaml_serializer_new_string();
+    SerdecSerializer ser = serdec_yaml_serializer_generic(yaml_ser);
+    serialize(&ser);
+
+    const char* string = serdec_yaml_serializer_borrow_string(yaml_ser);
+    SerdecYamlDeserializer* yaml_deser =
+        serdec_yaml_deserializer_new_string(string, strlen(string));
+    SerdecDeserializer deser = serdec_yaml_deserializer_generic(yaml_deser);
+    check_deserialize(&deser);
+    serdec_yaml_deserializer_free(yaml_deser);
+    serdec_yaml_serializer_free(yaml_ser);
+}
+
+TEST(Codec, Json) {
+    SerdecJsonSerializer* json_ser = serdec_json_serializer_new();
+    SerdecSerializer ser = serdec_json_serializer_generic(json_ser);
+    serialize(&ser);
+
+    size_t length = 0;
+    const char* string = serdec_json_serializer_borrow_string(json_ser,
+        &length);
+    TEST_ASSERT_EQUAL_STRING("{\"a\":-7,\"b\":[1,-2,9223372036854775807],"
+        "\"s\":\"it's \\\"quoted\\\"\",\"t\":true,\"d\":0.1,"
+        "\"u\":18446744073709551615,\"ignored\":42}", string);
+
+    SerdecJsonDeserializer* json_deser = serdec_json_deserializer_new(string,
+        length);
+    SerdecDeserializer deser = serdec_json_deserializer_generic(json_deser);
+    check_deserialize(&deser);
+    TEST_ASSERT_TRUE(serdec_json_deserializer_at_end(json_deser));
+    serdec_json_deserializer_free(json_deser);
+    serdec_json_serializer_free(json_ser);
+}
+
+TEST(Codec, Msgpack) {
+    SerdecMsgpackSerializer* msgpack_ser = serdec_msgpack_serializer_new();
+    SerdecSerializer ser = serdec_msgpack_serializer_generic(msgpack_ser);
+    serialize(&ser);
+
+    size_t length = 0;
+    const char* buffer = serdec_msgpack_serializer_borrow_buffer(msgpack_ser,
+        &length);
+    SerdecMsgpackDeserializer* msgpack_deser =
+        serdec_msgpack_deserializer_new(buffer, length);
+    SerdecDeserializer deser =
+        serdec_msgpack_deserializer_generic(msgpack_deser);
+    check_deserialize(&deser);
+    TEST_ASSERT_TRUE(serdec_msgpack_deserializer_at_end(msgpack_deser));
+    serdec_msgpack_deserializer_free(msgpack_deser);
+    serdec_msgpack_serializer_free(msgpack_ser);
+}
+
+static int failing_visit_list_entry(SerdecDeserializer* deser,
+    void* user_data, size_t index)
+{
+    (void)deser;
+    (void)user_data;
+    (void)index;
+    return 1;
+}
+
+TEST(Codec, Errors) {
+    // Errors are reported by the codec, with its own codes.
+    SerdecJsonSerializer* json_ser = serdec_json_serializer_new();
+    SerdecSerializer ser = serdec_json_serializer_generic(json_ser);
+    TEST_ASSERT_EQUAL_INT(SERDEC_JSON_UNEXPECTED_EVENT,
+        serdec_serialize_map_end(&ser));
+    TEST_ASSERT_EQUAL_STRING(serdec_json_serializer_strerror(json_ser),
+        serdec_serializer_strerror(&ser));
+    serdec_json_serializer_free(json_ser);
+
+    static const char LIST[] = "[1]";
+    SerdecJsonDeserializer* json_deser = serdec_json_deserializer_new(LIST,
+        strlen(LIST));
+    SerdecDeserializer deser = serdec_json_deserializer_generic(json_deser);
+    TEST_ASSERT_EQUAL_INT(SERDEC_JSON_CALLBACK_SIGNALED_ERROR,
+        serdec_deserialize_list(&deser, failing_visit_list_entry, NULL));
+    TEST_ASSERT_NOT_NULL(serdec_deserializer_strerror(&deser));
+    serdec_json_deserializer_free(json_deser);
+}
+
+TEST_GROUP_RUNNER(Codec) {
+    RUN_TEST_CASE(Codec, Yaml);
+    RUN_TEST_CASE(Codec, Json);
+    RUN_TEST_CASE(Codec, Msgpack);
+    RUN_TEST_CASE(Codec, Errors);
+}
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,328 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            test-json.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Unit tests of the JSON codec.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <serdec/json.h>
+#include <serdec/json-error.h>
+
+#include <unity_fixture.h>
+
+TEST_GROUP(Json);
+TEST_SETUP(Json) {}
+TEST_TEAR_DOWN(Json) {}
+
+static const char RECORD_DOCUMENT[] =
+    "{\"a\":1,\"b\":[-1,0,18446744073709551615],\"s\":\"hi\",\"t\":true,"
+    "\"d\":0.1,\"e\":{},\"l\":[]}";
+
+typedef struct Record {
+    int a;
+    int64_t b0;
+    int64_t b1;
+    uint64_t b2;
+    const char* s;
+    size_t s_length;
+    bool t;
+    double d;
+} Record;
+
+static int record_visit_list_entry(SerdecJsonDeserializer* deser,
+    void* user_data, size_t index)
+{
+    Record* record = (Record*)user_data;
+    switch (index) {
+    case 0: return serdec_json_deserialize_int64(deser, &record->b0);
+    case 1: return serdec_json_deserialize_int64(deser, &record->b1);
+    case 2: return serdec_json_deserialize_uint64(deser, &record->b2);
+    default:
+        return 1;
+    }
+}
+
+static int record_visit_map_entry(SerdecJsonDeserializer* deser,
+    void* user_data, const char* key, size_t length)
+{
+    Record* record = (Record*)user_data;
+    if (1 != length) {
+        return serdec_json_deserialize_skip(deser);
+    }
+
+    switch (*key) {
+    case 'a': return serdec_json_deserialize_int(deser, &record->a);
+    case 'b':
+        return serdec_json_deserialize_list(deser, record_visit_list_entry,
+            record);
+    case 's':
+        return serdec_json_deserialize_string(deser, &record->s,
+            &record->s_length);
+    case 't': return serdec_json_deserialize_bool(deser, &record->t);
+    case 'd': return serdec_json_deserialize_double(deser, &record->d);
+    default:
+        return serdec_json_deserialize_skip(deser);
+    }
+}
+
+TEST(Json, Encoding) {
+    SerdecJsonSerializer* ser = serdec_json_serializer_new();
+    TEST_ASSERT_NOT_NULL(ser);
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_map_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_map_key(ser, "a"));
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_int(ser, 1));
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_map_key(ser, "b"));
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_list_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_int64(ser, -1));
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_size_t(ser, 0));
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_uint64(ser, UINT64_MAX));
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_list_end(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_map_key(ser, "s"));
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_string(ser, "hi"));
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_map_key(ser, "t"));
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_bool(ser, true));
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_map_key(ser, "d"));
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_double(ser, 0.1));
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_map_key(ser, "e"));
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_map_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_map_end(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_map_key(ser, "l"));
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_list_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_list_end(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_map_end(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_end(ser));
+
+    size_t length = 0;
+    const char* string = serdec_json_serializer_borrow_string(ser, &length);
+    TEST_ASSERT_EQUAL_STRING(RECORD_DOCUMENT, string);
+    TEST_ASSERT_EQUAL_size_t(strlen(RECORD_DOCUMENT), length);
+
+    // Whitespace is permitted between tokens, and strings are read in place.
+    static const char SPACED[] = " {\n\t\"a\" : 1 ,\"b\":[ -1 , 0,"
+        "18446744073709551615 ] , \"s\" : \"hi\", \"t\": true,\"d\":1e-1,"
+        "\"x\": {\"y\": [null, \"]\\\"\", {}]}}\r\n";
+    Record read = {0};
+    SerdecJsonDeserializer* deser = serdec_json_deserializer_new(SPACED,
+        strlen(SPACED));
+    TEST_ASSERT_NOT_NULL(deser);
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_deserialize_map(deser,
+            record_visit_map_entry, &read));
+    TEST_ASSERT_TRUE(serdec_json_deserializer_at_end(deser));
+    TEST_ASSERT_EQUAL_INT(1, read.a);
+    TEST_ASSERT_EQUAL_INT64(-1, read.b0);
+    TEST_ASSERT_EQUAL_INT64(0, read.b1);
+    TEST_ASSERT_EQUAL_UINT64(UINT64_MAX, read.b2);
+    TEST_ASSERT_EQUAL_PTR(strstr(SPACED, "hi"), read.s);
+    TEST_ASSERT_EQUAL_size_t(2, read.s_length);
+    TEST_ASSERT_TRUE(read.t);
+    TEST_ASSERT_EQUAL_DOUBLE(0.1, read.d);
+    serdec_json_deserializer_free(deser);
+
+    // Several values are separated by newlines.
+    serdec_json_serializer_reset(ser);
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_double(ser, 1e30));
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_bool(ser, false));
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_end(ser));
+    char* taken = serdec_json_serializer_take_string(ser, &length);
+    TEST_ASSERT_EQUAL_STRING("1.0e+30\nfalse", taken);
+    free(taken);
+    serdec_json_serializer_free(ser);
+}
+
+typedef struct Entries {
+    char text[64];
+    size_t length;
+} Entries;
+
+static void append_entry(Entries* entries, const char* data, size_t length) {
+    TEST_ASSERT_TRUE(sizeof(entries->text) - entries->length > length);
+    memcpy(entries->text + entries->length, data, length);
+    entries->length += length;
+    entries->text[entries->length] = '\0';
+}
+
+static int entries_visit_map_entry(SerdecJsonDeserializer* deser,
+    void* user_data, const char* key, size_t length)
+{
+    // The key stays valid while the value is decoded.
+    const char* value = NULL;
+    size_t value_length = 0;
+    if (serdec_json_deserialize_string(deser, &value, &value_length)) {
+        return 1;
+    }
+
+    Entries* entries = (Entries*)user_data;
+    append_entry(entries, key, length);
+    append_entry(entries, "=", 1);
+    append_entry(entries, value, value_length);
+    append_entry(entries, ";", 1);
+    return 0;
+}
+
+TEST(Json, Strings) {
+    // Control characters, quotes and backslashes are escaped. Everything else
+    // is copied.
+    static const char RAW[] = "\"q\" \\ / \b\f\n\r\t \x01\x1f \xc3\xa9";
+    static const char ESCAPED[] =
+        "\"\\\"q\\\" \\\\ / \\b\\f\\n\\r\\t \\u0001\\u001f \xc3\xa9\"";
+    SerdecJsonSerializer* ser = serdec_json_serializer_new();
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_string_n(ser, RAW,
+            sizeof(RAW) - 1));
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_end(ser));
+    TEST_ASSERT_EQUAL_STRING(ESCAPED,
+        serdec_json_serializer_borrow_string(ser, NULL));
+    serdec_json_serializer_free(ser);
+
+    const char* value = NULL;
+    size_t length = 0;
+    SerdecJsonDeserializer* deser = serdec_json_deserializer_new(ESCAPED,
+        sizeof(ESCAPED) - 1);
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_deserialize_string(deser, &value,
+            &length));
+    TEST_ASSERT_EQUAL_size_t(sizeof(RAW) - 1, length);
+    TEST_ASSERT_EQUAL_MEMORY(RAW, value, length);
+
+    // Unicode escapes are decoded to UTF-8, including surrogate pairs.
+    static const char UNICODE[] = "\"\\u0041\\u00e9\\u20ac\\ud83d\\ude00\\/\"";
+    static const char DECODED[] = "A\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80/";
+    serdec_json_deserializer_reset(deser, UNICODE, sizeof(UNICODE) - 1);
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_deserialize_string(deser, &value,
+            &length));
+    TEST_ASSERT_EQUAL_size_t(sizeof(DECODED) - 1, length);
+    TEST_ASSERT_EQUAL_MEMORY(DECODED, value, length);
+
+    static const char* INVALID[] = {
+        "\"\\ud83d\"", "\"\\ude00\"", "\"\\u00g0\"", "\"\\x\"", "\"\x01\"",
+    };
+    for (size_t i = 0; i < sizeof(INVALID) / sizeof(INVALID[0]); ++i) {
+        serdec_json_deserializer_reset(deser, INVALID[i], strlen(INVALID[i]));
+        TEST_ASSERT_EQUAL_INT(SERDEC_JSON_INVALID_SYNTAX,
+            serdec_json_deserialize_string(deser, &value, &length));
+    }
+
+    // Escaped keys are decoded too.
+    static const char OBJECT[] = "{\"k\\u0031\":\"v\\n\",\"k2\":\"\\\"\"}";
+    Entries entries = {0};
+    serdec_json_deserializer_reset(deser, OBJECT, sizeof(OBJECT) - 1);
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_deserialize_map(deser,
+            entries_visit_map_entry, &entries));
+    TEST_ASSERT_EQUAL_STRING("k1=v\n;k2=\";", entries.text);
+    serdec_json_deserializer_free(deser);
+}
+
+TEST(Json, Errors) {
+    // Values must be where the container expects them
+    SerdecJsonSerializer* ser = serdec_json_serializer_new();
+    TEST_ASSERT_EQUAL_INT(SERDEC_JSON_UNEXPECTED_EVENT,
+        serdec_json_serialize_int(ser, 1));
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_map_start(ser));
+    TEST_ASSERT_EQUAL_INT(SERDEC_JSON_UNEXPECTED_EVENT,
+        serdec_json_serialize_int(ser, 1));
+    TEST_ASSERT_EQUAL_INT(SERDEC_JSON_UNEXPECTED_EVENT,
+        serdec_json_serialize_list_end(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_serialize_map_key(ser, "a"));
+    TEST_ASSERT_EQUAL_INT(SERDEC_JSON_UNEXPECTED_EVENT,
+        serdec_json_serialize_map_end(ser));
+    TEST_ASSERT_EQUAL_INT(SERDEC_JSON_OUT_OF_RANGE,
+        serdec_json_serialize_double(ser, INFINITY));
+    TEST_ASSERT_EQUAL_INT(SERDEC_JSON_UNEXPECTED_EVENT,
+        serdec_json_serialize_end(ser));
+    TEST_ASSERT_NOT_NULL(serdec_json_serializer_strerror(ser));
+    serdec_json_serializer_free(ser);
+
+    // Every truncation of a document is detected
+    size_t document_length = strlen(RECORD_DOCUMENT);
+    for (size_t i = 0; i < document_length; ++i) {
+        Record read = {0};
+        SerdecJsonDeserializer* deser = serdec_json_deserializer_new(
+            RECORD_DOCUMENT, i);
+        TEST_ASSERT_NOT_EQUAL(0, serdec_json_deserialize_map(deser,
+                record_visit_map_entry, &read));
+        serdec_json_deserializer_reset(deser, RECORD_DOCUMENT, i);
+        TEST_ASSERT_EQUAL_INT(SERDEC_JSON_END_OF_INPUT,
+            serdec_json_deserialize_skip(deser));
+        serdec_json_deserializer_free(deser);
+    }
+
+    SerdecJsonDeserializer* deser = serdec_json_deserializer_new(NULL, 0);
+    int64_t signed_value = 0;
+    uint64_t unsigned_value = 0;
+    bool boolean = false;
+    static const char LARGE[] = "9223372036854775808";
+    serdec_json_deserializer_reset(deser, LARGE, strlen(LARGE));
+    TEST_ASSERT_EQUAL_INT(SERDEC_JSON_OUT_OF_RANGE,
+        serdec_json_deserialize_int64(deser, &signed_value));
+    TEST_ASSERT_EQUAL_INT(SERDEC_JSON_WRONG_TYPE,
+        serdec_json_deserialize_bool(deser, &boolean));
+
+    // A value which is of the wrong type is not consumed.
+    TEST_ASSERT_EQUAL_INT(0, serdec_json_deserialize_uint64(deser,
+            &unsigned_value));
+    TEST_ASSERT_EQUAL_UINT64(UINT64_C(1) << 63, unsigned_value);
+
+    static const char NEGATIVE[] = "-1";
+    serdec_json_deserializer_reset(deser, NEGATIVE, strlen(NEGATIVE));
+    TEST_ASSERT_EQUAL_INT(SERDEC_JSON_OUT_OF_RANGE,
+        serdec_json_deserialize_uint64(deser, &unsigned_value));
+
+    static const char FRACTION[] = "1.0";
+    serdec_json_deserializer_reset(deser, FRACTION, strlen(FRACTION));
+    TEST_ASSERT_EQUAL_INT(SERDEC_JSON_WRONG_TYPE,
+        serdec_json_deserialize_int64(deser, &signed_value));
+
+    static const char* INVALID[] = {
+        "01", "-", "1.", "1e", "{\"a\" 1}", "{\"a\":1,}", "{1:1}",
+    };
+    for (size_t i = 0; i < sizeof(INVALID) / sizeof(INVALID[0]); ++i) {
+        Record read = {0};
+        serdec_json_deserializer_reset(deser, INVALID[i], strlen(INVALID[i]));
+        int result = '{' == *INVALID[i]
+            ? serdec_json_deserialize_map(deser, record_visit_map_entry, &read)
+            : serdec_json_deserialize_int64(deser, &signed_value);
+        TEST_ASSERT_EQUAL_INT(SERDEC_JSON_INVALID_SYNTAX, result);
+    }
+
+    TEST_ASSERT_NOT_NULL(serdec_json_deserializer_strerror(deser));
+    serdec_json_deserializer_free(deser);
+}
+
+TEST_GROUP_RUNNER(Json) {
+    RUN_TEST_CASE(Json, Encoding);
+    RUN_TEST_CASE(Json, Strings);
+    RUN_TEST_CASE(Json, Errors);
+}
+
+///////////////////////////////////////////////////////////////////////////////
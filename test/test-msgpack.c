@@ -0,0 +1,335 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            test-msgpack.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Unit tests of the MessagePack codec.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <serdec/msgpack.h>
+#include <serdec/msgpack-error.h>
+
+#include <unity_fixture.h>
+
+TEST_GROUP(Msgpack);
+TEST_SETUP(Msgpack) {}
+TEST_TEAR_DOWN(Msgpack) {}
+
+// {a: 1, b: [-1, -33, 200, 70000], s: 'hi', t: true, f: 1.5, d: 0.1}
+static const unsigned char RECORD_ENCODING[] = {
+    0x86,
+    0xa1, 'a', 0x01,
+    0xa1, 'b', 0x94, 0xff, 0xd0, 0xdf, 0xcc, 0xc8, 0xce, 0x00, 0x01, 0x11,
+    0x70,
+    0xa1, 's', 0xa2, 'h', 'i',
+    0xa1, 't', 0xc3,
+    0xa1, 'f', 0xca, 0x3f, 0xc0, 0x00, 0x00,
+    0xa1, 'd', 0xcb, 0x3f, 0xb9, 0x99, 0x99, 0x99, 0x99, 0x99, 0x9a,
+};
+
+typedef struct Record {
+    int a;
+    int64_t b[4];
+    size_t b_count;
+    const char* s;
+    size_t s_length;
+    bool t;
+    double f;
+    double d;
+} Record;
+
+static void serialize_record(SerdecMsgpackSerializer* ser,
+    const Record* record)
+{
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_map_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_map_key(ser, "a"));
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_int(ser, record->a));
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_map_key(ser, "b"));
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_list_start(ser));
+    for (size_t i = 0; i < record->b_count; ++i) {
+        TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_int64(ser,
+                record->b[i]));
+    }
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_list_end(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_map_key(ser, "s"));
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_string_n(ser, record->s,
+            record->s_length));
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_map_key(ser, "t"));
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_bool(ser, record->t));
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_map_key(ser, "f"));
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_double(ser, record->f));
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_map_key(ser, "d"));
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_double(ser, record->d));
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_map_end(ser));
+}
+
+static int record_visit_list_entry(SerdecMsgpackDeserializer* deser,
+    void* user_data, size_t index)
+{
+    Record* record = (Record*)user_data;
+    if (4 <= index) {
+        return 1;
+    }
+
+    record->b_count = index + 1;
+    return serdec_msgpack_deserialize_int64(deser, &record->b[index]);
+}
+
+static int record_visit_map_entry(SerdecMsgpackDeserializer* deser,
+    void* user_data, const char* key, size_t length)
+{
+    Record* record = (Record*)user_data;
+    if (1 != length) {
+        return serdec_msgpack_deserialize_skip(deser);
+    }
+
+    switch (*key) {
+    case 'a': return serdec_msgpack_deserialize_int(deser, &record->a);
+    case 'b':
+        return serdec_msgpack_deserialize_list(deser, record_visit_list_entry,
+            record);
+    case 's':
+        return serdec_msgpack_deserialize_string(deser, &record->s,
+            &record->s_length);
+    case 't': return serdec_msgpack_deserialize_bool(deser, &record->t);
+    case 'f': return serdec_msgpack_deserialize_double(deser, &record->f);
+    case 'd': return serdec_msgpack_deserialize_double(deser, &record->d);
+    default:
+        return serdec_msgpack_deserialize_skip(deser);
+    }
+}
+
+TEST(Msgpack, Encoding) {
+    Record record = {
+        .a = 1,
+        .b = {-1, -33, 200, 70000},
+        .b_count = 4,
+        .s = "hi",
+        .s_length = 2,
+        .t = true,
+        .f = 1.5,
+        .d = 0.1,
+    };
+
+    SerdecMsgpackSerializer* ser = serdec_msgpack_serializer_new();
+    TEST_ASSERT_NOT_NULL(ser);
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_start(ser));
+    serialize_record(ser, &record);
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_end(ser));
+
+    size_t length = 0;
+    const char* buffer = serdec_msgpack_serializer_borrow_buffer(ser, &length);
+    TEST_ASSERT_EQUAL_size_t(sizeof(RECORD_ENCODING), length);
+    TEST_ASSERT_EQUAL_MEMORY(RECORD_ENCODING, buffer, length);
+
+    // Strings are read in place.
+    Record read = {0};
+    SerdecMsgpackDeserializer* deser = serdec_msgpack_deserializer_new(buffer,
+        length);
+    TEST_ASSERT_NOT_NULL(deser);
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_deserialize_map(deser,
+            record_visit_map_entry, &read));
+    TEST_ASSERT_TRUE(serdec_msgpack_deserializer_at_end(deser));
+    TEST_ASSERT_EQUAL_INT(1, read.a);
+    TEST_ASSERT_EQUAL_size_t(4, read.b_count);
+    TEST_ASSERT_EQUAL_MEMORY(record.b, read.b, sizeof(record.b));
+    TEST_ASSERT_EQUAL_PTR(buffer + 20, read.s);
+    TEST_ASSERT_EQUAL_size_t(2, read.s_length);
+    TEST_ASSERT_TRUE(read.t);
+    TEST_ASSERT_EQUAL_DOUBLE(1.5, read.f);
+    TEST_ASSERT_EQUAL_DOUBLE(0.1, read.d);
+    serdec_msgpack_deserializer_free(deser);
+    serdec_msgpack_serializer_free(ser);
+}
+
+static int count_visit_list_entry(SerdecMsgpackDeserializer* deser,
+    void* user_data, size_t index)
+{
+    uint64_t value = 0;
+    if (serdec_msgpack_deserialize_uint64(deser, &value) || index != value) {
+        return 1;
+    }
+
+    *(size_t*)user_data += 1;
+    return 0;
+}
+
+TEST(Msgpack, Containers) {
+    // Each list gets the smallest header which holds its length: 1, 3 and 5
+    // bytes.
+    static const size_t LENGTHS[] = {15, 16, 65535, 65536};
+    static const unsigned char HEADERS[][5] = {
+        {0x9f},
+        {0xdc, 0x00, 0x10},
+        {0xdc, 0xff, 0xff},
+        {0xdd, 0x00, 0x01, 0x00, 0x00},
+    };
+    static const size_t HEADER_SIZES[] = {1, 3, 3, 5};
+
+    SerdecMsgpackSerializer* ser = serdec_msgpack_serializer_new();
+    SerdecMsgpackDeserializer* deser = serdec_msgpack_deserializer_new(NULL,
+        0);
+    for (size_t i = 0; i < sizeof(LENGTHS) / sizeof(LENGTHS[0]); ++i) {
+        serdec_msgpack_serializer_reset(ser);
+        TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_start(ser));
+        TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_list_start(ser));
+        for (size_t j = 0; j < LENGTHS[i]; ++j) {
+            TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_size_t(ser, j));
+        }
+        TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_list_end(ser));
+        TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_end(ser));
+
+        size_t length = 0;
+        const char* buffer = serdec_msgpack_serializer_borrow_buffer(ser,
+            &length);
+        TEST_ASSERT_EQUAL_MEMORY(HEADERS[i], buffer, HEADER_SIZES[i]);
+
+        size_t count = 0;
+        serdec_msgpack_deserializer_reset(deser, buffer, length);
+        TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_deserialize_list(deser,
+                count_visit_list_entry, &count));
+        TEST_ASSERT_EQUAL_size_t(LENGTHS[i], count);
+        TEST_ASSERT_TRUE(serdec_msgpack_deserializer_at_end(deser));
+    }
+
+    // Nested containers are shrunk too, and several values may follow one
+    // another.
+    serdec_msgpack_serializer_reset(ser);
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_list_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_map_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_map_end(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_list_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_list_end(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_list_end(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_string(ser, "x"));
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_end(ser));
+    size_t length = 0;
+    char* buffer = serdec_msgpack_serializer_take_buffer(ser, &length);
+    static const unsigned char NESTED[] = {0x92, 0x80, 0x90, 0xa1, 'x'};
+    TEST_ASSERT_EQUAL_size_t(sizeof(NESTED), length);
+    TEST_ASSERT_EQUAL_MEMORY(NESTED, buffer, length);
+
+    serdec_msgpack_deserializer_reset(deser, buffer, length);
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_deserialize_skip(deser));
+    const char* string = NULL;
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_deserialize_string(deser, &string,
+            NULL));
+    TEST_ASSERT_EQUAL_PTR(buffer + 4, string);
+    TEST_ASSERT_TRUE(serdec_msgpack_deserializer_at_end(deser));
+    free(buffer);
+    serdec_msgpack_deserializer_free(deser);
+    serdec_msgpack_serializer_free(ser);
+}
+
+static int failing_visit_map_entry(SerdecMsgpackDeserializer* deser,
+    void* user_data, const char* key, size_t length)
+{
+    (void)deser;
+    (void)user_data;
+    (void)key;
+    (void)length;
+    return 1;
+}
+
+TEST(Msgpack, Errors) {
+    // Values must be where the container expects them
+    SerdecMsgpackSerializer* ser = serdec_msgpack_serializer_new();
+    TEST_ASSERT_EQUAL_INT(SERDEC_MSGPACK_UNEXPECTED_EVENT,
+        serdec_msgpack_serialize_int(ser, 1));
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_map_start(ser));
+    TEST_ASSERT_EQUAL_INT(SERDEC_MSGPACK_UNEXPECTED_EVENT,
+        serdec_msgpack_serialize_int(ser, 1));
+    TEST_ASSERT_EQUAL_INT(SERDEC_MSGPACK_UNEXPECTED_EVENT,
+        serdec_msgpack_serialize_list_end(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_serialize_map_key(ser, "a"));
+    TEST_ASSERT_EQUAL_INT(SERDEC_MSGPACK_UNEXPECTED_EVENT,
+        serdec_msgpack_serialize_map_end(ser));
+    TEST_ASSERT_EQUAL_INT(SERDEC_MSGPACK_UNEXPECTED_EVENT,
+        serdec_msgpack_serialize_end(ser));
+    TEST_ASSERT_NOT_NULL(serdec_msgpack_serializer_strerror(ser));
+    serdec_msgpack_serializer_free(ser);
+
+    // Every truncation of a value is detected
+    for (size_t i = 0; i < sizeof(RECORD_ENCODING); ++i) {
+        Record read = {0};
+        SerdecMsgpackDeserializer* deser = serdec_msgpack_deserializer_new(
+            RECORD_ENCODING, i);
+        TEST_ASSERT_NOT_EQUAL(0, serdec_msgpack_deserialize_map(deser,
+                record_visit_map_entry, &read));
+        serdec_msgpack_deserializer_reset(deser, RECORD_ENCODING, i);
+        TEST_ASSERT_EQUAL_INT(SERDEC_MSGPACK_END_OF_INPUT,
+            serdec_msgpack_deserialize_skip(deser));
+        serdec_msgpack_deserializer_free(deser);
+    }
+
+    static const unsigned char LARGE[] = {0xcf, 0x80, 0, 0, 0, 0, 0, 0, 0};
+    SerdecMsgpackDeserializer* deser = serdec_msgpack_deserializer_new(LARGE,
+        sizeof(LARGE));
+    int64_t signed_value = 0;
+    uint64_t unsigned_value = 0;
+    bool boolean = false;
+    TEST_ASSERT_EQUAL_INT(SERDEC_MSGPACK_OUT_OF_RANGE,
+        serdec_msgpack_deserialize_int64(deser, &signed_value));
+    serdec_msgpack_deserializer_reset(deser, LARGE, sizeof(LARGE));
+    TEST_ASSERT_EQUAL_INT(SERDEC_MSGPACK_WRONG_TYPE,
+        serdec_msgpack_deserialize_bool(deser, &boolean));
+
+    // A value which is of the wrong type is not consumed.
+    TEST_ASSERT_EQUAL_INT(0, serdec_msgpack_deserialize_uint64(deser,
+            &unsigned_value));
+    TEST_ASSERT_EQUAL_UINT64(UINT64_C(1) << 63, unsigned_value);
+
+    static const unsigned char NEGATIVE[] = {0xd0, 0x80};
+    serdec_msgpack_deserializer_reset(deser, NEGATIVE, sizeof(NEGATIVE));
+    TEST_ASSERT_EQUAL_INT(SERDEC_MSGPACK_OUT_OF_RANGE,
+        serdec_msgpack_deserialize_uint64(deser, &unsigned_value));
+
+    static const unsigned char RESERVED[] = {0xc1};
+    serdec_msgpack_deserializer_reset(deser, RESERVED, sizeof(RESERVED));
+    TEST_ASSERT_EQUAL_INT(SERDEC_MSGPACK_INVALID_FORMAT,
+        serdec_msgpack_deserialize_skip(deser));
+
+    serdec_msgpack_deserializer_reset(deser, RECORD_ENCODING,
+        sizeof(RECORD_ENCODING));
+    TEST_ASSERT_EQUAL_INT(SERDEC_MSGPACK_CALLBACK_SIGNALED_ERROR,
+        serdec_msgpack_deserialize_map(deser, failing_visit_map_entry, NULL));
+    TEST_ASSERT_NOT_NULL(serdec_msgpack_deserializer_strerror(deser));
+    serdec_msgpack_deserializer_free(deser);
+}
+
+TEST_GROUP_RUNNER(Msgpack) {
+    RUN_TEST_CASE(Msgpack, Encoding);
+    RUN_TEST_CASE(Msgpack, Containers);
+    RUN_TEST_CASE(Msgpack, Errors);
+}
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,110 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            test-structural-index.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Tests for the structural index
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <serdec/structural-index.h>
+
+#include <unity_fixture.h>
+
+TEST_GROUP(StructuralIndex);
+TEST_SETUP(StructuralIndex) {}
+TEST_TEAR_DOWN(StructuralIndex) {}
+
+// Every byte which the scanner stops at must be a candidate.
+static bool is_structural(unsigned char c) {
+    return '\0' != c && NULL != strchr("\n\r\"#',:[\\]{}", c);
+}
+
+// The candidates are the structural bytes, and the bytes which differ from
+// them only in bit 5.
+static bool is_candidate(unsigned char c) {
+    return '\n' == c || '\r' == c || NULL != memchr("\"#',:{|}", c | 0x20, 8);
+}
+
+static const StructuralKernel KERNELS[] = {
+    STRUCTURAL_KERNEL_BEST,
+    STRUCTURAL_KERNEL_SCALAR,
+    STRUCTURAL_KERNEL_SSE2,
+    STRUCTURAL_KERNEL_AVX2,
+    STRUCTURAL_KERNEL_NEON,
+};
+
+TEST(StructuralIndex, Kernels) {
+    // Random input which is dense in structural characters, and lengths
+    // which end part-way through a block.
+    static const char alphabet[] = "ab -:#'\"\\\n\r,[]{}|\t\x0c\x1a\xff";
+    static char input[1000];
+    srand(2026);
+    for (size_t i = 0; i < sizeof(input); ++i) {
+        input[i] = alphabet[rand() % (sizeof(alphabet) - 1)];
+    }
+
+    StructuralIndex index;
+    structural_index_init(&index, NULL);
+    size_t lengths[] = {0, 1, 63, 64, 65, 640, 1000};
+    for (size_t k = 0; k < sizeof(KERNELS) / sizeof(*KERNELS); ++k) {
+        if (!structural_index_supports(KERNELS[k])) {
+            continue;
+        }
+
+        for (size_t l = 0; l < sizeof(lengths) / sizeof(*lengths); ++l) {
+            size_t length = lengths[l];
+            TEST_ASSERT_EQUAL_INT(0, structural_index_build(&index, input,
+                    length, KERNELS[k]));
+
+            size_t expected = length;
+            for (size_t offset = length + 1; offset-- > 0;) {
+                if (offset < length && is_candidate(input[offset])) {
+                    expected = offset;
+                }
+                TEST_ASSERT(offset >= length
+                    || !is_structural(input[offset]) || expected == offset);
+                TEST_ASSERT_EQUAL_size_t(expected,
+                    structural_index_next(&index, offset));
+            }
+        }
+    }
+
+    // The scalar fallback is always available.
+    TEST_ASSERT(structural_index_supports(STRUCTURAL_KERNEL_SCALAR));
+    structural_index_clear(&index);
+    TEST_ASSERT_EQUAL_size_t(0, structural_index_next(&index, 0));
+    structural_index_release(&index);
+}
+
+TEST_GROUP_RUNNER(StructuralIndex) {
+    RUN_TEST_CASE(StructuralIndex, Kernels);
+}
+
+///////////////////////////////////////////////////////////////////////////////
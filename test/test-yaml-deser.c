@@ -7,7 +7,7 @@
 //
 // CREATED:         12/20/2021
 //
-// LAST EDITED:     02/06/2022
+// LAST EDITED:     10/14/2026
 //
 // Copyright 2021, Ethan D. Twardy
 //
@@ -31,15 +31,23 @@
 ////
 
 #include <errno.h>
+#include <limits.h>
+#include <math.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
 #include <serdec/yaml.h>
+#include <serdec/yaml-error.h>
 
 #include <unity_fixture.h>
 
 #include "my-struct.h"
 
+#define PARALLEL_DOCUMENTS 200
+
 TEST_GROUP(YamlDeser);
 TEST_SETUP(YamlDeser) {}
 TEST_TEAR_DOWN(YamlDeser) {}
@@ -112,8 +120,987 @@ TEST(YamlDeser, BasicDocument) {
     serdec_yaml_deserializer_free(deser);
 }
 
+typedef struct Numbers {
+    int an_int;
+    int64_t an_int64;
+    uint64_t a_uint64;
+    size_t a_size;
+    double a_double;
+    double an_infinity;
+} Numbers;
+
+static int numbers_visit_map_entry(SerdecYamlDeserializer* deser,
+    void* user_data, const char* key)
+{
+    Numbers* numbers = (Numbers*)user_data;
+    if (!strcmp(key, "int")) {
+        return serdec_yaml_deserialize_int(deser, &numbers->an_int);
+    } else if (!strcmp(key, "int64")) {
+        return serdec_yaml_deserialize_int64(deser, &numbers->an_int64);
+    } else if (!strcmp(key, "uint64")) {
+        return serdec_yaml_deserialize_uint64(deser, &numbers->a_uint64);
+    } else if (!strcmp(key, "size")) {
+        return serdec_yaml_deserialize_size_t(deser, &numbers->a_size);
+    } else if (!strcmp(key, "double")) {
+        return serdec_yaml_deserialize_double(deser, &numbers->a_double);
+    } else if (!strcmp(key, "infinity")) {
+        return serdec_yaml_deserialize_double(deser, &numbers->an_infinity);
+    }
+    return 1;
+}
+
+static const char* NUMBERS_DOCUMENT = "\
+int: -2147483648\n\
+int64: -9223372036854775808\n\
+uint64: 18446744073709551615\n\
+size: 42\n\
+double: 0.1\n\
+infinity: -.inf\n\
+";
+
+TEST(YamlDeser, Numbers) {
+    SerdecYamlDeserializer* deser = serdec_yaml_deserializer_new_string(
+        NUMBERS_DOCUMENT, strlen(NUMBERS_DOCUMENT));
+    TEST_ASSERT_NOT_NULL(deser);
+    Numbers numbers = {0};
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserialize_map(deser,
+            numbers_visit_map_entry, &numbers));
+    TEST_ASSERT_EQUAL_INT(INT_MIN, numbers.an_int);
+    TEST_ASSERT(INT64_MIN == numbers.an_int64);
+    TEST_ASSERT(UINT64_MAX == numbers.a_uint64);
+    TEST_ASSERT_EQUAL_INT(42, numbers.a_size);
+    TEST_ASSERT(0.1 == numbers.a_double);
+    TEST_ASSERT(-INFINITY == numbers.an_infinity);
+    serdec_yaml_deserializer_free(deser);
+
+    const char* too_big = "2147483648";
+    deser = serdec_yaml_deserializer_new_string(too_big, strlen(too_big));
+    TEST_ASSERT_NOT_NULL(deser);
+    int value = 0;
+    TEST_ASSERT_EQUAL_INT(SERDEC_YAML_OUT_OF_RANGE,
+        serdec_yaml_deserialize_int(deser, &value));
+    serdec_yaml_deserializer_free(deser);
+
+    const char* not_a_number = "12abc";
+    deser = serdec_yaml_deserializer_new_string(not_a_number,
+        strlen(not_a_number));
+    TEST_ASSERT_NOT_NULL(deser);
+    TEST_ASSERT_EQUAL_INT(SERDEC_YAML_INVALID_NUMBER,
+        serdec_yaml_deserialize_int(deser, &value));
+    serdec_yaml_deserializer_free(deser);
+}
+
+static int skip_visit_map_entry(SerdecYamlDeserializer* deser,
+    void* user_data, const char* key)
+{
+    int* value = (int*)user_data;
+    if (!strcmp(key, "wanted")) {
+        return serdec_yaml_deserialize_int(deser, value);
+    }
+    return serdec_yaml_deserialize_skip(deser);
+}
+
+static const char* SKIP_DOCUMENT = "\
+before: 'a scalar'\n\
+nested:\n\
+    map:\n\
+        - 1\n\
+        - [2, 3, {four: 4}]\n\
+    empty: {}\n\
+wanted: 7\n\
+after:\n\
+    - key: value\n\
+";
+
+TEST(YamlDeser, Skip) {
+    SerdecYamlDeserializer* deser = serdec_yaml_deserializer_new_string(
+        SKIP_DOCUMENT, strlen(SKIP_DOCUMENT));
+    TEST_ASSERT_NOT_NULL(deser);
+    int wanted = 0;
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserialize_map(deser,
+            skip_visit_map_entry, &wanted));
+    TEST_ASSERT_EQUAL_INT(7, wanted);
+    serdec_yaml_deserializer_free(deser);
+
+    // There is nothing left to skip once the document has been consumed.
+    const char* empty = "[]";
+    deser = serdec_yaml_deserializer_new_string(empty, strlen(empty));
+    TEST_ASSERT_NOT_NULL(deser);
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserialize_skip(deser));
+    TEST_ASSERT_EQUAL_INT(SERDEC_YAML_UNEXPECTED_EVENT,
+        serdec_yaml_deserialize_skip(deser));
+    serdec_yaml_deserializer_free(deser);
+}
+
+static int my_struct_visit_test(SerdecYamlDeserializer* deser,
+    void* user_data, size_t index)
+{
+    (void)index;
+    return serdec_yaml_deserialize_bool(deser, &((MyStruct*)user_data)->test);
+}
+
+static int my_struct_visit_a_number(SerdecYamlDeserializer* deser,
+    void* user_data, size_t index)
+{
+    (void)index;
+    return serdec_yaml_deserialize_int(deser,
+        &((MyStruct*)user_data)->a_number);
+}
+
+static int my_struct_visit_list_of_four(SerdecYamlDeserializer* deser,
+    void* user_data, size_t index)
+{
+    (void)index;
+    return serdec_yaml_deserialize_list(deser, my_struct_visit_list_entry,
+        user_data);
+}
+
+static const SerdecYamlField MY_STRUCT_FIELDS[] = {
+    {"test", my_struct_visit_test},
+    {"a_number", my_struct_visit_a_number},
+    {"list_of_four", my_struct_visit_list_of_four},
+};
+
+// Every field has the same callback, which checks that it was dispatched with
+// the right index by reading it back from the document.
+static int visit_numbered_field(SerdecYamlDeserializer* deser,
+    void* user_data, size_t index)
+{
+    size_t value = 0;
+    if (serdec_yaml_deserialize_size_t(deser, &value) || value != index) {
+        return 1;
+    }
+    ++*(size_t*)user_data;
+    return 0;
+}
+
+#define NUMBERED_FIELDS 300
+
+TEST(YamlDeser, FieldTable) {
+    SerdecYamlFieldTable* table = serdec_yaml_field_table_new(
+        MY_STRUCT_FIELDS, sizeof(MY_STRUCT_FIELDS) / sizeof(*MY_STRUCT_FIELDS),
+        true);
+    TEST_ASSERT_NOT_NULL(table);
+    SerdecYamlDeserializer* deser = serdec_yaml_deserializer_new_string(
+        DOCUMENT, strlen(DOCUMENT));
+    TEST_ASSERT_NOT_NULL(deser);
+    MyStruct my_struct = {0};
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserialize_map_table(deser, table,
+            &my_struct));
+    TEST_ASSERT(true == my_struct.test);
+    TEST_ASSERT_EQUAL_INT(1, my_struct.a_number);
+    TEST_ASSERT_EQUAL_INT(4, my_struct.list_of_four[3]);
+    serdec_yaml_deserializer_free(deser);
+    serdec_yaml_field_table_free(table);
+
+    // Without skipping, a_string is an unknown key.
+    table = serdec_yaml_field_table_new(MY_STRUCT_FIELDS,
+        sizeof(MY_STRUCT_FIELDS) / sizeof(*MY_STRUCT_FIELDS), false);
+    TEST_ASSERT_NOT_NULL(table);
+    deser = serdec_yaml_deserializer_new_string(DOCUMENT, strlen(DOCUMENT));
+    TEST_ASSERT_NOT_NULL(deser);
+    TEST_ASSERT_EQUAL_INT(SERDEC_YAML_UNKNOWN_KEY,
+        serdec_yaml_deserialize_map_table(deser, table, &my_struct));
+    serdec_yaml_deserializer_free(deser);
+    serdec_yaml_field_table_free(table);
+
+    // Duplicate keys can't be dispatched.
+    const SerdecYamlField duplicates[] = {
+        {"test", my_struct_visit_test},
+        {"test", my_struct_visit_test},
+    };
+    TEST_ASSERT_NULL(serdec_yaml_field_table_new(duplicates, 2, true));
+
+    // A wide table, with a document containing every key in reverse order.
+    static char keys[NUMBERED_FIELDS][16];
+    static SerdecYamlField fields[NUMBERED_FIELDS];
+    static char document[NUMBERED_FIELDS * 32];
+    size_t length = 0;
+    for (size_t i = 0; i < NUMBERED_FIELDS; ++i) {
+        snprintf(keys[i], sizeof(keys[i]), "field_%zu", i);
+        fields[i].key = keys[i];
+        fields[i].callback = visit_numbered_field;
+        size_t reverse = NUMBERED_FIELDS - i - 1;
+        length += snprintf(document + length, sizeof(document) - length,
+            "field_%zu: %zu\n", reverse, reverse);
+    }
+
+    table = serdec_yaml_field_table_new(fields, NUMBERED_FIELDS, false);
+    TEST_ASSERT_NOT_NULL(table);
+    deser = serdec_yaml_deserializer_new_string(document, length);
+    TEST_ASSERT_NOT_NULL(deser);
+    size_t visited = 0;
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserialize_map_table(deser, table,
+            &visited));
+    TEST_ASSERT_EQUAL_size_t(NUMBERED_FIELDS, visited);
+    serdec_yaml_deserializer_free(deser);
+    serdec_yaml_field_table_free(table);
+}
+
+static const char* STRUCT_DOCUMENT = "\
+test: true\n\
+a_number: 1\n\
+unknown: {skipped: [1, 2]}\n\
+a_string: 'test'\n\
+list_of_four: [1, 2, 3, 4]\n\
+my_inner:\n\
+    my_value: 4\n\
+";
+
+TEST(YamlDeser, StructDescriptor) {
+    SerdecYamlType* type = serdec_yaml_type_new(&MY_STRUCT_TYPE);
+    TEST_ASSERT_NOT_NULL(type);
+    SerdecYamlDeserializer* deser = serdec_yaml_deserializer_new_string(
+        STRUCT_DOCUMENT, strlen(STRUCT_DOCUMENT));
+    TEST_ASSERT_NOT_NULL(deser);
+    MyStruct my_struct = {0};
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserialize_struct(deser, type,
+            &my_struct));
+    TEST_ASSERT(true == my_struct.test);
+    TEST_ASSERT_EQUAL_INT(1, my_struct.a_number);
+    TEST_ASSERT_EQUAL_STRING("test", my_struct.a_string);
+    for (int i = 0; i < 4; ++i) {
+        TEST_ASSERT_EQUAL_INT(i + 1, my_struct.list_of_four[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(4, my_struct.my_inner.my_value);
+    serdec_yaml_type_release(type, &my_struct);
+    TEST_ASSERT_NULL(my_struct.a_string);
+    serdec_yaml_deserializer_free(deser);
+
+    // Arrays can't hold more elements than their length.
+    const char* too_long = "list_of_four: [1, 2, 3, 4, 5]";
+    deser = serdec_yaml_deserializer_new_string(too_long, strlen(too_long));
+    TEST_ASSERT_NOT_NULL(deser);
+    TEST_ASSERT_EQUAL_INT(SERDEC_YAML_OUT_OF_RANGE,
+        serdec_yaml_deserialize_struct(deser, type, &my_struct));
+    serdec_yaml_deserializer_free(deser);
+    serdec_yaml_type_free(type);
+
+    // InnerStruct doesn't skip unknown keys.
+    type = serdec_yaml_type_new(&INNER_STRUCT_TYPE);
+    TEST_ASSERT_NOT_NULL(type);
+    const char* unknown = "my_value: 1\nother: 2\n";
+    deser = serdec_yaml_deserializer_new_string(unknown, strlen(unknown));
+    TEST_ASSERT_NOT_NULL(deser);
+    TEST_ASSERT_EQUAL_INT(SERDEC_YAML_UNKNOWN_KEY,
+        serdec_yaml_deserialize_struct(deser, type, &my_struct.my_inner));
+    serdec_yaml_deserializer_free(deser);
+    serdec_yaml_type_free(type);
+}
+
+typedef struct ArenaStrings {
+    SerdecArena* arena;
+    const char* values[2];
+    size_t lengths[2];
+} ArenaStrings;
+
+static int arena_strings_visit_list_entry(SerdecYamlDeserializer* deser,
+    void* user_data, size_t index)
+{
+    ArenaStrings* strings = (ArenaStrings*)user_data;
+    if (2 <= index) {
+        return 1;
+    }
+    return serdec_yaml_deserialize_string_arena(deser, strings->arena,
+        &strings->values[index], &strings->lengths[index]);
+}
+
+TEST(YamlDeser, Arena) {
+    SerdecArena* arena = serdec_arena_new(0);
+    TEST_ASSERT_NOT_NULL(arena);
+    SerdecYamlType* type = serdec_yaml_type_new(&MY_STRUCT_TYPE);
+    TEST_ASSERT_NOT_NULL(type);
+
+    // Struct strings come from the arena, and outlive the de-serializer.
+    SerdecYamlDeserializer* deser = serdec_yaml_deserializer_new_string(
+        STRUCT_DOCUMENT, strlen(STRUCT_DOCUMENT));
+    TEST_ASSERT_NOT_NULL(deser);
+    serdec_yaml_deserializer_set_arena(deser, arena);
+    MyStruct my_struct = {0};
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserialize_struct(deser, type,
+            &my_struct));
+    serdec_yaml_deserializer_free(deser);
+    TEST_ASSERT_EQUAL_STRING("test", my_struct.a_string);
+
+    // Strings copied into the arena outlive the de-serializer, too.
+    const char* list = "[first, second]";
+    deser = serdec_yaml_deserializer_new_string(list, strlen(list));
+    TEST_ASSERT_NOT_NULL(deser);
+    ArenaStrings strings = {.arena = arena};
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserialize_list(deser,
+            arena_strings_visit_list_entry, &strings));
+    serdec_yaml_deserializer_free(deser);
+    TEST_ASSERT_EQUAL_STRING("first", strings.values[0]);
+    TEST_ASSERT_EQUAL_STRING("second", strings.values[1]);
+    TEST_ASSERT_EQUAL_size_t(6, strings.lengths[1]);
+
+    serdec_yaml_type_free(type);
+    serdec_arena_free(arena);
+}
+
+#define VECTOR_LENGTH 100000
+
+TEST(YamlDeser, Arrays) {
+    const char* ints = "[1, -2, 3]";
+    SerdecYamlDeserializer* deser = serdec_yaml_deserializer_new_string(ints,
+        strlen(ints));
+    TEST_ASSERT_NOT_NULL(deser);
+    int int_values[4] = {0};
+    size_t count = 0;
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserialize_int_array(deser,
+            int_values, 4, &count));
+    TEST_ASSERT_EQUAL_size_t(3, count);
+    TEST_ASSERT_EQUAL_INT(-2, int_values[1]);
+    serdec_yaml_deserializer_free(deser);
+
+    // The array must be large enough for the whole list.
+    deser = serdec_yaml_deserializer_new_string(ints, strlen(ints));
+    TEST_ASSERT_NOT_NULL(deser);
+    TEST_ASSERT_EQUAL_INT(SERDEC_YAML_OUT_OF_RANGE,
+        serdec_yaml_deserialize_int_array(deser, int_values, 2, &count));
+    serdec_yaml_deserializer_free(deser);
+
+    const char* doubles = "- 0.5\n- 1e3\n- -.inf\n";
+    deser = serdec_yaml_deserializer_new_string(doubles, strlen(doubles));
+    TEST_ASSERT_NOT_NULL(deser);
+    double double_values[3] = {0};
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserialize_double_array(deser,
+            double_values, 3, &count));
+    TEST_ASSERT_EQUAL_size_t(3, count);
+    TEST_ASSERT(0.5 == double_values[0]);
+    TEST_ASSERT(1000.0 == double_values[1]);
+    TEST_ASSERT(-INFINITY == double_values[2]);
+    serdec_yaml_deserializer_free(deser);
+
+    const char* bools = "[true, false, yes]";
+    deser = serdec_yaml_deserializer_new_string(bools, strlen(bools));
+    TEST_ASSERT_NOT_NULL(deser);
+    bool* bool_values = NULL;
+    TEST_ASSERT_EQUAL_INT(SERDEC_YAML_INVALID_BOOLEAN_TOKEN,
+        serdec_yaml_deserialize_bool_vector(deser, &bool_values, &count));
+    TEST_ASSERT_NULL(bool_values);
+    serdec_yaml_deserializer_free(deser);
+
+    // A long list, which the vector grows to fit.
+    static char document[VECTOR_LENGTH * 16];
+    size_t length = 0;
+    for (size_t i = 0; i < VECTOR_LENGTH; ++i) {
+        length += snprintf(document + length, sizeof(document) - length,
+            "- %zu\n", i * 1000003);
+    }
+
+    deser = serdec_yaml_deserializer_new_string(document, length);
+    TEST_ASSERT_NOT_NULL(deser);
+    int64_t* int64_values = NULL;
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserialize_int64_vector(deser,
+            &int64_values, &count));
+    TEST_ASSERT_EQUAL_size_t(VECTOR_LENGTH, count);
+    for (size_t i = 0; i < VECTOR_LENGTH; ++i) {
+        TEST_ASSERT(int64_values[i] == (int64_t)(i * 1000003));
+    }
+    free(int64_values);
+    serdec_yaml_deserializer_free(deser);
+
+    // Empty lists produce no vector at all.
+    const char* empty = "[]";
+    deser = serdec_yaml_deserializer_new_string(empty, strlen(empty));
+    TEST_ASSERT_NOT_NULL(deser);
+    int* vector = &int_values[0];
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserialize_int_vector(deser,
+            &vector, &count));
+    TEST_ASSERT_NULL(vector);
+    TEST_ASSERT_EQUAL_size_t(0, count);
+    serdec_yaml_deserializer_free(deser);
+}
+
+TEST(YamlDeser, Reset) {
+    // The first input is abandoned part-way through, with a tag directive in
+    // effect.
+    const char* partial = "%TAG !e! tag:example.com,2026:\n--- {a: [1, 2";
+    SerdecYamlDeserializer* deser = serdec_yaml_deserializer_new_string(
+        partial, strlen(partial));
+    TEST_ASSERT_NOT_NULL(deser);
+    TEST_ASSERT_NOT_EQUAL(0, serdec_yaml_deserialize_skip(deser));
+
+    MyStruct my_struct = {0};
+
+    for (int i = 0; i < 2; ++i) {
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserializer_reset_string(deser,
+                DOCUMENT, strlen(DOCUMENT)));
+        memset(&my_struct, 0, sizeof(my_struct));
+        TEST_ASSERT_EQUAL_INT(0, my_struct_deserialize_yaml(deser,
+                &my_struct));
+        TEST_ASSERT(1 == my_struct.a_number);
+        TEST_ASSERT(4 == my_struct.list_of_four[3]);
+        TEST_ASSERT_EQUAL_STRING("test", my_struct.a_string);
+        free(my_struct.a_string);
+    }
+
+    // Errors in the new input are reported by the reset.
+    const char* invalid = "%YAML 1.1\n%YAML 1.1\n---\n";
+    TEST_ASSERT_NOT_EQUAL(0, serdec_yaml_deserializer_reset_string(deser,
+            invalid, strlen(invalid)));
+    serdec_yaml_deserializer_free(deser);
+}
+
+TEST(YamlDeser, MultipleDocuments) {
+    // The second document is skipped without being de-serialized.
+    const char* stream = "\
+--- {a_number: 1}\n\
+--- [1, {a: b}]\n\
+...\n\
+%YAML 1.1\n\
+---\n\
+a_number: 3\n\
+";
+    SerdecYamlDeserializer* deser = serdec_yaml_deserializer_new_string(
+        stream, strlen(stream));
+    TEST_ASSERT_NOT_NULL(deser);
+    MyStruct my_struct = {0};
+    TEST_ASSERT_EQUAL_INT(0, my_struct_deserialize_yaml(deser, &my_struct));
+    TEST_ASSERT_EQUAL_INT(1, my_struct.a_number);
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserializer_next_document(deser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserializer_next_document(deser));
+    TEST_ASSERT_EQUAL_INT(0, my_struct_deserialize_yaml(deser, &my_struct));
+    TEST_ASSERT_EQUAL_INT(3, my_struct.a_number);
+
+    // The end of the stream is reported for as long as it's asked for.
+    TEST_ASSERT_EQUAL_INT(SERDEC_YAML_END_OF_STREAM,
+        serdec_yaml_deserializer_next_document(deser));
+    TEST_ASSERT_EQUAL_INT(SERDEC_YAML_END_OF_STREAM,
+        serdec_yaml_deserializer_next_document(deser));
+    serdec_yaml_deserializer_free(deser);
+}
+
+static void check_path(const char* path) {
+    SerdecYamlDeserializer* deser = serdec_yaml_deserializer_new_path(path);
+    TEST_ASSERT_NOT_NULL(deser);
+    MyStruct my_struct = {0};
+    TEST_ASSERT_EQUAL_INT(0, my_struct_deserialize_yaml(deser, &my_struct));
+    TEST_ASSERT(4 == my_struct.list_of_four[3]);
+    TEST_ASSERT_EQUAL_STRING("test", my_struct.a_string);
+    free(my_struct.a_string);
+    serdec_yaml_deserializer_free(deser);
+}
+
+TEST(YamlDeser, Path) {
+    // Regular files are mapped.
+    char path[] = "/tmp/serdec-test-XXXXXX";
+    int fd = mkstemp(path);
+    TEST_ASSERT(0 <= fd);
+    size_t length = strlen(DOCUMENT);
+    TEST_ASSERT_EQUAL_INT(length, write(fd, DOCUMENT, length));
+    close(fd);
+    check_path(path);
+    unlink(path);
+
+    // Pipes are read with stdio.
+    int pipe_fds[2] = {0};
+    TEST_ASSERT_EQUAL_INT(0, pipe(pipe_fds));
+    TEST_ASSERT_EQUAL_INT(length, write(pipe_fds[1], DOCUMENT, length));
+    close(pipe_fds[1]);
+    char pipe_path[64] = {0};
+    snprintf(pipe_path, sizeof(pipe_path), "/dev/fd/%d", pipe_fds[0]);
+    check_path(pipe_path);
+    close(pipe_fds[0]);
+
+    errno = 0;
+    TEST_ASSERT_NULL(serdec_yaml_deserializer_new_path(path));
+    TEST_ASSERT_EQUAL_INT(ENOENT, errno);
+}
+
+TEST(YamlDeser, Push) {
+    const char* stream = "\
+# A stream of three documents.\n\
+--- {a_number: 1}\n\
+...\n\
+%YAML 1.1\n\
+---\n\
+a_number: 2\n\
+a_string: '---'\n\
+---\n\
+a_number: 3\n\
+# The end.\n\
+";
+
+    // Whatever the size of the chunks, each document is de-serialized once
+    // it's complete.
+    size_t chunk_sizes[] = {1, 7, 4096};
+    for (size_t i = 0; i < sizeof(chunk_sizes) / sizeof(*chunk_sizes); ++i) {
+        SerdecYamlDeserializer* deser = serdec_yaml_deserializer_new_push();
+        TEST_ASSERT_NOT_NULL(deser);
+
+        int numbers = 0;
+        int status = SERDEC_YAML_NEED_MORE_DATA;
+        size_t length = strlen(stream);
+        size_t offset = 0;
+        while (SERDEC_YAML_END_OF_STREAM != status) {
+            if (SERDEC_YAML_NEED_MORE_DATA == status && offset < length) {
+                size_t chunk = chunk_sizes[i] < length - offset
+                    ? chunk_sizes[i] : length - offset;
+                status = serdec_yaml_deserializer_feed(deser, stream + offset,
+                    chunk);
+                offset += chunk;
+            } else if (SERDEC_YAML_NEED_MORE_DATA == status) {
+                status = serdec_yaml_deserializer_feed_end(deser);
+            } else {
+                TEST_ASSERT_EQUAL_INT(0, status);
+                MyStruct my_struct = {0};
+                TEST_ASSERT_EQUAL_INT(0, my_struct_deserialize_yaml(deser,
+                        &my_struct));
+                TEST_ASSERT_EQUAL_INT(++numbers, my_struct.a_number);
+                if (2 == numbers) {
+                    TEST_ASSERT_EQUAL_STRING("---", my_struct.a_string);
+                }
+                free(my_struct.a_string);
+                status = serdec_yaml_deserializer_next_document(deser);
+            }
+        }
+
+        TEST_ASSERT_EQUAL_INT(3, numbers);
+        TEST_ASSERT_EQUAL_INT(SERDEC_YAML_INVALID_STATE,
+            serdec_yaml_deserializer_feed(deser, "a", 1));
+        serdec_yaml_deserializer_free(deser);
+    }
+
+    // Only push de-serializers can be fed.
+    SerdecYamlDeserializer* deser = serdec_yaml_deserializer_new_string(
+        DOCUMENT, strlen(DOCUMENT));
+    TEST_ASSERT_NOT_NULL(deser);
+    TEST_ASSERT_EQUAL_INT(SERDEC_YAML_WRONG_TYPE,
+        serdec_yaml_deserializer_feed(deser, "a", 1));
+    serdec_yaml_deserializer_free(deser);
+}
+
+static int long_key_visit_map_entry(SerdecYamlDeserializer* deser,
+    void* user_data, const char* key)
+{
+    *(size_t*)user_data = strlen(key);
+    return serdec_yaml_deserialize_skip(deser);
+}
+
+TEST(YamlDeser, NativeBackend) {
+    SerdecYamlDeserializerOptions options = {
+        .backend = SERDEC_YAML_BACKEND_NATIVE,
+    };
+    SerdecYamlDeserializer* deser =
+        serdec_yaml_deserializer_new_string_with_options(DOCUMENT,
+            strlen(DOCUMENT), &options);
+    TEST_ASSERT_NOT_NULL(deser);
+    MyStruct my_struct = {0};
+    TEST_ASSERT_EQUAL_INT(0, my_struct_deserialize_yaml(deser, &my_struct));
+    TEST_ASSERT(true == my_struct.test);
+    TEST_ASSERT(4 == my_struct.list_of_four[3]);
+    TEST_ASSERT_EQUAL_STRING("test", my_struct.a_string);
+    free(my_struct.a_string);
+
+    // Struct descriptors, and escaped strings.
+    SerdecYamlType* type = serdec_yaml_type_new(&MY_STRUCT_TYPE);
+    TEST_ASSERT_NOT_NULL(type);
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserializer_reset_string(deser,
+            STRUCT_DOCUMENT, strlen(STRUCT_DOCUMENT)));
+    memset(&my_struct, 0, sizeof(my_struct));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserialize_struct(deser, type,
+            &my_struct));
+    TEST_ASSERT_EQUAL_INT(1, my_struct.a_number);
+    TEST_ASSERT_EQUAL_STRING("test", my_struct.a_string);
+    TEST_ASSERT_EQUAL_INT(4, my_struct.my_inner.my_value);
+    serdec_yaml_type_release(type, &my_struct);
+
+    const char* escaped = "{a_string: \"tab\\there\", a_number: 2}";
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserializer_reset_string(deser,
+            escaped, strlen(escaped)));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserialize_struct(deser, type,
+            &my_struct));
+    TEST_ASSERT_EQUAL_STRING("tab\there", my_struct.a_string);
+    serdec_yaml_type_release(type, &my_struct);
+
+    // YAML outside of the subset is reported as a syntax error.
+    const char* alias = "a_number: *number\n";
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserializer_reset_string(deser,
+            alias, strlen(alias)));
+    TEST_ASSERT_EQUAL_INT(SERDEC_YAML_SYNTAX_ERROR,
+        serdec_yaml_deserialize_struct(deser, type, &my_struct));
+    TEST_ASSERT_EQUAL_STRING("anchors and aliases are not supported",
+        serdec_yaml_deserializer_strerror(deser));
+    serdec_yaml_type_free(type);
+
+    // Keys too long for the stack are still NUL-terminated.
+    char long_key[300] = {0};
+    memset(long_key, 'k', 200);
+    memcpy(long_key + 200, ": [1, 2]\n", 9);
+    size_t key_length = 0;
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserializer_reset_string(deser,
+            long_key, strlen(long_key)));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserialize_map(deser,
+            long_key_visit_map_entry, &key_length));
+    TEST_ASSERT_EQUAL_size_t(200, key_length);
+    serdec_yaml_deserializer_free(deser);
+
+    // Pushed documents are also scanned natively.
+    deser = serdec_yaml_deserializer_new_push_with_options(&options);
+    TEST_ASSERT_NOT_NULL(deser);
+    const char* pushed = "--- {a_number: 7}\n...\n";
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserializer_feed(deser, pushed,
+            strlen(pushed)));
+    memset(&my_struct, 0, sizeof(my_struct));
+    TEST_ASSERT_EQUAL_INT(0, my_struct_deserialize_yaml(deser, &my_struct));
+    TEST_ASSERT_EQUAL_INT(7, my_struct.a_number);
+    TEST_ASSERT_EQUAL_INT(SERDEC_YAML_NEED_MORE_DATA,
+        serdec_yaml_deserializer_next_document(deser));
+    serdec_yaml_deserializer_free(deser);
+}
+
+// The callbacks for parallel de-serialization can't assert on the worker
+// threads, so they report what they observe instead.
+typedef struct ParallelResults {
+    size_t delivered[PARALLEL_DOCUMENTS];
+    size_t count;
+    int statuses[PARALLEL_DOCUMENTS];
+    bool mismatched;
+} ParallelResults;
+
+static int parallel_visit_map_entry(SerdecYamlDeserializer* deser,
+    void* user_data, const char* key)
+{
+    if (!strcmp(key, "a_number")) {
+        return serdec_yaml_deserialize_int(deser, user_data);
+    }
+    return serdec_yaml_deserialize_skip(deser);
+}
+
+static int parallel_visit_document(SerdecYamlDeserializer* deser,
+    void* user_data, size_t index, void** result)
+{
+    (void)user_data;
+    (void)index;
+    int* value = malloc(sizeof(int));
+    if (NULL == value) {
+        return SERDEC_YAML_SYSTEM_ERROR;
+    }
+
+    *value = -1;
+    *result = value;
+    return serdec_yaml_deserialize_map(deser, parallel_visit_map_entry,
+        value);
+}
+
+static int parallel_deliver_document(void* user_data, size_t index,
+    void* result, int status)
+{
+    ParallelResults* results = user_data;
+    if (results->count >= PARALLEL_DOCUMENTS ||
+        (0 == status && (int)index != *(int*)result)) {
+        results->mismatched = true;
+    } else {
+        results->statuses[results->count] = status;
+        results->delivered[results->count++] = index;
+    }
+    free(result);
+    return 0;
+}
+
+// Write a stream of PARALLEL_DOCUMENTS documents, in which document <index>
+// has an a_number of <index>, or an invalid number if it's <invalid>.
+static void write_parallel_stream(char* stream, size_t size, size_t invalid) {
+    size_t length = snprintf(stream, size, "# Leading comment\n%%YAML 1.1\n");
+    for (size_t i = 0; i < PARALLEL_DOCUMENTS; ++i) {
+        if (i == invalid) {
+            length += snprintf(stream + length, size - length,
+                "---\na_number: x\n");
+        } else if (0 == i % 3) {
+            length += snprintf(stream + length, size - length,
+                "--- {a_string: '---', a_number: %zu}\n...\n", i);
+        } else {
+            length += snprintf(stream + length, size - length,
+                "---\na_string: 'document'\na_number: %zu\n", i);
+        }
+        TEST_ASSERT(length < size);
+    }
+    snprintf(stream + length, size - length, "# Trailing comment\n");
+}
+
+TEST(YamlDeser, Parallel) {
+    static char stream[PARALLEL_DOCUMENTS * 64];
+    write_parallel_stream(stream, sizeof(stream), SIZE_MAX);
+
+    // In order, and as completed, with each backend.
+    SerdecYamlParallelOptions options = {.threads = 4};
+    for (int i = 0; i < 4; ++i) {
+        options.order = i % 2 ? SERDEC_YAML_DELIVER_AS_COMPLETED
+            : SERDEC_YAML_DELIVER_IN_ORDER;
+        options.deserializer.backend = i / 2 ? SERDEC_YAML_BACKEND_NATIVE
+            : SERDEC_YAML_BACKEND_LIBYAML;
+        ParallelResults results = {0};
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_parallel_for_each_document(
+                stream, strlen(stream), parallel_visit_document,
+                parallel_deliver_document, &results, &options));
+        TEST_ASSERT_FALSE(results.mismatched);
+        TEST_ASSERT_EQUAL_size_t(PARALLEL_DOCUMENTS, results.count);
+
+        bool seen[PARALLEL_DOCUMENTS] = {0};
+        for (size_t j = 0; j < results.count; ++j) {
+            TEST_ASSERT(SERDEC_YAML_DELIVER_AS_COMPLETED == options.order
+                || j == results.delivered[j]);
+            TEST_ASSERT_FALSE(seen[results.delivered[j]]);
+            seen[results.delivered[j]] = true;
+        }
+    }
+
+    // Once a document fails, no more are started, but those which were
+    // started are still delivered, in order.
+    write_parallel_stream(stream, sizeof(stream), 50);
+    options = (SerdecYamlParallelOptions){.threads = 3};
+    ParallelResults results = {0};
+    TEST_ASSERT_EQUAL_INT(SERDEC_YAML_CALLBACK_SIGNALED_ERROR,
+        serdec_yaml_parallel_for_each_document(stream, strlen(stream),
+            parallel_visit_document, parallel_deliver_document, &results,
+            &options));
+    TEST_ASSERT_FALSE(results.mismatched);
+    TEST_ASSERT(50 < results.count);
+    TEST_ASSERT(results.count < PARALLEL_DOCUMENTS);
+    for (size_t i = 0; i < results.count; ++i) {
+        TEST_ASSERT_EQUAL_size_t(i, results.delivered[i]);
+        int status = 50 == i ? SERDEC_YAML_CALLBACK_SIGNALED_ERROR : 0;
+        TEST_ASSERT_EQUAL_INT(status, results.statuses[i]);
+    }
+
+    // Files are mapped, with the default options.
+    write_parallel_stream(stream, sizeof(stream), SIZE_MAX);
+    char path[] = "/tmp/serdec-test-XXXXXX";
+    int fd = mkstemp(path);
+    TEST_ASSERT(0 <= fd);
+    size_t length = strlen(stream);
+    TEST_ASSERT_EQUAL_INT(length, write(fd, stream, length));
+    close(fd);
+    memset(&results, 0, sizeof(results));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_parallel_for_each_document_path(path,
+            parallel_visit_document, parallel_deliver_document, &results,
+            NULL));
+    TEST_ASSERT_FALSE(results.mismatched);
+    TEST_ASSERT_EQUAL_size_t(PARALLEL_DOCUMENTS, results.count);
+    unlink(path);
+
+    // Pipes are read into memory.
+    int pipe_fds[2] = {0};
+    TEST_ASSERT_EQUAL_INT(0, pipe(pipe_fds));
+    TEST_ASSERT_EQUAL_INT(length, write(pipe_fds[1], stream, length));
+    close(pipe_fds[1]);
+    char pipe_path[64] = {0};
+    snprintf(pipe_path, sizeof(pipe_path), "/dev/fd/%d", pipe_fds[0]);
+    memset(&results, 0, sizeof(results));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_parallel_for_each_document_path(
+            pipe_path, parallel_visit_document, parallel_deliver_document,
+            &results, NULL));
+    TEST_ASSERT_EQUAL_size_t(PARALLEL_DOCUMENTS, results.count);
+    close(pipe_fds[0]);
+
+    errno = 0;
+    TEST_ASSERT_EQUAL_INT(SERDEC_YAML_SYSTEM_ERROR,
+        serdec_yaml_parallel_for_each_document_path(path,
+            parallel_visit_document, NULL, NULL, NULL));
+    TEST_ASSERT_EQUAL_INT(ENOENT, errno);
+
+    // Input without any documents doesn't start any workers.
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_parallel_for_each_document(
+            "# Nothing\n", 10, parallel_visit_document, NULL, NULL, NULL));
+}
+
+// Record which paths were visited, and the value of each.
+typedef struct Projected {
+    int values[4];
+    int visits[4];
+} Projected;
+
+static int projected_visit_path(SerdecYamlDeserializer* deser,
+    void* user_data, size_t index)
+{
+    Projected* projected = user_data;
+    ++projected->visits[index];
+    return serdec_yaml_deserialize_int(deser, &projected->values[index]);
+}
+
+static int failing_visit_path(SerdecYamlDeserializer* deser, void* user_data,
+    size_t index)
+{
+    (void)deser;
+    (void)user_data;
+    (void)index;
+    return 1;
+}
+
+static const SerdecYamlPath PROJECTED_PATHS[] = {
+    {"a_number", projected_visit_path},
+    {"nested.inner[1]", projected_visit_path},
+    {"records[2].value", projected_visit_path},
+};
+
+TEST(YamlDeser, Projection) {
+    // Only three of the keys are of interest, and the input becomes invalid
+    // after the last of them, which is never parsed.
+    static char document[8192];
+    size_t length = 0;
+    for (int i = 0; i < 100; ++i) {
+        length += snprintf(document + length, sizeof(document) - length,
+            "key_%d: {skipped: [%d, %d]}\n", i, i, i);
+    }
+    length += snprintf(document + length, sizeof(document) - length,
+        "records:\n"
+        "    - {value: 1, other: [1]}\n"
+        "    - value: 2\n"
+        "    - {other: {value: 0}, value: 3}\n"
+        "a_number: 4\n"
+        "nested: {outer: 1, inner: [5, 6, 7]}\n"
+        "after: 'the last path'\n"
+        "invalid: [unclosed\n"
+        "    - {\n");
+    TEST_ASSERT(length < sizeof(document));
+
+    SerdecYamlProjection* projection = serdec_yaml_projection_new(
+        PROJECTED_PATHS, sizeof(PROJECTED_PATHS) / sizeof(*PROJECTED_PATHS));
+    TEST_ASSERT_NOT_NULL(projection);
+    SerdecYamlBackend backends[] = {
+        SERDEC_YAML_BACKEND_LIBYAML,
+        SERDEC_YAML_BACKEND_NATIVE,
+    };
+    for (size_t i = 0; i < sizeof(backends) / sizeof(*backends); ++i) {
+        SerdecYamlDeserializerOptions options = {.backend = backends[i]};
+        SerdecYamlDeserializer* deser =
+            serdec_yaml_deserializer_new_string_with_options(document, length,
+                &options);
+        TEST_ASSERT_NOT_NULL(deser);
+        Projected projected = {0};
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserialize_projection(deser,
+                projection, &projected));
+        TEST_ASSERT_EQUAL_INT(4, projected.values[0]);
+        TEST_ASSERT_EQUAL_INT(6, projected.values[1]);
+        TEST_ASSERT_EQUAL_INT(3, projected.values[2]);
+        for (int j = 0; j < 3; ++j) {
+            TEST_ASSERT_EQUAL_INT(1, projected.visits[j]);
+        }
+        serdec_yaml_deserializer_free(deser);
+    }
+
+    // Paths which aren't in the input aren't visited, and the whole value is
+    // parsed looking for them. Repeated keys are visited each time.
+    const char* partial = "a_number: 1\nnested: [1, 2]\na_number: 2\n"
+        "records: [{value: 1}]\n";
+    SerdecYamlDeserializer* deser = serdec_yaml_deserializer_new_string(
+        partial, strlen(partial));
+    TEST_ASSERT_NOT_NULL(deser);
+    Projected projected = {0};
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserialize_projection(deser,
+            projection, &projected));
+    TEST_ASSERT_EQUAL_INT(2, projected.visits[0]);
+    TEST_ASSERT_EQUAL_INT(2, projected.values[0]);
+    TEST_ASSERT_EQUAL_INT(0, projected.visits[1]);
+    TEST_ASSERT_EQUAL_INT(0, projected.visits[2]);
+    TEST_ASSERT_EQUAL_INT(SERDEC_YAML_END_OF_STREAM,
+        serdec_yaml_deserializer_next_document(deser));
+    serdec_yaml_deserializer_free(deser);
+    serdec_yaml_projection_free(projection);
+
+    // Errors from the callbacks are reported.
+    SerdecYamlPath failing[] = {{"[1]", failing_visit_path}};
+    projection = serdec_yaml_projection_new(failing, 1);
+    TEST_ASSERT_NOT_NULL(projection);
+    const char* list = "[0, 1, 2]";
+    deser = serdec_yaml_deserializer_new_string(list, strlen(list));
+    TEST_ASSERT_NOT_NULL(deser);
+    TEST_ASSERT_EQUAL_INT(SERDEC_YAML_CALLBACK_SIGNALED_ERROR,
+        serdec_yaml_deserialize_projection(deser, projection, NULL));
+    serdec_yaml_deserializer_free(deser);
+    serdec_yaml_projection_free(projection);
+
+    // Paths which are malformed, repeated or overlapping are rejected.
+    const char* invalid[][2] = {
+        {"a..b", "c"}, {"a[1]", "a[1]"}, {"a", "a.b"}, {"a.b[0]", "a.b"},
+        {"", "a"},
+    };
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(*invalid); ++i) {
+        SerdecYamlPath paths[] = {
+            {invalid[i][0], projected_visit_path},
+            {invalid[i][1], projected_visit_path},
+        };
+        errno = 0;
+        TEST_ASSERT_NULL(serdec_yaml_projection_new(paths, 2));
+        TEST_ASSERT_EQUAL_INT(EINVAL, errno);
+    }
+}
+
+TEST(YamlDeser, Stats) {
+    SerdecYamlBackend backends[] = {
+        SERDEC_YAML_BACKEND_LIBYAML,
+        SERDEC_YAML_BACKEND_NATIVE,
+    };
+    for (size_t i = 0; i < sizeof(backends) / sizeof(*backends); ++i) {
+        SerdecYamlDeserializerOptions options = {.backend = backends[i]};
+        SerdecYamlDeserializer* deser =
+            serdec_yaml_deserializer_new_string_with_options(DOCUMENT,
+                strlen(DOCUMENT), &options);
+        TEST_ASSERT_NOT_NULL(deser);
+        MyStruct my_struct = {0};
+        TEST_ASSERT_EQUAL_INT(0, my_struct_deserialize_yaml(deser,
+                &my_struct));
+        free(my_struct.a_string);
+        TEST_ASSERT_EQUAL_INT(SERDEC_YAML_END_OF_STREAM,
+            serdec_yaml_deserializer_next_document(deser));
+
+        SerdecYamlStats stats = {0};
+        int result = serdec_yaml_deserializer_stats(deser, &stats);
+#ifdef SERDEC_ENABLE_STATS
+        TEST_ASSERT_EQUAL_INT(0, result);
+
+        // The stream, the document, the map with its four keys and three
+        // scalars, and the list with its four elements.
+        TEST_ASSERT_EQUAL_UINT64(19, stats.events);
+        TEST_ASSERT_EQUAL_UINT64(strlen(DOCUMENT), stats.bytes);
+        TEST_ASSERT_EQUAL_UINT64(2, stats.max_depth);
+
+        // Only the native scanner's keys and strings need to be copied.
+        size_t copied = SERDEC_YAML_BACKEND_NATIVE == backends[i] ? 36 : 0;
+        TEST_ASSERT_EQUAL_UINT64(copied, stats.scalar_bytes);
+        TEST_ASSERT_EQUAL_UINT64(0, stats.buffer_grows);
+#ifdef SERDEC_ENABLE_STATS_TIMING
+        TEST_ASSERT(0 < stats.codec_ns);
+        TEST_ASSERT(0 < stats.callback_ns);
+#else
+        TEST_ASSERT_EQUAL_UINT64(0, stats.codec_ns);
+        TEST_ASSERT_EQUAL_UINT64(0, stats.callback_ns);
+#endif
+
+        // Resetting the de-serializer keeps the counters.
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserializer_reset_string(deser,
+                "[1]", 3));
+        SerdecYamlStats after = {0};
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserializer_stats(deser,
+                &after));
+        TEST_ASSERT(stats.events < after.events);
+        TEST_ASSERT(stats.bytes < after.bytes);
+#else
+        TEST_ASSERT_EQUAL_INT(SERDEC_YAML_NOT_SUPPORTED, result);
+        TEST_ASSERT_NOT_NULL(serdec_yaml_deserializer_strerror(deser));
+#endif
+        serdec_yaml_deserializer_free(deser);
+    }
+}
+
 TEST_GROUP_RUNNER(YamlDeser) {
     RUN_TEST_CASE(YamlDeser, BasicDocument);
+    RUN_TEST_CASE(YamlDeser, Numbers);
+    RUN_TEST_CASE(YamlDeser, Skip);
+    RUN_TEST_CASE(YamlDeser, FieldTable);
+    RUN_TEST_CASE(YamlDeser, StructDescriptor);
+    RUN_TEST_CASE(YamlDeser, Arrays);
+    RUN_TEST_CASE(YamlDeser, Arena);
+    RUN_TEST_CASE(YamlDeser, Reset);
+    RUN_TEST_CASE(YamlDeser, MultipleDocuments);
+    RUN_TEST_CASE(YamlDeser, Path);
+    RUN_TEST_CASE(YamlDeser, Push);
+    RUN_TEST_CASE(YamlDeser, NativeBackend);
+    RUN_TEST_CASE(YamlDeser, Parallel);
+    RUN_TEST_CASE(YamlDeser, Projection);
+    RUN_TEST_CASE(YamlDeser, Stats);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,301 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            test-yaml-scanner.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Tests for the native YAML scanner
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <yaml.h>
+
+#include <serdec/yaml-error.h>
+#include <serdec/yaml-scanner.h>
+
+#include <unity_fixture.h>
+
+TEST_GROUP(YamlScanner);
+TEST_SETUP(YamlScanner) {}
+TEST_TEAR_DOWN(YamlScanner) {}
+
+#define TRACE_SIZE 4096
+
+// Append a line describing <event> to <trace>.
+static void trace_event(char* trace, const yaml_event_t* event) {
+    size_t used = strlen(trace);
+    TEST_ASSERT(used < TRACE_SIZE);
+    char* line = trace + used;
+    size_t remaining = TRACE_SIZE - used;
+    switch (event->type) {
+    case YAML_STREAM_START_EVENT: snprintf(line, remaining, "+STR\n"); break;
+    case YAML_STREAM_END_EVENT: snprintf(line, remaining, "-STR\n"); break;
+    case YAML_DOCUMENT_START_EVENT: snprintf(line, remaining, "+DOC\n"); break;
+    case YAML_DOCUMENT_END_EVENT: snprintf(line, remaining, "-DOC\n"); break;
+    case YAML_MAPPING_START_EVENT: snprintf(line, remaining, "+MAP\n"); break;
+    case YAML_MAPPING_END_EVENT: snprintf(line, remaining, "-MAP\n"); break;
+    case YAML_SEQUENCE_START_EVENT: snprintf(line, remaining, "+SEQ\n"); break;
+    case YAML_SEQUENCE_END_EVENT: snprintf(line, remaining, "-SEQ\n"); break;
+    case YAML_SCALAR_EVENT: {
+        // NUL characters (from "\0" escapes) are printed as "\0".
+        snprintf(line, remaining, "=VAL %d ", (int)event->data.scalar.style);
+        for (size_t i = 0; i < event->data.scalar.length; ++i) {
+            char c = (char)event->data.scalar.value[i];
+            size_t length = strlen(trace);
+            snprintf(trace + length, TRACE_SIZE - length, "%s",
+                '\0' == c ? "\\0" : (char[]){c, '\0'});
+        }
+        used = strlen(trace);
+        snprintf(trace + used, TRACE_SIZE - used, "\n");
+        break;
+    }
+    default: snprintf(line, remaining, "?%d\n", (int)event->type); break;
+    }
+}
+
+static void trace_libyaml(const char* document, char* trace) {
+    yaml_parser_t parser;
+    TEST_ASSERT(yaml_parser_initialize(&parser));
+    yaml_parser_set_input_string(&parser, (const unsigned char*)document,
+        strlen(document));
+    trace[0] = '\0';
+    yaml_event_t event = {0};
+    do {
+        yaml_event_delete(&event);
+        TEST_ASSERT_MESSAGE(yaml_parser_parse(&parser, &event), document);
+        trace_event(trace, &event);
+    } while (YAML_STREAM_END_EVENT != event.type);
+    yaml_event_delete(&event);
+    yaml_parser_delete(&parser);
+}
+
+static void trace_native(NativeScanner* scanner, const char* document,
+    char* trace)
+{
+    native_scanner_set_input(scanner, document, strlen(document));
+    trace[0] = '\0';
+    yaml_event_t event = {0};
+    do {
+        int result = native_scanner_next(scanner, &event);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(0, result, NULL != scanner->problem
+            ? scanner->problem : document);
+        trace_event(trace, &event);
+    } while (YAML_STREAM_END_EVENT != event.type);
+
+    // Once the stream has ended, there are no more events.
+    TEST_ASSERT_EQUAL_INT(0, native_scanner_next(scanner, &event));
+    TEST_ASSERT_EQUAL_INT(YAML_NO_EVENT, event.type);
+}
+
+static const char* const SUPPORTED_DOCUMENTS[] = {
+    "",
+    "# Only a comment\n",
+    "%YAML 1.1\n---\ntest: true\na_number: 1\na_string: 'test'\n"
+    "list_of_four:\n    - 1\n    - 2\n    - 3\n    - 4\n...\n",
+    "key: value\nnested:\n  a: 'x'\n  b: \"y\"\n  c:\n    d: e\nlast: 1\n",
+    "- a\n- b: 1\n  c: 2\n- - x\n  - y\n-\n- ''\n- \"\"\n",
+    "a:\n- 1\n- 2\nb: [1, 2, {c: d, e: }]\nf: {}\ng: []\nh:\ni: ~\n",
+    "{a, c: , \"q\":v, x: [1,\n  2,], y: {z: 1}, }\n",
+    "[a:b, -1, 'x', \"y\", [], {}, {a: b}]\n",
+    "a: 'it''s'\nb: \"tab\\tnl\\n\\x41\\u00e9\\U0001F600\\0\\\\\\\"\"\n"
+    "c: 'x\n\n  y  z'\nd: \"x \\\n  y\\\n\n z\"\ne: \"  lead  \"\n"
+    "f: 'one\n  two\n   three'\ng: \"\\N\\_\\L\\P\\e\\a\\ \\/\"\n",
+    "plain: a b  c\nurl: http://x.y/z\nneg: -1\ncolon: a:b\nhash: a#b\n"
+    "dash: -x\nquestion: ?x\nspaced key  : 1\n'quoted key': 2\n\"dq\": 3\n",
+    "a: # comment\n  b: 1 # trailing\n\n# between\nc: d\n  # indented\n",
+    "%YAML 1.1\n---\na: 1\n...\n---\n- b\n--- c\n---\n--- [d]\n...\n",
+    "---\nx\n...\n...\n--- y\n",
+    "\xef\xbb\xbf" "a: 1\r\nb:\r\n  - x\r\n  - 'y\r\n  z'\r\n",
+    "a:\tb\nc:   \n  d\n",
+    "  indented: 1\n  root: 2\n",
+    "a:\n  - b:\n    - c\n    d: e\n  - f\n",
+    "- {a: 1}\n- [2]\n-   - 3\n    - 4\n",
+};
+
+TEST(YamlScanner, MatchesLibyaml) {
+    NativeScanner scanner;
+    native_scanner_initialize(&scanner, NULL);
+    static char expected[TRACE_SIZE];
+    static char actual[TRACE_SIZE];
+    size_t count = sizeof(SUPPORTED_DOCUMENTS) / sizeof(*SUPPORTED_DOCUMENTS);
+    for (size_t i = 0; i < count; ++i) {
+        trace_libyaml(SUPPORTED_DOCUMENTS[i], expected);
+        trace_native(&scanner, SUPPORTED_DOCUMENTS[i], actual);
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, actual,
+            SUPPORTED_DOCUMENTS[i]);
+    }
+    native_scanner_delete(&scanner);
+}
+
+// Documents which use YAML the scanner doesn't support, or which are invalid.
+// These must be reported as errors, rather than produce different events.
+static const char* const UNSUPPORTED_DOCUMENTS[] = {
+    "a: &anchor 1\n",
+    "a: *alias\n",
+    "a: !tag 1\n",
+    "a: |\n  block\n",
+    "a: >\n  folded\n",
+    "? complex\n: key\n",
+    "[a]: b\n",
+    "a: b\n  continued\n",
+    "- a\n  continued\n",
+    "[a\n b]\n",
+    "\ta: b\n",
+    "--- a: 1\n",
+    "--- - a\n",
+    "a: - b\n",
+    "a: b: c\n",
+    "[a: b]\n",
+    "{a: 1\n",
+    "[1, 2\n",
+    "{: a}\n",
+    "%TAG ! tag:example.com,2026:\n---\na\n",
+    "%YAML 1.1\na: 1\n",
+    "%YAML 2.0\n---\n",
+    "a: 'unterminated\n",
+    "a: 'x\n---\ny'\n",
+    "a: \"\\q\"\n",
+    "a: \"\\uD800\"\n",
+    "'multi\n line': key\n",
+    "a: 1\n- b\n",
+    "...\n---\na\n",
+    "- a\nb: c\n",
+    "a\nb\n",
+    "a: 'b' c\n",
+    "\xff\xfe" "a\n",
+    "{\"a\n b\": 1}\n",
+    "{'a\n b': 1}\n",
+    "a: \xc3\n",
+    "a: \xc0\xaf\n",
+    "a: \xed\xa0\x80\n",
+};
+
+TEST(YamlScanner, Unsupported) {
+    NativeScanner scanner;
+    native_scanner_initialize(&scanner, NULL);
+    size_t count = sizeof(UNSUPPORTED_DOCUMENTS)
+        / sizeof(*UNSUPPORTED_DOCUMENTS);
+    for (size_t i = 0; i < count; ++i) {
+        const char* document = UNSUPPORTED_DOCUMENTS[i];
+        native_scanner_set_input(&scanner, document, strlen(document));
+        yaml_event_t event = {0};
+        int result = 0;
+        do {
+            result = native_scanner_next(&scanner, &event);
+        } while (0 == result && YAML_STREAM_END_EVENT != event.type);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(SERDEC_YAML_SYNTAX_ERROR, result,
+            document);
+        TEST_ASSERT_NOT_NULL(scanner.problem);
+
+        // The error is sticky.
+        TEST_ASSERT_EQUAL_INT(SERDEC_YAML_SYNTAX_ERROR,
+            native_scanner_next(&scanner, &event));
+    }
+    native_scanner_delete(&scanner);
+}
+
+// Scalars without escapes are referred to in place.
+TEST(YamlScanner, ZeroCopy) {
+    const char* document = "key: 'value'\nother: \"x\\ty\"\n";
+    NativeScanner scanner;
+    native_scanner_initialize(&scanner, NULL);
+    native_scanner_set_input(&scanner, document, strlen(document));
+    yaml_event_t event = {0};
+    const char* scalars[4] = {0};
+    size_t count = 0;
+    do {
+        TEST_ASSERT_EQUAL_INT(0, native_scanner_next(&scanner, &event));
+        if (YAML_SCALAR_EVENT == event.type) {
+            TEST_ASSERT(count < 4);
+            scalars[count++] = (const char*)event.data.scalar.value;
+        }
+    } while (YAML_STREAM_END_EVENT != event.type);
+
+    TEST_ASSERT_EQUAL_INT(4, count);
+    TEST_ASSERT(document == scalars[0]);
+    TEST_ASSERT(document + 6 == scalars[1]);
+    TEST_ASSERT(document + 13 == scalars[2]);
+    TEST_ASSERT(scalars[3] < document
+        || scalars[3] >= document + strlen(document));
+    native_scanner_delete(&scanner);
+}
+
+// Inputs at or beyond the threshold are scanned using the structural index.
+// Each document is padded with a trailing comment, so the scalars in it are
+// found through the index.
+TEST(YamlScanner, Indexed) {
+    static const char* const long_documents[] = {
+        "single: 'a scalar which is long enough to span several blocks of"
+        " the index, with ''quotes'' in it, and\n a line break, and the end"
+        " of it. Lorem ipsum dolor sit amet, consectetur adipiscing elit.'\n"
+        "double: \"the same, but double-quoted\\t with \\\"escapes\\\""
+        " spread through it: \\x41, \\u00e9, and a folded\n\n line.\"\n"
+        "plain: a plain scalar which is also long, has spaces   and:colons,"
+        " #hashes without a leading blank, and trailing blanks   \n"
+        "flow: [one long flow entry, another long flow entry, {key: value}]\n",
+    };
+
+    size_t padding = NATIVE_SCANNER_INDEX_THRESHOLD + 100;
+    size_t documents = sizeof(SUPPORTED_DOCUMENTS) / sizeof(*SUPPORTED_DOCUMENTS)
+        + sizeof(long_documents) / sizeof(*long_documents);
+    NativeScanner scanner;
+    native_scanner_initialize(&scanner, NULL);
+    static char expected[TRACE_SIZE];
+    static char actual[TRACE_SIZE];
+    for (size_t i = 0; i < documents; ++i) {
+        const char* document = i < sizeof(SUPPORTED_DOCUMENTS)
+            / sizeof(*SUPPORTED_DOCUMENTS) ? SUPPORTED_DOCUMENTS[i]
+            : long_documents[i - sizeof(SUPPORTED_DOCUMENTS)
+                / sizeof(*SUPPORTED_DOCUMENTS)];
+        size_t length = strlen(document);
+        char* padded = malloc(length + padding + 1);
+        TEST_ASSERT_NOT_NULL(padded);
+        memcpy(padded, document, length);
+        padded[length] = '#';
+        memset(padded + length + 1, 'x', padding - 2);
+        padded[length + padding - 1] = '\n';
+        padded[length + padding] = '\0';
+
+        trace_libyaml(padded, expected);
+        trace_native(&scanner, padded, actual);
+        TEST_ASSERT(scanner.indexed);
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, actual, document);
+        free(padded);
+    }
+    native_scanner_delete(&scanner);
+}
+
+TEST_GROUP_RUNNER(YamlScanner) {
+    RUN_TEST_CASE(YamlScanner, MatchesLibyaml);
+    RUN_TEST_CASE(YamlScanner, Unsupported);
+    RUN_TEST_CASE(YamlScanner, ZeroCopy);
+    RUN_TEST_CASE(YamlScanner, Indexed);
+}
+
+///////////////////////////////////////////////////////////////////////////////
@@ -7,7 +7,7 @@
 //
 // CREATED:         02/04/2022
 //
-// LAST EDITED:     02/05/2022
+// LAST EDITED:     10/14/2026
 //
 // Copyright 2022, Ethan D. Twardy
 //
@@ -30,7 +30,15 @@
 // IN THE SOFTWARE.
 ////
 
+#include <limits.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
 #include <serdec/yaml.h>
+#include <serdec/yaml-error.h>
 
 #include <unity_fixture.h>
 
@@ -113,8 +121,863 @@ TEST(YamlSer, BasicDocument) {
     serdec_yaml_serializer_free(ser);
 }
 
+TEST(YamlSer, TakeString) {
+    MyStruct value = {
+        .test = true,
+        .a_number = 1,
+        .a_string = "test",
+        .list_of_four = {1, 2, 3, 4},
+        .my_inner = {.my_value = 4},
+    };
+
+    SerdecYamlSerializer* ser = serdec_yaml_serializer_new_string();
+    TEST_ASSERT_NOT_NULL(ser);
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serializer_reserve(ser, 4096));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, my_struct_serialize_yaml(ser, &value));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_end(ser));
+
+    size_t length = 0;
+    char* string = serdec_yaml_serializer_take_string(ser, &length);
+    TEST_ASSERT_NOT_NULL(string);
+    TEST_ASSERT_EQUAL_INT(strlen(BASIC_DOCUMENT), length);
+    TEST_ASSERT_EQUAL_STRING(BASIC_DOCUMENT, string);
+    TEST_ASSERT_EQUAL_STRING("", serdec_yaml_serializer_borrow_string(ser));
+    free(string);
+    serdec_yaml_serializer_free(ser);
+}
+
+TEST(YamlSer, FixedBuffer) {
+    MyStruct value = {
+        .test = true,
+        .a_number = 1,
+        .a_string = "test",
+        .list_of_four = {1, 2, 3, 4},
+        .my_inner = {.my_value = 4},
+    };
+
+    // The first attempt doesn't fit, but reports how much space is needed.
+    char small[16] = {0};
+    SerdecYamlSerializer* ser = serdec_yaml_serializer_new_buffer(small,
+        sizeof(small));
+    TEST_ASSERT_NOT_NULL(ser);
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, my_struct_serialize_yaml(ser, &value));
+    TEST_ASSERT_NOT_EQUAL(0, serdec_yaml_serialize_end(ser));
+    TEST_ASSERT_NULL(serdec_yaml_serializer_borrow_string(ser));
+    size_t required = serdec_yaml_serializer_required_size(ser);
+    TEST_ASSERT_EQUAL_INT(strlen(BASIC_DOCUMENT) + 1, required);
+    serdec_yaml_serializer_free(ser);
+
+    char buffer[256] = {0};
+    TEST_ASSERT(required <= sizeof(buffer));
+    ser = serdec_yaml_serializer_new_buffer(buffer, required);
+    TEST_ASSERT_NOT_NULL(ser);
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, my_struct_serialize_yaml(ser, &value));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_end(ser));
+    TEST_ASSERT_EQUAL_STRING(BASIC_DOCUMENT, buffer);
+    serdec_yaml_serializer_free(ser);
+
+    // A zero-length buffer only measures the output, with either backend.
+    SerdecYamlBackend backends[] = {
+        SERDEC_YAML_BACKEND_LIBYAML, SERDEC_YAML_BACKEND_NATIVE,
+    };
+    for (size_t i = 0; i < sizeof(backends) / sizeof(*backends); ++i) {
+        ser = serdec_yaml_serializer_new_buffer(NULL, 0);
+        TEST_ASSERT_NOT_NULL(ser);
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serializer_set_backend(ser,
+                backends[i]));
+        TEST_ASSERT_EQUAL_STRING("", serdec_yaml_serializer_borrow_string(ser));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_start(ser));
+        TEST_ASSERT_EQUAL_INT(0, my_struct_serialize_yaml(ser, &value));
+        TEST_ASSERT_EQUAL_INT(SERDEC_YAML_BUFFER_OVERFLOW,
+            serdec_yaml_serialize_end(ser));
+        TEST_ASSERT_EQUAL_INT(strlen(BASIC_DOCUMENT) + 1,
+            serdec_yaml_serializer_required_size(ser));
+
+        memset(buffer, 0, sizeof(buffer));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serializer_reset_buffer(ser,
+                buffer, required));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_start(ser));
+        TEST_ASSERT_EQUAL_INT(0, my_struct_serialize_yaml(ser, &value));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_end(ser));
+        TEST_ASSERT_EQUAL_STRING(BASIC_DOCUMENT, buffer);
+        serdec_yaml_serializer_free(ser);
+    }
+}
+
+static void read_back_file(FILE* file, char* buffer, size_t length) {
+    rewind(file);
+    size_t read = fread(buffer, 1, length - 1, file);
+    buffer[read] = '\0';
+}
+
+TEST(YamlSer, File) {
+    MyStruct value = {
+        .test = true,
+        .a_number = 1,
+        .a_string = "test",
+        .list_of_four = {1, 2, 3, 4},
+        .my_inner = {.my_value = 4},
+    };
+
+    char buffer[256] = {0};
+    FILE* file = tmpfile();
+    TEST_ASSERT_NOT_NULL(file);
+    SerdecYamlSerializer* ser = serdec_yaml_serializer_new_file(file);
+    TEST_ASSERT_NOT_NULL(ser);
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, my_struct_serialize_yaml(ser, &value));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_end(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serializer_flush(ser));
+    serdec_yaml_serializer_free(ser);
+    read_back_file(file, buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL_STRING(BASIC_DOCUMENT, buffer);
+    fclose(file);
+
+    // A tiny threshold forces libyaml's chunks to be written straight through
+    file = tmpfile();
+    TEST_ASSERT_NOT_NULL(file);
+    ser = serdec_yaml_serializer_new_fd(fileno(file));
+    TEST_ASSERT_NOT_NULL(ser);
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serializer_set_flush_threshold(ser,
+            8));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, my_struct_serialize_yaml(ser, &value));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_end(ser));
+    serdec_yaml_serializer_free(ser);
+    read_back_file(file, buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL_STRING(BASIC_DOCUMENT, buffer);
+    fclose(file);
+
+    // With no threshold at all, nothing is buffered
+    file = tmpfile();
+    TEST_ASSERT_NOT_NULL(file);
+    ser = serdec_yaml_serializer_new_file(file);
+    TEST_ASSERT_NOT_NULL(ser);
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serializer_set_flush_threshold(ser,
+            0));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, my_struct_serialize_yaml(ser, &value));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_end(ser));
+    serdec_yaml_serializer_free(ser);
+    read_back_file(file, buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL_STRING(BASIC_DOCUMENT, buffer);
+    fclose(file);
+}
+
+typedef struct TestSink {
+    char buffer[256];
+    size_t length;
+    int flushes;
+} TestSink;
+
+static int test_sink_write(void* user_data, const char* buffer, size_t length)
+{
+    TestSink* sink = (TestSink*)user_data;
+    if (length >= sizeof(sink->buffer) - sink->length) {
+        return 1;
+    }
+    memcpy(sink->buffer + sink->length, buffer, length);
+    sink->length += length;
+    return 0;
+}
+
+static int test_sink_flush(void* user_data) {
+    TestSink* sink = (TestSink*)user_data;
+    sink->flushes += 1;
+    return 0;
+}
+
+TEST(YamlSer, Sink) {
+    MyStruct value = {
+        .test = true,
+        .a_number = 1,
+        .a_string = "test",
+        .list_of_four = {1, 2, 3, 4},
+        .my_inner = {.my_value = 4},
+    };
+
+    TestSink sink = {0};
+    SerdecYamlSerializer* ser = serdec_yaml_serializer_new_sink(
+        test_sink_write, test_sink_flush, &sink);
+    TEST_ASSERT_NOT_NULL(ser);
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, my_struct_serialize_yaml(ser, &value));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_end(ser));
+    serdec_yaml_serializer_free(ser);
+    TEST_ASSERT_EQUAL_INT(1, sink.flushes);
+    TEST_ASSERT_EQUAL_STRING(BASIC_DOCUMENT, sink.buffer);
+
+    // A callback's failure is reported, and has a description
+    TestSink small = {.length = sizeof(small.buffer) - 1};
+    ser = serdec_yaml_serializer_new_sink(test_sink_write, test_sink_flush,
+        &small);
+    TEST_ASSERT_NOT_NULL(ser);
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_start(ser));
+    my_struct_serialize_yaml(ser, &value);
+    TEST_ASSERT_NOT_EQUAL(0, serdec_yaml_serialize_end(ser));
+    TEST_ASSERT_NOT_NULL(serdec_yaml_serializer_strerror(ser));
+    serdec_yaml_serializer_free(ser);
+}
+
+TEST(YamlSer, NativeBackend) {
+    MyStruct value = {
+        .test = true,
+        .a_number = 1,
+        .a_string = "test",
+        .list_of_four = {1, 2, 3, 4},
+        .my_inner = {.my_value = 4},
+    };
+
+    SerdecYamlSerializer* ser = serdec_yaml_serializer_new_string();
+    TEST_ASSERT_NOT_NULL(ser);
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serializer_set_backend(ser,
+            SERDEC_YAML_BACKEND_NATIVE));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_start(ser));
+    TEST_ASSERT_NOT_EQUAL(0, serdec_yaml_serializer_set_backend(ser,
+            SERDEC_YAML_BACKEND_LIBYAML));
+    TEST_ASSERT_EQUAL_INT(0, my_struct_serialize_yaml(ser, &value));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_end(ser));
+    TEST_ASSERT_EQUAL_STRING(BASIC_DOCUMENT,
+        serdec_yaml_serializer_borrow_string(ser));
+    serdec_yaml_serializer_free(ser);
+
+    // Strings which can't be single-quoted are escaped
+    ser = serdec_yaml_serializer_new_string();
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serializer_set_backend(ser,
+            SERDEC_YAML_BACKEND_NATIVE));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_list_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_string(ser, "it's"));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_string(ser, "a\n\"b\""));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_map_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_map_end(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_list_end(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_end(ser));
+    TEST_ASSERT_EQUAL_STRING("%YAML 1.1\n---\n- 'it''s'\n- \"a\\n\\\"b\\\"\"\n"
+        "- {}\n", serdec_yaml_serializer_borrow_string(ser));
+    serdec_yaml_serializer_free(ser);
+}
+
+static const char* NUMBERS_DOCUMENT = "\
+%YAML 1.1\n\
+---\n\
+- -2147483648\n\
+- 2147483647\n\
+- -9223372036854775808\n\
+- 18446744073709551615\n\
+- 0.1\n\
+- 3.0\n\
+- -0.0\n\
+- 1.0e+300\n\
+- 1.5e-7\n\
+- -0.41000000000000014\n\
+- .inf\n\
+- .nan\n\
+";
+
+TEST(YamlSer, Numbers) {
+    for (int backend = 0; backend < 2; ++backend) {
+        SerdecYamlSerializer* ser = serdec_yaml_serializer_new_string();
+        TEST_ASSERT_NOT_NULL(ser);
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serializer_set_backend(ser,
+                backend ? SERDEC_YAML_BACKEND_NATIVE
+                : SERDEC_YAML_BACKEND_LIBYAML));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_start(ser));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_list_start(ser));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_int(ser, INT_MIN));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_int(ser, INT_MAX));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_int64(ser,
+                INT64_MIN));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_uint64(ser,
+                UINT64_MAX));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_double(ser, 0.1));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_double(ser, 3.0));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_double(ser, -0.0));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_double(ser, 1e300));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_double(ser, 1.5e-7));
+        // This needs more fractional digits than fit in 32 bits.
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_double(ser,
+                7 * 0.37 - 3));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_double(ser,
+                INFINITY));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_double(ser, NAN));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_list_end(ser));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_end(ser));
+        TEST_ASSERT_EQUAL_STRING(NUMBERS_DOCUMENT,
+            serdec_yaml_serializer_borrow_string(ser));
+        serdec_yaml_serializer_free(ser);
+    }
+}
+
+typedef struct Blob {
+    char value[16];
+    size_t length;
+} Blob;
+
+static int blob_visit_map_entry(SerdecYamlDeserializer* deser,
+    void* user_data, const char* key)
+{
+    Blob* blob = (Blob*)user_data;
+    const char* value = NULL;
+    if (strcmp(key, "blob") ||
+        serdec_yaml_deserialize_string_n(deser, &value, &blob->length) ||
+        sizeof(blob->value) <= blob->length)
+    {
+        return 1;
+    }
+
+    memcpy(blob->value, value, blob->length + 1);
+    return 0;
+}
+
+TEST(YamlSer, LengthAwareStrings) {
+    // Neither the key nor the value is NUL-terminated at its length, and the
+    // value contains a NUL byte.
+    static const char KEY[] = "blob_and_trailing_garbage";
+    static const char BLOB[] = "one\0two\0garbage";
+    static const size_t BLOB_LENGTH = 7;
+    SerdecYamlBackend backends[] = {
+        SERDEC_YAML_BACKEND_LIBYAML, SERDEC_YAML_BACKEND_NATIVE,
+    };
+
+    for (size_t i = 0; i < sizeof(backends) / sizeof(*backends); ++i) {
+        SerdecYamlSerializer* ser = serdec_yaml_serializer_new_string();
+        TEST_ASSERT_NOT_NULL(ser);
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serializer_set_backend(ser,
+                backends[i]));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_start(ser));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_map_start(ser));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_map_key_n(ser, KEY,
+                4));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_string_n(ser, BLOB,
+                BLOB_LENGTH));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_map_end(ser));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_end(ser));
+
+        size_t length = 0;
+        char* output = serdec_yaml_serializer_take_string(ser, &length);
+        serdec_yaml_serializer_free(ser);
+        TEST_ASSERT_NOT_NULL(output);
+        TEST_ASSERT_NOT_NULL(strstr(output, "\nblob: \"one\\0two\"\n"));
+
+        SerdecYamlDeserializer* deser = serdec_yaml_deserializer_new_string(
+            output, length);
+        TEST_ASSERT_NOT_NULL(deser);
+        Blob blob = {0};
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserialize_map(deser,
+                blob_visit_map_entry, &blob));
+        TEST_ASSERT_EQUAL_size_t(BLOB_LENGTH, blob.length);
+        TEST_ASSERT_EQUAL_MEMORY(BLOB, blob.value, BLOB_LENGTH);
+        TEST_ASSERT_EQUAL_INT(0, blob.value[blob.length]);
+        serdec_yaml_deserializer_free(deser);
+        free(output);
+    }
+}
+
+TEST(YamlSer, StructDescriptor) {
+    MyStruct value = {
+        .test = true,
+        .a_number = 1,
+        .a_string = "test",
+        .list_of_four = {1, 2, 3, 4},
+        .my_inner = {.my_value = 4},
+    };
+
+    SerdecYamlType* type = serdec_yaml_type_new(&MY_STRUCT_TYPE);
+    TEST_ASSERT_NOT_NULL(type);
+    SerdecYamlBackend backends[] = {
+        SERDEC_YAML_BACKEND_LIBYAML, SERDEC_YAML_BACKEND_NATIVE,
+    };
+
+    for (size_t i = 0; i < sizeof(backends) / sizeof(*backends); ++i) {
+        SerdecYamlSerializer* ser = serdec_yaml_serializer_new_string();
+        TEST_ASSERT_NOT_NULL(ser);
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serializer_set_backend(ser,
+                backends[i]));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_start(ser));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_struct(ser, type,
+                &value));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_end(ser));
+        TEST_ASSERT_EQUAL_STRING(BASIC_DOCUMENT,
+            serdec_yaml_serializer_borrow_string(ser));
+        serdec_yaml_serializer_free(ser);
+    }
+    serdec_yaml_type_free(type);
+
+    // Struct fields must have a descriptor.
+    static const SerdecYamlFieldDescriptor invalid_fields[] = {
+        {"inner", 0, SERDEC_YAML_KIND_STRUCT, NULL, 0},
+    };
+    const SerdecYamlTypeDescriptor invalid = {
+        .size = sizeof(InnerStruct),
+        .fields = invalid_fields,
+        .field_count = 1,
+    };
+    TEST_ASSERT_NULL(serdec_yaml_type_new(&invalid));
+}
+
+TEST(YamlSer, Reset) {
+    MyStruct value = {
+        .test = true,
+        .a_number = 1,
+        .a_string = "test",
+        .list_of_four = {1, 2, 3, 4},
+        .my_inner = {.my_value = 4},
+    };
+
+    SerdecYamlBackend backends[] = {
+        SERDEC_YAML_BACKEND_LIBYAML, SERDEC_YAML_BACKEND_NATIVE,
+    };
+    for (size_t i = 0; i < sizeof(backends) / sizeof(*backends); ++i) {
+        SerdecYamlSerializer* ser = serdec_yaml_serializer_new_string();
+        TEST_ASSERT_NOT_NULL(ser);
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serializer_set_backend(ser,
+                backends[i]));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_start(ser));
+        TEST_ASSERT_EQUAL_INT(0, my_struct_serialize_yaml(ser, &value));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_end(ser));
+        TEST_ASSERT_EQUAL_STRING(BASIC_DOCUMENT,
+            serdec_yaml_serializer_borrow_string(ser));
+
+        // A stream which was abandoned part-way through is discarded.
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serializer_reset(ser));
+        TEST_ASSERT_EQUAL_STRING("", serdec_yaml_serializer_borrow_string(ser));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_start(ser));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_map_start(ser));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_map_key(ser, "key"));
+
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serializer_reset(ser));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_start(ser));
+        TEST_ASSERT_EQUAL_INT(0, my_struct_serialize_yaml(ser, &value));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_end(ser));
+        TEST_ASSERT_EQUAL_STRING(BASIC_DOCUMENT,
+            serdec_yaml_serializer_borrow_string(ser));
+        serdec_yaml_serializer_free(ser);
+    }
+
+    // Buffer serializers can be pointed at a new buffer.
+    char first[256] = {0};
+    char second[256] = {0};
+    SerdecYamlSerializer* ser = serdec_yaml_serializer_new_buffer(first,
+        sizeof(first));
+    TEST_ASSERT_NOT_NULL(ser);
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, my_struct_serialize_yaml(ser, &value));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_end(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serializer_reset_buffer(ser, second,
+            sizeof(second)));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, my_struct_serialize_yaml(ser, &value));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_end(ser));
+    TEST_ASSERT_EQUAL_STRING(BASIC_DOCUMENT, first);
+    TEST_ASSERT_EQUAL_STRING(BASIC_DOCUMENT, second);
+    serdec_yaml_serializer_free(ser);
+
+    ser = serdec_yaml_serializer_new_string();
+    TEST_ASSERT_NOT_NULL(ser);
+    TEST_ASSERT_EQUAL_INT(SERDEC_YAML_WRONG_TYPE,
+        serdec_yaml_serializer_reset_buffer(ser, first, sizeof(first)));
+    serdec_yaml_serializer_free(ser);
+}
+
+static const char* MULTI_DOCUMENT = "\
+%YAML 1.1\n\
+---\n\
+a_number: 1\n\
+...\n\
+%YAML 1.1\n\
+---\n\
+a_number: 2\n\
+";
+
+TEST(YamlSer, MultipleDocuments) {
+    SerdecYamlBackend backends[] = {
+        SERDEC_YAML_BACKEND_LIBYAML, SERDEC_YAML_BACKEND_NATIVE,
+    };
+    for (size_t i = 0; i < sizeof(backends) / sizeof(*backends); ++i) {
+        SerdecYamlSerializer* ser = serdec_yaml_serializer_new_string();
+        TEST_ASSERT_NOT_NULL(ser);
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serializer_set_backend(ser,
+                backends[i]));
+        TEST_ASSERT_EQUAL_INT(SERDEC_YAML_UNEXPECTED_EVENT,
+            serdec_yaml_serialize_document_start(ser));
+
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_start(ser));
+        for (int number = 1; number <= 2; ++number) {
+            if (1 < number) {
+                TEST_ASSERT_EQUAL_INT(0,
+                    serdec_yaml_serialize_document_start(ser));
+            }
+            TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_map_start(ser));
+            TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_map_key(ser,
+                    "a_number"));
+            TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_int(ser, number));
+            TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_map_end(ser));
+            if (1 == number) {
+                TEST_ASSERT_EQUAL_INT(0,
+                    serdec_yaml_serialize_document_end(ser));
+                TEST_ASSERT_EQUAL_INT(SERDEC_YAML_UNEXPECTED_EVENT,
+                    serdec_yaml_serialize_document_end(ser));
+            }
+        }
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_end(ser));
+        TEST_ASSERT_EQUAL_STRING(MULTI_DOCUMENT,
+            serdec_yaml_serializer_borrow_string(ser));
+        serdec_yaml_serializer_free(ser);
+    }
+}
+
+// Serialize a list of records with the keys <keys>, either prepared or not.
+static char* serialize_records(SerdecYamlBackend backend,
+    const char* const* keys, SerdecYamlKey* const* prepared, size_t count)
+{
+    SerdecYamlSerializer* ser = serdec_yaml_serializer_new_string();
+    TEST_ASSERT_NOT_NULL(ser);
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serializer_set_backend(ser, backend));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_list_start(ser));
+    for (int record = 0; record < 3; ++record) {
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_map_start(ser));
+        for (size_t i = 0; i < count; ++i) {
+            if (NULL != prepared) {
+                TEST_ASSERT_EQUAL_INT(0,
+                    serdec_yaml_serialize_map_key_prepared(ser, prepared[i]));
+            } else {
+                TEST_ASSERT_EQUAL_INT(0,
+                    serdec_yaml_serialize_map_key(ser, keys[i]));
+            }
+            TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_int(ser, record));
+        }
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_map_end(ser));
+    }
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_list_end(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_end(ser));
+    char* string = serdec_yaml_serializer_take_string(ser, NULL);
+    serdec_yaml_serializer_free(ser);
+    return string;
+}
+
+TEST(YamlSer, PreparedKeys) {
+    static const char* KEYS[] = {"name", "it's: quoted", "a\ttab", "- item",
+        "..."};
+    static const size_t KEY_COUNT = sizeof(KEYS) / sizeof(KEYS[0]);
+    SerdecYamlKey* prepared[sizeof(KEYS) / sizeof(KEYS[0])];
+    for (size_t i = 0; i < KEY_COUNT; ++i) {
+        // Keys prepared with a length needn't be NUL-terminated.
+        char unterminated[32] = {0};
+        snprintf(unterminated, sizeof(unterminated), "%s_garbage", KEYS[i]);
+        switch (i % 3) {
+        case 0: prepared[i] = serdec_yaml_key_prepare(KEYS[i]); break;
+        case 1:
+            prepared[i] = serdec_yaml_key_prepare_n(unterminated,
+                strlen(KEYS[i]));
+            break;
+        default:
+            prepared[i] = serdec_yaml_key_prepare_with_allocator(KEYS[i],
+                NULL);
+            break;
+        }
+        TEST_ASSERT_NOT_NULL(prepared[i]);
+    }
+
+    // Prepared keys are written exactly as the keys they were prepared from.
+    static const SerdecYamlBackend BACKENDS[] = {SERDEC_YAML_BACKEND_LIBYAML,
+        SERDEC_YAML_BACKEND_NATIVE};
+    for (size_t i = 0; i < sizeof(BACKENDS) / sizeof(BACKENDS[0]); ++i) {
+        char* expected = serialize_records(BACKENDS[i], KEYS, NULL,
+            KEY_COUNT);
+        char* actual = serialize_records(BACKENDS[i], KEYS, prepared,
+            KEY_COUNT);
+        TEST_ASSERT_EQUAL_STRING(expected, actual);
+        free(expected);
+        free(actual);
+    }
+
+    // A key is still only valid where a key is expected.
+    SerdecYamlSerializer* ser = serdec_yaml_serializer_new_string();
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serializer_set_backend(ser,
+            SERDEC_YAML_BACKEND_NATIVE));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_list_start(ser));
+    TEST_ASSERT_EQUAL_INT(SERDEC_YAML_UNEXPECTED_EVENT,
+        serdec_yaml_serialize_map_key_prepared(ser, prepared[0]));
+    serdec_yaml_serializer_free(ser);
+
+    for (size_t i = 0; i < KEY_COUNT; ++i) {
+        serdec_yaml_key_free(prepared[i]);
+    }
+}
+
+static const char* COMPACT_DOCUMENT = "\
+numbers: [0, 1000, 2000, 3000, 4000, 5000, 6000, 7000, 8000, 9000, 10000]\n\
+empty: []\n\
+records:\n\
+- name: a_name\n\
+  tags: [plain words, 'x,y', 'true', {ratio: 1.5}, [false]]\n\
+- name: a_name\n\
+  tags: [plain words, 'x,y', 'true', {ratio: 1.5}, [false]]\n\
+---\n\
+- [1]\n\
+- []\n\
+";
+
+static void serialize_compact_document(SerdecYamlSerializer* ser) {
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_map_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_map_key(ser, "numbers"));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_list_start(ser));
+    for (int i = 0; i <= 10; ++i) {
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_int(ser, i * 1000));
+    }
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_list_end(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_map_key(ser, "empty"));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_list_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_list_end(ser));
+
+    // Lists which begin with a collection are block lists.
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_map_key(ser, "records"));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_list_start(ser));
+    for (int i = 0; i < 2; ++i) {
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_map_start(ser));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_map_key(ser, "name"));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_string(ser, "a_name"));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_map_key(ser, "tags"));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_list_start(ser));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_string(ser,
+                "plain words"));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_string(ser, "x,y"));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_string(ser, "true"));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_map_start(ser));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_map_key(ser, "ratio"));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_double(ser, 1.5));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_map_end(ser));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_list_start(ser));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_bool(ser, false));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_list_end(ser));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_list_end(ser));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_map_end(ser));
+    }
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_list_end(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_map_end(ser));
+
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_document_end(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_document_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_list_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_list_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_int(ser, 1));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_list_end(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_list_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_list_end(ser));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_list_end(ser));
+}
+
+TEST(YamlSer, Options) {
+    SerdecYamlSerializerOptions options = {
+        .indent = 2,
+        .flow_scalar_lists = true,
+        .plain_strings = true,
+        .omit_directives = true,
+    };
+
+    static const SerdecYamlBackend BACKENDS[] = {SERDEC_YAML_BACKEND_LIBYAML,
+        SERDEC_YAML_BACKEND_NATIVE};
+    for (size_t i = 0; i < sizeof(BACKENDS) / sizeof(BACKENDS[0]); ++i) {
+        SerdecYamlSerializer* ser = serdec_yaml_serializer_new_string();
+        TEST_ASSERT_NOT_NULL(ser);
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serializer_set_options(ser,
+                &options));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serializer_set_backend(ser,
+                BACKENDS[i]));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_start(ser));
+        serialize_compact_document(ser);
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_end(ser));
+        TEST_ASSERT_EQUAL_STRING(COMPACT_DOCUMENT,
+            serdec_yaml_serializer_borrow_string(ser));
+
+        // The options are kept by _reset(), but can't change once the stream
+        // has started.
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serializer_reset(ser));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_start(ser));
+        TEST_ASSERT_EQUAL_INT(SERDEC_YAML_INVALID_STATE,
+            serdec_yaml_serializer_set_options(ser, NULL));
+        serialize_compact_document(ser);
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_end(ser));
+        TEST_ASSERT_EQUAL_STRING(COMPACT_DOCUMENT,
+            serdec_yaml_serializer_borrow_string(ser));
+        serdec_yaml_serializer_free(ser);
+    }
+
+    // The default options write the same document as before.
+    SerdecYamlSerializer* ser = serdec_yaml_serializer_new_string();
+    options.indent = 1;
+    TEST_ASSERT_EQUAL_INT(SERDEC_YAML_OUT_OF_RANGE,
+        serdec_yaml_serializer_set_options(ser, &options));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serializer_set_options(ser, NULL));
+    MyStruct value = {
+        .test = true,
+        .a_number = 1,
+        .a_string = "test",
+        .list_of_four = {1, 2, 3, 4},
+        .my_inner = {.my_value = 4},
+    };
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_start(ser));
+    TEST_ASSERT_EQUAL_INT(0, my_struct_serialize_yaml(ser, &value));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_end(ser));
+    TEST_ASSERT_EQUAL_STRING(BASIC_DOCUMENT,
+        serdec_yaml_serializer_borrow_string(ser));
+    serdec_yaml_serializer_free(ser);
+}
+
+// YAML 1.1 line breaks (NEL, LS and PS) and byte order marks, alone and
+// within other text.
+static const char* LINE_BREAKS[] = {"x\xc2\x85y", "\xe2\x80\xa8",
+    "\xe2\x80\xa9", "\xef\xbb\xbf", "a\xef\xbb\xbf b"};
+#define LINE_BREAK_COUNT (sizeof(LINE_BREAKS) / sizeof(LINE_BREAKS[0]))
+
+typedef struct LineBreaks {
+    size_t count;
+    bool matched[LINE_BREAK_COUNT];
+} LineBreaks;
+
+static int line_breaks_visit_map_entry(SerdecYamlDeserializer* deser,
+    void* user_data, const char* key)
+{
+    LineBreaks* line_breaks = (LineBreaks*)user_data;
+    const char* value = NULL;
+    if (LINE_BREAK_COUNT <= line_breaks->count ||
+        serdec_yaml_deserialize_string(deser, &value)) {
+        return 1;
+    }
+
+    size_t index = line_breaks->count++;
+    line_breaks->matched[index] = !strcmp(LINE_BREAKS[index], key) &&
+        !strcmp(LINE_BREAKS[index], value);
+    return 0;
+}
+
+TEST(YamlSer, LineBreaks) {
+    SerdecYamlKey* prepared[LINE_BREAK_COUNT];
+    for (size_t i = 0; i < LINE_BREAK_COUNT; ++i) {
+        prepared[i] = serdec_yaml_key_prepare(LINE_BREAKS[i]);
+        TEST_ASSERT_NOT_NULL(prepared[i]);
+    }
+
+    SerdecYamlBackend backends[] = {
+        SERDEC_YAML_BACKEND_LIBYAML, SERDEC_YAML_BACKEND_NATIVE,
+    };
+    for (size_t i = 0; i < sizeof(backends) / sizeof(*backends); ++i) {
+        // Every other key is prepared.
+        SerdecYamlSerializer* ser = serdec_yaml_serializer_new_string();
+        TEST_ASSERT_NOT_NULL(ser);
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serializer_set_backend(ser,
+                backends[i]));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_start(ser));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_map_start(ser));
+        for (size_t j = 0; j < LINE_BREAK_COUNT; ++j) {
+            TEST_ASSERT_EQUAL_INT(0, j % 2
+                ? serdec_yaml_serialize_map_key_prepared(ser, prepared[j])
+                : serdec_yaml_serialize_map_key(ser, LINE_BREAKS[j]));
+            TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_string(ser,
+                    LINE_BREAKS[j]));
+        }
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_map_end(ser));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_end(ser));
+
+        size_t length = 0;
+        char* output = serdec_yaml_serializer_take_string(ser, &length);
+        serdec_yaml_serializer_free(ser);
+        TEST_ASSERT_NOT_NULL(output);
+
+        // The output reads back the same. libyaml writes keys which contain
+        // line breaks as complex keys, which the native scanner doesn't
+        // support, so only the native output is read with both backends.
+        for (size_t j = 0; j <= i; ++j) {
+            SerdecYamlDeserializerOptions options = {.backend = backends[j]};
+            SerdecYamlDeserializer* deser =
+                serdec_yaml_deserializer_new_string_with_options(output,
+                    length, &options);
+            TEST_ASSERT_NOT_NULL(deser);
+            LineBreaks line_breaks = {0};
+            TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserialize_map(deser,
+                    line_breaks_visit_map_entry, &line_breaks));
+            TEST_ASSERT_EQUAL_size_t(LINE_BREAK_COUNT, line_breaks.count);
+            for (size_t k = 0; k < LINE_BREAK_COUNT; ++k) {
+                TEST_ASSERT(line_breaks.matched[k]);
+            }
+            serdec_yaml_deserializer_free(deser);
+        }
+        free(output);
+    }
+
+    for (size_t i = 0; i < LINE_BREAK_COUNT; ++i) {
+        serdec_yaml_key_free(prepared[i]);
+    }
+}
+
+TEST(YamlSer, Stats) {
+    SerdecYamlBackend backends[] = {
+        SERDEC_YAML_BACKEND_LIBYAML, SERDEC_YAML_BACKEND_NATIVE,
+    };
+    for (size_t i = 0; i < sizeof(backends) / sizeof(*backends); ++i) {
+        SerdecYamlSerializer* ser = serdec_yaml_serializer_new_string();
+        TEST_ASSERT_NOT_NULL(ser);
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serializer_set_backend(ser,
+                backends[i]));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_start(ser));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_map_start(ser));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_map_key(ser, "name"));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_string(ser, "value"));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_map_key(ser, "list"));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_list_start(ser));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_int(ser, 10));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_bool(ser, true));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_list_end(ser));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_map_end(ser));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_serialize_end(ser));
+
+        SerdecYamlStats stats = {0};
+        int result = serdec_yaml_serializer_stats(ser, &stats);
+#ifdef SERDEC_ENABLE_STATS
+        TEST_ASSERT_EQUAL_INT(0, result);
+
+        // libyaml also emits the start and end of the stream.
+        size_t events = SERDEC_YAML_BACKEND_LIBYAML == backends[i] ? 13 : 11;
+        TEST_ASSERT_EQUAL_UINT64(events, stats.events);
+        TEST_ASSERT_EQUAL_UINT64(serdec_yaml_serializer_required_size(ser) - 1,
+            stats.bytes);
+        TEST_ASSERT_EQUAL_UINT64(19, stats.scalar_bytes);
+        TEST_ASSERT_EQUAL_UINT64(2, stats.max_depth);
+        TEST_ASSERT(0 < stats.buffer_grows);
+        TEST_ASSERT(stats.buffer_grows <= stats.allocations
+            + stats.reallocations);
+        TEST_ASSERT_EQUAL_UINT64(0, stats.callback_ns);
+        TEST_ASSERT_EQUAL_UINT64(0, stats.codec_ns);
+#else
+        TEST_ASSERT_EQUAL_INT(SERDEC_YAML_NOT_SUPPORTED, result);
+        TEST_ASSERT_NOT_NULL(serdec_yaml_serializer_strerror(ser));
+#endif
+        serdec_yaml_serializer_free(ser);
+    }
+}
+
 TEST_GROUP_RUNNER(YamlSer) {
     RUN_TEST_CASE(YamlSer, BasicDocument);
+    RUN_TEST_CASE(YamlSer, TakeString);
+    RUN_TEST_CASE(YamlSer, FixedBuffer);
+    RUN_TEST_CASE(YamlSer, File);
+    RUN_TEST_CASE(YamlSer, Sink);
+    RUN_TEST_CASE(YamlSer, NativeBackend);
+    RUN_TEST_CASE(YamlSer, Numbers);
+    RUN_TEST_CASE(YamlSer, LengthAwareStrings);
+    RUN_TEST_CASE(YamlSer, StructDescriptor);
+    RUN_TEST_CASE(YamlSer, Reset);
+    RUN_TEST_CASE(YamlSer, MultipleDocuments);
+    RUN_TEST_CASE(YamlSer, PreparedKeys);
+    RUN_TEST_CASE(YamlSer, Options);
+    RUN_TEST_CASE(YamlSer, LineBreaks);
+    RUN_TEST_CASE(YamlSer, Stats);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
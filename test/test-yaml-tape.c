@@ -0,0 +1,243 @@
+///////////////////////////////////////////////////////////////////////////////
+// NAME:            test-yaml-tape.c
+//
+// AUTHOR:          Ethan D. Twardy <ethan.twardy@gmail.com>
+//
+// DESCRIPTION:     Tests for parsed-once tapes.
+//
+// CREATED:         10/14/2026
+//
+// LAST EDITED:     10/14/2026
+//
+// Copyright 2026, Ethan D. Twardy
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+////
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <serdec/yaml.h>
+#include <serdec/yaml-error.h>
+
+#include <unity_fixture.h>
+
+#include "my-struct.h"
+
+TEST_GROUP(YamlTape);
+TEST_SETUP(YamlTape) {}
+TEST_TEAR_DOWN(YamlTape) {}
+
+static const char* TAPE_DOCUMENT = "\
+name: 'config'\n\
+servers:\n\
+    - {host: a, port: 1}\n\
+    - {host: b, port: 2}\n\
+    - {host: c, port: 3}\n\
+    - {host: d, port: 4, tags: [x, 'y', \"z\\0\"]}\n\
+records:\n\
+    - test: true\n\
+      a_number: 7\n\
+      a_string: 'first'\n\
+      list_of_four: [1, 2, 3, 4]\n\
+      my_inner: {my_value: 8}\n\
+empty: {}\n\
+name: 'duplicate'\n\
+";
+
+static SerdecYamlTape* parse_tape(SerdecYamlBackend backend) {
+    SerdecYamlDeserializerOptions options = {.backend = backend};
+    SerdecYamlDeserializer* deser =
+        serdec_yaml_deserializer_new_string_with_options(TAPE_DOCUMENT,
+            strlen(TAPE_DOCUMENT), &options);
+    TEST_ASSERT_NOT_NULL(deser);
+    SerdecYamlTape* tape = serdec_yaml_tape_new(deser);
+    TEST_ASSERT_NOT_NULL(tape);
+
+    // The whole document has been consumed.
+    TEST_ASSERT_EQUAL_INT(SERDEC_YAML_END_OF_STREAM,
+        serdec_yaml_deserializer_next_document(deser));
+    serdec_yaml_deserializer_free(deser);
+    return tape;
+}
+
+static void check_scalar(const SerdecYamlTape* tape, const char* path,
+    const char* expected)
+{
+    size_t node = 0;
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, serdec_yaml_tape_get(tape, path, &node),
+        path);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(expected,
+        serdec_yaml_tape_scalar(tape, node, NULL), path);
+}
+
+TEST(YamlTape, Lookup) {
+    SerdecYamlBackend backends[] = {
+        SERDEC_YAML_BACKEND_LIBYAML,
+        SERDEC_YAML_BACKEND_NATIVE,
+    };
+    for (size_t i = 0; i < sizeof(backends) / sizeof(*backends); ++i) {
+        SerdecYamlTape* tape = parse_tape(backends[i]);
+        check_scalar(tape, "name", "config");
+        check_scalar(tape, "servers[0].host", "a");
+        check_scalar(tape, "servers[2].port", "3");
+        check_scalar(tape, "servers[3].tags[1]", "y");
+        check_scalar(tape, "records[0].my_inner.my_value", "8");
+
+        size_t node = 0;
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_tape_get(tape, "", &node));
+        TEST_ASSERT_EQUAL_size_t(SERDEC_YAML_TAPE_ROOT, node);
+        TEST_ASSERT_EQUAL_INT(SERDEC_YAML_NODE_MAP,
+            serdec_yaml_tape_kind(tape, node));
+        TEST_ASSERT_EQUAL_size_t(5, serdec_yaml_tape_length(tape, node));
+        TEST_ASSERT_NULL(serdec_yaml_tape_scalar(tape, node, NULL));
+
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_tape_get(tape, "servers",
+                &node));
+        TEST_ASSERT_EQUAL_INT(SERDEC_YAML_NODE_LIST,
+            serdec_yaml_tape_kind(tape, node));
+        TEST_ASSERT_EQUAL_size_t(4, serdec_yaml_tape_length(tape, node));
+        size_t server = 0;
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_tape_get_from(tape, node,
+                "[3].tags[2]", &server));
+        size_t length = 0;
+        const char* value = serdec_yaml_tape_scalar(tape, server, &length);
+        TEST_ASSERT_EQUAL_size_t(2, length);
+        TEST_ASSERT_EQUAL_MEMORY("z\0", value, 3);
+
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_tape_get(tape, "empty", &node));
+        TEST_ASSERT_EQUAL_size_t(0, serdec_yaml_tape_length(tape, node));
+
+        // Lookups which don't match anything.
+        const char* missing[] = {
+            "nothing", "servers[4]", "servers.host", "name[0]", "name.x",
+            "servers[99999999999999999999999]", "[0]",
+        };
+        for (size_t j = 0; j < sizeof(missing) / sizeof(*missing); ++j) {
+            TEST_ASSERT_EQUAL_INT_MESSAGE(SERDEC_YAML_NOT_FOUND,
+                serdec_yaml_tape_get(tape, missing[j], &node), missing[j]);
+        }
+
+        // Malformed paths are reported, even after a part which doesn't match.
+        const char* malformed[] = {
+            ".name", "name.", "a..b", "servers[", "servers[]", "servers[x]",
+            "servers[0]host", "nothing[0", "servers[-1]",
+        };
+        for (size_t j = 0; j < sizeof(malformed) / sizeof(*malformed); ++j) {
+            TEST_ASSERT_EQUAL_INT_MESSAGE(SERDEC_YAML_INVALID_PATH,
+                serdec_yaml_tape_get(tape, malformed[j], &node),
+                malformed[j]);
+        }
+        serdec_yaml_tape_free(tape);
+    }
+}
+
+static int a_number_visit_map_entry(SerdecYamlDeserializer* deser,
+    void* user_data, const char* key)
+{
+    if (!strcmp(key, "a_number")) {
+        return serdec_yaml_deserialize_int(deser, user_data);
+    }
+    return serdec_yaml_deserialize_skip(deser);
+}
+
+TEST(YamlTape, Replay) {
+    SerdecYamlTape* tape = parse_tape(SERDEC_YAML_BACKEND_LIBYAML);
+    SerdecYamlType* type = serdec_yaml_type_new(&MY_STRUCT_TYPE);
+    TEST_ASSERT_NOT_NULL(type);
+    size_t node = 0;
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_tape_get(tape, "records[0]", &node));
+
+    // Any part of the tape can be replayed, as many times as necessary.
+    SerdecYamlDeserializer* deser = serdec_yaml_deserializer_new_tape(tape,
+        node);
+    TEST_ASSERT_NOT_NULL(deser);
+    for (int i = 0; i < 3; ++i) {
+        MyStruct my_struct = {0};
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserialize_struct(deser, type,
+                &my_struct));
+        TEST_ASSERT(true == my_struct.test);
+        TEST_ASSERT_EQUAL_INT(7, my_struct.a_number);
+        TEST_ASSERT_EQUAL_STRING("first", my_struct.a_string);
+        TEST_ASSERT_EQUAL_INT(4, my_struct.list_of_four[3]);
+        TEST_ASSERT_EQUAL_INT(8, my_struct.my_inner.my_value);
+        serdec_yaml_type_release(type, &my_struct);
+        TEST_ASSERT_EQUAL_INT(SERDEC_YAML_END_OF_STREAM,
+            serdec_yaml_deserializer_next_document(deser));
+        TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserializer_reset_tape(deser,
+                tape, node));
+    }
+
+    // Through the visitor API.
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_tape_get(tape, "records[0]", &node));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserializer_reset_tape(deser, tape,
+            node));
+    int a_number = 0;
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserialize_map(deser,
+            a_number_visit_map_entry, &a_number));
+    TEST_ASSERT_EQUAL_INT(7, a_number);
+
+    // Scalars and lists.
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_tape_get(tape, "servers[1].port",
+            &node));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserializer_reset_tape(deser, tape,
+            node));
+    int port = 0;
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserialize_int(deser, &port));
+    TEST_ASSERT_EQUAL_INT(2, port);
+
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_tape_get(tape,
+            "records[0].list_of_four", &node));
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserializer_reset_tape(deser, tape,
+            node));
+    int* values = NULL;
+    size_t count = 0;
+    TEST_ASSERT_EQUAL_INT(0, serdec_yaml_deserialize_int_vector(deser,
+            &values, &count));
+    TEST_ASSERT_EQUAL_size_t(4, count);
+    TEST_ASSERT_EQUAL_INT(1, values[0]);
+    free(values);
+
+    // Nodes which don't exist can't be replayed.
+    TEST_ASSERT_EQUAL_INT(SERDEC_YAML_NOT_FOUND,
+        serdec_yaml_deserializer_reset_tape(deser, tape, 1000));
+    serdec_yaml_deserializer_free(deser);
+    TEST_ASSERT_NULL(serdec_yaml_deserializer_new_tape(tape, 1000));
+    serdec_yaml_type_free(type);
+    serdec_yaml_tape_free(tape);
+}
+
+TEST(YamlTape, Aliases) {
+    const char* document = "a: &anchor 1\nb: *anchor\n";
+    SerdecYamlDeserializer* deser = serdec_yaml_deserializer_new_string(
+        document, strlen(document));
+    TEST_ASSERT_NOT_NULL(deser);
+    TEST_ASSERT_NULL(serdec_yaml_tape_new(deser));
+    TEST_ASSERT_EQUAL_STRING("expected a different event in the stream",
+        serdec_yaml_deserializer_strerror(deser));
+    serdec_yaml_deserializer_free(deser);
+}
+
+TEST_GROUP_RUNNER(YamlTape) {
+    RUN_TEST_CASE(YamlTape, Lookup);
+    RUN_TEST_CASE(YamlTape, Replay);
+    RUN_TEST_CASE(YamlTape, Aliases);
+}
+
+///////////////////////////////////////////////////////////////////////////////